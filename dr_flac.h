@@ -96,6 +96,13 @@
 //   returns after about 4KB (which is the default). Consider reducing this if you have a very efficient implementation of
 //   onRead(), or increase it if it's very inefficient. Must be a multiple of 8.
 //
+// #define DR_FLAC_READ_AHEAD_SIZE <number>
+//   Enables read-ahead for decoders opened with drflac_open_file(). As the decoder reads through the file the operating system
+//   is asked to start loading the next <number> bytes so that the data is already in memory by the time it's needed. This
+//   helps when decoding from slow storage such as network mounts. On Linux this uses posix_fadvise() and requires a POSIX
+//   environment, in which case <number> should be in the order of a few hundred kilobytes. With the Win32 IO APIs the file is
+//   opened for sequential access and the OS chooses the read-ahead size. Ignored on other platforms.
+//
 // #define DR_FLAC_NO_CRC
 //   Disables CRC checks. This will offer a performance boost when CRC is unnecessary.
 //
@@ -103,6 +110,13 @@
 //   Disables SIMD optimizations (SSE on x86/x64 architectures). Use this if you are having compatibility issues with your
 //   compiler.
 //
+// #define DR_FLAC_LOW_MEMORY
+//   Reduces the amount of memory used by each decoder. Streams with 16 bits per sample or less will store the samples of the
+//   current frame as 16-bit integers rather than 32-bit, and the working buffer used for decoding subframes is shared between
+//   every decoder on the same thread. This is intended for when many decoders need to be open at the same time. In this mode
+//   a decoder should be closed on the same thread it was opened on. The default value of DR_FLAC_BUFFER_SIZE is also reduced
+//   to 1KB. Use drflac_get_memory_usage() to find out how much memory a decoder is using.
+//
 //
 //
 // QUICK NOTES
@@ -148,8 +162,12 @@ typedef drflac_uint32    drflac_bool32;
 // size of that buffer. Larger values means more speed, but also more memory. In my testing there is diminishing
 // returns after about 4KB, but you can fiddle with this to suit your own needs. Must be a multiple of 8.
 #ifndef DR_FLAC_BUFFER_SIZE
+#ifdef DR_FLAC_LOW_MEMORY
+#define DR_FLAC_BUFFER_SIZE   1024
+#else
 #define DR_FLAC_BUFFER_SIZE   4096
 #endif
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -335,6 +353,10 @@ typedef size_t (* drflac_read_proc)(void* pUserData, void* pBufferOut, size_t by
 // by the "origin" parameter which will be either drflac_seek_origin_start or drflac_seek_origin_current.
 typedef drflac_bool32 (* drflac_seek_proc)(void* pUserData, int offset, drflac_seek_origin origin);
 
+// The same as drflac_seek_proc, except the offset is 64-bit so the whole stream can be covered in a single call. The offset
+// will never be negative. Use this with drflac_open_seek64() and drflac_open_with_metadata_seek64().
+typedef drflac_bool32 (* drflac_seek64_proc)(void* pUserData, drflac_int64 offset, drflac_seek_origin origin);
+
 // Callback for when a metadata block is read.
 //
 // pUserData [in] The user data that was passed to drflac_open() and family.
@@ -352,6 +374,14 @@ typedef struct
     size_t currentReadPos;
 } drflac__memory_stream;
 
+// Structure for internal use. Used for calculating the MD5 of the decoded audio data.
+typedef struct
+{
+    drflac_uint32 state[4];
+    drflac_uint64 byteCount;
+    drflac_uint8 buffer[64];
+} drflac__md5;
+
 // Structure for internal use. Used for bit streaming.
 typedef struct
 {
@@ -361,6 +391,9 @@ typedef struct
     // The function to call when the current read position needs to be moved.
     drflac_seek_proc onSeek;
 
+    // The 64-bit variant of onSeek. When set, this is used instead of onSeek.
+    drflac_seek64_proc onSeek64;
+
     // The user data to pass around to onRead and onSeek.
     void* pUserData;
 
@@ -450,6 +483,29 @@ typedef struct
     drflac_subframe subframes[8];
 } drflac_frame;
 
+// How samples are rounded when drflac_read_s16() throws away bits. See drflac_dither_init().
+typedef enum
+{
+    drflac_dither_mode_none = 0,        // The extra bits are truncated. This is the default.
+    drflac_dither_mode_triangle,        // Triangular (TPDF) dither of up to 1 LSB is added before rounding to the nearest value.
+    drflac_dither_mode_triangle_shaped  // The same, with first-order noise shaping which moves the noise up towards high frequencies.
+} drflac_dither_mode;
+
+// The maximum number of channels that can be noise shaped. This is the most a FLAC stream can have.
+#define DRFLAC_MAX_DITHER_CHANNELS  8
+
+// The state of a dithered conversion to 16-bit samples. The noise shaping error is tracked per channel, so the samples of a
+// stream must be converted in order, although they can be split across any number of calls.
+typedef struct
+{
+    drflac_dither_mode mode;
+    drflac_uint32 channels;
+    drflac_uint32 iChannel;     // The channel of the next sample.
+    drflac_uint32 iLane;        // The random number generator lane to use for the next sample.
+    drflac_uint32 lanes[4];     // Four xorshift generators which are used in turn.
+    double error[DRFLAC_MAX_DITHER_CHANNELS];   // The quantization error of the previous sample of each channel.
+} drflac_dither;
+
 typedef struct
 {
     // The function to call when a metadata block is read.
@@ -500,9 +556,36 @@ typedef struct
     drflac__memory_stream memoryStream;
 
 
-    // A pointer to the decoded sample data. This is an offset of pExtraData.
+    // A pointer to the decoded sample data. This is an offset of pExtraData. When DR_FLAC_LOW_MEMORY is enabled and the stream is
+    // 16 bits per sample or less, this points to the buffer that is shared between all decoders on the current thread.
     drflac_int32* pDecodedSamples;
 
+    // Only used when DR_FLAC_LOW_MEMORY is enabled and the stream is 16 bits per sample or less. Holds the fully decoded, interleaved
+    // samples of the current frame as the upper 16 bits of what is returned by drflac_read_s32(). This is an offset of pExtraData.
+    drflac_int16* pDecodedSamples16;
+
+    // The size in bytes of the allocation holding this object and it's extra data. Used by drflac_get_memory_usage().
+    size_t allocationSize;
+
+
+    // The MD5 signature of the unencoded audio data as specified by the STREAMINFO block. All zero if not present.
+    drflac_uint8 streaminfoMD5[16];
+
+    // Whether or not the decoded audio is being hashed. See drflac_enable_md5_verification().
+    drflac_bool32 isMD5Enabled;
+
+    // Whether or not every sample since the start of the stream has been hashed, in order. This is cleared when seeking.
+    drflac_bool32 isMD5Contiguous;
+
+    // The number of samples that have been hashed so far.
+    drflac_uint64 md5SampleCount;
+
+    // The running MD5 of the decoded audio.
+    drflac__md5 md5;
+
+    // The dither used by drflac_read_s16(). See drflac_set_dither().
+    drflac_dither dither;
+
     // Internal use only. Only used with Ogg containers. Points to a drflac_oggbs object. This is an offset of pExtraData.
     void* _oggbs;
 
@@ -581,6 +664,19 @@ drflac* drflac_open_with_metadata(drflac_read_proc onRead, drflac_seek_proc onSe
 // See also: drflac_open_with_metadata(), drflac_open_relaxed()
 drflac* drflac_open_with_metadata_relaxed(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_meta_proc onMeta, drflac_container container, void* pUserData);
 
+// The same as drflac_open(), except the seek callback takes a 64-bit offset.
+//
+// Seeking in a stream larger than 2GB with a 32-bit callback needs to be broken up into a series of relative seeks. Use this
+// when your stream can move anywhere in a single call.
+//
+// See also: drflac_open(), drflac_open_with_metadata_seek64()
+drflac* drflac_open_seek64(drflac_read_proc onRead, drflac_seek64_proc onSeek64, void* pUserData);
+
+// The same as drflac_open_with_metadata(), except the seek callback takes a 64-bit offset.
+//
+// See also: drflac_open_with_metadata(), drflac_open_seek64()
+drflac* drflac_open_with_metadata_seek64(drflac_read_proc onRead, drflac_seek64_proc onSeek64, drflac_meta_proc onMeta, void* pUserData);
+
 // Closes the given FLAC decoder.
 //
 // pFlac [in] The decoder to close.
@@ -588,6 +684,15 @@ drflac* drflac_open_with_metadata_relaxed(drflac_read_proc onRead, drflac_seek_p
 // This will destroy the decoder object.
 void drflac_close(drflac* pFlac);
 
+// Retrieves the number of bytes of memory that have been allocated for the given decoder.
+//
+// pFlac [in] The decoder.
+//
+// This includes the decoder object itself and any memory attached to it, such as the decoded samples of the current frame and
+// the Ogg page buffer. When DR_FLAC_LOW_MEMORY is enabled, the decoding buffer that is shared between decoders on the same
+// thread is not included.
+size_t drflac_get_memory_usage(drflac* pFlac);
+
 
 // Reads sample data from the given FLAC decoder, output as interleaved signed 32-bit PCM.
 //
@@ -612,9 +717,41 @@ drflac_uint64 drflac_read_s32(drflac* pFlac, drflac_uint64 samplesToRead, drflac
 // pBufferOut can be null, in which case the call will act as a seek, and the return value will be the number of samples
 // seeked.
 //
-// Note that this is lossy for streams where the bits per sample is larger than 16.
+// Note that this is lossy for streams where the bits per sample is larger than 16. The extra bits are truncated unless a dither
+// has been set with drflac_set_dither().
 drflac_uint64 drflac_read_s16(drflac* pFlac, drflac_uint64 samplesToRead, drflac_int16* pBufferOut);
 
+// Same as drflac_read_s16(), except dithered with the given dither instead of the one set with drflac_set_dither().
+//
+// pFlac         [in]            The decoder.
+// samplesToRead [in]            The number of samples to read.
+// pBufferOut    [out]           A pointer to the buffer that will receive the decoded samples.
+// pDither       [in, optional]  The dither state. This is updated so it can be passed to the next call. NULL truncates.
+//
+// Returns the number of samples actually read.
+drflac_uint64 drflac_read_s16_dithered(drflac* pFlac, drflac_uint64 samplesToRead, drflac_int16* pBufferOut, drflac_dither* pDither);
+
+// Initializes the state of a dithered conversion to 16-bit samples.
+//
+// pDither  [out] The dither state to initialize.
+// mode     [in]  How to round samples.
+// channels [in]  The number of interleaved channels in the samples that will be dithered.
+// seed     [in]  The seed of the random numbers used for the dither. The same seed always produces the same output.
+//
+// Returns DRFLAC_TRUE if successful; DRFLAC_FALSE if <channels> is 0, or if noise shaping is requested for more than
+// DRFLAC_MAX_DITHER_CHANNELS channels.
+drflac_bool32 drflac_dither_init(drflac_dither* pDither, drflac_dither_mode mode, drflac_uint32 channels, drflac_uint32 seed);
+
+// Sets the dither used by drflac_read_s16().
+//
+// pFlac [in] The decoder.
+// mode  [in] How to round samples.
+//
+// Returns DRFLAC_TRUE if successful; DRFLAC_FALSE otherwise.
+//
+// Only streams with more than 16 bits per sample are dithered. Everything else converts to 16 bits without any loss.
+drflac_bool32 drflac_set_dither(drflac* pFlac, drflac_dither_mode mode);
+
 // Same as drflac_read_s32(), except outputs samples as 32-bit floating-point PCM.
 //
 // pFlac         [in]            The decoder.
@@ -644,6 +781,101 @@ drflac_uint64 drflac_read_f32(drflac* pFlac, drflac_uint64 samplesToRead, float*
 // something like drflac_seek_to_sample(pFlac, (mySampleIndex + (mySampleIndex % pFlac->channels)))
 drflac_bool32 drflac_seek_to_sample(drflac* pFlac, drflac_uint64 sampleIndex);
 
+// Enables verification of the decoded audio against the MD5 signature in the STREAMINFO block.
+//
+// pFlac [in] The decoder.
+//
+// Returns DRFLAC_TRUE if verification was enabled; DRFLAC_FALSE if the stream does not have an MD5 signature or samples have
+// already been read.
+//
+// When enabled, every sample returned by drflac_read_s32() and family is hashed as it's decoded, so there's no need for a
+// second decoding pass. Use drflac_md5_matches() after the last sample has been read to check the result. Seeking to anywhere
+// other than the start of the stream, or reading with a null output buffer, means the hash can no longer be calculated.
+//
+// See also: drflac_md5_matches()
+drflac_bool32 drflac_enable_md5_verification(drflac* pFlac);
+
+// Determines whether or not the MD5 of the decoded audio matches the signature in the STREAMINFO block.
+//
+// pFlac [in] The decoder.
+//
+// Returns DRFLAC_TRUE if every sample in the stream has been read, in order, and the MD5 matches. Returns DRFLAC_FALSE if there
+// is a mismatch, verification was not enabled, the end of the stream has not been reached or the hash could not be calculated
+// due to seeking.
+//
+// See also: drflac_enable_md5_verification()
+drflac_bool32 drflac_md5_matches(drflac* pFlac);
+
+
+//// Waveform Overviews ////
+
+// Parameters for drflac_overview_init().
+typedef struct
+{
+    // The number of PCM frames summarized by each point of the most detailed level. Set to 0 to use 256.
+    drflac_uint32 framesPerPoint;
+
+    // The maximum number of levels. Each level has half as many points as the one before it. Set to 0 to keep adding levels
+    // until one has a single point.
+    drflac_uint32 maxLevels;
+} drflac_overview_config;
+
+// The range and loudness of one channel over a run of PCM frames.
+typedef struct
+{
+    float min;
+    float max;
+    float rms;
+} drflac_overview_point;
+
+// A min/max/RMS summary of an entire stream at several zoom levels, for drawing waveforms.
+typedef struct
+{
+    drflac_uint16 channels;
+    drflac_uint32 framesPerPoint;   // For level 0. This doubles with each level.
+    drflac_uint32 levelCount;
+    drflac_uint64 frameCount;
+
+    // The points of every level, most detailed first. Within a level there is one point per channel for each run of frames.
+    // Use drflac_overview_get_level() to find the start of a level.
+    drflac_overview_point* pPoints;
+} drflac_overview;
+
+// Builds a waveform overview of the entire stream.
+//
+// pFlac   [in]           The decoder.
+// pConfig [in, optional] The parameters of the overview, or NULL to use the defaults.
+//
+// Returns DRFLAC_TRUE if successful; DRFLAC_FALSE otherwise.
+//
+// The decoder is moved back to the first sample and then the stream is decoded once, a fixed-size chunk at a time, so the only
+// memory needed apart from the overview itself is a single chunk. This also works for streams that don't know their total
+// sample count. The decoder is left at the end of the stream.
+//
+// Free the overview with drflac_overview_uninit().
+drflac_bool32 drflac_overview_init(drflac_overview* pOverview, drflac* pFlac, const drflac_overview_config* pConfig);
+
+// Restores an overview that was saved with drflac_overview_serialize().
+drflac_bool32 drflac_overview_init_serialized(drflac_overview* pOverview, const void* pData, size_t dataSize);
+
+// Frees the memory of the given overview.
+void drflac_overview_uninit(drflac_overview* pOverview);
+
+// Retrieves the points of a level of an overview.
+//
+// Returns a pointer to <*pPointCount> runs of frames with <channels> points each, or NULL if <level> is out of range.
+const drflac_overview_point* drflac_overview_get_level(const drflac_overview* pOverview, drflac_uint32 level, drflac_uint64* pPointCount);
+
+// Saves an overview in a compact form.
+//
+// Only the most detailed level is stored, at 16-bit precision with the minimum rounded down and the maximum rounded up so the
+// range still covers every sample that is within the range of 16-bit PCM. The other levels are rebuilt by
+// drflac_overview_init_serialized(). This is the same format as drwav_overview_serialize() in dr_wav.
+//
+// Returns the number of bytes written to <pBufferOut>, or 0 if <bufferSize> is too small. When <pBufferOut> is NULL the
+// required size is returned.
+size_t drflac_overview_serialize(const drflac_overview* pOverview, void* pBufferOut, size_t bufferSize);
+
 
 
 #ifndef DR_FLAC_NO_STDIO
@@ -826,6 +1058,12 @@ const char* drflac_next_vorbis_comment(drflac_vorbis_comment_iterator* pIter, dr
     #endif
 #endif
 
+// SSE2 is only used when the compiler is guaranteed to be targeting it. It's always available on x64.
+#if !defined(DR_FLAC_NO_SIMD) && (defined(DRFLAC_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define DRFLAC_SUPPORT_SSE2
+#include <emmintrin.h>
+#endif
+
 
 // Standard library stuff.
 #ifndef DRFLAC_ASSERT
@@ -886,6 +1124,9 @@ typedef drflac_int32 drflac_result;
 #define drflac_assert                                   DRFLAC_ASSERT
 #define drflac_copy_memory                              DRFLAC_COPY_MEMORY
 #define drflac_zero_memory                              DRFLAC_ZERO_MEMORY
+#define drflac_min(a, b)                                (((a) < (b)) ? (a) : (b))
+#define drflac_max(a, b)                                (((a) > (b)) ? (a) : (b))
+#define drflac_clamp(x, lo, hi)                         (drflac_max((lo), drflac_min((hi), (x))))
 
 
 // CPU caps.
@@ -907,6 +1148,67 @@ static void drflac__init_cpu_caps()
 #endif
 
 
+// The size of the buffer needed to hold the decoded samples of the largest frame in the stream. Each channel is padded to a
+// whole number of SIMD vectors.
+static drflac_uint32 drflac__get_decoded_samples_allocation_size(drflac_uint32 maxBlockSize, drflac_uint32 channels)
+{
+    drflac_uint32 wholeSIMDVectorCountPerChannel;
+    if ((maxBlockSize % (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32))) == 0) {
+        wholeSIMDVectorCountPerChannel = (maxBlockSize / (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32)));
+    } else {
+        wholeSIMDVectorCountPerChannel = (maxBlockSize / (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32))) + 1;
+    }
+
+    return wholeSIMDVectorCountPerChannel * DRFLAC_MAX_SIMD_VECTOR_SIZE * channels;
+}
+
+#ifdef DR_FLAC_LOW_MEMORY
+#if defined(_MSC_VER)
+#define DRFLAC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DRFLAC_THREAD_LOCAL __thread
+#else
+#define DRFLAC_THREAD_LOCAL     // <-- No thread-local storage. Decoders must all be used from the same thread.
+#endif
+
+// The buffer subframes are decoded into in low memory mode. This is shared between every decoder on the thread because the
+// decoded subframes are converted to their final 16-bit form straight after the frame has been decoded. It grows to fit
+// the largest frame of any decoder and is freed when the last decoder on the thread is closed.
+static DRFLAC_THREAD_LOCAL void* drflac__g_pScratch = NULL;
+static DRFLAC_THREAD_LOCAL size_t drflac__g_scratchSize = 0;
+static DRFLAC_THREAD_LOCAL drflac_uint32 drflac__g_scratchRefCount = 0;
+
+static drflac_int32* drflac__get_scratch(size_t sizeInBytes)
+{
+    if (drflac__g_scratchSize < sizeInBytes) {
+        // The contents never need to be preserved so there's no need to realloc().
+        DRFLAC_FREE(drflac__g_pScratch);
+        drflac__g_pScratch = DRFLAC_MALLOC(sizeInBytes + DRFLAC_MAX_SIMD_VECTOR_SIZE);
+        if (drflac__g_pScratch == NULL) {
+            drflac__g_scratchSize = 0;
+            return NULL;
+        }
+
+        drflac__g_scratchSize = sizeInBytes;
+    }
+
+    return (drflac_int32*)drflac_align((size_t)drflac__g_pScratch, DRFLAC_MAX_SIMD_VECTOR_SIZE);
+}
+
+static void drflac__release_scratch()
+{
+    drflac_assert(drflac__g_scratchRefCount > 0);
+
+    drflac__g_scratchRefCount -= 1;
+    if (drflac__g_scratchRefCount == 0) {
+        DRFLAC_FREE(drflac__g_pScratch);
+        drflac__g_pScratch = NULL;
+        drflac__g_scratchSize = 0;
+    }
+}
+#endif
+
+
 //// Endian Management ////
 static DRFLAC_INLINE drflac_bool32 drflac__is_little_endian()
 {
@@ -1030,6 +1332,236 @@ static DRFLAC_INLINE drflac_uint32 drflac__le2host_32(drflac_uint32 n)
 
 
 
+// MD5, as described in RFC 1321. This is used for verifying the decoded audio against the signature in the STREAMINFO block.
+#define DRFLAC_MD5_F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define DRFLAC_MD5_G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define DRFLAC_MD5_H(x, y, z) ((x) ^ (y) ^ (z))
+#define DRFLAC_MD5_I(x, y, z) ((y) ^ ((x) | ~(z)))
+#define DRFLAC_MD5_STEP(f, a, b, c, d, x, t, s) \
+    (a) += f((b), (c), (d)) + (x) + (drflac_uint32)(t); \
+    (a)  = ((a) << (s)) | ((a) >> (32 - (s))); \
+    (a) += (b)
+
+static void drflac__md5_init(drflac__md5* pMD5)
+{
+    pMD5->state[0] = 0x67452301;
+    pMD5->state[1] = 0xEFCDAB89;
+    pMD5->state[2] = 0x98BADCFE;
+    pMD5->state[3] = 0x10325476;
+    pMD5->byteCount = 0;
+}
+
+static void drflac__md5_transform(drflac_uint32 state[4], const drflac_uint8* pBlock)
+{
+    drflac_uint32 x[16];
+    drflac_copy_memory(x, pBlock, sizeof(x));
+    for (int i = 0; i < 16; ++i) {
+        x[i] = drflac__le2host_32(x[i]);
+    }
+
+    drflac_uint32 a = state[0];
+    drflac_uint32 b = state[1];
+    drflac_uint32 c = state[2];
+    drflac_uint32 d = state[3];
+
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, a, b, c, d, x[ 0], 0xD76AA478,  7);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, d, a, b, c, x[ 1], 0xE8C7B756, 12);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, c, d, a, b, x[ 2], 0x242070DB, 17);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, b, c, d, a, x[ 3], 0xC1BDCEEE, 22);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, a, b, c, d, x[ 4], 0xF57C0FAF,  7);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, d, a, b, c, x[ 5], 0x4787C62A, 12);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, c, d, a, b, x[ 6], 0xA8304613, 17);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, b, c, d, a, x[ 7], 0xFD469501, 22);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, a, b, c, d, x[ 8], 0x698098D8,  7);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, d, a, b, c, x[ 9], 0x8B44F7AF, 12);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, c, d, a, b, x[10], 0xFFFF5BB1, 17);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, b, c, d, a, x[11], 0x895CD7BE, 22);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, a, b, c, d, x[12], 0x6B901122,  7);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, d, a, b, c, x[13], 0xFD987193, 12);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, c, d, a, b, x[14], 0xA679438E, 17);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_F, b, c, d, a, x[15], 0x49B40821, 22);
+
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, a, b, c, d, x[ 1], 0xF61E2562,  5);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, d, a, b, c, x[ 6], 0xC040B340,  9);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, c, d, a, b, x[11], 0x265E5A51, 14);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, b, c, d, a, x[ 0], 0xE9B6C7AA, 20);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, a, b, c, d, x[ 5], 0xD62F105D,  5);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, d, a, b, c, x[10], 0x02441453,  9);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, c, d, a, b, x[15], 0xD8A1E681, 14);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, b, c, d, a, x[ 4], 0xE7D3FBC8, 20);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, a, b, c, d, x[ 9], 0x21E1CDE6,  5);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, d, a, b, c, x[14], 0xC33707D6,  9);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, c, d, a, b, x[ 3], 0xF4D50D87, 14);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, b, c, d, a, x[ 8], 0x455A14ED, 20);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, a, b, c, d, x[13], 0xA9E3E905,  5);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, d, a, b, c, x[ 2], 0xFCEFA3F8,  9);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, c, d, a, b, x[ 7], 0x676F02D9, 14);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_G, b, c, d, a, x[12], 0x8D2A4C8A, 20);
+
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, a, b, c, d, x[ 5], 0xFFFA3942,  4);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, d, a, b, c, x[ 8], 0x8771F681, 11);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, c, d, a, b, x[11], 0x6D9D6122, 16);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, b, c, d, a, x[14], 0xFDE5380C, 23);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, a, b, c, d, x[ 1], 0xA4BEEA44,  4);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, d, a, b, c, x[ 4], 0x4BDECFA9, 11);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, c, d, a, b, x[ 7], 0xF6BB4B60, 16);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, b, c, d, a, x[10], 0xBEBFBC70, 23);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, a, b, c, d, x[13], 0x289B7EC6,  4);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, d, a, b, c, x[ 0], 0xEAA127FA, 11);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, c, d, a, b, x[ 3], 0xD4EF3085, 16);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, b, c, d, a, x[ 6], 0x04881D05, 23);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, a, b, c, d, x[ 9], 0xD9D4D039,  4);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, d, a, b, c, x[12], 0xE6DB99E5, 11);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, c, d, a, b, x[15], 0x1FA27CF8, 16);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_H, b, c, d, a, x[ 2], 0xC4AC5665, 23);
+
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, a, b, c, d, x[ 0], 0xF4292244,  6);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, d, a, b, c, x[ 7], 0x432AFF97, 10);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, c, d, a, b, x[14], 0xAB9423A7, 15);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, b, c, d, a, x[ 5], 0xFC93A039, 21);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, a, b, c, d, x[12], 0x655B59C3,  6);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, d, a, b, c, x[ 3], 0x8F0CCC92, 10);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, c, d, a, b, x[10], 0xFFEFF47D, 15);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, b, c, d, a, x[ 1], 0x85845DD1, 21);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, a, b, c, d, x[ 8], 0x6FA87E4F,  6);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, d, a, b, c, x[15], 0xFE2CE6E0, 10);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, c, d, a, b, x[ 6], 0xA3014314, 15);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, b, c, d, a, x[13], 0x4E0811A1, 21);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, a, b, c, d, x[ 4], 0xF7537E82,  6);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, d, a, b, c, x[11], 0xBD3AF235, 10);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, c, d, a, b, x[ 2], 0x2AD7D2BB, 15);
+    DRFLAC_MD5_STEP(DRFLAC_MD5_I, b, c, d, a, x[ 9], 0xEB86D391, 21);
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+static void drflac__md5_update(drflac__md5* pMD5, const drflac_uint8* pData, size_t dataSize)
+{
+    size_t bufferedBytes = (size_t)(pMD5->byteCount & 63);
+    pMD5->byteCount += dataSize;
+
+    // Top up any partially filled block first.
+    if (bufferedBytes > 0) {
+        size_t bytesToCopy = 64 - bufferedBytes;
+        if (bytesToCopy > dataSize) {
+            bytesToCopy = dataSize;
+        }
+
+        drflac_copy_memory(pMD5->buffer + bufferedBytes, pData, bytesToCopy);
+        pData    += bytesToCopy;
+        dataSize -= bytesToCopy;
+
+        if (bufferedBytes + bytesToCopy < 64) {
+            return;
+        }
+
+        drflac__md5_transform(pMD5->state, pMD5->buffer);
+    }
+
+    // Whole blocks are hashed straight from the input.
+    while (dataSize >= 64) {
+        drflac__md5_transform(pMD5->state, pData);
+        pData    += 64;
+        dataSize -= 64;
+    }
+
+    if (dataSize > 0) {
+        drflac_copy_memory(pMD5->buffer, pData, dataSize);
+    }
+}
+
+static void drflac__md5_final(drflac__md5* pMD5, drflac_uint8 digest[16])
+{
+    drflac_uint64 bitCount = pMD5->byteCount * 8;
+
+    drflac_uint8 padding[72];
+    drflac_zero_memory(padding, sizeof(padding));
+    padding[0] = 0x80;
+
+    // Pad to 56 bytes mod 64, then append the length in bits as a little-endian 64-bit integer.
+    size_t paddingSize = 64 - (size_t)((pMD5->byteCount + 8) & 63);
+    if (paddingSize == 0) {
+        paddingSize = 64;
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        padding[paddingSize + i] = (drflac_uint8)(bitCount >> (i*8));
+    }
+
+    drflac__md5_update(pMD5, padding, paddingSize + 8);
+
+    for (int i = 0; i < 4; ++i) {
+        digest[i*4+0] = (drflac_uint8)(pMD5->state[i] >>  0);
+        digest[i*4+1] = (drflac_uint8)(pMD5->state[i] >>  8);
+        digest[i*4+2] = (drflac_uint8)(pMD5->state[i] >> 16);
+        digest[i*4+3] = (drflac_uint8)(pMD5->state[i] >> 24);
+    }
+}
+
+// Hashes samples in the format returned by drflac_read_s32(). FLAC defines the signature as being that of the samples as
+// signed, little-endian integers at the stream's bits per sample, rounded up to whole bytes.
+static void drflac__md5_update_samples(drflac__md5* pMD5, drflac_uint32 bitsPerSample, const drflac_int32* pSamples, drflac_uint64 sampleCount)
+{
+    drflac_uint32 shift = 32 - bitsPerSample;
+    drflac_uint32 bytesPerSample = (bitsPerSample + 7) / 8;
+
+    drflac_uint8 bytes[4096];
+    size_t samplesPerChunk = sizeof(bytes) / bytesPerSample;
+
+    while (sampleCount > 0) {
+        size_t samplesInChunk = (sampleCount > samplesPerChunk) ? samplesPerChunk : (size_t)sampleCount;
+        drflac_uint8* pBytes = bytes;
+
+        switch (bytesPerSample)
+        {
+            case 1:
+            {
+                for (size_t i = 0; i < samplesInChunk; ++i) {
+                    pBytes[i] = (drflac_uint8)(pSamples[i] >> shift);
+                }
+            } break;
+
+            case 2:
+            {
+                for (size_t i = 0; i < samplesInChunk; ++i) {
+                    drflac_uint32 sample = (drflac_uint32)(pSamples[i] >> shift);
+                    pBytes[i*2+0] = (drflac_uint8)(sample >> 0);
+                    pBytes[i*2+1] = (drflac_uint8)(sample >> 8);
+                }
+            } break;
+
+            case 3:
+            {
+                for (size_t i = 0; i < samplesInChunk; ++i) {
+                    drflac_uint32 sample = (drflac_uint32)(pSamples[i] >> shift);
+                    pBytes[i*3+0] = (drflac_uint8)(sample >>  0);
+                    pBytes[i*3+1] = (drflac_uint8)(sample >>  8);
+                    pBytes[i*3+2] = (drflac_uint8)(sample >> 16);
+                }
+            } break;
+
+            default:
+            {
+                for (size_t i = 0; i < samplesInChunk; ++i) {
+                    drflac_uint32 sample = (drflac_uint32)(pSamples[i] >> shift);
+                    pBytes[i*4+0] = (drflac_uint8)(sample >>  0);
+                    pBytes[i*4+1] = (drflac_uint8)(sample >>  8);
+                    pBytes[i*4+2] = (drflac_uint8)(sample >> 16);
+                    pBytes[i*4+3] = (drflac_uint8)(sample >> 24);
+                }
+            } break;
+        }
+
+        drflac__md5_update(pMD5, bytes, samplesInChunk * bytesPerSample);
+        pSamples    += samplesInChunk;
+        sampleCount -= samplesInChunk;
+    }
+}
+
+
 // The CRC code below is based on this document: http://zlib.net/crc_v3.txt
 static drflac_uint8 drflac__crc8_table[] = {
     0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D,
@@ -1802,39 +2334,44 @@ static inline drflac_bool32 drflac__seek_past_next_set_bit(drflac_bs* bs, unsign
 
 
 
-static drflac_bool32 drflac__seek_to_byte(drflac_bs* bs, drflac_uint64 offsetFromStart)
+// Moves the client's read position with whichever seek callback it gave us. The 32-bit callback can only move up to 2GB at a time
+// so larger offsets are broken up into a series of relative seeks.
+static drflac_bool32 drflac__seek_client(drflac_seek_proc onSeek, drflac_seek64_proc onSeek64, void* pUserData, drflac_uint64 offset, drflac_seek_origin origin)
 {
-    drflac_assert(bs != NULL);
-    drflac_assert(offsetFromStart > 0);
+    if (offset > (drflac_uint64)0x7FFFFFFFFFFFFFFF) {
+        return DRFLAC_FALSE;
+    }
 
-    // Seeking from the start is not quite as trivial as it sounds because the onSeek callback takes a signed 32-bit integer (which
-    // is intentional because it simplifies the implementation of the onSeek callbacks), however offsetFromStart is unsigned 64-bit.
-    // To resolve we just need to do an initial seek from the start, and then a series of offset seeks to make up the remainder.
-    if (offsetFromStart > 0x7FFFFFFF) {
-        drflac_uint64 bytesRemaining = offsetFromStart;
-        if (!bs->onSeek(bs->pUserData, 0x7FFFFFFF, drflac_seek_origin_start)) {
-            return DRFLAC_FALSE;
-        }
-        bytesRemaining -= 0x7FFFFFFF;
+    if (onSeek64 != NULL) {
+        return onSeek64(pUserData, (drflac_int64)offset, origin);
+    }
 
-        while (bytesRemaining > 0x7FFFFFFF) {
-            if (!bs->onSeek(bs->pUserData, 0x7FFFFFFF, drflac_seek_origin_current)) {
-                return DRFLAC_FALSE;
-            }
-            bytesRemaining -= 0x7FFFFFFF;
+    while (offset > 0x7FFFFFFF) {
+        if (!onSeek(pUserData, 0x7FFFFFFF, origin)) {
+            return DRFLAC_FALSE;
         }
+        offset -= 0x7FFFFFFF;
+        origin  = drflac_seek_origin_current;
+    }
 
-        if (bytesRemaining > 0) {
-            if (!bs->onSeek(bs->pUserData, (int)bytesRemaining, drflac_seek_origin_current)) {
-                return DRFLAC_FALSE;
-            }
-        }
-    } else {
-        if (!bs->onSeek(bs->pUserData, (int)offsetFromStart, drflac_seek_origin_start)) {
+    if (offset > 0 || origin == drflac_seek_origin_start) {
+        if (!onSeek(pUserData, (int)offset, origin)) {    // <-- Safe cast thanks to the loop above.
             return DRFLAC_FALSE;
         }
     }
 
+    return DRFLAC_TRUE;
+}
+
+static drflac_bool32 drflac__seek_to_byte(drflac_bs* bs, drflac_uint64 offsetFromStart)
+{
+    drflac_assert(bs != NULL);
+    drflac_assert(offsetFromStart > 0);
+
+    if (!drflac__seek_client(bs->onSeek, bs->onSeek64, bs->pUserData, offsetFromStart, drflac_seek_origin_start)) {
+        return DRFLAC_FALSE;
+    }
+
     // The cache should be reset to force a reload of fresh data from the client.
     drflac__reset_cache(bs);
     return DRFLAC_TRUE;
@@ -2278,37 +2815,58 @@ static DRFLAC_INLINE drflac_bool32 drflac__read_rice_parts(drflac_bs* bs, drflac
 }
 
 
+static DRFLAC_INLINE drflac_bool32 drflac__read_rice_residual(drflac_bs* bs, drflac_uint8 riceParam, drflac_uint32* pResidualOut)
+{
+    drflac_uint32 zeroCountPart;
+    drflac_uint32 riceParamPart;
+
+    // Rice extraction.
+    if (!drflac__read_rice_parts(bs, riceParam, &zeroCountPart, &riceParamPart)) {
+        return DRFLAC_FALSE;
+    }
+
+    // Rice reconstruction.
+    static drflac_uint32 t[2] = {0x00000000, 0xFFFFFFFF};
+
+    riceParamPart |= (zeroCountPart << riceParam);
+    riceParamPart  = (riceParamPart >> 1) ^ t[riceParamPart & 0x01];
+    //riceParamPart  = (riceParamPart >> 1) ^ (~(riceParamPart & 0x01) + 1);
+
+    *pResidualOut = riceParamPart;
+    return DRFLAC_TRUE;
+}
+
 static drflac_bool32 drflac__decode_samples_with_residual__rice__simple(drflac_bs* bs, drflac_uint32 bitsPerSample, drflac_uint32 count, drflac_uint8 riceParam, drflac_uint32 order, drflac_int32 shift, const drflac_int32* coefficients, drflac_int32* pSamplesOut)
 {
     drflac_assert(bs != NULL);
     drflac_assert(count > 0);
     drflac_assert(pSamplesOut != NULL);
 
-    drflac_uint32 zeroCountPart;
-    drflac_uint32 riceParamPart;
+    drflac_uint32 residual;
 
-    drflac_uint32 i = 0;
-    while (i < count) {
-        // Rice extraction.
-        if (!drflac__read_rice_parts(bs, riceParam, &zeroCountPart, &riceParamPart)) {
-            return DRFLAC_FALSE;
+    // The choice of prediction is the same for every sample so it's done once up front rather than in the inner loop.
+    if (coefficients == NULL) {
+        // Residual only. The caller restores the prediction.
+        for (drflac_uint32 i = 0; i < count; ++i) {
+            if (!drflac__read_rice_residual(bs, riceParam, &residual)) {
+                return DRFLAC_FALSE;
+            }
+            pSamplesOut[i] = residual;
         }
-
-        // Rice reconstruction.
-        static drflac_uint32 t[2] = {0x00000000, 0xFFFFFFFF};
-
-        riceParamPart |= (zeroCountPart << riceParam);
-        riceParamPart  = (riceParamPart >> 1) ^ t[riceParamPart & 0x01];
-        //riceParamPart  = (riceParamPart >> 1) ^ (~(riceParamPart & 0x01) + 1);
-
-        // Sample reconstruction.
-        if (bitsPerSample > 16) {
-            pSamplesOut[i] = riceParamPart + drflac__calculate_prediction_64(order, shift, coefficients, pSamplesOut + i);
-        } else {
-            pSamplesOut[i] = riceParamPart + drflac__calculate_prediction_32(order, shift, coefficients, pSamplesOut + i);
+    } else if (bitsPerSample > 16) {
+        for (drflac_uint32 i = 0; i < count; ++i) {
+            if (!drflac__read_rice_residual(bs, riceParam, &residual)) {
+                return DRFLAC_FALSE;
+            }
+            pSamplesOut[i] = residual + drflac__calculate_prediction_64(order, shift, coefficients, pSamplesOut + i);
+        }
+    } else {
+        for (drflac_uint32 i = 0; i < count; ++i) {
+            if (!drflac__read_rice_residual(bs, riceParam, &residual)) {
+                return DRFLAC_FALSE;
+            }
+            pSamplesOut[i] = residual + drflac__calculate_prediction_32(order, shift, coefficients, pSamplesOut + i);
         }
-
-        i += 1;
     }
 
     return DRFLAC_TRUE;
@@ -2352,6 +2910,10 @@ static drflac_bool32 drflac__decode_samples_with_residual__unencoded(drflac_bs*
             return DRFLAC_FALSE;
         }
 
+        if (coefficients == NULL) {
+            continue;   // Residual only. The caller restores the prediction.
+        }
+
         if (bitsPerSample > 16) {
             pSamplesOut[i] += drflac__calculate_prediction_64(order, shift, coefficients, pSamplesOut + i);
         } else {
@@ -2366,6 +2928,9 @@ static drflac_bool32 drflac__decode_samples_with_residual__unencoded(drflac_bs*
 // Reads and decodes the residual for the sub-frame the decoder is currently sitting on. This function should be called
 // when the decoder is sitting at the very start of the RESIDUAL block. The first <order> residuals will be ignored. The
 // <blockSize> and <order> parameters are used to determine how many residual values need to be decoded.
+//
+// When <coefficients> is NULL the raw residual values are written to the output without any prediction being applied. This
+// is used by FIXED subframes which restore the signal in a separate pass.
 static drflac_bool32 drflac__decode_samples_with_residual(drflac_bs* bs, drflac_uint32 bitsPerSample, drflac_uint32 blockSize, drflac_uint32 order, drflac_int32 shift, const drflac_int32* coefficients, drflac_int32* pDecodedSamples)
 {
     drflac_assert(bs != NULL);
@@ -2542,40 +3107,180 @@ static drflac_bool32 drflac__decode_samples__verbatim(drflac_bs* bs, drflac_uint
     return DRFLAC_TRUE;
 }
 
-static drflac_bool32 drflac__decode_samples__fixed(drflac_bs* bs, drflac_uint32 blockSize, drflac_uint32 bitsPerSample, drflac_uint8 lpcOrder, drflac_int32* pDecodedSamples)
+// The fixed predictors are nothing more than the Nth order difference of the signal. This means the signal can be restored
+// from the residual by running N cascaded prefix sums (order 1 is a running sum, order 2 is a running sum of a running sum,
+// etc.), each one seeded with the difference of the matching order at the last warm up sample. Everything is done with
+// unsigned 32-bit arithmetic which wraps in exactly the same way as the truncation done by the generic LPC path.
+//
+// <pSamples> should point to the first warm up sample, with the residuals sitting immediately after them.
+static DRFLAC_INLINE void drflac__calculate_fixed_prediction_seeds(drflac_uint32 order, const drflac_int32* pSamples, drflac_uint32* pSeeds)
 {
-    drflac_int32 lpcCoefficientsTable[5][4] = {
-        {0,  0, 0,  0},
-        {1,  0, 0,  0},
-        {2, -1, 0,  0},
-        {3, -3, 1,  0},
-        {4, -6, 4, -1}
-    };
+    drflac_uint32 diffs[4];
+    for (drflac_uint32 i = 0; i < order; ++i) {
+        diffs[i] = (drflac_uint32)pSamples[i];
+    }
 
-    // Warm up samples and coefficients.
-    for (drflac_uint32 i = 0; i < lpcOrder; ++i) {
-        drflac_int32 sample;
-        if (!drflac__read_int32(bs, bitsPerSample, &sample)) {
-            return DRFLAC_FALSE;
+    // pSeeds[0] is the last warm up sample, pSeeds[1] is it's first order difference, etc.
+    for (drflac_uint32 j = 0; j < order; ++j) {
+        pSeeds[j] = diffs[order-1];
+        for (drflac_uint32 i = order-1; i > j; --i) {
+            diffs[i] -= diffs[i-1];
         }
-
-        pDecodedSamples[i] = sample;
     }
+}
+
+static void drflac__restore_fixed_prediction__scalar(drflac_uint32 order, drflac_uint32 count, drflac_uint32* pSeeds, drflac_int32* pResiduals)
+{
+    switch (order)
+    {
+        case 1:
+        {
+            drflac_uint32 s0 = pSeeds[0];
+            for (drflac_uint32 i = 0; i < count; ++i) {
+                s0 += (drflac_uint32)pResiduals[i];
+                pResiduals[i] = (drflac_int32)s0;
+            }
+            pSeeds[0] = s0;
+        } break;
 
+        case 2:
+        {
+            drflac_uint32 s0 = pSeeds[0];
+            drflac_uint32 s1 = pSeeds[1];
+            for (drflac_uint32 i = 0; i < count; ++i) {
+                s1 += (drflac_uint32)pResiduals[i];
+                s0 += s1;
+                pResiduals[i] = (drflac_int32)s0;
+            }
+            pSeeds[0] = s0;
+            pSeeds[1] = s1;
+        } break;
 
-    if (!drflac__decode_samples_with_residual(bs, bitsPerSample, blockSize, lpcOrder, 0, lpcCoefficientsTable[lpcOrder], pDecodedSamples)) {
-        return DRFLAC_FALSE;
+        case 3:
+        {
+            drflac_uint32 s0 = pSeeds[0];
+            drflac_uint32 s1 = pSeeds[1];
+            drflac_uint32 s2 = pSeeds[2];
+            for (drflac_uint32 i = 0; i < count; ++i) {
+                s2 += (drflac_uint32)pResiduals[i];
+                s1 += s2;
+                s0 += s1;
+                pResiduals[i] = (drflac_int32)s0;
+            }
+            pSeeds[0] = s0;
+            pSeeds[1] = s1;
+            pSeeds[2] = s2;
+        } break;
+
+        case 4:
+        {
+            drflac_uint32 s0 = pSeeds[0];
+            drflac_uint32 s1 = pSeeds[1];
+            drflac_uint32 s2 = pSeeds[2];
+            drflac_uint32 s3 = pSeeds[3];
+            for (drflac_uint32 i = 0; i < count; ++i) {
+                s3 += (drflac_uint32)pResiduals[i];
+                s2 += s3;
+                s1 += s2;
+                s0 += s1;
+                pResiduals[i] = (drflac_int32)s0;
+            }
+            pSeeds[0] = s0;
+            pSeeds[1] = s1;
+            pSeeds[2] = s2;
+            pSeeds[3] = s3;
+        } break;
+
+        default: break; // Order 0 means the residual is the signal.
     }
+}
 
-    return DRFLAC_TRUE;
+#ifdef DRFLAC_SUPPORT_SSE2
+// Inclusive prefix sum of the 4 lanes of <x>, plus <carry> which should have the same value in each lane.
+static DRFLAC_INLINE __m128i drflac__prefix_sum_epi32__sse2(__m128i x, __m128i carry)
+{
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    return _mm_add_epi32(x, carry);
 }
 
-static drflac_bool32 drflac__decode_samples__lpc(drflac_bs* bs, drflac_uint32 blockSize, drflac_uint32 bitsPerSample, drflac_uint8 lpcOrder, drflac_int32* pDecodedSamples)
+static void drflac__restore_fixed_prediction__sse2(drflac_uint32 order, drflac_uint32 count, drflac_uint32* pSeeds, drflac_int32* pResiduals)
 {
-    drflac_uint8 i;
+    // Each prefix sum in the cascade is done on the same 4 samples before moving on so that the data is only streamed through
+    // once. The carry for each order is the last lane of its output, broadcast to every lane.
+    __m128i carries[4];
+    for (drflac_uint32 j = 0; j < order; ++j) {
+        carries[j] = _mm_set1_epi32((int)pSeeds[j]);
+    }
 
-    // Warm up samples.
-    for (i = 0; i < lpcOrder; ++i) {
+    drflac_uint32 count4 = count >> 2;
+    for (drflac_uint32 i = 0; i < count4; ++i) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(pResiduals + i*4));
+        for (drflac_uint32 j = order; j > 0; --j) {
+            x = drflac__prefix_sum_epi32__sse2(x, carries[j-1]);
+            carries[j-1] = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+        _mm_storeu_si128((__m128i*)(pResiduals + i*4), x);
+    }
+
+    for (drflac_uint32 j = 0; j < order; ++j) {
+        pSeeds[j] = (drflac_uint32)_mm_cvtsi128_si32(carries[j]);
+    }
+
+    // Leftovers.
+    drflac__restore_fixed_prediction__scalar(order, count & 3, pSeeds, pResiduals + count4*4);
+}
+#endif
+
+static void drflac__restore_fixed_prediction(drflac_uint32 order, drflac_uint32 blockSize, drflac_int32* pDecodedSamples)
+{
+    drflac_assert(order <= 4);
+    drflac_assert(blockSize >= order);
+
+    if (order == 0 || blockSize == order) {
+        return;
+    }
+
+    drflac_uint32 seeds[4];
+    drflac__calculate_fixed_prediction_seeds(order, pDecodedSamples, seeds);
+
+#ifdef DRFLAC_SUPPORT_SSE2
+    drflac__restore_fixed_prediction__sse2(order, blockSize - order, seeds, pDecodedSamples + order);
+#else
+    drflac__restore_fixed_prediction__scalar(order, blockSize - order, seeds, pDecodedSamples + order);
+#endif
+}
+
+static drflac_bool32 drflac__decode_samples__fixed(drflac_bs* bs, drflac_uint32 blockSize, drflac_uint32 bitsPerSample, drflac_uint8 lpcOrder, drflac_int32* pDecodedSamples)
+{
+    drflac_assert(lpcOrder <= 4);   // <-- Orders above 4 are reserved and rejected by drflac__read_subframe_header().
+
+    // Warm up samples.
+    for (drflac_uint32 i = 0; i < lpcOrder; ++i) {
+        drflac_int32 sample;
+        if (!drflac__read_int32(bs, bitsPerSample, &sample)) {
+            return DRFLAC_FALSE;
+        }
+
+        pDecodedSamples[i] = sample;
+    }
+
+
+    // The residuals are decoded in bulk, without prediction, and then restored with a dedicated kernel for the given order.
+    if (!drflac__decode_samples_with_residual(bs, bitsPerSample, blockSize, lpcOrder, 0, NULL, pDecodedSamples)) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac__restore_fixed_prediction(lpcOrder, blockSize, pDecodedSamples);
+    return DRFLAC_TRUE;
+}
+
+static drflac_bool32 drflac__decode_samples__lpc(drflac_bs* bs, drflac_uint32 blockSize, drflac_uint32 bitsPerSample, drflac_uint8 lpcOrder, drflac_int32* pDecodedSamples)
+{
+    drflac_uint8 i;
+
+    // Warm up samples.
+    for (i = 0; i < lpcOrder; ++i) {
         drflac_int32 sample;
         if (!drflac__read_int32(bs, bitsPerSample, &sample)) {
             return DRFLAC_FALSE;
@@ -2965,7 +3670,8 @@ static DRFLAC_INLINE drflac_uint8 drflac__get_channel_count_from_channel_assignm
     return lookup[channelAssignment];
 }
 
-static drflac_result drflac__decode_frame(drflac* pFlac)
+// Decodes the subframes of the current frame into pDecodedSamples and checks the frame's CRC.
+static drflac_result drflac__decode_frame__impl(drflac* pFlac)
 {
     // This function should be called while the stream is sitting on the first byte after the frame header.
     drflac_zero_memory(pFlac->currentFrame.subframes, sizeof(pFlac->currentFrame.subframes));
@@ -3004,6 +3710,111 @@ static drflac_result drflac__decode_frame(drflac* pFlac)
     return DRFLAC_SUCCESS;
 }
 
+#ifdef DR_FLAC_LOW_MEMORY
+// Converts the decoded subframes of the current frame to interleaved 16-bit samples. This is done using the same channel
+// decorrelation and shifting as drflac_read_s32(), with the difference being that only the upper 16 bits are kept. The lower 16
+// bits are always zero for streams with 16 bits per sample or less so this is lossless.
+static void drflac__store_decoded_frame_s16(drflac* pFlac)
+{
+    drflac_uint32 channelCount = drflac__get_channel_count_from_channel_assignment(pFlac->currentFrame.header.channelAssignment);
+    drflac_uint32 blockSize = pFlac->currentFrame.header.blockSize;
+    unsigned int unusedBitsPerSample = 32 - pFlac->bitsPerSample;
+    drflac_int16* pOut = pFlac->pDecodedSamples16;
+
+    drflac_assert(pFlac->bitsPerSample <= 16);
+
+    switch (pFlac->currentFrame.header.channelAssignment)
+    {
+        case DRFLAC_CHANNEL_ASSIGNMENT_LEFT_SIDE:
+        {
+            const drflac_int32* pDecodedSamples0 = pFlac->currentFrame.subframes[0].pDecodedSamples;
+            const drflac_int32* pDecodedSamples1 = pFlac->currentFrame.subframes[1].pDecodedSamples;
+            unsigned int shift0 = unusedBitsPerSample + pFlac->currentFrame.subframes[0].wastedBitsPerSample;
+            unsigned int shift1 = unusedBitsPerSample + pFlac->currentFrame.subframes[1].wastedBitsPerSample;
+
+            for (drflac_uint32 i = 0; i < blockSize; ++i) {
+                int left  = pDecodedSamples0[i];
+                int side  = pDecodedSamples1[i];
+                int right = left - side;
+
+                pOut[i*2+0] = (drflac_int16)((left  << shift0) >> 16);
+                pOut[i*2+1] = (drflac_int16)((right << shift1) >> 16);
+            }
+        } break;
+
+        case DRFLAC_CHANNEL_ASSIGNMENT_RIGHT_SIDE:
+        {
+            const drflac_int32* pDecodedSamples0 = pFlac->currentFrame.subframes[0].pDecodedSamples;
+            const drflac_int32* pDecodedSamples1 = pFlac->currentFrame.subframes[1].pDecodedSamples;
+            unsigned int shift0 = unusedBitsPerSample + pFlac->currentFrame.subframes[0].wastedBitsPerSample;
+            unsigned int shift1 = unusedBitsPerSample + pFlac->currentFrame.subframes[1].wastedBitsPerSample;
+
+            for (drflac_uint32 i = 0; i < blockSize; ++i) {
+                int side  = pDecodedSamples0[i];
+                int right = pDecodedSamples1[i];
+                int left  = right + side;
+
+                pOut[i*2+0] = (drflac_int16)((left  << shift0) >> 16);
+                pOut[i*2+1] = (drflac_int16)((right << shift1) >> 16);
+            }
+        } break;
+
+        case DRFLAC_CHANNEL_ASSIGNMENT_MID_SIDE:
+        {
+            const drflac_int32* pDecodedSamples0 = pFlac->currentFrame.subframes[0].pDecodedSamples;
+            const drflac_int32* pDecodedSamples1 = pFlac->currentFrame.subframes[1].pDecodedSamples;
+            unsigned int shift0 = unusedBitsPerSample + pFlac->currentFrame.subframes[0].wastedBitsPerSample;
+            unsigned int shift1 = unusedBitsPerSample + pFlac->currentFrame.subframes[1].wastedBitsPerSample;
+
+            for (drflac_uint32 i = 0; i < blockSize; ++i) {
+                int side = pDecodedSamples1[i];
+                int mid  = (((drflac_uint32)pDecodedSamples0[i]) << 1) | (side & 0x01);
+
+                pOut[i*2+0] = (drflac_int16)((((mid + side) >> 1) << shift0) >> 16);
+                pOut[i*2+1] = (drflac_int16)((((mid - side) >> 1) << shift1) >> 16);
+            }
+        } break;
+
+        case DRFLAC_CHANNEL_ASSIGNMENT_INDEPENDENT:
+        default:
+        {
+            for (drflac_uint32 j = 0; j < channelCount; ++j) {
+                const drflac_int32* pDecodedSamples = pFlac->currentFrame.subframes[j].pDecodedSamples;
+                unsigned int shift = unusedBitsPerSample + pFlac->currentFrame.subframes[j].wastedBitsPerSample;
+
+                for (drflac_uint32 i = 0; i < blockSize; ++i) {
+                    pOut[(i*channelCount)+j] = (drflac_int16)((pDecodedSamples[i] << shift) >> 16);
+                }
+            }
+        } break;
+    }
+}
+#endif
+
+static DRFLAC_INLINE drflac_result drflac__decode_frame(drflac* pFlac)
+{
+#ifdef DR_FLAC_LOW_MEMORY
+    if (pFlac->pDecodedSamples16 != NULL) {
+        // The subframes are decoded into the buffer that's shared with the other decoders on this thread, and then immediately
+        // converted to their final form so that the shared buffer is free to be used by the next decoder.
+        pFlac->pDecodedSamples = drflac__get_scratch(drflac__get_decoded_samples_allocation_size(pFlac->maxBlockSize, pFlac->channels));
+        if (pFlac->pDecodedSamples == NULL) {
+            return DRFLAC_ERROR;
+        }
+
+        drflac_result result = drflac__decode_frame__impl(pFlac);
+        if (result == DRFLAC_SUCCESS) {
+            drflac__store_decoded_frame_s16(pFlac);
+        }
+
+        pFlac->pDecodedSamples = NULL;
+        return result;
+    }
+#endif
+
+    return drflac__decode_frame__impl(pFlac);
+}
+
 static drflac_result drflac__seek_frame(drflac* pFlac)
 {
     int channelCount = drflac__get_channel_count_from_channel_assignment(pFlac->currentFrame.header.channelAssignment);
@@ -3267,6 +4078,7 @@ typedef struct
 {
     drflac_read_proc onRead;
     drflac_seek_proc onSeek;
+    drflac_seek64_proc onSeek64;
     drflac_meta_proc onMeta;
     drflac_container container;
     void* pUserData;
@@ -3279,6 +4091,7 @@ typedef struct
     drflac_uint64 runningFilePos;
     drflac_bool32 hasStreamInfoBlock;
     drflac_bool32 hasMetadataBlocks;
+    drflac_uint8  md5[16];
     drflac_bs bs;                           // <-- A bit streamer is required for loading data during initialization.
     drflac_frame_header firstFrameHeader;   // <-- The header of the first frame that was read during relaxed initalization. Only set if there is no STREAMINFO block.
 
@@ -3532,7 +4345,7 @@ drflac_bool32 drflac__read_and_decode_metadata(drflac* pFlac)
                     metadata.data.padding.unused = 0;
 
                     // Padding doesn't have anything meaningful in it, so just skip over it, but make sure the caller is aware of it by firing the callback.
-                    if (!pFlac->bs.onSeek(pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
+                    if (!drflac__seek_client(pFlac->bs.onSeek, pFlac->bs.onSeek64, pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
                         isLastBlock = DRFLAC_TRUE;  // An error occured while seeking. Attempt to recover by treating this as the last block which will in turn terminate the loop.
                     } else {
                         pFlac->onMeta(pFlac->pUserDataMD, &metadata);
@@ -3544,7 +4357,7 @@ drflac_bool32 drflac__read_and_decode_metadata(drflac* pFlac)
             {
                 // Invalid chunk. Just skip over this one.
                 if (pFlac->onMeta) {
-                    if (!pFlac->bs.onSeek(pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
+                    if (!drflac__seek_client(pFlac->bs.onSeek, pFlac->bs.onSeek64, pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
                         isLastBlock = DRFLAC_TRUE;  // An error occured while seeking. Attempt to recover by treating this as the last block which will in turn terminate the loop.
                     }
                 }
@@ -3576,7 +4389,7 @@ drflac_bool32 drflac__read_and_decode_metadata(drflac* pFlac)
 
         // If we're not handling metadata, just skip over the block. If we are, it will have been handled earlier in the switch statement above.
         if (pFlac->onMeta == NULL && blockSize > 0) {
-            if (!pFlac->bs.onSeek(pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
+            if (!drflac__seek_client(pFlac->bs.onSeek, pFlac->bs.onSeek64, pFlac->bs.pUserData, blockSize, drflac_seek_origin_current)) {
                 isLastBlock = DRFLAC_TRUE;
             }
         }
@@ -3647,6 +4460,7 @@ drflac_bool32 drflac__init_private__native(drflac_init_info* pInit, drflac_read_
         pInit->totalSampleCount   = streaminfo.totalSampleCount;
         pInit->maxBlockSize       = streaminfo.maxBlockSize;    // Don't care about the min block size - only the max (used for determining the size of the memory allocation).
         pInit->hasMetadataBlocks = !isLastBlock;
+        drflac_copy_memory(pInit->md5, streaminfo.md5, sizeof(pInit->md5));
 
         if (onMeta) {
             drflac_metadata metadata;
@@ -3887,6 +4701,7 @@ typedef struct
 {
     drflac_read_proc onRead;    // The original onRead callback from drflac_open() and family.
     drflac_seek_proc onSeek;    // The original onSeek callback from drflac_open() and family.
+    drflac_seek64_proc onSeek64;    // The original onSeek64 callback from drflac_open_seek64() and family. Takes priority over onSeek.
     void* pUserData;            // The user data passed on onRead and onSeek. This is the user data that was passed on drflac_open() and family.
     drflac_uint64 currentBytePos;   // The position of the byte we are sitting on in the physical byte stream. Used for efficient seeking.
     drflac_uint64 firstBytePos;     // The position of the first byte in the physical bitstream. Points to the start of the "OggS" identifier of the FLAC bos page.
@@ -3908,38 +4723,17 @@ static size_t drflac_oggbs__read_physical(drflac_oggbs* oggbs, void* bufferOut,
 
 static drflac_bool32 drflac_oggbs__seek_physical(drflac_oggbs* oggbs, drflac_uint64 offset, drflac_seek_origin origin)
 {
-    if (origin == drflac_seek_origin_start) {
-        if (offset <= 0x7FFFFFFF) {
-            if (!oggbs->onSeek(oggbs->pUserData, (int)offset, drflac_seek_origin_start)) {
-                return DRFLAC_FALSE;
-            }
-            oggbs->currentBytePos = offset;
-
-            return DRFLAC_TRUE;
-        } else {
-            if (!oggbs->onSeek(oggbs->pUserData, 0x7FFFFFFF, drflac_seek_origin_start)) {
-                return DRFLAC_FALSE;
-            }
-            oggbs->currentBytePos = offset;
+    if (!drflac__seek_client(oggbs->onSeek, oggbs->onSeek64, oggbs->pUserData, offset, origin)) {
+        return DRFLAC_FALSE;
+    }
 
-            return drflac_oggbs__seek_physical(oggbs, offset - 0x7FFFFFFF, drflac_seek_origin_current);
-        }
+    if (origin == drflac_seek_origin_start) {
+        oggbs->currentBytePos = offset;
     } else {
-        while (offset > 0x7FFFFFFF) {
-            if (!oggbs->onSeek(oggbs->pUserData, 0x7FFFFFFF, drflac_seek_origin_current)) {
-                return DRFLAC_FALSE;
-            }
-            oggbs->currentBytePos += 0x7FFFFFFF;
-            offset -= 0x7FFFFFFF;
-        }
-
-        if (!oggbs->onSeek(oggbs->pUserData, (int)offset, drflac_seek_origin_current)) {    // <-- Safe cast thanks to the loop above.
-            return DRFLAC_FALSE;
-        }
         oggbs->currentBytePos += offset;
-
-        return DRFLAC_TRUE;
     }
+
+    return DRFLAC_TRUE;
 }
 
 static drflac_bool32 drflac_oggbs__goto_next_page(drflac_oggbs* oggbs, drflac_ogg_crc_mismatch_recovery recoveryMethod)
@@ -4283,6 +5077,7 @@ drflac_bool32 drflac__init_private__ogg(drflac_init_info* pInit, drflac_read_pro
 {
     // Pre: The bit stream should be sitting just past the 4-byte OggS capture pattern.
     (void)relaxed;
+    (void)onSeek;   // <-- Seeking goes through pInit so the 64-bit callback is used if we have one.
 
     pInit->container = drflac_container_ogg;
     pInit->oggFirstBytePos = 0;
@@ -4339,7 +5134,7 @@ drflac_bool32 drflac__init_private__ogg(drflac_init_info* pInit, drflac_read_pro
 
                     // The next 2 bytes are the non-audio packets, not including this one. We don't care about this because we're going to
                     // be handling it in a generic way based on the serial number and packet types.
-                    if (!onSeek(pUserData, 2, drflac_seek_origin_current)) {
+                    if (!drflac__seek_client(pInit->onSeek, pInit->onSeek64, pUserData, 2, drflac_seek_origin_current)) {
                         return DRFLAC_FALSE;
                     }
 
@@ -4371,6 +5166,7 @@ drflac_bool32 drflac__init_private__ogg(drflac_init_info* pInit, drflac_read_pro
                             pInit->totalSampleCount   = streaminfo.totalSampleCount;
                             pInit->maxBlockSize       = streaminfo.maxBlockSize;
                             pInit->hasMetadataBlocks  = !isLastBlock;
+                            drflac_copy_memory(pInit->md5, streaminfo.md5, sizeof(pInit->md5));
 
                             if (onMeta) {
                                 drflac_metadata metadata;
@@ -4396,18 +5192,18 @@ drflac_bool32 drflac__init_private__ogg(drflac_init_info* pInit, drflac_read_pro
                     }
                 } else {
                     // Not a FLAC header. Skip it.
-                    if (!onSeek(pUserData, bytesRemainingInPage, drflac_seek_origin_current)) {
+                    if (!drflac__seek_client(pInit->onSeek, pInit->onSeek64, pUserData, bytesRemainingInPage, drflac_seek_origin_current)) {
                         return DRFLAC_FALSE;
                     }
                 }
             } else {
                 // Not a FLAC header. Seek past the entire page and move on to the next.
-                if (!onSeek(pUserData, bytesRemainingInPage, drflac_seek_origin_current)) {
+                if (!drflac__seek_client(pInit->onSeek, pInit->onSeek64, pUserData, bytesRemainingInPage, drflac_seek_origin_current)) {
                     return DRFLAC_FALSE;
                 }
             }
         } else {
-            if (!onSeek(pUserData, pageBodySize, drflac_seek_origin_current)) {
+            if (!drflac__seek_client(pInit->onSeek, pInit->onSeek64, pUserData, pageBodySize, drflac_seek_origin_current)) {
                 return DRFLAC_FALSE;
             }
         }
@@ -4431,15 +5227,16 @@ drflac_bool32 drflac__init_private__ogg(drflac_init_info* pInit, drflac_read_pro
 }
 #endif
 
-drflac_bool32 drflac__init_private(drflac_init_info* pInit, drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_meta_proc onMeta, drflac_container container, void* pUserData, void* pUserDataMD)
+drflac_bool32 drflac__init_private(drflac_init_info* pInit, drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_seek64_proc onSeek64, drflac_meta_proc onMeta, drflac_container container, void* pUserData, void* pUserDataMD)
 {
-    if (pInit == NULL || onRead == NULL || onSeek == NULL) {
+    if (pInit == NULL || onRead == NULL || (onSeek == NULL && onSeek64 == NULL)) {
         return DRFLAC_FALSE;
     }
 
     drflac_zero_memory(pInit, sizeof(*pInit));
     pInit->onRead       = onRead;
     pInit->onSeek       = onSeek;
+    pInit->onSeek64     = onSeek64;
     pInit->onMeta       = onMeta;
     pInit->container    = container;
     pInit->pUserData    = pUserData;
@@ -4447,6 +5244,7 @@ drflac_bool32 drflac__init_private(drflac_init_info* pInit, drflac_read_proc onR
 
     pInit->bs.onRead    = onRead;
     pInit->bs.onSeek    = onSeek;
+    pInit->bs.onSeek64  = onSeek64;
     pInit->bs.pUserData = pUserData;
     drflac__reset_cache(&pInit->bs);
 
@@ -4499,9 +5297,22 @@ void drflac__init_from_info(drflac* pFlac, drflac_init_info* pInit)
     pFlac->bitsPerSample    = (drflac_uint8)pInit->bitsPerSample;
     pFlac->totalSampleCount = pInit->totalSampleCount;
     pFlac->container        = pInit->container;
+    drflac_copy_memory(pFlac->streaminfoMD5, pInit->md5, sizeof(pFlac->streaminfoMD5));
+}
+
+// Frees the memory of a decoder without closing any file handles.
+static void drflac__free_private(drflac* pFlac)
+{
+#ifdef DR_FLAC_LOW_MEMORY
+    if (pFlac->pDecodedSamples16 != NULL) {
+        drflac__release_scratch();
+    }
+#endif
+
+    DRFLAC_FREE(pFlac);
 }
 
-drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_meta_proc onMeta, drflac_container container, void* pUserData, void* pUserDataMD)
+drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_seek64_proc onSeek64, drflac_meta_proc onMeta, drflac_container container, void* pUserData, void* pUserDataMD)
 {
 #ifndef DRFLAC_NO_CPUID
     // CPU support first.
@@ -4509,7 +5320,7 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
 #endif
 
     drflac_init_info init;
-    if (!drflac__init_private(&init, onRead, onSeek, onMeta, container, pUserData, pUserDataMD)) {
+    if (!drflac__init_private(&init, onRead, onSeek, onSeek64, onMeta, container, pUserData, pUserDataMD)) {
         return NULL;
     }
 
@@ -4524,14 +5335,16 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
 
     // The allocation size for decoded frames depends on the number of 32-bit integers that fit inside the largest SIMD vector
     // we are supporting.
-    drflac_uint32 wholeSIMDVectorCountPerChannel;
-    if ((init.maxBlockSize % (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32))) == 0) {
-        wholeSIMDVectorCountPerChannel = (init.maxBlockSize / (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32)));
-    } else {
-        wholeSIMDVectorCountPerChannel = (init.maxBlockSize / (DRFLAC_MAX_SIMD_VECTOR_SIZE / sizeof(drflac_int32))) + 1;
-    }
+    drflac_uint32 decodedSamplesAllocationSize = drflac__get_decoded_samples_allocation_size(init.maxBlockSize, init.channels);
 
-    drflac_uint32 decodedSamplesAllocationSize = wholeSIMDVectorCountPerChannel * DRFLAC_MAX_SIMD_VECTOR_SIZE * init.channels;
+#ifdef DR_FLAC_LOW_MEMORY
+    // In low memory mode the subframes of streams that fit in 16 bits are decoded into a shared buffer, and only the 16-bit
+    // interleaved samples are kept with the decoder.
+    drflac_bool32 isLowMemory = init.bitsPerSample <= 16;
+    if (isLowMemory) {
+        decodedSamplesAllocationSize = (drflac_uint32)drflac_align(init.maxBlockSize * init.channels * sizeof(drflac_int16), DRFLAC_MAX_SIMD_VECTOR_SIZE);
+    }
+#endif
 
     allocationSize += decodedSamplesAllocationSize;
     allocationSize += DRFLAC_MAX_SIMD_VECTOR_SIZE;  // Allocate extra bytes to ensure we have enough for alignment.
@@ -4544,14 +5357,28 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
 #endif
 
     drflac* pFlac = (drflac*)DRFLAC_MALLOC(allocationSize);
+    if (pFlac == NULL) {
+        return NULL;
+    }
+
     drflac__init_from_info(pFlac, &init);
+    pFlac->allocationSize = allocationSize;
     pFlac->pDecodedSamples = (drflac_int32*)drflac_align((size_t)pFlac->pExtraData, DRFLAC_MAX_SIMD_VECTOR_SIZE);
 
+#ifdef DR_FLAC_LOW_MEMORY
+    if (isLowMemory) {
+        pFlac->pDecodedSamples16 = (drflac_int16*)pFlac->pDecodedSamples;
+        pFlac->pDecodedSamples = NULL;
+        drflac__g_scratchRefCount += 1;
+    }
+#endif
+
 #ifndef DR_FLAC_NO_OGG
     if (init.container == drflac_container_ogg) {
-        drflac_oggbs* oggbs = (drflac_oggbs*)((drflac_uint8*)pFlac->pDecodedSamples + decodedSamplesAllocationSize);
+        drflac_oggbs* oggbs = (drflac_oggbs*)((drflac_uint8*)drflac_align((size_t)pFlac->pExtraData, DRFLAC_MAX_SIMD_VECTOR_SIZE) + decodedSamplesAllocationSize);
         oggbs->onRead = onRead;
         oggbs->onSeek = onSeek;
+        oggbs->onSeek64 = onSeek64;
         oggbs->pUserData = pUserData;
         oggbs->currentBytePos = init.oggFirstBytePos;
         oggbs->firstBytePos = init.oggFirstBytePos;
@@ -4562,6 +5389,7 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
         // The Ogg bistream needs to be layered on top of the original bitstream.
         pFlac->bs.onRead = drflac__on_read_ogg;
         pFlac->bs.onSeek = drflac__on_seek_ogg;
+        pFlac->bs.onSeek64 = NULL;
         pFlac->bs.pUserData = (void*)oggbs;
         pFlac->_oggbs = (void*)oggbs;
     }
@@ -4570,9 +5398,11 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
     // Decode metadata before returning.
     if (init.hasMetadataBlocks) {
         if (!drflac__read_and_decode_metadata(pFlac)) {
-            DRFLAC_FREE(pFlac);
+            drflac__free_private(pFlac);
             return NULL;
         }
+    } else if (init.hasStreamInfoBlock) {
+        pFlac->firstFramePos = 42;  // <-- The first frame comes straight after the STREAMINFO block.
     }
 
     // If we get here, but don't have a STREAMINFO block, it means we've opened the stream in relaxed mode and need to decode
@@ -4587,12 +5417,12 @@ drflac* drflac_open_with_metadata_private(drflac_read_proc onRead, drflac_seek_p
             } else {
                 if (result == DRFLAC_CRC_MISMATCH) {
                     if (!drflac__read_next_frame_header(&pFlac->bs, pFlac->bitsPerSample, &pFlac->currentFrame.header)) {
-                        DRFLAC_FREE(pFlac);
+                        drflac__free_private(pFlac);
                         return NULL;
                     }
                     continue;
                 } else {
-                    DRFLAC_FREE(pFlac);
+                    drflac__free_private(pFlac);
                     return NULL;
                 }
             }
@@ -4609,18 +5439,84 @@ typedef void* drflac_file;
 
 #if defined(DR_FLAC_NO_WIN32_IO) || !defined(_WIN32)
 #include <stdio.h>
+#include <limits.h> // For LONG_MAX
+
+#if defined(DR_FLAC_READ_AHEAD_SIZE) && defined(__linux__) && defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L
+#include <fcntl.h>
+#define DRFLAC_HAS_FADVISE
+#endif
+
+#ifdef DRFLAC_HAS_FADVISE
+// Asks the kernel to start loading the next DR_FLAC_READ_AHEAD_SIZE bytes of the file. This is done each time the read position
+// crosses into the next half of the window so that the I/O for the next chunk is always in flight while the current one is
+// being decoded. Passing 0 for <bytesJustRead> forces the hint, which is what we want after a seek.
+static void drflac__read_ahead_stdio(FILE* pFile, size_t bytesJustRead)
+{
+    off_t pos = ftello(pFile);
+    if (pos < 0) {
+        return;
+    }
+
+    off_t halfWindow = (DR_FLAC_READ_AHEAD_SIZE / 2) > 0 ? (DR_FLAC_READ_AHEAD_SIZE / 2) : 1;
+    if (bytesJustRead > 0 && ((pos - (off_t)bytesJustRead) / halfWindow) == (pos / halfWindow)) {
+        return;
+    }
+
+    posix_fadvise(fileno(pFile), pos, DR_FLAC_READ_AHEAD_SIZE, POSIX_FADV_WILLNEED);
+}
+#endif
 
 static size_t drflac__on_read_stdio(void* pUserData, void* bufferOut, size_t bytesToRead)
 {
-    return fread(bufferOut, 1, bytesToRead, (FILE*)pUserData);
+    size_t bytesRead = fread(bufferOut, 1, bytesToRead, (FILE*)pUserData);
+#ifdef DRFLAC_HAS_FADVISE
+    drflac__read_ahead_stdio((FILE*)pUserData, bytesRead);
+#endif
+
+    return bytesRead;
 }
 
+// Files are seeked with a 64-bit offset where the platform has one. That's _fseeki64() on Windows, and plain fseek() wherever long
+// is 64 bits. Everywhere else falls back to the 32-bit callback.
+#if defined(_WIN32) && (!defined(_MSC_VER) || _MSC_VER >= 1400)
+#define DRFLAC_HAS_SEEK64_STDIO
+static drflac_bool32 drflac__on_seek64_stdio(void* pUserData, drflac_int64 offset, drflac_seek_origin origin)
+{
+    drflac_assert(offset > 0 || (offset == 0 && origin == drflac_seek_origin_start));
+    return _fseeki64((FILE*)pUserData, offset, (origin == drflac_seek_origin_current) ? SEEK_CUR : SEEK_SET) == 0;
+}
+#elif LONG_MAX > 0x7FFFFFFF
+#define DRFLAC_HAS_SEEK64_STDIO
+static drflac_bool32 drflac__on_seek64_stdio(void* pUserData, drflac_int64 offset, drflac_seek_origin origin)
+{
+    drflac_assert(offset > 0 || (offset == 0 && origin == drflac_seek_origin_start));
+
+    if (fseek((FILE*)pUserData, (long)offset, (origin == drflac_seek_origin_current) ? SEEK_CUR : SEEK_SET) != 0) {
+        return DRFLAC_FALSE;
+    }
+
+#ifdef DRFLAC_HAS_FADVISE
+    drflac__read_ahead_stdio((FILE*)pUserData, 0);
+#endif
+
+    return DRFLAC_TRUE;
+}
+#else
 static drflac_bool32 drflac__on_seek_stdio(void* pUserData, int offset, drflac_seek_origin origin)
 {
     drflac_assert(offset > 0 || (offset == 0 && origin == drflac_seek_origin_start));
 
-    return fseek((FILE*)pUserData, offset, (origin == drflac_seek_origin_current) ? SEEK_CUR : SEEK_SET) == 0;
+    if (fseek((FILE*)pUserData, offset, (origin == drflac_seek_origin_current) ? SEEK_CUR : SEEK_SET) != 0) {
+        return DRFLAC_FALSE;
+    }
+
+#ifdef DRFLAC_HAS_FADVISE
+    drflac__read_ahead_stdio((FILE*)pUserData, 0);
+#endif
+
+    return DRFLAC_TRUE;
 }
+#endif
 
 static drflac_file drflac__open_file_handle(const char* filename)
 {
@@ -4636,6 +5532,12 @@ static drflac_file drflac__open_file_handle(const char* filename)
     }
 #endif
 
+#ifdef DRFLAC_HAS_FADVISE
+    // Sequential access lets the kernel use a larger read-ahead window of it's own, on top of what we ask for explicitly.
+    posix_fadvise(fileno(pFile), 0, 0, POSIX_FADV_SEQUENTIAL);
+    drflac__read_ahead_stdio(pFile, 0);
+#endif
+
     return (drflac_file)pFile;
 }
 
@@ -4661,16 +5563,25 @@ static size_t drflac__on_read_stdio(void* pUserData, void* bufferOut, size_t byt
     return (size_t)bytesRead;
 }
 
-static drflac_bool32 drflac__on_seek_stdio(void* pUserData, int offset, drflac_seek_origin origin)
+#define DRFLAC_HAS_SEEK64_STDIO
+static drflac_bool32 drflac__on_seek64_stdio(void* pUserData, drflac_int64 offset, drflac_seek_origin origin)
 {
     drflac_assert(offset > 0 || (offset == 0 && origin == drflac_seek_origin_start));
 
-    return SetFilePointer((HANDLE)pUserData, offset, NULL, (origin == drflac_seek_origin_current) ? FILE_CURRENT : FILE_BEGIN) != INVALID_SET_FILE_POINTER;
+    // INVALID_SET_FILE_POINTER is also a valid low part of a 64-bit position so GetLastError() needs to be checked as well.
+    LONG offsetHigh = (LONG)(offset >> 32);
+    DWORD result = SetFilePointer((HANDLE)pUserData, (LONG)(offset & 0xFFFFFFFF), &offsetHigh, (origin == drflac_seek_origin_current) ? FILE_CURRENT : FILE_BEGIN);
+    return result != INVALID_SET_FILE_POINTER || GetLastError() == NO_ERROR;
 }
 
 static drflac_file drflac__open_file_handle(const char* filename)
 {
-    HANDLE hFile = CreateFileA(filename, FILE_GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+#ifdef DR_FLAC_READ_AHEAD_SIZE
+    flags |= FILE_FLAG_SEQUENTIAL_SCAN;    // <-- Windows manages the read-ahead size itself.
+#endif
+
+    HANDLE hFile = CreateFileA(filename, FILE_GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
     if (hFile == INVALID_HANDLE_VALUE) {
         return NULL;
     }
@@ -4692,7 +5603,11 @@ drflac* drflac_open_file(const char* filename)
         return NULL;
     }
 
+#ifdef DRFLAC_HAS_SEEK64_STDIO
+    drflac* pFlac = drflac_open_seek64(drflac__on_read_stdio, drflac__on_seek64_stdio, (void*)file);
+#else
     drflac* pFlac = drflac_open(drflac__on_read_stdio, drflac__on_seek_stdio, (void*)file);
+#endif
     if (pFlac == NULL) {
         drflac__close_file_handle(file);
         return NULL;
@@ -4708,7 +5623,11 @@ drflac* drflac_open_file_with_metadata(const char* filename, drflac_meta_proc on
         return NULL;
     }
 
-    drflac* pFlac = drflac_open_with_metadata_private(drflac__on_read_stdio, drflac__on_seek_stdio, onMeta, drflac_container_unknown, (void*)file, pUserData);
+#ifdef DRFLAC_HAS_SEEK64_STDIO
+    drflac* pFlac = drflac_open_with_metadata_private(drflac__on_read_stdio, NULL, drflac__on_seek64_stdio, onMeta, drflac_container_unknown, (void*)file, pUserData);
+#else
+    drflac* pFlac = drflac_open_with_metadata_private(drflac__on_read_stdio, drflac__on_seek_stdio, NULL, onMeta, drflac_container_unknown, (void*)file, pUserData);
+#endif
     if (pFlac == NULL) {
         drflac__close_file_handle(file);
         return pFlac;
@@ -4737,21 +5656,21 @@ static size_t drflac__on_read_memory(void* pUserData, void* bufferOut, size_t by
     return bytesToRead;
 }
 
-static drflac_bool32 drflac__on_seek_memory(void* pUserData, int offset, drflac_seek_origin origin)
+static drflac_bool32 drflac__on_seek64_memory(void* pUserData, drflac_int64 offset, drflac_seek_origin origin)
 {
     drflac__memory_stream* memoryStream = (drflac__memory_stream*)pUserData;
     drflac_assert(memoryStream != NULL);
     drflac_assert(offset > 0 || (offset == 0 && origin == drflac_seek_origin_start));
 
     if (origin == drflac_seek_origin_current) {
-        if (memoryStream->currentReadPos + offset <= memoryStream->dataSize) {
-            memoryStream->currentReadPos += offset;
+        if ((drflac_uint64)offset <= memoryStream->dataSize - memoryStream->currentReadPos) {
+            memoryStream->currentReadPos += (size_t)offset;
         } else {
             memoryStream->currentReadPos = memoryStream->dataSize;  // Trying to seek too far forward.
         }
     } else {
-        if ((drflac_uint32)offset <= memoryStream->dataSize) {
-            memoryStream->currentReadPos = offset;
+        if ((drflac_uint64)offset <= memoryStream->dataSize) {
+            memoryStream->currentReadPos = (size_t)offset;
         } else {
             memoryStream->currentReadPos = memoryStream->dataSize;  // Trying to seek too far forward.
         }
@@ -4766,7 +5685,7 @@ drflac* drflac_open_memory(const void* data, size_t dataSize)
     memoryStream.data = (const unsigned char*)data;
     memoryStream.dataSize = dataSize;
     memoryStream.currentReadPos = 0;
-    drflac* pFlac = drflac_open(drflac__on_read_memory, drflac__on_seek_memory, &memoryStream);
+    drflac* pFlac = drflac_open_seek64(drflac__on_read_memory, drflac__on_seek64_memory, &memoryStream);
     if (pFlac == NULL) {
         return NULL;
     }
@@ -4795,7 +5714,7 @@ drflac* drflac_open_memory_with_metadata(const void* data, size_t dataSize, drfl
     memoryStream.data = (const unsigned char*)data;
     memoryStream.dataSize = dataSize;
     memoryStream.currentReadPos = 0;
-    drflac* pFlac = drflac_open_with_metadata_private(drflac__on_read_memory, drflac__on_seek_memory, onMeta, drflac_container_unknown, &memoryStream, pUserData);
+    drflac* pFlac = drflac_open_with_metadata_private(drflac__on_read_memory, NULL, drflac__on_seek64_memory, onMeta, drflac_container_unknown, &memoryStream, pUserData);
     if (pFlac == NULL) {
         return NULL;
     }
@@ -4822,20 +5741,30 @@ drflac* drflac_open_memory_with_metadata(const void* data, size_t dataSize, drfl
 
 drflac* drflac_open(drflac_read_proc onRead, drflac_seek_proc onSeek, void* pUserData)
 {
-    return drflac_open_with_metadata_private(onRead, onSeek, NULL, drflac_container_unknown, pUserData, pUserData);
+    return drflac_open_with_metadata_private(onRead, onSeek, NULL, NULL, drflac_container_unknown, pUserData, pUserData);
 }
 drflac* drflac_open_relaxed(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_container container, void* pUserData)
 {
-    return drflac_open_with_metadata_private(onRead, onSeek, NULL, container, pUserData, pUserData);
+    return drflac_open_with_metadata_private(onRead, onSeek, NULL, NULL, container, pUserData, pUserData);
 }
 
 drflac* drflac_open_with_metadata(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_meta_proc onMeta, void* pUserData)
 {
-    return drflac_open_with_metadata_private(onRead, onSeek, onMeta, drflac_container_unknown, pUserData, pUserData);
+    return drflac_open_with_metadata_private(onRead, onSeek, NULL, onMeta, drflac_container_unknown, pUserData, pUserData);
 }
 drflac* drflac_open_with_metadata_relaxed(drflac_read_proc onRead, drflac_seek_proc onSeek, drflac_meta_proc onMeta, drflac_container container, void* pUserData)
 {
-    return drflac_open_with_metadata_private(onRead, onSeek, onMeta, container, pUserData, pUserData);
+    return drflac_open_with_metadata_private(onRead, onSeek, NULL, onMeta, container, pUserData, pUserData);
+}
+
+drflac* drflac_open_seek64(drflac_read_proc onRead, drflac_seek64_proc onSeek64, void* pUserData)
+{
+    return drflac_open_with_metadata_private(onRead, NULL, onSeek64, NULL, drflac_container_unknown, pUserData, pUserData);
+}
+
+drflac* drflac_open_with_metadata_seek64(drflac_read_proc onRead, drflac_seek64_proc onSeek64, drflac_meta_proc onMeta, void* pUserData)
+{
+    return drflac_open_with_metadata_private(onRead, NULL, onSeek64, onMeta, drflac_container_unknown, pUserData, pUserData);
 }
 
 void drflac_close(drflac* pFlac)
@@ -4863,7 +5792,16 @@ void drflac_close(drflac* pFlac)
 #endif
 #endif
 
-    DRFLAC_FREE(pFlac);
+    drflac__free_private(pFlac);
+}
+
+size_t drflac_get_memory_usage(drflac* pFlac)
+{
+    if (pFlac == NULL) {
+        return 0;
+    }
+
+    return pFlac->allocationSize;
 }
 
 drflac_uint64 drflac__read_s32__misaligned(drflac* pFlac, drflac_uint64 samplesToRead, drflac_int32* bufferOut)
@@ -4975,9 +5913,11 @@ drflac_uint64 drflac_read_s32(drflac* pFlac, drflac_uint64 samplesToRead, drflac
     }
 
     if (bufferOut == NULL) {
+        pFlac->isMD5Contiguous = DRFLAC_FALSE;  // <-- Samples are being skipped so they can't be hashed.
         return drflac__seek_forward_by_samples(pFlac, samplesToRead);
     }
 
+    drflac_int32* bufferOutStart = bufferOut;
 
     drflac_uint64 samplesRead = 0;
     while (samplesToRead > 0) {
@@ -4987,13 +5927,41 @@ drflac_uint64 drflac_read_s32(drflac* pFlac, drflac_uint64 samplesToRead, drflac
                 break;  // Couldn't read the next frame, so just break from the loop and return.
             }
         } else {
+#ifdef DR_FLAC_LOW_MEMORY
+            if (pFlac->pDecodedSamples16 != NULL) {
+                // The frame has already been interleaved so it's just a matter of widening the samples.
+                unsigned int channelCount = drflac__get_channel_count_from_channel_assignment(pFlac->currentFrame.header.channelAssignment);
+                drflac_uint64 totalSamplesInFrame = pFlac->currentFrame.header.blockSize * channelCount;
+                const drflac_int16* pDecodedSamples16 = pFlac->pDecodedSamples16 + (totalSamplesInFrame - pFlac->currentFrame.samplesRemaining);
+
+                drflac_uint64 samplesToReadFromFrame = samplesToRead;
+                if (samplesToReadFromFrame > pFlac->currentFrame.samplesRemaining) {
+                    samplesToReadFromFrame = pFlac->currentFrame.samplesRemaining;
+                }
+
+                for (drflac_uint64 i = 0; i < samplesToReadFromFrame; ++i) {
+                    bufferOut[i] = (drflac_int32)((drflac_uint32)pDecodedSamples16[i] << 16);
+                }
+
+                samplesRead   += samplesToReadFromFrame;
+                bufferOut     += samplesToReadFromFrame;
+                samplesToRead -= samplesToReadFromFrame;
+                pFlac->currentFrame.samplesRemaining -= (drflac_uint32)samplesToReadFromFrame;
+                continue;
+            }
+#endif
+
             // Here is where we grab the samples and interleave them.
 
             unsigned int channelCount = drflac__get_channel_count_from_channel_assignment(pFlac->currentFrame.header.channelAssignment);
             drflac_uint64 totalSamplesInFrame = pFlac->currentFrame.header.blockSize * channelCount;
             drflac_uint64 samplesReadFromFrameSoFar = totalSamplesInFrame - pFlac->currentFrame.samplesRemaining;
 
-            drflac_uint64 misalignedSampleCount = samplesReadFromFrameSoFar % channelCount;
+            // If the last read stopped part way through a PCM frame, the rest of that PCM frame needs to be read before the fast path.
+            drflac_uint64 misalignedSampleCount = (channelCount - (samplesReadFromFrameSoFar % channelCount)) % channelCount;
+            if (misalignedSampleCount > samplesToRead) {
+                misalignedSampleCount = samplesToRead;
+            }
             if (misalignedSampleCount > 0) {
                 drflac_uint64 misalignedSamplesRead = drflac__read_s32__misaligned(pFlac, misalignedSampleCount, bufferOut);
                 samplesRead   += misalignedSamplesRead;
@@ -5109,11 +6077,131 @@ drflac_uint64 drflac_read_s32(drflac* pFlac, drflac_uint64 samplesToRead, drflac
         }
     }
 
+    if (pFlac->isMD5Enabled && pFlac->isMD5Contiguous) {
+        drflac__md5_update_samples(&pFlac->md5, pFlac->bitsPerSample, bufferOutStart, samplesRead);
+        pFlac->md5SampleCount += samplesRead;
+    }
+
     return samplesRead;
 }
 
+// Dithering.
+//
+// This is the same dither as dr_wav's, and gives the same output for the same samples and seed. Decoding the FLAC stream costs far
+// more than dithering it, so there is only a scalar implementation. The random numbers come from four xorshift generators which are
+// used in turn.
+static DRFLAC_INLINE drflac_uint32 drflac__dither_next_random(drflac_dither* pDither)
+{
+    drflac_uint32 x = pDither->lanes[pDither->iLane];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pDither->lanes[pDither->iLane] = x;
+    pDither->iLane = (pDither->iLane + 1) & 3;
+    return x;
+}
+
+// Samples are scaled so that 1 is the least significant bit of the output and are rounded after adding triangular noise between -1
+// and 1, made by adding the two halves of a random number together. The offset makes the value positive so truncation is the same
+// as rounding down. This is all done with doubles because a float doesn't have enough precision for a 32-bit sample.
+static void drflac__s32_to_s16_dithered(drflac_dither* pDither, drflac_int16* pOut, const drflac_int32* pIn, size_t sampleCount)
+{
+    drflac_bool32 isShaped = pDither->mode == drflac_dither_mode_triangle_shaped;
+    drflac_uint32 iChannel = pDither->iChannel;
+    drflac_assert(pDither->channels > 0);    // <-- The dither must be initialized with drflac_dither_init().
+
+    for (size_t i = 0; i < sampleCount; ++i) {
+        drflac_uint32 random = drflac__dither_next_random(pDither);
+        double noise = (double)((drflac_int32)(random & 0xFFFF) + (drflac_int32)(random >> 16) - 65535) * (1.0 / 65536);
+
+        double x = (double)pIn[i] * (1.0 / 65536);
+        if (isShaped) {
+            x -= pDither->error[iChannel];  // First-order noise shaping feeds the error of each sample into the next one of the same channel.
+        }
+
+        double r = x + noise + 32768.5;
+        r = ((r < 0) ? 0 : ((r > 65535) ? 65535 : r));
+        pOut[i] = (drflac_int16)((drflac_int32)r - 32768);
+
+        if (isShaped) {
+            // The error is limited to what rounding and the dither can produce so that clipping doesn't build up.
+            double error = (double)pOut[i] - x;
+            pDither->error[iChannel] = (error < -1.5) ? -1.5 : ((error > 1.5) ? 1.5 : error);
+        }
+
+        iChannel += 1;
+        if (iChannel == pDither->channels) {
+            iChannel = 0;
+        }
+    }
+
+    pDither->iChannel = iChannel;
+}
+
+// The noise shaping error of the previous sample doesn't apply after a seek. The channel of the next sample is kept in step with
+// the new position.
+static void drflac__dither_seek(drflac_dither* pDither, drflac_uint64 sampleIndex)
+{
+    if (pDither->channels == 0) {
+        return;
+    }
+
+    pDither->iChannel = (drflac_uint32)(sampleIndex % pDither->channels);
+    drflac_zero_memory(pDither->error, sizeof(pDither->error));
+}
+
+drflac_bool32 drflac_dither_init(drflac_dither* pDither, drflac_dither_mode mode, drflac_uint32 channels, drflac_uint32 seed)
+{
+    if (pDither == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_zero_memory(pDither, sizeof(*pDither));
+
+    if (channels == 0 || (mode == drflac_dither_mode_triangle_shaped && channels > DRFLAC_MAX_DITHER_CHANNELS)) {
+        return DRFLAC_FALSE;
+    }
+
+    pDither->mode     = mode;
+    pDither->channels = channels;
+
+    // Each lane is seeded with a hash of the seed so that similar seeds give unrelated sequences. Xorshift gets stuck at 0.
+    for (drflac_uint32 iLane = 0; iLane < 4; ++iLane) {
+        drflac_uint32 x = seed + (iLane + 1) * 0x9E3779B9;
+        x = (x ^ (x >> 16)) * 0x7FEB352D;
+        x = (x ^ (x >> 15)) * 0x846CA68B;
+        x =  x ^ (x >> 16);
+        pDither->lanes[iLane] = (x != 0) ? x : (iLane + 1);
+    }
+
+    return DRFLAC_TRUE;
+}
+
+drflac_bool32 drflac_set_dither(drflac* pFlac, drflac_dither_mode mode)
+{
+    if (pFlac == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_dither dither;
+    if (!drflac_dither_init(&dither, mode, pFlac->channels, 0)) {
+        return DRFLAC_FALSE;
+    }
+
+    pFlac->dither = dither;
+    return DRFLAC_TRUE;
+}
+
 drflac_uint64 drflac_read_s16(drflac* pFlac, drflac_uint64 samplesToRead, drflac_int16* pBufferOut)
 {
+    return drflac_read_s16_dithered(pFlac, samplesToRead, pBufferOut, (pFlac != NULL) ? &pFlac->dither : NULL);
+}
+
+drflac_uint64 drflac_read_s16_dithered(drflac* pFlac, drflac_uint64 samplesToRead, drflac_int16* pBufferOut, drflac_dither* pDither)
+{
+    // Streams with 16 bits per sample or less have nothing below the upper 16 bits to dither.
+    drflac_bool32 isDithered = pFlac != NULL && pFlac->bitsPerSample > 16 && pDither != NULL && pDither->mode != drflac_dither_mode_none;
+
     // This reads samples in 2 passes and can probably be optimized.
     drflac_uint64 totalSamplesRead = 0;
 
@@ -5125,8 +6213,12 @@ drflac_uint64 drflac_read_s16(drflac* pFlac, drflac_uint64 samplesToRead, drflac
         }
 
         // s32 -> s16
-        for (drflac_uint64 i = 0; i < samplesJustRead; ++i) {
-            pBufferOut[i] = (drflac_int16)(samples32[i] >> 16);
+        if (isDithered) {
+            drflac__s32_to_s16_dithered(pDither, pBufferOut, samples32, (size_t)samplesJustRead);
+        } else {
+            for (drflac_uint64 i = 0; i < samplesJustRead; ++i) {
+                pBufferOut[i] = (drflac_int16)(samples32[i] >> 16);
+            }
         }
 
         totalSamplesRead += samplesJustRead;
@@ -5175,14 +6267,28 @@ drflac_bool32 drflac_seek_to_sample(drflac* pFlac, drflac_uint64 sampleIndex)
     }
 
     if (sampleIndex == 0) {
-        return drflac__seek_to_first_frame(pFlac);
+        if (!drflac__seek_to_first_frame(pFlac)) {
+            return DRFLAC_FALSE;
+        }
+
+        drflac__dither_seek(&pFlac->dither, 0);
+
+        // Back at the start so the hash can be started again from scratch.
+        drflac__md5_init(&pFlac->md5);
+        pFlac->md5SampleCount  = 0;
+        pFlac->isMD5Contiguous = DRFLAC_TRUE;
+        return DRFLAC_TRUE;
     }
 
+    pFlac->isMD5Contiguous = DRFLAC_FALSE;
+
     // Clamp the sample to the end.
     if (sampleIndex >= pFlac->totalSampleCount) {
         sampleIndex  = pFlac->totalSampleCount - 1;
     }
 
+    drflac__dither_seek(&pFlac->dither, sampleIndex);
+
 
     // Different techniques depending on encapsulation. Using the native FLAC seektable with Ogg encapsulation is a bit awkward so
     // we'll instead use Ogg's natural seeking facility.
@@ -5205,6 +6311,57 @@ drflac_bool32 drflac_seek_to_sample(drflac* pFlac, drflac_uint64 sampleIndex)
 }
 
 
+drflac_bool32 drflac_enable_md5_verification(drflac* pFlac)
+{
+    if (pFlac == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    // An all-zero signature means the encoder didn't calculate it.
+    drflac_bool32 hasSignature = DRFLAC_FALSE;
+    for (int i = 0; i < 16; ++i) {
+        if (pFlac->streaminfoMD5[i] != 0) {
+            hasSignature = DRFLAC_TRUE;
+            break;
+        }
+    }
+
+    // Hashing must start from the first sample. The current frame is only ever empty before anything has been decoded.
+    if (!hasSignature || pFlac->currentFrame.header.blockSize != 0) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac__md5_init(&pFlac->md5);
+    pFlac->md5SampleCount  = 0;
+    pFlac->isMD5Enabled    = DRFLAC_TRUE;
+    pFlac->isMD5Contiguous = DRFLAC_TRUE;
+    return DRFLAC_TRUE;
+}
+
+drflac_bool32 drflac_md5_matches(drflac* pFlac)
+{
+    if (pFlac == NULL || !pFlac->isMD5Enabled || !pFlac->isMD5Contiguous) {
+        return DRFLAC_FALSE;
+    }
+
+    if (pFlac->totalSampleCount == 0 || pFlac->md5SampleCount != pFlac->totalSampleCount) {
+        return DRFLAC_FALSE;
+    }
+
+    // Finalizing is destructive so it's done on a copy. That way this can be called more than once.
+    drflac__md5 md5 = pFlac->md5;
+    drflac_uint8 digest[16];
+    drflac__md5_final(&md5, digest);
+
+    for (int i = 0; i < 16; ++i) {
+        if (digest[i] != pFlac->streaminfoMD5[i]) {
+            return DRFLAC_FALSE;
+        }
+    }
+
+    return DRFLAC_TRUE;
+}
+
 
 //// High Level APIs ////
 
@@ -5423,6 +6580,448 @@ void drflac_free(void* pSampleDataReturnedByOpenAndDecode)
 
 
 
+//// Waveform Overviews ////
+
+#define DRFLAC_OVERVIEW_DEFAULT_FRAMES_PER_POINT    256
+#define DRFLAC_OVERVIEW_MAX_LEVELS                  64
+#define DRFLAC_OVERVIEW_CHUNK_SAMPLE_COUNT          16384   // The number of samples decoded at a time.
+#define DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE      24
+#define DRFLAC_OVERVIEW_SERIALIZED_VERSION          1
+
+// These stand in for HUGE_VAL, sqrt(), floor() and ceil() so the library doesn't need to be linked with the math library.
+static DRFLAC_INLINE float drflac__overview_infinity(void)
+{
+    drflac_uint32 bits = 0x7F800000;
+    float x;
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+static double drflac__sqrt_f64(double x)
+{
+    if (!(x > 0)) {
+        return 0;
+    }
+    if (x - x != 0) {
+        return x;   // Infinity.
+    }
+
+    // Halving the exponent gets within a factor of two of the root. After one step of Newton's method the estimate is never
+    // below the root, so the rest of the steps only get smaller until they can't improve it any more.
+    drflac_uint64 bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = (bits >> 1) + ((drflac_uint64)0x1FF8 << 48);
+
+    double y;
+    memcpy(&y, &bits, sizeof(y));
+    y = 0.5 * (y + x/y);
+    for (;;) {
+        double next = 0.5 * (y + x/y);
+        if (next >= y) {
+            break;
+        }
+        y = next;
+    }
+
+    return y;
+}
+
+static DRFLAC_INLINE double drflac__floor_f64(double x)
+{
+    if (!(x > -4503599627370496.0 && x < 4503599627370496.0)) {
+        return x;   // Already a whole number, or NaN.
+    }
+
+    double i = (double)(drflac_int64)x;
+    return (i > x) ? i - 1 : i;
+}
+
+static DRFLAC_INLINE double drflac__ceil_f64(double x)
+{
+    return -drflac__floor_f64(-x);
+}
+
+typedef struct
+{
+    float min;
+    float max;
+    double sumSquares;
+} drflac__overview_accumulator;
+
+static void drflac__overview_reset_accumulators(drflac__overview_accumulator* pAccumulators, drflac_uint16 channels)
+{
+    for (drflac_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        pAccumulators[iChannel].min =  drflac__overview_infinity();
+        pAccumulators[iChannel].max = -drflac__overview_infinity();
+        pAccumulators[iChannel].sumSquares = 0;
+    }
+}
+
+static void drflac__overview_accumulate(drflac__overview_accumulator* pAccumulators, const float* pSamples, drflac_uint64 frameCount, drflac_uint16 channels)
+{
+    for (drflac_uint64 iFrame = 0; iFrame < frameCount; ++iFrame) {
+        for (drflac_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+            float x = *pSamples++;
+            drflac__overview_accumulator* pAccumulator = &pAccumulators[iChannel];
+            pAccumulator->min = drflac_min(pAccumulator->min, x);
+            pAccumulator->max = drflac_max(pAccumulator->max, x);
+            pAccumulator->sumSquares += (double)x*x;
+        }
+    }
+}
+
+static void drflac__overview_emit_point(drflac_overview_point* pPointsOut, drflac__overview_accumulator* pAccumulators, drflac_uint16 channels, drflac_uint32 frameCount)
+{
+    for (drflac_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        pPointsOut[iChannel].min = pAccumulators[iChannel].min;
+        pPointsOut[iChannel].max = pAccumulators[iChannel].max;
+        pPointsOut[iChannel].rms = (float)drflac__sqrt_f64(pAccumulators[iChannel].sumSquares / frameCount);
+    }
+
+    drflac__overview_reset_accumulators(pAccumulators, channels);
+}
+
+static drflac_uint64 drflac__overview_get_point_count(drflac_uint64 frameCount, drflac_uint32 framesPerPoint, drflac_uint32 level)
+{
+    drflac_uint64 pointCount = (frameCount / framesPerPoint) + ((frameCount % framesPerPoint) ? 1 : 0);
+    for (drflac_uint32 iLevel = 0; iLevel < level; ++iLevel) {
+        pointCount = (pointCount + 1) / 2;
+    }
+
+    return pointCount;
+}
+
+// The index of the first point of <level>, counting every channel.
+static drflac_uint64 drflac__overview_get_level_offset(const drflac_overview* pOverview, drflac_uint32 level)
+{
+    drflac_uint64 offset = 0;
+    drflac_uint64 pointCount = drflac__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, 0);
+    for (drflac_uint32 iLevel = 0; iLevel < level; ++iLevel) {
+        offset += pointCount * pOverview->channels;
+        pointCount = (pointCount + 1) / 2;
+    }
+
+    return offset;
+}
+
+static void drflac__overview_set_frame_count(drflac_overview* pOverview, drflac_uint64 frameCount, drflac_uint32 maxLevels)
+{
+    pOverview->frameCount = frameCount;
+    pOverview->levelCount = 1;
+
+    drflac_uint64 pointCount = drflac__overview_get_point_count(frameCount, pOverview->framesPerPoint, 0);
+    while (pointCount > 1 && pOverview->levelCount < maxLevels) {
+        pointCount = (pointCount + 1) / 2;
+        pOverview->levelCount += 1;
+    }
+}
+
+// Resizes the points for <frameCount> frames. Level 0 is at the start of the buffer so it stays in place.
+static drflac_bool32 drflac__overview_resize(drflac_overview* pOverview, drflac_uint64 frameCount, drflac_uint32 maxLevels)
+{
+    drflac__overview_set_frame_count(pOverview, frameCount, maxLevels);
+
+    // Each level is about half the size of the one before it so this is less than twice the size of level 0, which keeps it
+    // from overflowing.
+    if (drflac__overview_get_point_count(frameCount, pOverview->framesPerPoint, 0) > SIZE_MAX / 2 / pOverview->channels / sizeof(drflac_overview_point)) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_uint64 pointCount = drflac__overview_get_level_offset(pOverview, pOverview->levelCount);
+    drflac_overview_point* pNewPoints = (drflac_overview_point*)DRFLAC_REALLOC(pOverview->pPoints, (size_t)drflac_max(pointCount, 1) * sizeof(drflac_overview_point));
+    if (pNewPoints == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    pOverview->pPoints = pNewPoints;
+    return DRFLAC_TRUE;
+}
+
+static drflac_uint32 drflac__overview_get_max_levels(const drflac_overview_config* pConfig)
+{
+    if (pConfig == NULL || pConfig->maxLevels == 0 || pConfig->maxLevels > DRFLAC_OVERVIEW_MAX_LEVELS) {
+        return DRFLAC_OVERVIEW_MAX_LEVELS;
+    }
+
+    return pConfig->maxLevels;
+}
+
+// Each point of a level is made from two points of the level before it.
+static void drflac__overview_build_levels(drflac_overview* pOverview)
+{
+    drflac_uint16 channels = pOverview->channels;
+    for (drflac_uint32 iLevel = 1; iLevel < pOverview->levelCount; ++iLevel) {
+        drflac_uint64 srcPointCount;
+        drflac_uint64 dstPointCount;
+        const drflac_overview_point* pSrc = drflac_overview_get_level(pOverview, iLevel - 1, &srcPointCount);
+        drflac_overview_point* pDst = (drflac_overview_point*)drflac_overview_get_level(pOverview, iLevel, &dstPointCount);
+        drflac_uint64 framesPerSrcPoint = (drflac_uint64)pOverview->framesPerPoint << (iLevel - 1);
+
+        for (drflac_uint64 iPoint = 0; iPoint < dstPointCount; ++iPoint) {
+            drflac_uint64 iSrcPoint = iPoint*2;
+            const drflac_overview_point* pA = pSrc + (iSrcPoint * channels);
+            if (iSrcPoint + 1 == srcPointCount) {
+                drflac_copy_memory(pDst, pA, channels * sizeof(*pDst));
+            } else {
+                const drflac_overview_point* pB = pA + channels;
+
+                // The second point may be the last one of the level, which covers fewer frames.
+                double frameCountA = (double)framesPerSrcPoint;
+                double frameCountB = (double)drflac_min(framesPerSrcPoint, pOverview->frameCount - ((iSrcPoint + 1) * framesPerSrcPoint));
+
+                for (drflac_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+                    double sumSquares = ((double)pA[iChannel].rms * pA[iChannel].rms * frameCountA) + ((double)pB[iChannel].rms * pB[iChannel].rms * frameCountB);
+                    pDst[iChannel].min = drflac_min(pA[iChannel].min, pB[iChannel].min);
+                    pDst[iChannel].max = drflac_max(pA[iChannel].max, pB[iChannel].max);
+                    pDst[iChannel].rms = (float)drflac__sqrt_f64(sumSquares / (frameCountA + frameCountB));
+                }
+            }
+
+            pDst += channels;
+        }
+    }
+}
+
+drflac_bool32 drflac_overview_init(drflac_overview* pOverview, drflac* pFlac, const drflac_overview_config* pConfig)
+{
+    if (pOverview == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_zero_memory(pOverview, sizeof(*pOverview));
+
+    if (pFlac == NULL || pFlac->channels == 0 || !drflac_seek_to_sample(pFlac, 0)) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_uint16 channels = pFlac->channels;
+    drflac_uint32 maxLevels = drflac__overview_get_max_levels(pConfig);
+    pOverview->channels = channels;
+    pOverview->framesPerPoint = (pConfig != NULL && pConfig->framesPerPoint != 0) ? pConfig->framesPerPoint : DRFLAC_OVERVIEW_DEFAULT_FRAMES_PER_POINT;
+
+    // The total sample count is optional in FLAC so level 0 grows as needed. It only needs to be resized once when it's known.
+    drflac_uint64 capacityInFrames = (pFlac->totalSampleCount > 0) ? pFlac->totalSampleCount / channels : (drflac_uint64)pOverview->framesPerPoint * 1024;
+
+    size_t chunkFrameCount = DRFLAC_OVERVIEW_CHUNK_SAMPLE_COUNT / channels;
+    float* pChunk = (float*)DRFLAC_MALLOC(chunkFrameCount * channels * sizeof(float));
+    drflac__overview_accumulator* pAccumulators = (drflac__overview_accumulator*)DRFLAC_MALLOC(channels * sizeof(*pAccumulators));
+    if (pChunk == NULL || pAccumulators == NULL || !drflac__overview_resize(pOverview, capacityInFrames, 1)) {
+        DRFLAC_FREE(pChunk);
+        DRFLAC_FREE(pAccumulators);
+        drflac_overview_uninit(pOverview);
+        return DRFLAC_FALSE;
+    }
+
+    drflac__overview_reset_accumulators(pAccumulators, channels);
+
+    drflac_bool32 result = DRFLAC_TRUE;
+    drflac_uint64 totalFramesRead = 0;
+    drflac_uint64 pointCount = 0;
+    drflac_uint32 framesInPoint = 0;
+    for (;;) {
+        drflac_uint64 framesRead = drflac_read_f32(pFlac, chunkFrameCount * channels, pChunk) / channels;
+        if (framesRead == 0) {
+            break;
+        }
+
+        // A chunk can span any number of points, and a point any number of chunks.
+        drflac_uint64 iFrame = 0;
+        while (iFrame < framesRead) {
+            drflac_uint32 framesToAccumulate = (drflac_uint32)drflac_min(framesRead - iFrame, pOverview->framesPerPoint - framesInPoint);
+            drflac__overview_accumulate(pAccumulators, pChunk + (iFrame * channels), framesToAccumulate, channels);
+
+            framesInPoint += framesToAccumulate;
+            iFrame += framesToAccumulate;
+
+            if (framesInPoint == pOverview->framesPerPoint) {
+                if (pointCount * pOverview->framesPerPoint >= capacityInFrames) {
+                    capacityInFrames *= 2;
+                    if (!drflac__overview_resize(pOverview, capacityInFrames, 1)) {
+                        result = DRFLAC_FALSE;
+                        break;
+                    }
+                }
+
+                drflac__overview_emit_point(pOverview->pPoints + (pointCount * channels), pAccumulators, channels, framesInPoint);
+                pointCount += 1;
+                framesInPoint = 0;
+            }
+        }
+
+        totalFramesRead += framesRead;
+        if (!result) {
+            break;
+        }
+    }
+
+    if (result && framesInPoint > 0) {
+        if (pointCount * pOverview->framesPerPoint >= capacityInFrames) {
+            result = drflac__overview_resize(pOverview, totalFramesRead, 1);
+        }
+        if (result) {
+            drflac__overview_emit_point(pOverview->pPoints + (pointCount * channels), pAccumulators, channels, framesInPoint);
+        }
+    }
+
+    DRFLAC_FREE(pChunk);
+    DRFLAC_FREE(pAccumulators);
+
+    // Now that level 0 is complete there's room for the other levels.
+    if (!result || !drflac__overview_resize(pOverview, totalFramesRead, maxLevels)) {
+        drflac_overview_uninit(pOverview);
+        return DRFLAC_FALSE;
+    }
+
+    drflac__overview_build_levels(pOverview);
+    return DRFLAC_TRUE;
+}
+
+void drflac_overview_uninit(drflac_overview* pOverview)
+{
+    if (pOverview == NULL) {
+        return;
+    }
+
+    DRFLAC_FREE(pOverview->pPoints);
+    pOverview->pPoints = NULL;
+}
+
+const drflac_overview_point* drflac_overview_get_level(const drflac_overview* pOverview, drflac_uint32 level, drflac_uint64* pPointCount)
+{
+    if (pPointCount != NULL) {
+        *pPointCount = 0;
+    }
+
+    if (pOverview == NULL || pOverview->pPoints == NULL || level >= pOverview->levelCount) {
+        return NULL;
+    }
+
+    if (pPointCount != NULL) {
+        *pPointCount = drflac__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, level);
+    }
+
+    return pOverview->pPoints + drflac__overview_get_level_offset(pOverview, level);
+}
+
+static DRFLAC_INLINE void drflac__overview_write_le(unsigned char* pData, drflac_uint64 value, int byteCount)
+{
+    for (int i = 0; i < byteCount; ++i) {
+        pData[i] = (unsigned char)(value >> (i*8));
+    }
+}
+
+static DRFLAC_INLINE drflac_uint64 drflac__overview_read_le(const unsigned char* pData, int byteCount)
+{
+    drflac_uint64 value = 0;
+    for (int i = 0; i < byteCount; ++i) {
+        value |= (drflac_uint64)pData[i] << (i*8);
+    }
+
+    return value;
+}
+
+static DRFLAC_INLINE drflac_uint16 drflac__overview_quantize(double x)
+{
+    return (drflac_uint16)(drflac_int16)drflac_clamp(x, -32768.0, 32767.0);
+}
+
+// Serialized overviews are little-endian. After a 24 byte header come the level 0 points, each of which is the minimum, maximum
+// and RMS as signed 16-bit values.
+//
+//   0  "DROV"
+//   4  Version (u16)
+//   6  Channels (u16)
+//   8  Frames per point (u32)
+//   12 Level count (u32)
+//   16 Frame count (u64)
+size_t drflac_overview_serialize(const drflac_overview* pOverview, void* pBufferOut, size_t bufferSize)
+{
+    if (pOverview == NULL || pOverview->pPoints == NULL) {
+        return 0;
+    }
+
+    drflac_uint64 pointCount = drflac__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, 0) * pOverview->channels;
+    drflac_uint64 dataSize = DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE + (pointCount * 6);
+    if (dataSize > SIZE_MAX) {
+        return 0;
+    }
+
+    if (pBufferOut == NULL) {
+        return (size_t)dataSize;
+    }
+    if (bufferSize < dataSize) {
+        return 0;
+    }
+
+    unsigned char* pRunningData = (unsigned char*)pBufferOut;
+    pRunningData[0] = 'D'; pRunningData[1] = 'R'; pRunningData[2] = 'O'; pRunningData[3] = 'V';
+    drflac__overview_write_le(pRunningData +  4, DRFLAC_OVERVIEW_SERIALIZED_VERSION, 2);
+    drflac__overview_write_le(pRunningData +  6, pOverview->channels, 2);
+    drflac__overview_write_le(pRunningData +  8, pOverview->framesPerPoint, 4);
+    drflac__overview_write_le(pRunningData + 12, pOverview->levelCount, 4);
+    drflac__overview_write_le(pRunningData + 16, pOverview->frameCount, 8);
+    pRunningData += DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE;
+
+    for (drflac_uint64 iPoint = 0; iPoint < pointCount; ++iPoint) {
+        const drflac_overview_point* pPoint = &pOverview->pPoints[iPoint];
+        drflac__overview_write_le(pRunningData + 0, drflac__overview_quantize(drflac__floor_f64(pPoint->min * 32768.0)), 2);
+        drflac__overview_write_le(pRunningData + 2, drflac__overview_quantize(drflac__ceil_f64(pPoint->max * 32768.0)), 2);
+        drflac__overview_write_le(pRunningData + 4, drflac__overview_quantize(drflac__floor_f64(pPoint->rms * 32768.0 + 0.5)), 2);
+        pRunningData += 6;
+    }
+
+    return (size_t)dataSize;
+}
+
+drflac_bool32 drflac_overview_init_serialized(drflac_overview* pOverview, const void* pData, size_t dataSize)
+{
+    if (pOverview == NULL) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_zero_memory(pOverview, sizeof(*pOverview));
+
+    const unsigned char* pRunningData = (const unsigned char*)pData;
+    if (pRunningData == NULL || dataSize < DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE || memcmp(pRunningData, "DROV", 4) != 0 || drflac__overview_read_le(pRunningData + 4, 2) != DRFLAC_OVERVIEW_SERIALIZED_VERSION) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_uint16 channels       = (drflac_uint16)drflac__overview_read_le(pRunningData +  6, 2);
+    drflac_uint32 framesPerPoint = (drflac_uint32)drflac__overview_read_le(pRunningData +  8, 4);
+    drflac_uint32 levelCount     = (drflac_uint32)drflac__overview_read_le(pRunningData + 12, 4);
+    drflac_uint64 frameCount     =                drflac__overview_read_le(pRunningData + 16, 8);
+    pRunningData += DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE;
+
+    if (channels == 0 || framesPerPoint == 0 || levelCount == 0 || levelCount > DRFLAC_OVERVIEW_MAX_LEVELS) {
+        return DRFLAC_FALSE;
+    }
+
+    drflac_uint64 pointCount = drflac__overview_get_point_count(frameCount, framesPerPoint, 0);
+    if (pointCount > (dataSize - DRFLAC_OVERVIEW_SERIALIZED_HEADER_SIZE) / 6 / channels) {
+        return DRFLAC_FALSE;    // Truncated.
+    }
+
+    pOverview->channels = channels;
+    pOverview->framesPerPoint = framesPerPoint;
+    if (!drflac__overview_resize(pOverview, frameCount, levelCount) || pOverview->levelCount != levelCount) {
+        drflac_overview_uninit(pOverview);
+        return DRFLAC_FALSE;
+    }
+
+    for (drflac_uint64 iPoint = 0; iPoint < pointCount * channels; ++iPoint) {
+        drflac_overview_point* pPoint = &pOverview->pPoints[iPoint];
+        pPoint->min = (drflac_int16)drflac__overview_read_le(pRunningData + 0, 2) / 32768.0f;
+        pPoint->max = (drflac_int16)drflac__overview_read_le(pRunningData + 2, 2) / 32768.0f;
+        pPoint->rms = (drflac_int16)drflac__overview_read_le(pRunningData + 4, 2) / 32768.0f;
+        pRunningData += 6;
+    }
+
+    drflac__overview_build_levels(pOverview);
+    return DRFLAC_TRUE;
+}
+
+
+
 
 void drflac_init_vorbis_comment_iterator(drflac_vorbis_comment_iterator* pIter, drflac_uint32 commentCount, const char* pComments)
 {
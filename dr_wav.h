@@ -63,17 +63,94 @@
 // dr_wav has seamless support the Sony Wave64 format. The decoder will automatically detect it and it should Just Work
 // without any manual intervention.
 //
+// AIFF and AIFC files are detected the same way. Uncompressed big-endian and little-endian ("sowt") PCM, 32- and 64-bit
+// floating point, A-law and u-law are supported. drwav_read_s16(), drwav_read_f32() and drwav_read_s32() convert the samples
+// as usual, but drwav_read() and drwav_read_raw() return them exactly as they are stored in the file. AIFF files can not be
+// written.
+//
+// To serve many readers from one file, parse it once into a drwav_source and give each reader its own drwav_cursor. The
+// cursors share the source's file handle but read at explicit positions, so they can be used on different threads without
+// any locking:
+//
+//     drwav_source source;
+//     drwav_source_init_file(&source, "my_song.wav");
+//
+//     drwav_cursor cursor;
+//     drwav_cursor_init(&cursor, &source);
+//     drwav_seek_to_sample(&cursor.wav, firstSample);
+//     drwav_read_f32(&cursor.wav, samplesToRead, pSamples);
+//
+//     ...
+//
+//     drwav_cursor_uninit(&cursor);
+//     drwav_source_uninit(&source);   // <-- After every cursor has been uninitialized.
+//
+//
+// dr_wav can also write WAV files. Describe the format of the audio data with a drwav_data_format object and then use
+// drwav_init_write(), drwav_init_file_write() or drwav_init_memory_write():
+//
+//     drwav_data_format format;
+//     format.container = drwav_container_riff;     // <-- drwav_container_riff = normal WAV files, drwav_container_w64 = Sony Wave64.
+//     format.format = DR_WAVE_FORMAT_PCM;          // <-- Any of the DR_WAVE_FORMAT_* codes, except DR_WAVE_FORMAT_EXTENSIBLE.
+//     format.channels = 2;
+//     format.sampleRate = 44100;
+//     format.bitsPerSample = 16;
+//     drwav_init_file_write(&wav, "my_song.wav", &format);
+//
+//     ...
+//
+//     drwav_uint64 samplesWritten = drwav_write(&wav, sampleCount, pSamples);
+//
+//     ...
+//
+//     drwav_uninit(&wav);  // <-- This updates the sizes in the header so it must always be called.
+//
+// RIFF files that grow past 4GB are automatically converted to RF64 when the writer is uninitialized.
+//
+// To write Microsoft ADPCM or IMA ADPCM, set the format to DR_WAVE_FORMAT_ADPCM or DR_WAVE_FORMAT_DVI_ADPCM, the channel count
+// to 1 or 2 and bitsPerSample to 4. drwav_write() then takes signed 16-bit PCM samples and encodes them a block at a time. Call
+// drwav_set_adpcm_config() before the first write to change the block size, spread the encoding of blocks across multiple
+// threads, or have every Microsoft ADPCM predictor tried for each block:
+//
+//     drwav_adpcm_config config;
+//     config.blockAlign = 0;                       // <-- 0 = the usual size for the sample rate.
+//     config.threadCount = 0;                      // <-- 0 = one thread per processor.
+//     config.exhaustiveSearch = DRWAV_TRUE;
+//     drwav_set_adpcm_config(&wav, &config);
+//
 //
 //
 // OPTIONS
 // #define these options before including this file.
 //
 // #define DR_WAV_NO_CONVERSION_API
-//   Disables conversion APIs such as drwav_read_f32() and drwav_s16_to_f32().
+//   Disables conversion APIs such as drwav_read_f32() and drwav_s16_to_f32(). This also disables writing ADPCM files.
 //
 // #define DR_WAV_NO_STDIO
 //   Disables drwav_open_file().
 //
+// #define DR_WAV_NO_MMAP
+//   Disables drwav_init_file_mmap() and drwav_open_file_mmap(). These are only available on Windows and POSIX systems.
+//
+// #define DR_WAV_NO_THREADS
+//   Disables the worker threads used by drwav_open_and_read_*_parallel() and the ADPCM encoder, which will then do everything
+//   on the calling thread. On POSIX systems the threads are created with pthreads which may require linking with -pthread.
+//
+// #define DR_WAV_CONVERSION_BUFFER_SIZE <bytes>
+//   The size of the stack buffer used by drwav_read_s16(), drwav_read_f32() and drwav_read_s32() when the output samples are
+//   narrower than the samples in the file, such as 24-bit PCM to s16 or 64-bit floating point to f32. Defaults to 16384.
+//   Widening conversions read straight into the output buffer and convert in place, so do not use it.
+//
+// #define DR_WAV_NO_SIMD
+//   Disables SIMD optimizations (SSE on x86/x64 architectures) in the sample format conversion routines. Use this if you
+//   are having compatibility issues with your compiler.
+//
+// #define DR_WAV_UNBUFFERED_FILE_WRITES
+//   Disables stdio's buffering for files opened with drwav_init_file_write() and drwav_open_file_write(). Each call to
+//   drwav_write() is then passed straight to the operating system from the application's buffer, without first being
+//   copied into the FILE object's internal buffer. Use this when writing large blocks of audio data at a time. Small
+//   writes will be slower because each one becomes a separate system call.
+//
 //
 //
 // QUICK NOTES
@@ -146,7 +223,9 @@ typedef enum
 typedef enum
 {
     drwav_container_riff,
-    drwav_container_w64
+    drwav_container_w64,
+    drwav_container_rf64,
+    drwav_container_aiff    // AIFF and AIFC. Only supported for reading.
 } drwav_container;
 
 // Callback for when data is read. Return value is the number of bytes actually read.
@@ -173,6 +252,35 @@ typedef size_t (* drwav_read_proc)(void* pUserData, void* pBufferOut, size_t byt
 // will be either drwav_seek_origin_start or drwav_seek_origin_current.
 typedef drwav_bool32 (* drwav_seek_proc)(void* pUserData, int offset, drwav_seek_origin origin);
 
+// The same as drwav_seek_proc, but with a 64-bit offset so that any position in a large file can be reached in one call. Used
+// with drwav_init_seek64().
+typedef drwav_bool32 (* drwav_seek64_proc)(void* pUserData, drwav_int64 offset, drwav_seek_origin origin);
+
+// Callback for when data is written. Return value is the number of bytes actually written.
+//
+// pUserData    [in] The user data that was passed to drwav_init_write(), drwav_open_write() and family.
+// pData        [in] A pointer to the data to write.
+// bytesToWrite [in] The number of bytes to write.
+//
+// Returns the number of bytes actually written.
+//
+// If the return value differs from bytesToWrite, it indicates an error.
+typedef size_t (* drwav_write_proc)(void* pUserData, const void* pData, size_t bytesToWrite);
+
+// Callback for when data is read from a specific position. This is used by drwav_source.
+//
+// pUserData   [in]  The user data that was passed to drwav_source_init().
+// offset      [in]  The position in the stream of the first byte to read.
+// pBufferOut  [out] The output buffer.
+// bytesToRead [in]  The number of bytes to read.
+//
+// Returns the number of bytes actually read.
+//
+// A return value of less than bytesToRead indicates the end of the stream. This will be called from every thread that reads
+// from a cursor of the source, possibly at the same time, so it must not depend on a shared read position. pread() is an
+// example of a function that works this way.
+typedef size_t (* drwav_read_at_proc)(void* pUserData, drwav_uint64 offset, void* pBufferOut, size_t bytesToRead);
+
 // Structure for internal use. Only used for loaders opened with drwav_open_memory.
 typedef struct
 {
@@ -181,6 +289,68 @@ typedef struct
     size_t currentReadPos;
 } drwav__memory_stream;
 
+// Structure for internal use. Only used for writers opened with drwav_open_memory_write.
+typedef struct
+{
+    void** ppData;
+    size_t* pDataSize;
+    size_t dataSize;
+    size_t dataCapacity;
+    size_t currentWritePos;
+} drwav__memory_stream_write;
+
+typedef struct
+{
+    drwav_container container;  // RIFF, W64 or RF64. RIFF files are converted to RF64 automatically if they grow too big.
+    drwav_uint32 format;        // DR_WAVE_FORMAT_*, except DR_WAVE_FORMAT_EXTENSIBLE. DR_WAVE_FORMAT_ADPCM and DR_WAVE_FORMAT_DVI_ADPCM are encoded by drwav_write().
+    drwav_uint32 channels;
+    drwav_uint32 sampleRate;
+    drwav_uint32 bitsPerSample;
+} drwav_data_format;
+
+// Settings for writers of Microsoft ADPCM and IMA ADPCM streams. See drwav_set_adpcm_config().
+typedef struct
+{
+    // The size of each block in bytes. Smaller blocks spend more space on block headers but need less memory to decode. Set to 0
+    // for 256 bytes per channel for every 11025 Hz of sample rate, which is what most encoders use. IMA ADPCM blocks must be a
+    // multiple of 4 bytes per channel.
+    drwav_uint16 blockAlign;
+
+    // The number of threads to encode blocks on. Set to 0 for one thread per processor. Until drwav_set_adpcm_config() is called
+    // this is 1, which encodes everything on the calling thread. With more than one thread, samples are held back until there are
+    // 64 blocks for each thread so that small writes don't start and stop threads for a block or two at a time. That takes 64
+    // blocks of 16-bit samples per thread of memory.
+    unsigned int threadCount;
+
+    // Microsoft ADPCM only. When set, every block is encoded with each of the seven predictors and the one that ends up closest to
+    // the input is kept. Otherwise the predictor is chosen from the input samples alone, which is much faster but not always the
+    // best choice.
+    drwav_bool32 exhaustiveSearch;
+} drwav_adpcm_config;
+
+// How samples are rounded when converting them to signed 16-bit PCM throws away bits. See drwav_dither_init().
+typedef enum
+{
+    drwav_dither_mode_none = 0,         // The extra bits are truncated. This is the default.
+    drwav_dither_mode_triangle,         // Triangular (TPDF) dither of up to 1 LSB is added before rounding to the nearest value.
+    drwav_dither_mode_triangle_shaped   // The same, with first-order noise shaping which moves the noise up towards high frequencies.
+} drwav_dither_mode;
+
+// The maximum number of channels that can be noise shaped.
+#define DRWAV_MAX_DITHER_CHANNELS   32
+
+// The state of a dithered conversion to 16-bit samples. The noise shaping error is tracked per channel, so the samples of a
+// stream must be converted in order, although they can be split across any number of calls.
+typedef struct
+{
+    drwav_dither_mode mode;
+    drwav_uint32 channels;
+    drwav_uint32 iChannel;                          // The channel of the next sample.
+    drwav_uint32 iLane;                             // The random number generator lane to use for the next sample.
+    drwav_uint32 lanes[4];                          // Four xorshift generators which are stepped together by the SIMD code paths.
+    double error[DRWAV_MAX_DITHER_CHANNELS];        // The quantization error of the previous sample of each channel.
+} drwav_dither;
+
 typedef struct
 {
     // The format tag exactly as specified in the wave file's "fmt" chunk. This can be used by applications
@@ -217,6 +387,105 @@ typedef struct
     drwav_uint8 subFormat[16];
 } drwav_fmt;
 
+// Describes a chunk found by drwav_index_chunks().
+typedef struct
+{
+    // The chunk's ID. For RIFF and RF64 files this is the FOURCC in the first 4 bytes with the rest set to 0. For W64 files this is
+    // the full GUID.
+    drwav_uint8 id[16];
+
+    // The position in the stream of the first byte of the chunk's data, just past the chunk header.
+    drwav_uint64 dataPos;
+
+    // The size in bytes of the chunk's data, not including the chunk header or padding.
+    drwav_uint64 sizeInBytes;
+} drwav_chunk_info;
+
+// A loop from the "smpl" chunk. Positions are in PCM frames.
+typedef struct
+{
+    drwav_uint32 cuePointId;
+    drwav_uint32 type;          // 0 = forward, 1 = ping-pong, 2 = backward.
+    drwav_uint32 start;
+    drwav_uint32 end;           // Inclusive.
+    drwav_uint32 fraction;
+    drwav_uint32 playCount;     // 0 = infinite.
+} drwav_smpl_loop;
+
+// The fixed part of the "smpl" chunk.
+typedef struct
+{
+    drwav_uint32 manufacturer;
+    drwav_uint32 product;
+    drwav_uint32 samplePeriod;
+    drwav_uint32 midiUnityNote;
+    drwav_uint32 midiPitchFraction;
+    drwav_uint32 smpteFormat;
+    drwav_uint32 smpteOffset;
+    drwav_uint32 loopCount;     // The number of loops in the file, which may be more than were retrieved.
+    drwav_uint32 samplerDataSize;
+} drwav_smpl;
+
+// A point from the "cue " chunk.
+typedef struct
+{
+    drwav_uint32 id;
+    drwav_uint32 position;
+    drwav_uint8  dataChunkId[4];
+    drwav_uint32 chunkStart;
+    drwav_uint32 blockStart;
+    drwav_uint32 sampleOffset;  // The position of the point in PCM frames.
+} drwav_cue_point;
+
+// The fixed part of the Broadcast Wave "bext" chunk. Strings are null terminated.
+typedef struct
+{
+    char description[257];
+    char originator[33];
+    char originatorReference[33];
+    char originationDate[11];   // yyyy:mm:dd
+    char originationTime[9];    // hh:mm:ss
+    drwav_uint64 timeReference; // The number of samples since midnight.
+    drwav_uint16 version;
+    drwav_uint8  umid[64];      // Version 1 and above.
+    drwav_int16  loudnessValue; // Version 2 and above. Loudness values are in hundredths of a unit.
+    drwav_int16  loudnessRange;
+    drwav_int16  maxTruePeakLevel;
+    drwav_int16  maxMomentaryLoudness;
+    drwav_int16  maxShortTermLoudness;
+    drwav_uint64 codingHistorySize;
+} drwav_bext;
+
+// Parameters for drwav_read_f32_ex().
+typedef struct
+{
+    // The number of channels in each output frame. Set to 0 to use the channel count of the file.
+    drwav_uint16 outputChannels;
+
+    // Row-major matrix of <outputChannels> rows by <channels> columns, where <channels> is the channel count of the file. Each
+    // output channel is the weighted sum of the input channels in its row. When NULL, input channels map straight through to the
+    // output channel of the same index and any extra output channels are silent.
+    const float* pMatrix;
+
+    // Applied to every output sample after mixing. Set to 0 to leave the level unchanged, the same as a gain of 1, so that a
+    // zero-initialized drwav_mix_params is a plain passthrough. Silence can be had with a matrix of zeros.
+    float gain;
+} drwav_mix_params;
+
+// A run of PCM frames for drwav_read_f32_at_batch().
+typedef struct
+{
+    drwav_uint64 frameIndex;
+    drwav_uint64 frameCount;
+
+    // Must have room for <frameCount> frames. The buffers of different windows must not overlap.
+    float* pFramesOut;
+
+    // Set by drwav_read_f32_at_batch() to the number of frames actually read, which is less than <frameCount> when the window
+    // runs past the end of the file.
+    drwav_uint64 framesRead;
+} drwav_read_window;
+
 typedef struct
 {
     // A pointer to the function to call when more data is needed.
@@ -225,11 +494,17 @@ typedef struct
     // A pointer to the function to call when the wav file needs to be seeked.
     drwav_seek_proc onSeek;
 
+    // The 64-bit version of onSeek. When set, it is used instead of onSeek.
+    drwav_seek64_proc onSeek64;
+
+    // A pointer to the function to call when data needs to be written. Only used when the drwav object is opened in write mode.
+    drwav_write_proc onWrite;
+
     // The user data to pass to callbacks.
     void* pUserData;
 
 
-    // Whether or not the WAV file is formatted as a standard RIFF file or W64.
+    // Whether or not the WAV file is formatted as a standard RIFF file, W64, RF64 or AIFF.
     drwav_container container;
 
 
@@ -266,8 +541,27 @@ typedef struct
     drwav_uint64 bytesRemaining;
 
 
+    // AIFF specific data. Multi-byte samples are big-endian unless the compression type is "sowt", and 8-bit PCM samples are
+    // signed. The conversion APIs such as drwav_read_f32() take care of this, but drwav_read() and drwav_read_raw() return
+    // samples exactly as they are stored in the file. drwav_map_frames() fails for such files.
+    struct
+    {
+        drwav_bool8 isBigEndian;
+        drwav_bool8 isSigned8Bit;
+    } aiff;
+
+
     // A hack to avoid a DRWAV_MALLOC() when opening a decoder with drwav_open_memory().
     drwav__memory_stream memoryStream;
+    drwav__memory_stream_write memoryStreamWrite;
+
+    // Whether or not memoryStream refers to a file mapped with drwav_init_file_mmap(). The mapping is released in drwav_uninit().
+    drwav_bool32 isMemoryMapped;
+
+
+    // Every chunk in the file, in the order they appear. This is empty until drwav_index_chunks() is called.
+    drwav_chunk_info* pChunks;
+    drwav_uint32 chunkCount;
 
 
     // Generic data for compressed formats. This data is shared across all block-compressed formats.
@@ -296,8 +590,92 @@ typedef struct
         drwav_int32  cachedSamples[16]; // Samples are stored in this cache during decoding.
         drwav_uint32 cachedSampleCount;
     } ima;
+
+    // ADPCM encoder state. Only used when the drwav object is opened in write mode with a compressed format.
+    struct
+    {
+        drwav_int16* pPendingSamples;   // Samples that haven't been encoded yet. Has room for <pendingBlockCapacity> blocks.
+        drwav_uint32 pendingSampleCount;
+        drwav_uint32 pendingBlockCapacity;  // The number of blocks collected before encoding them. More than 1 when encoding on multiple threads.
+        unsigned int threadCount;
+        drwav_bool32 exhaustiveSearch;
+    } adpcmEncoder;
+
+    // The dither used by drwav_read_s16(). See drwav_set_dither().
+    drwav_dither dither;
 } drwav;
 
+// A file that has been parsed once and can then be read by any number of drwav_cursor objects at the same time. Nothing in it
+// changes after initialization so it can be shared between threads without locking.
+typedef struct
+{
+    // The function to call when data is needed, and the user data to pass to it.
+    drwav_read_at_proc onReadAt;
+    void* pUserData;
+
+    // The parsed file. Use this for format information such as <channels>, <sampleRate> and <totalSampleCount>. It has no
+    // read position of its own, so audio data must be read through a drwav_cursor.
+    drwav wav;
+} drwav_source;
+
+// Structure for internal use. The read position of a drwav_cursor.
+typedef struct
+{
+    drwav_read_at_proc onReadAt;
+    void* pUserData;
+    drwav_uint64 readPos;
+
+    // Small reads, like those made for each ADPCM block, are served from here so they don't each cost a call to onReadAt.
+    drwav_uint64 cachePos;      // The offset of the first byte of the cache.
+    size_t cacheSize;           // The number of valid bytes in the cache.
+    drwav_uint8 cache[4096];
+} drwav__read_at_stream;
+
+// A read position in a drwav_source. Cursors do not own a file handle and only ever modify their own state, so there can be
+// thousands of them over a single source, each used on a different thread.
+typedef struct
+{
+    drwav__read_at_stream stream;
+
+    // The decoder. Pass &cursor.wav to drwav_read(), drwav_read_f32(), drwav_seek_to_sample() and the other reading APIs.
+    drwav wav;
+} drwav_cursor;
+
+// Parameters for drwav_overview_init() and drwav_overview_init_source().
+typedef struct
+{
+    // The number of PCM frames summarized by each point of the most detailed level. Set to 0 to use 256.
+    drwav_uint32 framesPerPoint;
+
+    // The maximum number of levels. Each level has half as many points as the one before it. Set to 0 to keep adding levels
+    // until one has a single point.
+    drwav_uint32 maxLevels;
+
+    // The number of threads used by drwav_overview_init_source(). Set to 0 to use one thread for each processor.
+    drwav_uint32 threadCount;
+} drwav_overview_config;
+
+// The range and loudness of one channel over a run of PCM frames.
+typedef struct
+{
+    float min;
+    float max;
+    float rms;
+} drwav_overview_point;
+
+// A min/max/RMS summary of an entire stream at several zoom levels, for drawing waveforms.
+typedef struct
+{
+    drwav_uint16 channels;
+    drwav_uint32 framesPerPoint;    // For level 0. This doubles with each level.
+    drwav_uint32 levelCount;
+    drwav_uint64 frameCount;
+
+    // The points of every level, most detailed first. Within a level there is one point per channel for each run of frames.
+    // Use drwav_overview_get_level() to find the start of a level.
+    drwav_overview_point* pPoints;
+} drwav_overview;
+
 
 // Initializes a pre-allocated drwav object.
 //
@@ -318,9 +696,37 @@ typedef struct
 // See also: drwav_init_file(), drwav_init_memory(), drwav_uninit()
 drwav_bool32 drwav_init(drwav* pWav, drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData);
 
+// The same as drwav_init(), but with a seek callback that takes a 64-bit offset.
+//
+// onSeek only takes an int, so moving more than 2GB takes several calls. With a 64-bit callback every seek is a single call,
+// which matters for large W64 and RF64 files. drwav_init_file() and drwav_init_memory() already use one internally.
+drwav_bool32 drwav_init_seek64(drwav* pWav, drwav_read_proc onRead, drwav_seek64_proc onSeek64, void* pUserData);
+
+// Initializes a pre-allocated drwav object for writing.
+//
+// pFormat   [in]           A pointer to the object describing the format of the audio data to write.
+// onWrite   [in]           The function to call when data needs to be written.
+// onSeek    [in]           The function to call when the write position needs to move.
+// pUserData [in, optional] A pointer to application defined data that will be passed to onWrite and onSeek.
+//
+// Returns true if successful; false otherwise.
+//
+// Close the writer with drwav_uninit(). The sizes in the header are not known until the last sample has been written, so
+// drwav_uninit() seeks back to the start of the stream and updates them. If a RIFF file has grown beyond 4GB by then it is
+// converted to RF64. Space for the RF64 header is reserved by a JUNK chunk at the start of every RIFF file for this reason.
+//
+// Streams with more than 2 channels or more than 16 bits per sample are written as WAVE_FORMAT_EXTENSIBLE, with <format> as the
+// sub-format and the default speaker layout for the channel count. Every format other than PCM also gets a "fact" chunk.
+//
+// This is the lowest level function for initializing a WAV file for writing. You can also use drwav_init_file_write() and
+// drwav_init_memory_write() to write to a file or to a block of memory respectively.
+//
+// See also: drwav_init_file_write(), drwav_init_memory_write(), drwav_uninit()
+drwav_bool32 drwav_init_write(drwav* pWav, const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData);
+
 // Uninitializes the given drwav object.
 //
-// Use this only for objects initialized with drwav_init().
+// Use this only for objects initialized with drwav_init() or drwav_init_write().
 void drwav_uninit(drwav* pWav);
 
 
@@ -343,9 +749,24 @@ void drwav_uninit(drwav* pWav);
 // See also: drwav_open_file(), drwav_open_memory(), drwav_close()
 drwav* drwav_open(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData);
 
+// The same as drwav_open(), but with a seek callback that takes a 64-bit offset. See drwav_init_seek64().
+drwav* drwav_open_seek64(drwav_read_proc onRead, drwav_seek64_proc onSeek64, void* pUserData);
+
+// Opens a wav file for writing using the given callbacks.
+//
+// Returns null on error.
+//
+// Close the writer with drwav_close().
+//
+// This is different from drwav_init_write() in that it will allocate the drwav object for you via DRWAV_MALLOC() before
+// initializing it.
+//
+// See also: drwav_open_file_write(), drwav_open_memory_write(), drwav_close()
+drwav* drwav_open_write(const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData);
+
 // Uninitializes and deletes the the given drwav object.
 //
-// Use this only for objects created with drwav_open().
+// Use this only for objects created with drwav_open() or drwav_open_write().
 void drwav_close(drwav* pWav);
 
 
@@ -377,6 +798,96 @@ drwav_uint64 drwav_read(drwav* pWav, drwav_uint64 samplesToRead, void* pBufferOu
 // Returns true if successful; false otherwise.
 drwav_bool32 drwav_seek_to_sample(drwav* pWav, drwav_uint64 sample);
 
+// Retrieves a pointer to the raw audio data of a range of PCM frames without copying it.
+//
+// pWav       [in]  The loader.
+// firstFrame [in]  The index of the first PCM frame to retrieve. A PCM frame is one sample for each channel.
+// frameCount [in]  The number of PCM frames to retrieve.
+// ppFrames   [out] Receives a pointer to the interleaved data of the first frame.
+//
+// Returns the number of frames the pointer refers to. This will be less than frameCount if the range goes past the end of the
+// data. Returns 0 if the data cannot be accessed directly.
+//
+// This only works for loaders initialized with drwav_init_file_mmap() and drwav_init_memory() and their drwav_open_*()
+// equivalents, and only for uncompressed formats. The data is in the format described by the loader's fmt: unsigned if 8-bit,
+// signed and in native byte order otherwise. Data that is stored any other way cannot be used in place, so this fails for
+// big-endian and signed 8-bit AIFF files, and on big-endian architectures for every format wider than 8 bits.
+//
+// The pointer remains valid until the loader is uninitialized. This does not move the read position used by drwav_read().
+drwav_uint64 drwav_map_frames(drwav* pWav, drwav_uint64 firstFrame, drwav_uint64 frameCount, const void** ppFrames);
+
+
+// Builds an index of every chunk in the file.
+//
+// drwav_init() stops at the "data" chunk so anything after it, such as loop points and markers, is not seen. This walks the chunk
+// headers of the whole file, seeking past the audio data rather than reading it, and stores the position and size of each chunk
+// in pWav->pChunks. The index is freed by drwav_uninit().
+//
+// The read position is left where it was. Returns true if successful; false otherwise.
+//
+// The metadata functions below call this automatically if it hasn't already been done.
+drwav_bool32 drwav_index_chunks(drwav* pWav);
+
+// Finds the first chunk with the given FOURCC, such as "smpl". For W64 files this matches the GUID built from the FOURCC in
+// the same way as the "fmt " and "data" GUIDs.
+//
+// Returns NULL if there is no such chunk.
+const drwav_chunk_info* drwav_find_chunk(drwav* pWav, const char* fourcc);
+
+// Reads the data of a chunk returned by drwav_find_chunk() or taken from pWav->pChunks.
+//
+// Returns the number of bytes read, which will be at most the size of the chunk. The read position is left where it was.
+size_t drwav_read_chunk(drwav* pWav, const drwav_chunk_info* pChunk, void* pBufferOut, size_t bufferSize);
+
+// Reads the "smpl" chunk and up to <maxLoops> of its loops. <pLoops> can be NULL if <maxLoops> is 0.
+//
+// Returns false if there is no "smpl" chunk.
+drwav_bool32 drwav_read_smpl(drwav* pWav, drwav_smpl* pSmpl, drwav_smpl_loop* pLoops, drwav_uint32 maxLoops);
+
+// Reads up to <maxPoints> points from the "cue " chunk. <pPoints> can be NULL if <maxPoints> is 0.
+//
+// Returns the number of points in the file, which may be more than <maxPoints>. Returns 0 if there is no "cue " chunk.
+drwav_uint32 drwav_read_cue_points(drwav* pWav, drwav_cue_point* pPoints, drwav_uint32 maxPoints);
+
+// Retrieves a string from the "LIST" chunk of type "INFO", such as "INAM" for the title or "IART" for the artist.
+//
+// The string is always null terminated and is truncated if it doesn't fit in the buffer. Returns the length of the string in the
+// file, not including the null terminator, or 0 if there is no such string.
+size_t drwav_read_info_string(drwav* pWav, const char* id, char* pBufferOut, size_t bufferSize);
+
+// Reads the fixed part of the Broadcast Wave "bext" chunk. The coding history that follows it can be read with drwav_read_chunk().
+//
+// Returns false if there is no "bext" chunk.
+drwav_bool32 drwav_read_bext(drwav* pWav, drwav_bext* pBext);
+
+
+// Writes raw audio data.
+//
+// Returns the number of bytes actually written. If this differs from bytesToWrite, it indicates an error.
+size_t drwav_write_raw(drwav* pWav, size_t bytesToWrite, const void* pData);
+
+// Writes audio data based on sample counts.
+//
+// Returns the number of samples written.
+//
+// The data is passed straight to the onWrite callback without being copied, so it must already be in the format that was
+// specified when the writer was initialized.
+//
+// The exception is Microsoft ADPCM and IMA ADPCM, where <pData> is signed 16-bit PCM. Samples are encoded as soon as they make
+// up a whole block, or a whole batch of blocks when encoding on multiple threads (see drwav_adpcm_config), and the rest are kept
+// until the next call. drwav_uninit() pads the last block with silence.
+drwav_uint64 drwav_write(drwav* pWav, drwav_uint64 samplesToWrite, const void* pData);
+
+#ifndef DR_WAV_NO_CONVERSION_API
+// Changes the settings of an ADPCM writer.
+//
+// The block size is stored in the header, so it can only be changed before the first call to drwav_write(). The other settings
+// can be changed at any time.
+//
+// Returns false if the writer isn't writing a compressed format, or if the block size is invalid or can no longer be changed.
+drwav_bool32 drwav_set_adpcm_config(drwav* pWav, const drwav_adpcm_config* pConfig);
+#endif
+
 
 
 //// Convertion Utilities ////
@@ -387,6 +898,8 @@ drwav_bool32 drwav_seek_to_sample(drwav* pWav, drwav_uint64 sample);
 // Returns the number of samples actually read.
 //
 // If the return value is less than <samplesToRead> it means the end of the file has been reached.
+//
+// Formats with more than 16 bits per sample are truncated unless a dither has been set with drwav_set_dither().
 drwav_uint64 drwav_read_s16(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut);
 
 // Low-level function for converting unsigned 8-bit PCM samples to signed 16-bit PCM samples.
@@ -404,6 +917,30 @@ void drwav_f32_to_s16(drwav_int16* pOut, const float* pIn, size_t sampleCount);
 // Low-level function for converting IEEE 64-bit floating point samples to signed 16-bit PCM samples.
 void drwav_f64_to_s16(drwav_int16* pOut, const double* pIn, size_t sampleCount);
 
+// Initializes the state of a dithered conversion to signed 16-bit PCM for a stream with the given number of channels. The
+// same <seed> always produces the same output.
+//
+// Returns false if <channels> is 0, or if noise shaping is requested for more than DRWAV_MAX_DITHER_CHANNELS channels.
+drwav_bool32 drwav_dither_init(drwav_dither* pDither, drwav_dither_mode mode, drwav_uint32 channels, drwav_uint32 seed);
+
+// Sets the dither used by drwav_read_s16() for formats with more than 16 bits per sample. Every other format converts to 16 bits
+// without any loss and is never dithered.
+//
+// Returns false if the mode can't be used with the channel count of the file.
+drwav_bool32 drwav_set_dither(drwav* pWav, drwav_dither_mode mode);
+
+// Same as drwav_read_s16(), except dithered with <pDither> instead of the dither set with drwav_set_dither(). <pDither> is
+// updated so it can be passed to the next call. A NULL <pDither> truncates.
+drwav_uint64 drwav_read_s16_dithered(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut, drwav_dither* pDither);
+
+// Same as drwav_s24_to_s16(), drwav_s32_to_s16(), drwav_f32_to_s16() and drwav_f64_to_s16(), except dithered with <pDither>. The
+// dither is added while converting so it doesn't need a separate pass over the output. A NULL <pDither> behaves the same as
+// drwav_dither_mode_none.
+void drwav_s24_to_s16_dithered(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount, drwav_dither* pDither);
+void drwav_s32_to_s16_dithered(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount, drwav_dither* pDither);
+void drwav_f32_to_s16_dithered(drwav_int16* pOut, const float* pIn, size_t sampleCount, drwav_dither* pDither);
+void drwav_f64_to_s16_dithered(drwav_int16* pOut, const double* pIn, size_t sampleCount, drwav_dither* pDither);
+
 // Low-level function for converting A-law samples to signed 16-bit PCM samples.
 void drwav_alaw_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount);
 
@@ -468,6 +1005,125 @@ void drwav_alaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleC
 // Low-level function for converting u-law samples to signed 32-bit PCM samples.
 void drwav_mulaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount);
 
+
+// Reads a chunk of audio data, converts it to IEEE 32-bit floating point samples and deinterleaves it into one buffer
+// per channel.
+//
+// <ppChannelsOut> is an array of <channels> pointers, each of which must have room for <framesToRead> samples. Unlike
+// drwav_read_f32(), this is specified in PCM frames rather than samples.
+//
+// Returns the number of PCM frames actually read. Streams with more than 1024 channels are not supported and will return 0.
+//
+// If the return value is less than <framesToRead> it means the end of the file has been reached.
+drwav_uint64 drwav_read_f32_planar(drwav* pWav, drwav_uint64 framesToRead, float** ppChannelsOut);
+
+// Reads a chunk of audio data, converts it to signed 16-bit PCM samples and deinterleaves it into one buffer per channel.
+//
+// See drwav_read_f32_planar() for details.
+drwav_uint64 drwav_read_s16_planar(drwav* pWav, drwav_uint64 framesToRead, drwav_int16** ppChannelsOut);
+
+// Reads a chunk of audio data, converts it to IEEE 32-bit floating point samples, remixes it through the channel matrix in
+// <pMix> and applies its gain, all in a single pass.
+//
+// <pFramesOut> must have room for <framesToRead> frames of <pMix->outputChannels> channels each. When <pMix> is NULL this is
+// equivalent to drwav_read_f32(), but is specified in PCM frames rather than samples.
+//
+// Returns the number of PCM frames actually read. Streams with more than 1024 channels are not supported and will return 0.
+//
+// If the return value is less than <framesToRead> it means the end of the file has been reached.
+drwav_uint64 drwav_read_f32_ex(drwav* pWav, drwav_uint64 framesToRead, float* pFramesOut, const drwav_mix_params* pMix);
+
+// Reads <frameCount> PCM frames starting at <frameIndex> and converts them to IEEE 32-bit floating point samples.
+//
+// This is the same as drwav_seek_to_sample() followed by drwav_read_f32(), except that it's specified in PCM frames and reading
+// past the end just returns fewer frames. When <pWav> is the decoder of a drwav_cursor and the format is uncompressed there is
+// no seek at all - the frames are read straight from their position in the file.
+//
+// Returns the number of PCM frames actually read. The read position is left at the end of the frames that were read.
+drwav_uint64 drwav_read_f32_at(drwav* pWav, drwav_uint64 frameIndex, drwav_uint64 frameCount, float* pFramesOut);
+
+// Reads a set of windows with drwav_read_f32_at().
+//
+// The windows are read in order of position rather than the order they are given in, so the stream only ever moves forward.
+// Where windows overlap, the shared frames are read once and copied. For compressed formats this also means that windows
+// falling in the same block decode that block once.
+//
+// Returns DRWAV_TRUE if successful; DRWAV_FALSE if memory could not be allocated, in which case no windows are read. The number
+// of frames read into each window is stored in its <framesRead> member.
+drwav_bool32 drwav_read_f32_at_batch(drwav* pWav, drwav_read_window* pWindows, size_t windowCount);
+
+#endif  //DR_WAV_NO_CONVERSION_API
+
+
+//// Shared Sources ////
+
+// Parses the header of a file that is read with positional reads so it can be shared between cursors.
+//
+// onReadAt  [in]           The function to call when data needs to be read from the client.
+// pUserData [in, optional] A pointer to application defined data that will be passed to onReadAt.
+//
+// Returns true if successful; false otherwise.
+//
+// The header is read once here. Audio data is read with a drwav_cursor, each of which has its own read position and decoder
+// state so no locking is needed between them. Cursors must be uninitialized before the source.
+//
+// Uninitialize the source with drwav_source_uninit().
+drwav_bool32 drwav_source_init(drwav_source* pSource, drwav_read_at_proc onReadAt, void* pUserData);
+
+// Uninitializes the given source.
+void drwav_source_uninit(drwav_source* pSource);
+
+// Initializes a cursor at the first sample of the given source.
+//
+// This does not do any I/O and does not allocate memory. The cursor refers to itself, so it must not be moved in memory until
+// drwav_cursor_uninit() is called.
+//
+// Returns true if successful; false otherwise.
+drwav_bool32 drwav_cursor_init(drwav_cursor* pCursor, const drwav_source* pSource);
+
+// Uninitializes the given cursor.
+void drwav_cursor_uninit(drwav_cursor* pCursor);
+
+
+//// Waveform Overviews ////
+#ifndef DR_WAV_NO_CONVERSION_API
+
+// Builds a waveform overview of the entire stream.
+//
+// The stream is moved back to the first sample and then decoded once, a fixed-size chunk at a time, so the only memory needed
+// apart from the overview itself is a single chunk. The read position is left at the end of the stream. <pConfig> can be NULL
+// to use the defaults.
+//
+// Returns true if successful; false otherwise. Free the overview with drwav_overview_uninit().
+drwav_bool32 drwav_overview_init(drwav_overview* pOverview, drwav* pWav, const drwav_overview_config* pConfig);
+
+// Builds a waveform overview of a shared source using multiple threads.
+//
+// The most detailed level is split evenly between <pConfig->threadCount> threads, each of which reads its share through its
+// own drwav_cursor.
+drwav_bool32 drwav_overview_init_source(drwav_overview* pOverview, const drwav_source* pSource, const drwav_overview_config* pConfig);
+
+// Restores an overview that was saved with drwav_overview_serialize().
+drwav_bool32 drwav_overview_init_serialized(drwav_overview* pOverview, const void* pData, size_t dataSize);
+
+// Frees the memory of the given overview.
+void drwav_overview_uninit(drwav_overview* pOverview);
+
+// Retrieves the points of a level of an overview.
+//
+// Returns a pointer to <*pPointCount> runs of frames with <channels> points each, or NULL if <level> is out of range.
+const drwav_overview_point* drwav_overview_get_level(const drwav_overview* pOverview, drwav_uint32 level, drwav_uint64* pPointCount);
+
+// Saves an overview in a compact form.
+//
+// Only the most detailed level is stored, at 16-bit precision with the minimum rounded down and the maximum rounded up so the
+// range still covers every sample that is within the range of 16-bit PCM. The other levels are rebuilt by
+// drwav_overview_init_serialized().
+//
+// Returns the number of bytes written to <pBufferOut>, or 0 if <bufferSize> is too small. When <pBufferOut> is NULL the
+// required size is returned.
+size_t drwav_overview_serialize(const drwav_overview* pOverview, void* pBufferOut, size_t bufferSize);
+
 #endif  //DR_WAV_NO_CONVERSION_API
 
 
@@ -489,6 +1145,41 @@ drwav_bool32 drwav_init_file(drwav* pWav, const char* filename);
 // any given time.
 drwav* drwav_open_file(const char* filename);
 
+// Helper for initializing a wave file by mapping it into memory.
+//
+// The entire file is mapped read-only and read through the same code path as drwav_init_memory(), which also means that
+// drwav_map_frames() can be used to access the audio data in place. The mapping is released by drwav_uninit().
+//
+// Returns false if the file cannot be mapped, including on platforms without memory mapping support.
+drwav_bool32 drwav_init_file_mmap(drwav* pWav, const char* filename);
+
+// Helper for opening a wave file by mapping it into memory.
+//
+// The mapping is released by drwav_close().
+drwav* drwav_open_file_mmap(const char* filename);
+
+// Helper for initializing a source from a file.
+//
+// This holds a single file handle until drwav_source_uninit() is called, which is shared by every cursor of the source.
+// Data is read with pread() on POSIX systems and with positioned ReadFile() calls on Windows.
+//
+// Returns false if the file cannot be opened or parsed, including on platforms without positional reads.
+drwav_bool32 drwav_source_init_file(drwav_source* pSource, const char* filename);
+
+// Helper for initializing a wave file for writing using stdio.
+//
+// This holds the internal FILE object until drwav_uninit() is called. Keep this in mind if you're caching drwav
+// objects because the operating system may restrict the number of file handles an application can have open at
+// any given time.
+drwav_bool32 drwav_init_file_write(drwav* pWav, const char* filename, const drwav_data_format* pFormat);
+
+// Helper for opening a wave file for writing using stdio.
+//
+// This holds the internal FILE object until drwav_close() is called. Keep this in mind if you're caching drwav
+// objects because the operating system may restrict the number of file handles an application can have open at
+// any given time.
+drwav* drwav_open_file_write(const char* filename, const drwav_data_format* pFormat);
+
 #endif  //DR_WAV_NO_STDIO
 
 // Helper for initializing a file from a pre-allocated memory buffer.
@@ -507,6 +1198,22 @@ drwav_bool32 drwav_init_memory(drwav* pWav, const void* data, size_t dataSize);
 // The buffer should contain the contents of the entire wave file, not just the sample data.
 drwav* drwav_open_memory(const void* data, size_t dataSize);
 
+// Helper for initializing a writer which outputs data to a memory buffer.
+//
+// dr_wav will manage the memory allocations, however it is up to the caller to free the data with drwav_free().
+//
+// The buffer will remain allocated even after drwav_uninit() is called. Indeed, the buffer should not be
+// considered valid until after drwav_uninit() has been called anyway.
+drwav_bool32 drwav_init_memory_write(drwav* pWav, void** ppData, size_t* pDataSize, const drwav_data_format* pFormat);
+
+// Helper for opening a writer which outputs data to a memory buffer.
+//
+// dr_wav will manage the memory allocations, however it is up to the caller to free the data with drwav_free().
+//
+// The buffer will remain allocated even after drwav_close() is called. Indeed, the buffer should not be
+// considered valid until after drwav_close() has been called anyway.
+drwav* drwav_open_memory_write(void** ppData, size_t* pDataSize, const drwav_data_format* pFormat);
+
 
 
 #ifndef DR_WAV_NO_CONVERSION_API
@@ -525,10 +1232,48 @@ drwav_int32* drwav_open_and_read_file_s32(const char* filename, unsigned int* ch
 drwav_int16* drwav_open_and_read_memory_s16(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
 float* drwav_open_and_read_memory_f32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
 drwav_int32* drwav_open_and_read_memory_s32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
-#endif
 
-// Frees data that was allocated internally by dr_wav.
-void drwav_free(void* pDataReturnedByOpenAndRead);
+// Opens and decodes a wav file in a single operation using multiple threads.
+//
+// Each block of an MS-ADPCM or IMA ADPCM stream can be decoded on its own, so the blocks are split evenly between <threadCount>
+// threads which decode straight into the returned buffer. Set <threadCount> to 0 to use one thread for each processor. Other
+// formats are decoded on the calling thread in the same way as drwav_open_and_read_memory_*().
+//
+// The file versions map the file into memory with drwav_init_file_mmap(). If the file can't be mapped it is decoded on the
+// calling thread with regular reads instead.
+drwav_int16* drwav_open_and_read_memory_s16_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+float* drwav_open_and_read_memory_f32_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_int32* drwav_open_and_read_memory_s32_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+#ifndef DR_WAV_NO_STDIO
+drwav_int16* drwav_open_and_read_file_s16_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+float* drwav_open_and_read_file_f32_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_int32* drwav_open_and_read_file_s32_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+#endif
+
+// Opens and reads a wav file into a buffer provided by the application in a single operation.
+//
+// Nothing is allocated. The whole file is read with a single drwav_read_*() call, so when the format of the file matches the
+// requested format the samples are read straight into <pBufferOut> without a conversion pass.
+//
+// Returns the number of samples written to <pBufferOut>, which will be equal to <*totalSampleCount> on success. If <pBufferOut>
+// is NULL or <bufferSizeInSamples> is too small nothing is read and 0 is returned, but <*channels>, <*sampleRate> and
+// <*totalSampleCount> are still set so the required size of the buffer can be determined. Note that for the callback version
+// the stream will need to be moved back to the start before calling it again.
+drwav_uint64 drwav_open_and_read_s16_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_f32_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_s32_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+#ifndef DR_WAV_NO_STDIO
+drwav_uint64 drwav_open_and_read_file_s16_into(const char* filename, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_file_f32_into(const char* filename, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_file_s32_into(const char* filename, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+#endif
+drwav_uint64 drwav_open_and_read_memory_s16_into(const void* data, size_t dataSize, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_memory_f32_into(const void* data, size_t dataSize, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+drwav_uint64 drwav_open_and_read_memory_s32_into(const void* data, size_t dataSize, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount);
+#endif
+
+// Frees data that was allocated internally by dr_wav.
+void drwav_free(void* pDataReturnedByOpenAndRead);
 
 #ifdef __cplusplus
 }
@@ -551,6 +1296,29 @@ void drwav_free(void* pDataReturnedByOpenAndRead);
 #include <stdio.h>
 #endif
 
+// CPU architecture.
+#if defined(__x86_64__) || defined(_M_X64)
+#define DRWAV_X64
+#elif defined(__i386) || defined(_M_IX86)
+#define DRWAV_X86
+#endif
+
+// SSE2 is only used when the compiler is guaranteed to be targeting it. It's always available on x64. SSSE3 is used when the
+// compiler is targeting it, or with MSVC, which allows the intrinsics regardless and is checked with CPUID at run time.
+#if !defined(DR_WAV_NO_SIMD) && (defined(DRWAV_X64) || defined(DRWAV_X86))
+    #if defined(DRWAV_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define DRWAV_SUPPORT_SSE2
+        #include <emmintrin.h>
+    #endif
+    #if defined(DRWAV_SUPPORT_SSE2) && (defined(__SSSE3__) || (defined(_MSC_VER) && _MSC_VER >= 1500))
+        #define DRWAV_SUPPORT_SSSE3
+        #include <tmmintrin.h>
+        #if !defined(__SSSE3__)
+            #include <intrin.h>
+        #endif
+    #endif
+#endif
+
 // Standard library stuff.
 #ifndef DRWAV_ASSERT
 #include <assert.h>
@@ -676,6 +1444,32 @@ static DRWAV_INLINE drwav_uint64 drwav__bytes_to_u64(const unsigned char* data)
     }
 }
 
+static DRWAV_INLINE drwav_uint16 drwav__bytes_to_u16_be(const unsigned char* data)
+{
+    return (drwav_uint16)((data[0] << 8) | (data[1] << 0));
+}
+
+static DRWAV_INLINE drwav_uint32 drwav__bytes_to_u32_be(const unsigned char* data)
+{
+    return ((drwav_uint32)data[0] << 24) | ((drwav_uint32)data[1] << 16) | ((drwav_uint32)data[2] << 8) | ((drwav_uint32)data[3] << 0);
+}
+
+// Converts the 80-bit IEEE extended precision sample rate from an AIFF "COMM" chunk. Returns 0 if it's out of range.
+static drwav_uint32 drwav__bytes_to_sample_rate_ieee_extended(const unsigned char* data)
+{
+    if ((data[0] & 0x80) != 0) {
+        return 0;   // Negative.
+    }
+
+    int exponent = (((data[0] & 0x7F) << 8) | data[1]) - 16383;
+    if (exponent < 0 || exponent > 31) {
+        return 0;
+    }
+
+    drwav_uint64 mantissa = ((drwav_uint64)drwav__bytes_to_u32_be(data + 2) << 32) | drwav__bytes_to_u32_be(data + 6);
+    return (drwav_uint32)(mantissa >> (63 - exponent));
+}
+
 static DRWAV_INLINE void drwav__bytes_to_guid(const unsigned char* data, drwav_uint8* guid)
 {
     for (int i = 0; i < 16; ++i) {
@@ -683,6 +1477,27 @@ static DRWAV_INLINE void drwav__bytes_to_guid(const unsigned char* data, drwav_u
     }
 }
 
+static DRWAV_INLINE void drwav__u16_to_bytes(unsigned char* data, drwav_uint16 value)
+{
+    data[0] = (unsigned char)(value >> 0);
+    data[1] = (unsigned char)(value >> 8);
+}
+
+static DRWAV_INLINE void drwav__u32_to_bytes(unsigned char* data, drwav_uint32 value)
+{
+    data[0] = (unsigned char)(value >>  0);
+    data[1] = (unsigned char)(value >>  8);
+    data[2] = (unsigned char)(value >> 16);
+    data[3] = (unsigned char)(value >> 24);
+}
+
+static DRWAV_INLINE void drwav__u64_to_bytes(unsigned char* data, drwav_uint64 value)
+{
+    for (int i = 0; i < 8; ++i) {
+        data[i] = (unsigned char)(value >> (i*8));
+    }
+}
+
 
 static DRWAV_INLINE drwav_bool32 drwav__is_compressed_format_tag(drwav_uint16 formatTag)
 {
@@ -691,6 +1506,10 @@ static DRWAV_INLINE drwav_bool32 drwav__is_compressed_format_tag(drwav_uint16 fo
         formatTag == DR_WAVE_FORMAT_DVI_ADPCM;
 }
 
+// The predictors of Microsoft ADPCM. These are also written to the "fmt " chunk of Microsoft ADPCM files.
+static drwav_int32 g_drwavMSADPCMCoeff1Table[7] = { 256, 512, 0, 192, 240, 460,  392 };
+static drwav_int32 g_drwavMSADPCMCoeff2Table[7] = { 0,  -256, 0, 64,  0,  -208, -232 };
+
 
 typedef struct
 {
@@ -711,7 +1530,20 @@ typedef struct
 
 static drwav_bool32 drwav__read_chunk_header(drwav_read_proc onRead, void* pUserData, drwav_container container, drwav_uint64* pRunningBytesReadOut, drwav__chunk_header* pHeaderOut)
 {
-    if (container == drwav_container_riff) {
+    if (container == drwav_container_aiff) {   // <-- Same as RIFF, but big-endian.
+        if (onRead(pUserData, pHeaderOut->id.fourcc, 4) != 4) {
+            return DRWAV_FALSE;
+        }
+
+        unsigned char sizeInBytes[4];
+        if (onRead(pUserData, sizeInBytes, 4) != 4) {
+            return DRWAV_FALSE;
+        }
+
+        pHeaderOut->sizeInBytes = drwav__bytes_to_u32_be(sizeInBytes);
+        pHeaderOut->paddingSize = (unsigned int)(pHeaderOut->sizeInBytes % 2);
+        *pRunningBytesReadOut += 8;
+    } else if (container != drwav_container_w64) {    // <-- RF64 uses the same chunk layout as RIFF.
         if (onRead(pUserData, pHeaderOut->id.fourcc, 4) != 4) {
             return DRWAV_FALSE;
         }
@@ -736,35 +1568,58 @@ static drwav_bool32 drwav__read_chunk_header(drwav_read_proc onRead, void* pUser
 
         pHeaderOut->sizeInBytes = drwav__bytes_to_u64(sizeInBytes) - 24;    // <-- Subtract 24 because w64 includes the size of the header.
         pHeaderOut->paddingSize = (unsigned int)(pHeaderOut->sizeInBytes % 8);
-        pRunningBytesReadOut += 24;
+        *pRunningBytesReadOut += 24;
     }
 
     return DRWAV_TRUE;
 }
 
-static drwav_bool32 drwav__seek_forward(drwav_seek_proc onSeek, drwav_uint64 offset, void* pUserData)
+static drwav_bool32 drwav__seek(drwav* pWav, drwav_int64 offset, drwav_seek_origin origin)
 {
-    drwav_uint64 bytesRemainingToSeek = offset;
-    while (bytesRemainingToSeek > 0) {
-        if (bytesRemainingToSeek > 0x7FFFFFFF) {
-            if (!onSeek(pUserData, 0x7FFFFFFF, drwav_seek_origin_current)) {
-                return DRWAV_FALSE;
-            }
-            bytesRemainingToSeek -= 0x7FFFFFFF;
-        } else {
-            if (!onSeek(pUserData, (int)bytesRemainingToSeek, drwav_seek_origin_current)) {
-                return DRWAV_FALSE;
-            }
-            bytesRemainingToSeek = 0;
+    if (pWav->onSeek64 != NULL) {
+        return pWav->onSeek64(pWav->pUserData, offset, origin);
+    }
+
+    // The 32-bit callback can only move up to 2GB at a time.
+    if (origin == drwav_seek_origin_start) {
+        if (offset < 0) {
+            return DRWAV_FALSE;
+        }
+
+        int offset32 = (offset > INT_MAX) ? INT_MAX : (int)offset;
+        if (!pWav->onSeek(pWav->pUserData, offset32, drwav_seek_origin_start)) {
+            return DRWAV_FALSE;
+        }
+        offset -= offset32;
+    }
+
+    while (offset != 0) {
+        int offset32 = (offset > INT_MAX) ? INT_MAX : ((offset < -INT_MAX) ? -INT_MAX : (int)offset);
+        if (!pWav->onSeek(pWav->pUserData, offset32, drwav_seek_origin_current)) {
+            return DRWAV_FALSE;
         }
+        offset -= offset32;
     }
 
     return DRWAV_TRUE;
 }
 
+static drwav_bool32 drwav__seek_forward(drwav* pWav, drwav_uint64 offset)
+{
+    if (offset > (drwav_uint64)0x7FFFFFFFFFFFFFFF) {
+        return DRWAV_FALSE;     // <-- Can only come from a corrupt chunk size.
+    }
+
+    return drwav__seek(pWav, (drwav_int64)offset, drwav_seek_origin_current);
+}
+
 
-static drwav_bool32 drwav__read_fmt(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, drwav_container container, drwav_uint64* pRunningBytesReadOut, drwav_fmt* fmtOut)
+static drwav_bool32 drwav__read_fmt(drwav* pWav, drwav_uint64* pRunningBytesReadOut, drwav_fmt* fmtOut)
 {
+    drwav_read_proc onRead = pWav->onRead;
+    void* pUserData = pWav->pUserData;
+    drwav_container container = pWav->container;
+
     drwav__chunk_header header;
     if (!drwav__read_chunk_header(onRead, pUserData, container, pRunningBytesReadOut, &header)) {
         return DRWAV_FALSE;
@@ -772,18 +1627,18 @@ static drwav_bool32 drwav__read_fmt(drwav_read_proc onRead, drwav_seek_proc onSe
 
 
     // Skip junk chunks.
-    if ((container == drwav_container_riff && drwav__fourcc_equal(header.id.fourcc, "JUNK")) || (container == drwav_container_w64 && drwav__guid_equal(header.id.guid, drwavGUID_W64_JUNK))) {
-        if (!drwav__seek_forward(onSeek, header.sizeInBytes + header.paddingSize, pUserData)) {
+    if ((container != drwav_container_w64 && drwav__fourcc_equal(header.id.fourcc, "JUNK")) || (container == drwav_container_w64 && drwav__guid_equal(header.id.guid, drwavGUID_W64_JUNK))) {
+        if (!drwav__seek_forward(pWav, header.sizeInBytes + header.paddingSize)) {
             return DRWAV_FALSE;
         }
         *pRunningBytesReadOut += header.sizeInBytes + header.paddingSize;
 
-        return drwav__read_fmt(onRead, onSeek, pUserData, container, pRunningBytesReadOut, fmtOut);
+        return drwav__read_fmt(pWav, pRunningBytesReadOut, fmtOut);
     }
 
 
     // Validation.
-    if (container == drwav_container_riff) {
+    if (container != drwav_container_w64) {
         if (!drwav__fourcc_equal(header.id.fourcc, "fmt ")) {
             return DRWAV_FALSE;
         }
@@ -840,7 +1695,7 @@ static drwav_bool32 drwav__read_fmt(drwav_read_proc onRead, drwav_seek_proc onSe
                 fmtOut->channelMask        = drwav__bytes_to_u32(fmtext + 2);
                 drwav__bytes_to_guid(fmtext + 6, fmtOut->subFormat);
             } else {
-                if (!onSeek(pUserData, fmtOut->extendedSize, drwav_seek_origin_current)) {
+                if (!drwav__seek(pWav, fmtOut->extendedSize, drwav_seek_origin_current)) {
                     return DRWAV_FALSE;
                 }
             }
@@ -850,14 +1705,14 @@ static drwav_bool32 drwav__read_fmt(drwav_read_proc onRead, drwav_seek_proc onSe
         }
 
         // Seek past any leftover bytes. For w64 the leftover will be defined based on the chunk size.
-        if (!onSeek(pUserData, (int)(header.sizeInBytes - bytesReadSoFar), drwav_seek_origin_current)) {
+        if (!drwav__seek(pWav, (drwav_int64)(header.sizeInBytes - bytesReadSoFar), drwav_seek_origin_current)) {
             return DRWAV_FALSE;
         }
         *pRunningBytesReadOut += (header.sizeInBytes - bytesReadSoFar);
     }
 
     if (header.paddingSize > 0) {
-        if (!onSeek(pUserData, header.paddingSize, drwav_seek_origin_current)) {
+        if (!drwav__seek(pWav, header.paddingSize, drwav_seek_origin_current)) {
             return DRWAV_FALSE;
         }
         *pRunningBytesReadOut += header.paddingSize;
@@ -878,6 +1733,22 @@ static drwav_bool32 drwav__on_seek_stdio(void* pUserData, int offset, drwav_seek
     return fseek((FILE*)pUserData, offset, (origin == drwav_seek_origin_current) ? SEEK_CUR : SEEK_SET) == 0;
 }
 
+// Files are read with a 64-bit seek where the platform has one. That's _fseeki64() on Windows, and plain fseek() wherever long is
+// 64 bits.
+#if defined(_WIN32) && (!defined(_MSC_VER) || _MSC_VER >= 1400)
+#define DRWAV_HAS_SEEK64_STDIO
+static drwav_bool32 drwav__on_seek64_stdio(void* pUserData, drwav_int64 offset, drwav_seek_origin origin)
+{
+    return _fseeki64((FILE*)pUserData, offset, (origin == drwav_seek_origin_current) ? SEEK_CUR : SEEK_SET) == 0;
+}
+#elif LONG_MAX > 0x7FFFFFFF
+#define DRWAV_HAS_SEEK64_STDIO
+static drwav_bool32 drwav__on_seek64_stdio(void* pUserData, drwav_int64 offset, drwav_seek_origin origin)
+{
+    return fseek((FILE*)pUserData, (long)offset, (origin == drwav_seek_origin_current) ? SEEK_CUR : SEEK_SET) == 0;
+}
+#endif
+
 drwav_bool32 drwav_init_file(drwav* pWav, const char* filename)
 {
     FILE* pFile;
@@ -892,7 +1763,16 @@ drwav_bool32 drwav_init_file(drwav* pWav, const char* filename)
     }
 #endif
 
-    return drwav_init(pWav, drwav__on_read_stdio, drwav__on_seek_stdio, (void*)pFile);
+#ifdef DRWAV_HAS_SEEK64_STDIO
+    if (!drwav_init_seek64(pWav, drwav__on_read_stdio, drwav__on_seek64_stdio, (void*)pFile)) {
+#else
+    if (!drwav_init(pWav, drwav__on_read_stdio, drwav__on_seek_stdio, (void*)pFile)) {
+#endif
+        fclose(pFile);
+        return DRWAV_FALSE;
+    }
+
+    return DRWAV_TRUE;
 }
 
 drwav* drwav_open_file(const char* filename)
@@ -909,7 +1789,69 @@ drwav* drwav_open_file(const char* filename)
     }
 #endif
 
+#ifdef DRWAV_HAS_SEEK64_STDIO
+    drwav* pWav = drwav_open_seek64(drwav__on_read_stdio, drwav__on_seek64_stdio, (void*)pFile);
+#else
     drwav* pWav = drwav_open(drwav__on_read_stdio, drwav__on_seek_stdio, (void*)pFile);
+#endif
+    if (pWav == NULL) {
+        fclose(pFile);
+        return NULL;
+    }
+
+    return pWav;
+}
+
+
+static size_t drwav__on_write_stdio(void* pUserData, const void* pData, size_t bytesToWrite)
+{
+    return fwrite(pData, 1, bytesToWrite, (FILE*)pUserData);
+}
+
+static FILE* drwav__open_file_write(const char* filename)
+{
+    FILE* pFile;
+#if defined(_MSC_VER) && _MSC_VER >= 1400
+    if (fopen_s(&pFile, filename, "wb") != 0) {
+        return NULL;
+    }
+#else
+    pFile = fopen(filename, "wb");
+    if (pFile == NULL) {
+        return NULL;
+    }
+#endif
+
+#ifdef DR_WAV_UNBUFFERED_FILE_WRITES
+    setvbuf(pFile, NULL, _IONBF, 0);
+#endif
+
+    return pFile;
+}
+
+drwav_bool32 drwav_init_file_write(drwav* pWav, const char* filename, const drwav_data_format* pFormat)
+{
+    FILE* pFile = drwav__open_file_write(filename);
+    if (pFile == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    if (!drwav_init_write(pWav, pFormat, drwav__on_write_stdio, drwav__on_seek_stdio, (void*)pFile)) {
+        fclose(pFile);
+        return DRWAV_FALSE;
+    }
+
+    return DRWAV_TRUE;
+}
+
+drwav* drwav_open_file_write(const char* filename, const drwav_data_format* pFormat)
+{
+    FILE* pFile = drwav__open_file_write(filename);
+    if (pFile == NULL) {
+        return NULL;
+    }
+
+    drwav* pWav = drwav_open_write(pFormat, drwav__on_write_stdio, drwav__on_seek_stdio, (void*)pFile);
     if (pWav == NULL) {
         fclose(pFile);
         return NULL;
@@ -939,33 +1881,35 @@ static size_t drwav__on_read_memory(void* pUserData, void* pBufferOut, size_t by
     return bytesToRead;
 }
 
-static drwav_bool32 drwav__on_seek_memory(void* pUserData, int offset, drwav_seek_origin origin)
+static drwav_bool32 drwav__on_seek64_memory(void* pUserData, drwav_int64 offset, drwav_seek_origin origin)
 {
     drwav__memory_stream* memory = (drwav__memory_stream*)pUserData;
     drwav_assert(memory != NULL);
 
+    drwav_uint64 newPos;
     if (origin == drwav_seek_origin_current) {
         if (offset > 0) {
-            if (memory->currentReadPos + offset > memory->dataSize) {
-                offset = (int)(memory->dataSize - memory->currentReadPos);  // Trying to seek too far forward.
+            if ((drwav_uint64)offset > memory->dataSize - memory->currentReadPos) {
+                newPos = memory->dataSize;  // Trying to seek too far forward.
+            } else {
+                newPos = memory->currentReadPos + (drwav_uint64)offset;
             }
         } else {
-            if (memory->currentReadPos < (size_t)-offset) {
-                offset = -(int)memory->currentReadPos;  // Trying to seek too far backwards.
+            if ((drwav_uint64)0 - (drwav_uint64)offset > memory->currentReadPos) {
+                newPos = 0;     // Trying to seek too far backwards.
+            } else {
+                newPos = memory->currentReadPos - ((drwav_uint64)0 - (drwav_uint64)offset);
             }
         }
-
-        // This will never underflow thanks to the clamps above.
-        memory->currentReadPos += offset;
     } else {
-        if ((drwav_uint32)offset <= memory->dataSize) {
-            memory->currentReadPos = offset;
-        } else {
-            memory->currentReadPos = memory->dataSize;  // Trying to seek too far forward.
+        if (offset < 0) {
+            return DRWAV_FALSE;
         }
+
+        newPos = drwav_min((drwav_uint64)offset, memory->dataSize);     // Trying to seek too far forward.
     }
 
-    
+    memory->currentReadPos = (size_t)newPos;
     return DRWAV_TRUE;
 }
 
@@ -976,7 +1920,7 @@ drwav_bool32 drwav_init_memory(drwav* pWav, const void* data, size_t dataSize)
     memoryStream.dataSize = dataSize;
     memoryStream.currentReadPos = 0;
 
-    if (!drwav_init(pWav, drwav__on_read_memory, drwav__on_seek_memory, (void*)&memoryStream)) {
+    if (!drwav_init_seek64(pWav, drwav__on_read_memory, drwav__on_seek64_memory, (void*)&memoryStream)) {
         return DRWAV_FALSE;
     }
 
@@ -992,7 +1936,7 @@ drwav* drwav_open_memory(const void* data, size_t dataSize)
     memoryStream.dataSize = dataSize;
     memoryStream.currentReadPos = 0;
 
-    drwav* pWav = drwav_open(drwav__on_read_memory, drwav__on_seek_memory, (void*)&memoryStream);
+    drwav* pWav = drwav_open_seek64(drwav__on_read_memory, drwav__on_seek64_memory, (void*)&memoryStream);
     if (pWav == NULL) {
         return NULL;
     }
@@ -1003,239 +1947,236 @@ drwav* drwav_open_memory(const void* data, size_t dataSize)
 }
 
 
-drwav_bool32 drwav_init(drwav* pWav, drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData)
-{
-    if (onRead == NULL || onSeek == NULL) {
-        return DRWAV_FALSE;
-    }
-
-    drwav_zero_memory(pWav, sizeof(*pWav));
-
+static drwav_bool32 drwav__init_write(drwav* pWav, const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData);
+static drwav_uint64 drwav__get_compressed_samples_per_block(drwav* pWav);
+#ifndef DR_WAV_NO_CONVERSION_API
+static drwav_uint64 drwav__write_adpcm(drwav* pWav, drwav_uint64 samplesToWrite, const drwav_int16* pSamples);
+static drwav_bool32 drwav__flush_adpcm(drwav* pWav);
+static drwav_bool32 drwav__set_adpcm_thread_count(drwav* pWav, unsigned int threadCount);
+#endif
 
-    // The first 4 bytes should be the RIFF identifier.
-    unsigned char riff[4];
-    if (onRead(pUserData, riff, sizeof(riff)) != sizeof(riff)) {
-        return DRWAV_FALSE;    // Failed to read data.
-    }
+static size_t drwav__on_write_memory(void* pUserData, const void* pDataIn, size_t bytesToWrite)
+{
+    drwav__memory_stream_write* memory = (drwav__memory_stream_write*)pUserData;
+    drwav_assert(memory != NULL);
+    drwav_assert(memory->dataCapacity >= memory->currentWritePos);
 
-    // The first 4 bytes can be used to identify the container. For RIFF files it will start with "RIFF" and for
-    // w64 it will start with "riff".
-    if (drwav__fourcc_equal(riff, "RIFF")) {
-        pWav->container = drwav_container_riff;
-    } else if (drwav__fourcc_equal(riff, "riff")) {
-        pWav->container = drwav_container_w64;
+    size_t bytesRemaining = memory->dataCapacity - memory->currentWritePos;
+    if (bytesRemaining < bytesToWrite) {
+        // Need to reallocate.
+        size_t newDataCapacity = (memory->dataCapacity == 0) ? 256 : memory->dataCapacity * 2;
 
-        // Check the rest of the GUID for validity.
-        drwav_uint8 riff2[12];
-        if (onRead(pUserData, riff2, sizeof(riff2)) != sizeof(riff2)) {
-            return DRWAV_FALSE;
+        // If doubling wasn't enough, just make it the minimum required size to write the data.
+        if ((newDataCapacity - memory->currentWritePos) < bytesToWrite) {
+            newDataCapacity = memory->currentWritePos + bytesToWrite;
         }
 
-        for (int i = 0; i < 12; ++i) {
-            if (riff2[i] != drwavGUID_W64_RIFF[i+4]) {
-                return DRWAV_FALSE;
-            }
+        void* pNewData = DRWAV_REALLOC(*memory->ppData, newDataCapacity);
+        if (pNewData == NULL) {
+            return 0;
         }
-    } else {
-        return DRWAV_FALSE;   // Unknown or unsupported container.
+
+        *memory->ppData = pNewData;
+        memory->dataCapacity = newDataCapacity;
     }
 
+    drwav_uint8* pDataOut = (drwav_uint8*)(*memory->ppData);
+    DRWAV_COPY_MEMORY(pDataOut + memory->currentWritePos, pDataIn, bytesToWrite);
 
-    if (pWav->container == drwav_container_riff) {
-        // RIFF/WAVE
-        unsigned char chunkSizeBytes[4];
-        if (onRead(pUserData, chunkSizeBytes, sizeof(chunkSizeBytes)) != sizeof(chunkSizeBytes)) {
-            return DRWAV_FALSE;
-        }
+    memory->currentWritePos += bytesToWrite;
+    if (memory->dataSize < memory->currentWritePos) {
+        memory->dataSize = memory->currentWritePos;
+    }
 
-        unsigned int chunkSize = drwav__bytes_to_u32(chunkSizeBytes);
-        if (chunkSize < 36) {
-            return DRWAV_FALSE;    // Chunk size should always be at least 36 bytes.
-        }
+    *memory->pDataSize = memory->dataSize;
 
-        unsigned char wave[4];
-        if (onRead(pUserData, wave, sizeof(wave)) != sizeof(wave)) {
-            return DRWAV_FALSE;
-        }
+    return bytesToWrite;
+}
 
-        if (!drwav__fourcc_equal(wave, "WAVE")) {
-            return DRWAV_FALSE;    // Expecting "WAVE".
+static drwav_bool32 drwav__on_seek_memory_write(void* pUserData, int offset, drwav_seek_origin origin)
+{
+    drwav__memory_stream_write* memory = (drwav__memory_stream_write*)pUserData;
+    drwav_assert(memory != NULL);
+
+    if (origin == drwav_seek_origin_current) {
+        if (offset > 0) {
+            if (memory->currentWritePos + offset > memory->dataSize) {
+                offset = (int)(memory->dataSize - memory->currentWritePos);  // Trying to seek too far forward.
+            }
+        } else {
+            if (memory->currentWritePos < (size_t)-offset) {
+                offset = -(int)memory->currentWritePos;  // Trying to seek too far backwards.
+            }
         }
 
-        pWav->dataChunkDataPos = 4 + sizeof(chunkSizeBytes) + sizeof(wave);
+        // This will never underflow thanks to the clamps above.
+        memory->currentWritePos += offset;
     } else {
-        // W64
-        unsigned char chunkSize[8];
-        if (onRead(pUserData, chunkSize, sizeof(chunkSize)) != sizeof(chunkSize)) {
-            return DRWAV_FALSE;
+        if ((drwav_uint32)offset <= memory->dataSize) {
+            memory->currentWritePos = offset;
+        } else {
+            memory->currentWritePos = memory->dataSize;  // Trying to seek too far forward.
         }
+    }
 
-        if (drwav__bytes_to_u64(chunkSize) < 84) {
-            return DRWAV_FALSE;
-        }
+    return DRWAV_TRUE;
+}
 
-        drwav_uint8 wave[16];
-        if (onRead(pUserData, wave, sizeof(wave)) != sizeof(wave)) {
-            return DRWAV_FALSE;
-        }
+static void drwav__init_memory_stream_write(drwav__memory_stream_write* pMemoryStream, void** ppData, size_t* pDataSize)
+{
+    *ppData = NULL;
+    *pDataSize = 0;
+
+    pMemoryStream->ppData = ppData;
+    pMemoryStream->pDataSize = pDataSize;
+    pMemoryStream->dataSize = 0;
+    pMemoryStream->dataCapacity = 0;
+    pMemoryStream->currentWritePos = 0;
+}
 
-        if (!drwav__guid_equal(wave, drwavGUID_W64_WAVE)) {
-            return DRWAV_FALSE;
-        }
+drwav_bool32 drwav_init_memory_write(drwav* pWav, void** ppData, size_t* pDataSize, const drwav_data_format* pFormat)
+{
+    if (ppData == NULL || pDataSize == NULL) {
+        return DRWAV_FALSE;
+    }
 
-        pWav->dataChunkDataPos = 16 + sizeof(chunkSize) + sizeof(wave);
+    // The header is written during initialization so the memory stream needs to live in the drwav object from the start.
+    drwav_zero_memory(pWav, sizeof(*pWav));
+    drwav__init_memory_stream_write(&pWav->memoryStreamWrite, ppData, pDataSize);
+
+    if (!drwav__init_write(pWav, pFormat, drwav__on_write_memory, drwav__on_seek_memory_write, (void*)&pWav->memoryStreamWrite)) {
+        DRWAV_FREE(*ppData);
+        *ppData = NULL;
+        *pDataSize = 0;
+        return DRWAV_FALSE;
     }
 
+    return DRWAV_TRUE;
+}
 
-    // The next 24 bytes should be the "fmt " chunk.
-    drwav_fmt fmt;
-    if (!drwav__read_fmt(onRead, onSeek, pUserData, pWav->container, &pWav->dataChunkDataPos, &fmt)) {
-        return DRWAV_FALSE;    // Failed to read the "fmt " chunk.
+drwav* drwav_open_memory_write(void** ppData, size_t* pDataSize, const drwav_data_format* pFormat)
+{
+    if (ppData == NULL || pDataSize == NULL) {
+        return NULL;
     }
 
+    drwav* pWav = (drwav*)DRWAV_MALLOC(sizeof(*pWav));
+    if (pWav == NULL) {
+        return NULL;
+    }
 
-    // Translate the internal format.
-    unsigned short translatedFormatTag = fmt.formatTag;
-    if (translatedFormatTag == DR_WAVE_FORMAT_EXTENSIBLE) {
-        translatedFormatTag = drwav__bytes_to_u16(fmt.subFormat + 0);
+    if (!drwav_init_memory_write(pWav, ppData, pDataSize, pFormat)) {
+        DRWAV_FREE(pWav);
+        return NULL;
     }
 
+    return pWav;
+}
 
-    drwav_uint64 sampleCountFromFactChunk = 0;
 
-    // The next chunk we care about is the "data" chunk. This is not necessarily the next chunk so we'll need to loop.
-    drwav_uint64 dataSize;
-    for (;;)
-    {
-        drwav__chunk_header header;
-        if (!drwav__read_chunk_header(onRead, pUserData, pWav->container, &pWav->dataChunkDataPos, &header)) {
-            return DRWAV_FALSE;
-        }
-
-        dataSize = header.sizeInBytes;
-        if (pWav->container == drwav_container_riff) {
-            if (drwav__fourcc_equal(header.id.fourcc, "data")) {
-                break;
-            }
-        } else {
-            if (drwav__guid_equal(header.id.guid, drwavGUID_W64_DATA)) {
-                break;
-            }
-        }
+#ifndef DR_WAV_NO_STDIO
+#if !defined(DR_WAV_NO_MMAP) && defined(_WIN32)
+#include <windows.h>
+#define DRWAV_HAS_MMAP
 
-        // Optional. Get the total sample count from the FACT chunk. This is useful for compressed formats.
-        if (pWav->container == drwav_container_riff) {
-            if (drwav__fourcc_equal(header.id.fourcc, "fact")) {
-                drwav_uint32 sampleCount;
-                if (onRead(pUserData, &sampleCount, 4) != 4) {
-                    return DRWAV_FALSE;
-                }
-                pWav->dataChunkDataPos += 4;
-                dataSize -= 4;
+static const void* drwav__map_file(const char* filename, size_t* pSizeOut)
+{
+    HANDLE hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
 
-                // The sample count in the "fact" chunk is either unreliable, or I'm not understanding it properly. For now I am only enabling this
-                // for Microsoft ADPCM formats.
-                if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-                    sampleCountFromFactChunk = sampleCount;
-                } else {
-                    sampleCountFromFactChunk = 0;
-                }
-            }
-        } else {
-            if (drwav__guid_equal(header.id.guid, drwavGUID_W64_FACT)) {
-                if (onRead(pUserData, &sampleCountFromFactChunk, 8) != 8) {
-                    return DRWAV_FALSE;
-                }
-                pWav->dataChunkDataPos += 4;
-                dataSize -= 8;
-            }
+    const void* pData = NULL;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 && (drwav_uint64)fileSize.QuadPart <= SIZE_MAX) {
+        HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (hMapping != NULL) {
+            pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(hMapping);  // <-- The view keeps the mapping alive.
         }
-
-        // If we get here it means we didn't find the "data" chunk. Seek past it.
-
-        // Make sure we seek past the padding.
-        dataSize += header.paddingSize;
-        drwav__seek_forward(onSeek, dataSize, pUserData);
-        pWav->dataChunkDataPos += dataSize;
     }
 
-    // At this point we should be sitting on the first byte of the raw audio data.
+    CloseHandle(hFile);
 
-    pWav->onRead              = onRead;
-    pWav->onSeek              = onSeek;
-    pWav->pUserData           = pUserData;
-    pWav->fmt                 = fmt;
-    pWav->sampleRate          = fmt.sampleRate;
-    pWav->channels            = fmt.channels;
-    pWav->bitsPerSample       = fmt.bitsPerSample;
-    pWav->bytesPerSample      = (unsigned int)(fmt.blockAlign / fmt.channels);
-    pWav->bytesRemaining      = dataSize;
-    pWav->translatedFormatTag = translatedFormatTag;
-    pWav->dataChunkDataSize   = dataSize;
+    if (pData != NULL) {
+        *pSizeOut = (size_t)fileSize.QuadPart;
+    }
+    return pData;
+}
 
-    if (sampleCountFromFactChunk != 0) {
-        pWav->totalSampleCount = sampleCountFromFactChunk * fmt.channels;
-    } else {
-        pWav->totalSampleCount = dataSize / pWav->bytesPerSample;
+static void drwav__unmap_file(const void* pData, size_t dataSize)
+{
+    (void)dataSize;
+    UnmapViewOfFile(pData);
+}
+#elif !defined(DR_WAV_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define DRWAV_HAS_MMAP
+
+static const void* drwav__map_file(const char* filename, size_t* pSizeOut)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return NULL;
+    }
 
-        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-            drwav_uint64 blockCount = dataSize / fmt.blockAlign;
-            pWav->totalSampleCount = (blockCount * (fmt.blockAlign - (6*pWav->channels))) * 2;  // x2 because two samples per byte.
-        }
-        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
-            drwav_uint64 blockCount = dataSize / fmt.blockAlign;
-            pWav->totalSampleCount = ((blockCount * (fmt.blockAlign - (4*pWav->channels))) * 2) + (blockCount * pWav->channels);
+    const void* pData = NULL;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0 && (drwav_uint64)info.st_size <= SIZE_MAX) {
+        void* pMapped = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapped != MAP_FAILED) {
+            pData = pMapped;
         }
     }
-    
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-        pWav->bytesPerSample = 0;
-    }
 
-#ifdef DR_WAV_LIBSNDFILE_COMPAT
-    // I use libsndfile as a benchmark for testing, however in the version I'm using (from the Windows installer on the libsndfile website),
-    // it appears the total sample count libsndfile uses for MS-ADPCM is incorrect. It would seem they are computing the total sample count
-    // from the number of blocks, however this results in the inclusion of the extra silent samples at the end of the last block. The correct
-    // way to know the total sample count is to inspect the "fact" chunk which should always be present for compressed formats, and should
-    // always include the sample count. This little block of code below is only used to emulate the libsndfile logic so I can properly run my
-    // correctness tests against libsndfile and is disabled by default.
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-        drwav_uint64 blockCount = dataSize / fmt.blockAlign;
-        pWav->totalSampleCount = (blockCount * (fmt.blockAlign - (6*pWav->channels))) * 2;  // x2 because two samples per byte.
-    }
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
-        drwav_uint64 blockCount = dataSize / fmt.blockAlign;
-        pWav->totalSampleCount = ((blockCount * (fmt.blockAlign - (4*pWav->channels))) * 2) + (blockCount * pWav->channels);
+    close(fd);  // <-- The mapping keeps a reference to the file.
+
+    if (pData != NULL) {
+        *pSizeOut = (size_t)info.st_size;
     }
-#endif
+    return pData;
+}
 
-    return DRWAV_TRUE;
+static void drwav__unmap_file(const void* pData, size_t dataSize)
+{
+    munmap((void*)pData, dataSize);
 }
+#endif
 
-void drwav_uninit(drwav* pWav)
+drwav_bool32 drwav_init_file_mmap(drwav* pWav, const char* filename)
 {
-    if (pWav == NULL) {
-        return;
+#ifdef DRWAV_HAS_MMAP
+    size_t dataSize;
+    const void* pData = drwav__map_file(filename, &dataSize);
+    if (pData == NULL) {
+        return DRWAV_FALSE;
     }
 
-#ifndef DR_WAV_NO_STDIO
-    // If we opened the file with drwav_open_file() we will want to close the file handle. We can know whether or not drwav_open_file()
-    // was used by looking at the onRead and onSeek callbacks.
-    if (pWav->onRead == drwav__on_read_stdio) {
-        fclose((FILE*)pWav->pUserData);
+    if (!drwav_init_memory(pWav, pData, dataSize)) {
+        drwav__unmap_file(pData, dataSize);
+        return DRWAV_FALSE;
     }
+
+    pWav->isMemoryMapped = DRWAV_TRUE;
+    return DRWAV_TRUE;
+#else
+    (void)pWav;
+    (void)filename;
+    return DRWAV_FALSE;
 #endif
 }
 
-
-drwav* drwav_open(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData)
+drwav* drwav_open_file_mmap(const char* filename)
 {
     drwav* pWav = (drwav*)DRWAV_MALLOC(sizeof(*pWav));
     if (pWav == NULL) {
         return NULL;
     }
 
-    if (!drwav_init(pWav, onRead, onSeek, pUserData)) {
+    if (!drwav_init_file_mmap(pWav, filename)) {
         DRWAV_FREE(pWav);
         return NULL;
     }
@@ -1243,509 +2184,2852 @@ drwav* drwav_open(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserDat
     return pWav;
 }
 
-void drwav_close(drwav* pWav)
+#if defined(_WIN32)
+#include <windows.h>
+#define DRWAV_HAS_READ_AT_FILE
+
+// A synchronous handle can be read from multiple threads at once as long as each read passes its own position.
+static size_t drwav__on_read_at_file(void* pUserData, drwav_uint64 offset, void* pBufferOut, size_t bytesToRead)
 {
-    drwav_uninit(pWav);
-    DRWAV_FREE(pWav);
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < bytesToRead) {
+        size_t bytesRemaining = bytesToRead - totalBytesRead;
+        DWORD bytesToReadThisIteration = (bytesRemaining > 0x40000000) ? 0x40000000 : (DWORD)bytesRemaining;
+
+        OVERLAPPED overlapped;
+        drwav_zero_memory(&overlapped, sizeof(overlapped));
+        overlapped.Offset     = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        DWORD bytesRead;
+        if (!ReadFile((HANDLE)pUserData, (drwav_uint8*)pBufferOut + totalBytesRead, bytesToReadThisIteration, &bytesRead, &overlapped) || bytesRead == 0) {
+            break;
+        }
+
+        totalBytesRead += bytesRead;
+        offset += bytesRead;
+    }
+
+    return totalBytesRead;
 }
 
+static void* drwav__open_read_at_file(const char* filename)
+{
+    HANDLE hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    return (hFile == INVALID_HANDLE_VALUE) ? NULL : (void*)hFile;
+}
 
-size_t drwav_read_raw(drwav* pWav, size_t bytesToRead, void* pBufferOut)
+static void drwav__close_read_at_file(void* pUserData)
 {
-    if (pWav == NULL || bytesToRead == 0 || pBufferOut == NULL) {
-        return 0;
-    }
+    CloseHandle((HANDLE)pUserData);
+}
+#elif defined(__APPLE__) || (defined(__unix__) && ((defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L) || defined(__BSD_VISIBLE)))
+// pread() is part of POSIX 2008, which strict ISO C modes such as -std=c99 hide on glibc.
+#include <fcntl.h>
+#include <unistd.h>
+#define DRWAV_HAS_READ_AT_FILE
 
-    if (bytesToRead > pWav->bytesRemaining) {
-        bytesToRead = (size_t)pWav->bytesRemaining;
+static size_t drwav__on_read_at_file(void* pUserData, drwav_uint64 offset, void* pBufferOut, size_t bytesToRead)
+{
+    // The descriptor is stored as fd+1 so that a descriptor of 0 doesn't look like a NULL handle.
+    int fd = (int)((size_t)pUserData - 1);
+
+    size_t totalBytesRead = 0;
+    while (totalBytesRead < bytesToRead) {
+        off_t readPos = (off_t)(offset + totalBytesRead);
+        if (readPos < 0 || (drwav_uint64)readPos != offset + totalBytesRead) {
+            break;  // Not representable by off_t.
+        }
+
+        ssize_t bytesRead = pread(fd, (drwav_uint8*)pBufferOut + totalBytesRead, bytesToRead - totalBytesRead, readPos);
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        totalBytesRead += (size_t)bytesRead;
     }
 
-    size_t bytesRead = pWav->onRead(pWav->pUserData, pBufferOut, bytesToRead);
+    return totalBytesRead;
+}
 
-    pWav->bytesRemaining -= bytesRead;
-    return bytesRead;
+static void* drwav__open_read_at_file(const char* filename)
+{
+    int fd = open(filename, O_RDONLY);
+    return (fd == -1) ? NULL : (void*)((size_t)fd + 1);
 }
 
-drwav_uint64 drwav_read(drwav* pWav, drwav_uint64 samplesToRead, void* pBufferOut)
+static void drwav__close_read_at_file(void* pUserData)
 {
-    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
-        return 0;
+    close((int)((size_t)pUserData - 1));
+}
+#endif
+
+drwav_bool32 drwav_source_init_file(drwav_source* pSource, const char* filename)
+{
+#ifdef DRWAV_HAS_READ_AT_FILE
+    void* pFile = drwav__open_read_at_file(filename);
+    if (pFile == NULL) {
+        return DRWAV_FALSE;
     }
 
-    // Cannot use this function for compressed formats.
-    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
-        return 0;
+    if (!drwav_source_init(pSource, drwav__on_read_at_file, pFile)) {
+        drwav__close_read_at_file(pFile);
+        return DRWAV_FALSE;
     }
 
-    // Don't try to read more samples than can potentially fit in the output buffer.
-    if (samplesToRead * pWav->bytesPerSample > SIZE_MAX) {
-        samplesToRead = SIZE_MAX / pWav->bytesPerSample;
+    return DRWAV_TRUE;
+#else
+    (void)pSource;
+    (void)filename;
+    return DRWAV_FALSE;
+#endif
+}
+#endif  //DR_WAV_NO_STDIO
+
+
+static size_t drwav__on_read_at_stream(void* pUserData, void* pBufferOut, size_t bytesToRead)
+{
+    drwav__read_at_stream* pStream = (drwav__read_at_stream*)pUserData;
+    drwav_assert(pStream != NULL);
+
+    drwav_uint8* pRunningBufferOut = (drwav_uint8*)pBufferOut;
+    size_t bytesRead = 0;
+    while (bytesRead < bytesToRead) {
+        size_t bytesRemaining = bytesToRead - bytesRead;
+
+        // Take what we can from the cache first.
+        if (pStream->readPos >= pStream->cachePos && pStream->readPos - pStream->cachePos < pStream->cacheSize) {
+            size_t cacheOffset = (size_t)(pStream->readPos - pStream->cachePos);
+            size_t bytesToCopy = drwav_min(bytesRemaining, pStream->cacheSize - cacheOffset);
+            drwav_copy_memory(pRunningBufferOut, pStream->cache + cacheOffset, bytesToCopy);
+
+            pRunningBufferOut += bytesToCopy;
+            bytesRead         += bytesToCopy;
+            pStream->readPos  += bytesToCopy;
+            continue;
+        }
+
+        // Large reads go straight to the output buffer.
+        if (bytesRemaining >= sizeof(pStream->cache)) {
+            size_t bytesReadNow = pStream->onReadAt(pStream->pUserData, pStream->readPos, pRunningBufferOut, bytesRemaining);
+            bytesRead        += bytesReadNow;
+            pStream->readPos += bytesReadNow;
+            break;
+        }
+
+        pStream->cachePos  = pStream->readPos;
+        pStream->cacheSize = pStream->onReadAt(pStream->pUserData, pStream->readPos, pStream->cache, sizeof(pStream->cache));
+        if (pStream->cacheSize == 0) {
+            break;  // Reached the end.
+        }
     }
 
-    size_t bytesRead = drwav_read_raw(pWav, (size_t)(samplesToRead * pWav->bytesPerSample), pBufferOut);
-    return bytesRead / pWav->bytesPerSample;
+    return bytesRead;
 }
 
-drwav_bool32 drwav_seek_to_first_sample(drwav* pWav)
+static drwav_bool32 drwav__on_seek_at_stream(void* pUserData, drwav_int64 offset, drwav_seek_origin origin)
+{
+    drwav__read_at_stream* pStream = (drwav__read_at_stream*)pUserData;
+    drwav_assert(pStream != NULL);
+
+    // Like fseek(), seeking past the end is allowed. Reads from there will just return 0.
+    if (origin == drwav_seek_origin_current) {
+        if (offset < 0 && (drwav_uint64)0 - (drwav_uint64)offset > pStream->readPos) {
+            return DRWAV_FALSE;
+        }
+        pStream->readPos += offset;
+    } else {
+        if (offset < 0) {
+            return DRWAV_FALSE;
+        }
+        pStream->readPos = (drwav_uint64)offset;
+    }
+
+    return DRWAV_TRUE;
+}
+
+drwav_bool32 drwav_source_init(drwav_source* pSource, drwav_read_at_proc onReadAt, void* pUserData)
 {
-    if (!pWav->onSeek(pWav->pUserData, (int)pWav->dataChunkDataPos, drwav_seek_origin_start)) {
+    if (pSource == NULL || onReadAt == NULL) {
         return DRWAV_FALSE;
     }
 
-    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
-        pWav->compressed.iCurrentSample = 0;
+    drwav_zero_memory(pSource, sizeof(*pSource));
+
+    // The header is parsed through a temporary stream. Each cursor gets its own stream after that.
+    drwav__read_at_stream stream;
+    stream.onReadAt  = onReadAt;
+    stream.pUserData = pUserData;
+    stream.readPos   = 0;
+    stream.cachePos  = 0;
+    stream.cacheSize = 0;
+    if (!drwav_init_seek64(&pSource->wav, drwav__on_read_at_stream, drwav__on_seek_at_stream, &stream)) {
+        return DRWAV_FALSE;
     }
-    
-    pWav->bytesRemaining = pWav->dataChunkDataSize;
+
+    pSource->wav.onRead    = NULL;
+    pSource->wav.onSeek    = NULL;
+    pSource->wav.onSeek64  = NULL;
+    pSource->wav.pUserData = NULL;
+    pSource->onReadAt  = onReadAt;
+    pSource->pUserData = pUserData;
+
     return DRWAV_TRUE;
 }
 
-drwav_bool32 drwav_seek_to_sample(drwav* pWav, drwav_uint64 sample)
+void drwav_source_uninit(drwav_source* pSource)
 {
-    // Seeking should be compatible with wave files > 2GB.
+    if (pSource == NULL) {
+        return;
+    }
 
-    if (pWav == NULL || pWav->onSeek == NULL) {
-        return DRWAV_FALSE;
+    drwav_uninit(&pSource->wav);
+
+#if !defined(DR_WAV_NO_STDIO) && defined(DRWAV_HAS_READ_AT_FILE)
+    // If the source was initialized with drwav_source_init_file() we need to close the file.
+    if (pSource->onReadAt == drwav__on_read_at_file) {
+        drwav__close_read_at_file(pSource->pUserData);
     }
+#endif
+}
 
-    // If there are no samples, just return DRWAV_TRUE without doing anything.
-    if (pWav->totalSampleCount == 0) {
-        return DRWAV_TRUE;
+drwav_bool32 drwav_cursor_init(drwav_cursor* pCursor, const drwav_source* pSource)
+{
+    if (pCursor == NULL || pSource == NULL || pSource->onReadAt == NULL) {
+        return DRWAV_FALSE;
     }
 
-    // Make sure the sample is clamped.
-    if (sample >= pWav->totalSampleCount) {
-        sample  = pWav->totalSampleCount - 1;
+    // drwav_init() leaves the stream at the start of the data chunk, so a copy of the parsed source with a stream at that position
+    // is the same as a freshly initialized drwav object.
+    pCursor->stream.onReadAt  = pSource->onReadAt;
+    pCursor->stream.pUserData = pSource->pUserData;
+    pCursor->stream.readPos   = pSource->wav.dataChunkDataPos;
+    pCursor->stream.cachePos  = 0;
+    pCursor->stream.cacheSize = 0;
+
+    drwav_copy_memory(&pCursor->wav, &pSource->wav, sizeof(pCursor->wav));
+    pCursor->wav.onRead     = drwav__on_read_at_stream;
+    pCursor->wav.onSeek64   = drwav__on_seek_at_stream;
+    pCursor->wav.pUserData  = &pCursor->stream;
+    pCursor->wav.pChunks    = NULL;
+    pCursor->wav.chunkCount = 0;
+
+    return DRWAV_TRUE;
+}
+
+void drwav_cursor_uninit(drwav_cursor* pCursor)
+{
+    if (pCursor == NULL) {
+        return;
     }
 
+    drwav_uninit(&pCursor->wav);
+}
 
-    // For compressed formats we just use a slow generic seek. If we are seeking forward we just seek forward. If we are going backwards we need
-    // to seek back to the start.
-    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
-        // TODO: This can be optimized.
-        if (sample > pWav->compressed.iCurrentSample) {
-            // Seeking forward - just move from the current position.
-            drwav_uint64 offset = sample - pWav->compressed.iCurrentSample;
-
-            drwav_int16 devnull[2048];
-            while (offset > 0) {
-                drwav_uint64 samplesToRead = sample;
-                if (samplesToRead > 2048) {
-                    samplesToRead = 2048;
-                }
 
-                drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, devnull);
-                if (samplesRead != samplesToRead) {
-                    return DRWAV_FALSE;
-                }
+// AIFF and AIFC. Everything is big-endian, and the "COMM" and "SSND" chunks, which hold the format and the audio data, can
+// come in either order. The "FORM" identifier has already been read.
+static drwav_bool32 drwav__init_aiff(drwav* pWav)
+{
+    drwav_read_proc onRead = pWav->onRead;
+    void* pUserData = pWav->pUserData;
 
-                offset -= samplesRead;
-            }
-        } else {
-            // Seeking backwards. Just use the fallback.
-            goto fallback;
-        }
+    unsigned char form[8];  // <-- Chunk size and form type.
+    if (onRead(pUserData, form, sizeof(form)) != sizeof(form)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_bool32 isAIFC;
+    if (drwav__fourcc_equal(form + 4, "AIFF")) {
+        isAIFC = DRWAV_FALSE;
+    } else if (drwav__fourcc_equal(form + 4, "AIFC")) {
+        isAIFC = DRWAV_TRUE;
     } else {
-        drwav_uint64 totalSizeInBytes = pWav->totalSampleCount * pWav->bytesPerSample;
-        drwav_assert(totalSizeInBytes >= pWav->bytesRemaining);
+        return DRWAV_FALSE;
+    }
 
-        drwav_uint64 currentBytePos = totalSizeInBytes - pWav->bytesRemaining;
-        drwav_uint64 targetBytePos  = sample * pWav->bytesPerSample;
+    unsigned char comm[22];     // <-- Channels, frame count, sample size, sample rate and, for AIFC, the compression type.
+    size_t commSize = isAIFC ? 22 : 18;
+    drwav_bool32 foundCOMM = DRWAV_FALSE;
+    drwav_bool32 foundSSND = DRWAV_FALSE;
+    drwav_bool32 isAtSSNDData = DRWAV_FALSE;
+    drwav_uint64 dataPos  = 0;
+    drwav_uint64 dataSize = 0;
+    drwav_uint64 runningPos = 12;
+    while (!foundCOMM || !foundSSND) {
+        drwav__chunk_header header;
+        if (!drwav__read_chunk_header(onRead, pUserData, drwav_container_aiff, &runningPos, &header)) {
+            return DRWAV_FALSE;
+        }
 
-        drwav_uint64 offset;
-        if (currentBytePos < targetBytePos) {
-            // Offset forwards.
-            offset = (targetBytePos - currentBytePos);
-        } else {
-            // Offset backwards.
-            if (!drwav_seek_to_first_sample(pWav)) {
+        drwav_uint64 bytesToSkip = header.sizeInBytes + header.paddingSize;
+        if (drwav__fourcc_equal(header.id.fourcc, "COMM")) {
+            if (header.sizeInBytes < commSize || onRead(pUserData, comm, commSize) != commSize) {
                 return DRWAV_FALSE;
             }
-            offset = targetBytePos;
-        }
 
-        while (offset > 0) {
-            int offset32 = ((offset > INT_MAX) ? INT_MAX : (int)offset);
-            if (!pWav->onSeek(pWav->pUserData, offset32, drwav_seek_origin_current)) {
+            bytesToSkip -= commSize;
+            foundCOMM = DRWAV_TRUE;
+        } else if (drwav__fourcc_equal(header.id.fourcc, "SSND")) {
+            unsigned char ssnd[8];  // <-- Offset and block size.
+            if (header.sizeInBytes < sizeof(ssnd) || onRead(pUserData, ssnd, sizeof(ssnd)) != sizeof(ssnd)) {
                 return DRWAV_FALSE;
             }
 
-            pWav->bytesRemaining -= offset32;
-            offset -= offset32;
-        }
-    }
+            drwav_uint32 offset = drwav__bytes_to_u32_be(ssnd);
+            if (offset > header.sizeInBytes - sizeof(ssnd)) {
+                return DRWAV_FALSE;
+            }
 
-    return DRWAV_TRUE;
+            bytesToSkip -= sizeof(ssnd);
+            dataPos   = runningPos + sizeof(ssnd) + offset;
+            dataSize  = header.sizeInBytes - sizeof(ssnd) - offset;
+            foundSSND = DRWAV_TRUE;
 
-fallback:
-    // This is a generic seek implementation that just continuously reads samples into a temporary buffer. This should work for all supported
-    // formats, but it is not efficient. This should be used as a fall back.
-    if (!drwav_seek_to_first_sample(pWav)) {
-        return DRWAV_FALSE;
-    }
+            if (foundCOMM) {
+                if (!drwav__seek_forward(pWav, offset)) {
+                    return DRWAV_FALSE;
+                }
 
-    drwav_int16 devnull[2048];
-    while (sample > 0) {
-        drwav_uint64 samplesToRead = sample;
-        if (samplesToRead > 2048) {
-            samplesToRead = 2048;
+                isAtSSNDData = DRWAV_TRUE;
+                break;
+            }
         }
 
-        drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, devnull);
-        if (samplesRead != samplesToRead) {
+        if (!drwav__seek_forward(pWav, bytesToSkip)) {
             return DRWAV_FALSE;
         }
+        runningPos += header.sizeInBytes + header.paddingSize;
+    }
 
-        sample -= samplesRead;
+    // The "SSND" chunk came first so we need to go back to it.
+    if (!isAtSSNDData) {
+        if (!drwav__seek(pWav, (drwav_int64)dataPos, drwav_seek_origin_start)) {
+            return DRWAV_FALSE;
+        }
     }
 
-    return DRWAV_TRUE;
-}
 
+    drwav_fmt fmt;
+    drwav_zero_memory(&fmt, sizeof(fmt));
+    fmt.formatTag     = DR_WAVE_FORMAT_PCM;
+    fmt.channels      = drwav__bytes_to_u16_be(comm + 0);
+    fmt.sampleRate    = drwav__bytes_to_sample_rate_ieee_extended(comm + 8);
+    fmt.bitsPerSample = drwav__bytes_to_u16_be(comm + 6);
+
+    drwav_uint32 frameCount = drwav__bytes_to_u32_be(comm + 2);
+    drwav_bool32 isBigEndian = DRWAV_TRUE;
+    if (isAIFC) {
+        const unsigned char* compressionType = comm + 18;
+        if (drwav__fourcc_equal(compressionType, "NONE") || drwav__fourcc_equal(compressionType, "twos")) {
+            // Big-endian PCM, the same as AIFF.
+        } else if (drwav__fourcc_equal(compressionType, "sowt")) {
+            isBigEndian = DRWAV_FALSE;
+        } else if (drwav__fourcc_equal(compressionType, "fl32") || drwav__fourcc_equal(compressionType, "FL32")) {
+            fmt.formatTag     = DR_WAVE_FORMAT_IEEE_FLOAT;
+            fmt.bitsPerSample = 32;
+        } else if (drwav__fourcc_equal(compressionType, "fl64") || drwav__fourcc_equal(compressionType, "FL64")) {
+            fmt.formatTag     = DR_WAVE_FORMAT_IEEE_FLOAT;
+            fmt.bitsPerSample = 64;
+        } else if (drwav__fourcc_equal(compressionType, "alaw") || drwav__fourcc_equal(compressionType, "ALAW")) {
+            fmt.formatTag     = DR_WAVE_FORMAT_ALAW;
+            fmt.bitsPerSample = 8;  // <-- The sample size of G.711 streams is usually set to the decoded size of 16.
+        } else if (drwav__fourcc_equal(compressionType, "ulaw") || drwav__fourcc_equal(compressionType, "ULAW")) {
+            fmt.formatTag     = DR_WAVE_FORMAT_MULAW;
+            fmt.bitsPerSample = 8;
+        } else {
+            return DRWAV_FALSE;     // Unsupported compression type.
+        }
+    }
 
-#ifndef DR_WAV_NO_CONVERSION_API
-static unsigned short g_drwavAlawTable[256] = {
-    0xEA80, 0xEB80, 0xE880, 0xE980, 0xEE80, 0xEF80, 0xEC80, 0xED80, 0xE280, 0xE380, 0xE080, 0xE180, 0xE680, 0xE780, 0xE480, 0xE580, 
-    0xF540, 0xF5C0, 0xF440, 0xF4C0, 0xF740, 0xF7C0, 0xF640, 0xF6C0, 0xF140, 0xF1C0, 0xF040, 0xF0C0, 0xF340, 0xF3C0, 0xF240, 0xF2C0, 
-    0xAA00, 0xAE00, 0xA200, 0xA600, 0xBA00, 0xBE00, 0xB200, 0xB600, 0x8A00, 0x8E00, 0x8200, 0x8600, 0x9A00, 0x9E00, 0x9200, 0x9600, 
-    0xD500, 0xD700, 0xD100, 0xD300, 0xDD00, 0xDF00, 0xD900, 0xDB00, 0xC500, 0xC700, 0xC100, 0xC300, 0xCD00, 0xCF00, 0xC900, 0xCB00, 
-    0xFEA8, 0xFEB8, 0xFE88, 0xFE98, 0xFEE8, 0xFEF8, 0xFEC8, 0xFED8, 0xFE28, 0xFE38, 0xFE08, 0xFE18, 0xFE68, 0xFE78, 0xFE48, 0xFE58, 
-    0xFFA8, 0xFFB8, 0xFF88, 0xFF98, 0xFFE8, 0xFFF8, 0xFFC8, 0xFFD8, 0xFF28, 0xFF38, 0xFF08, 0xFF18, 0xFF68, 0xFF78, 0xFF48, 0xFF58, 
-    0xFAA0, 0xFAE0, 0xFA20, 0xFA60, 0xFBA0, 0xFBE0, 0xFB20, 0xFB60, 0xF8A0, 0xF8E0, 0xF820, 0xF860, 0xF9A0, 0xF9E0, 0xF920, 0xF960, 
-    0xFD50, 0xFD70, 0xFD10, 0xFD30, 0xFDD0, 0xFDF0, 0xFD90, 0xFDB0, 0xFC50, 0xFC70, 0xFC10, 0xFC30, 0xFCD0, 0xFCF0, 0xFC90, 0xFCB0, 
-    0x1580, 0x1480, 0x1780, 0x1680, 0x1180, 0x1080, 0x1380, 0x1280, 0x1D80, 0x1C80, 0x1F80, 0x1E80, 0x1980, 0x1880, 0x1B80, 0x1A80, 
-    0x0AC0, 0x0A40, 0x0BC0, 0x0B40, 0x08C0, 0x0840, 0x09C0, 0x0940, 0x0EC0, 0x0E40, 0x0FC0, 0x0F40, 0x0CC0, 0x0C40, 0x0DC0, 0x0D40, 
-    0x5600, 0x5200, 0x5E00, 0x5A00, 0x4600, 0x4200, 0x4E00, 0x4A00, 0x7600, 0x7200, 0x7E00, 0x7A00, 0x6600, 0x6200, 0x6E00, 0x6A00, 
-    0x2B00, 0x2900, 0x2F00, 0x2D00, 0x2300, 0x2100, 0x2700, 0x2500, 0x3B00, 0x3900, 0x3F00, 0x3D00, 0x3300, 0x3100, 0x3700, 0x3500, 
-    0x0158, 0x0148, 0x0178, 0x0168, 0x0118, 0x0108, 0x0138, 0x0128, 0x01D8, 0x01C8, 0x01F8, 0x01E8, 0x0198, 0x0188, 0x01B8, 0x01A8, 
-    0x0058, 0x0048, 0x0078, 0x0068, 0x0018, 0x0008, 0x0038, 0x0028, 0x00D8, 0x00C8, 0x00F8, 0x00E8, 0x0098, 0x0088, 0x00B8, 0x00A8, 
-    0x0560, 0x0520, 0x05E0, 0x05A0, 0x0460, 0x0420, 0x04E0, 0x04A0, 0x0760, 0x0720, 0x07E0, 0x07A0, 0x0660, 0x0620, 0x06E0, 0x06A0, 
-    0x02B0, 0x0290, 0x02F0, 0x02D0, 0x0230, 0x0210, 0x0270, 0x0250, 0x03B0, 0x0390, 0x03F0, 0x03D0, 0x0330, 0x0310, 0x0370, 0x0350
-};
+    if (fmt.channels == 0 || fmt.sampleRate == 0 || fmt.bitsPerSample == 0 || fmt.bitsPerSample > 64) {
+        return DRWAV_FALSE;
+    }
 
-static unsigned short g_drwavMulawTable[256] = {
-    0x8284, 0x8684, 0x8A84, 0x8E84, 0x9284, 0x9684, 0x9A84, 0x9E84, 0xA284, 0xA684, 0xAA84, 0xAE84, 0xB284, 0xB684, 0xBA84, 0xBE84, 
-    0xC184, 0xC384, 0xC584, 0xC784, 0xC984, 0xCB84, 0xCD84, 0xCF84, 0xD184, 0xD384, 0xD584, 0xD784, 0xD984, 0xDB84, 0xDD84, 0xDF84, 
-    0xE104, 0xE204, 0xE304, 0xE404, 0xE504, 0xE604, 0xE704, 0xE804, 0xE904, 0xEA04, 0xEB04, 0xEC04, 0xED04, 0xEE04, 0xEF04, 0xF004, 
-    0xF0C4, 0xF144, 0xF1C4, 0xF244, 0xF2C4, 0xF344, 0xF3C4, 0xF444, 0xF4C4, 0xF544, 0xF5C4, 0xF644, 0xF6C4, 0xF744, 0xF7C4, 0xF844, 
-    0xF8A4, 0xF8E4, 0xF924, 0xF964, 0xF9A4, 0xF9E4, 0xFA24, 0xFA64, 0xFAA4, 0xFAE4, 0xFB24, 0xFB64, 0xFBA4, 0xFBE4, 0xFC24, 0xFC64, 
-    0xFC94, 0xFCB4, 0xFCD4, 0xFCF4, 0xFD14, 0xFD34, 0xFD54, 0xFD74, 0xFD94, 0xFDB4, 0xFDD4, 0xFDF4, 0xFE14, 0xFE34, 0xFE54, 0xFE74, 
-    0xFE8C, 0xFE9C, 0xFEAC, 0xFEBC, 0xFECC, 0xFEDC, 0xFEEC, 0xFEFC, 0xFF0C, 0xFF1C, 0xFF2C, 0xFF3C, 0xFF4C, 0xFF5C, 0xFF6C, 0xFF7C, 
-    0xFF88, 0xFF90, 0xFF98, 0xFFA0, 0xFFA8, 0xFFB0, 0xFFB8, 0xFFC0, 0xFFC8, 0xFFD0, 0xFFD8, 0xFFE0, 0xFFE8, 0xFFF0, 0xFFF8, 0x0000, 
-    0x7D7C, 0x797C, 0x757C, 0x717C, 0x6D7C, 0x697C, 0x657C, 0x617C, 0x5D7C, 0x597C, 0x557C, 0x517C, 0x4D7C, 0x497C, 0x457C, 0x417C, 
-    0x3E7C, 0x3C7C, 0x3A7C, 0x387C, 0x367C, 0x347C, 0x327C, 0x307C, 0x2E7C, 0x2C7C, 0x2A7C, 0x287C, 0x267C, 0x247C, 0x227C, 0x207C, 
-    0x1EFC, 0x1DFC, 0x1CFC, 0x1BFC, 0x1AFC, 0x19FC, 0x18FC, 0x17FC, 0x16FC, 0x15FC, 0x14FC, 0x13FC, 0x12FC, 0x11FC, 0x10FC, 0x0FFC, 
-    0x0F3C, 0x0EBC, 0x0E3C, 0x0DBC, 0x0D3C, 0x0CBC, 0x0C3C, 0x0BBC, 0x0B3C, 0x0ABC, 0x0A3C, 0x09BC, 0x093C, 0x08BC, 0x083C, 0x07BC, 
-    0x075C, 0x071C, 0x06DC, 0x069C, 0x065C, 0x061C, 0x05DC, 0x059C, 0x055C, 0x051C, 0x04DC, 0x049C, 0x045C, 0x041C, 0x03DC, 0x039C, 
-    0x036C, 0x034C, 0x032C, 0x030C, 0x02EC, 0x02CC, 0x02AC, 0x028C, 0x026C, 0x024C, 0x022C, 0x020C, 0x01EC, 0x01CC, 0x01AC, 0x018C, 
-    0x0174, 0x0164, 0x0154, 0x0144, 0x0134, 0x0124, 0x0114, 0x0104, 0x00F4, 0x00E4, 0x00D4, 0x00C4, 0x00B4, 0x00A4, 0x0094, 0x0084, 
-    0x0078, 0x0070, 0x0068, 0x0060, 0x0058, 0x0050, 0x0048, 0x0040, 0x0038, 0x0030, 0x0028, 0x0020, 0x0018, 0x0010, 0x0008, 0x0000
-};
+    drwav_uint16 bytesPerSample = (drwav_uint16)((fmt.bitsPerSample + 7) / 8);
+    fmt.blockAlign     = (drwav_uint16)(fmt.channels * bytesPerSample);
+    fmt.avgBytesPerSec = fmt.blockAlign * fmt.sampleRate;
 
-static DRWAV_INLINE drwav_int16 drwav__alaw_to_s16(drwav_uint8 sampleIn)
-{
-    return (short)g_drwavAlawTable[sampleIn];
-}
+    // The "SSND" chunk may be padded out past the last frame.
+    if (dataSize > (drwav_uint64)frameCount * fmt.blockAlign) {
+        dataSize = (drwav_uint64)frameCount * fmt.blockAlign;
+    }
 
-static DRWAV_INLINE drwav_int16 drwav__mulaw_to_s16(drwav_uint8 sampleIn)
-{
-    return (short)g_drwavMulawTable[sampleIn];
-}
+    pWav->container           = drwav_container_aiff;
+    pWav->fmt                 = fmt;
+    pWav->sampleRate          = fmt.sampleRate;
+    pWav->channels            = fmt.channels;
+    pWav->bitsPerSample       = fmt.bitsPerSample;
+    pWav->bytesPerSample      = bytesPerSample;
+    pWav->translatedFormatTag = fmt.formatTag;
+    pWav->dataChunkDataPos    = dataPos;
+    pWav->dataChunkDataSize   = dataSize;
+    pWav->bytesRemaining      = dataSize;
+    pWav->totalSampleCount    = dataSize / bytesPerSample;
 
+    if (fmt.formatTag == DR_WAVE_FORMAT_PCM || fmt.formatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        pWav->aiff.isBigEndian  = (drwav_bool8)(isBigEndian && bytesPerSample > 1);
+        pWav->aiff.isSigned8Bit = (drwav_bool8)(fmt.formatTag == DR_WAVE_FORMAT_PCM && bytesPerSample == 1);
+    }
 
+    return DRWAV_TRUE;
+}
 
-static void drwav__pcm_to_s16(drwav_int16* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
+static drwav_bool32 drwav__init(drwav* pWav, drwav_read_proc onRead, drwav_seek_proc onSeek, drwav_seek64_proc onSeek64, void* pUserData)
 {
-    // Special case for 8-bit sample data because it's treated as unsigned.
-    if (bytesPerSample == 1) {
-        drwav_u8_to_s16(pOut, pIn, totalSampleCount);
-        return;
+    if (onRead == NULL || (onSeek == NULL && onSeek64 == NULL)) {
+        return DRWAV_FALSE;
     }
 
+    drwav_zero_memory(pWav, sizeof(*pWav));
+    pWav->onRead    = onRead;
+    pWav->onSeek    = onSeek;
+    pWav->onSeek64  = onSeek64;
+    pWav->pUserData = pUserData;
 
-    // Slightly more optimal implementation for common formats.
-    if (bytesPerSample == 2) {
-        for (unsigned int i = 0; i < totalSampleCount; ++i) {
-           *pOut++ = ((drwav_int16*)pIn)[i];
-        }
-        return;
-    }
-    if (bytesPerSample == 3) {
-        drwav_s24_to_s16(pOut, pIn, totalSampleCount);
-        return;
+
+    // The first 4 bytes should be the RIFF identifier.
+    unsigned char riff[4];
+    if (onRead(pUserData, riff, sizeof(riff)) != sizeof(riff)) {
+        return DRWAV_FALSE;    // Failed to read data.
     }
-    if (bytesPerSample == 4) {
-        drwav_s32_to_s16(pOut, (const drwav_int32*)pIn, totalSampleCount);
-        return;
+
+    // The first 4 bytes can be used to identify the container. For RIFF files it will start with "RIFF", for RF64
+    // it will start with "RF64", for w64 it will start with "riff" and for AIFF it will start with "FORM".
+    if (drwav__fourcc_equal(riff, "FORM")) {
+        return drwav__init_aiff(pWav);
     }
 
+    if (drwav__fourcc_equal(riff, "RIFF")) {
+        pWav->container = drwav_container_riff;
+    } else if (drwav__fourcc_equal(riff, "RF64")) {
+        pWav->container = drwav_container_rf64;
+    } else if (drwav__fourcc_equal(riff, "riff")) {
+        pWav->container = drwav_container_w64;
 
-    // Generic, slow converter.
-    for (unsigned int i = 0; i < totalSampleCount; ++i) {
-        unsigned short sample = 0;
-        unsigned short shift  = (8 - bytesPerSample) * 8;
-        for (unsigned short j = 0; j < bytesPerSample && j < 2; ++j) {
-            sample |= (unsigned short)(pIn[j]) << shift;
-            shift  += 8;
+        // Check the rest of the GUID for validity.
+        drwav_uint8 riff2[12];
+        if (onRead(pUserData, riff2, sizeof(riff2)) != sizeof(riff2)) {
+            return DRWAV_FALSE;
         }
 
-        pIn += bytesPerSample;
-        *pOut++ = sample;
-    }
-}
-
-static void drwav__ieee_to_s16(drwav_int16* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
-{
-    if (bytesPerSample == 4) {
-        drwav_f32_to_s16(pOut, (float*)pIn, totalSampleCount);
-        return;
+        for (int i = 0; i < 12; ++i) {
+            if (riff2[i] != drwavGUID_W64_RIFF[i+4]) {
+                return DRWAV_FALSE;
+            }
+        }
     } else {
-        drwav_f64_to_s16(pOut, (double*)pIn, totalSampleCount);
-        return;
+        return DRWAV_FALSE;   // Unknown or unsupported container.
     }
-}
 
-drwav_uint64 drwav_read_s16__pcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
-{
-    // Fast path.
-    if (pWav->bytesPerSample == 2) {
-        return drwav_read(pWav, samplesToRead, pBufferOut);
-    }
 
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+    if (pWav->container != drwav_container_w64) {
+        // RIFF/WAVE and RF64/WAVE
+        unsigned char chunkSizeBytes[4];
+        if (onRead(pUserData, chunkSizeBytes, sizeof(chunkSizeBytes)) != sizeof(chunkSizeBytes)) {
+            return DRWAV_FALSE;
         }
 
-        drwav__pcm_to_s16(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
+        unsigned int chunkSize = drwav__bytes_to_u32(chunkSizeBytes);
+        if (chunkSize < 36) {
+            return DRWAV_FALSE;    // Chunk size should always be at least 36 bytes.
+        }
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
-    }
+        unsigned char wave[4];
+        if (onRead(pUserData, wave, sizeof(wave)) != sizeof(wave)) {
+            return DRWAV_FALSE;
+        }
 
-    return totalSamplesRead;
-}
+        if (!drwav__fourcc_equal(wave, "WAVE")) {
+            return DRWAV_FALSE;    // Expecting "WAVE".
+        }
 
-drwav_uint64 drwav_read_s16__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
-{
-    drwav_assert(pWav != NULL);
-    drwav_assert(samplesToRead > 0);
-    drwav_assert(pBufferOut != NULL);
+        pWav->dataChunkDataPos = 4 + sizeof(chunkSizeBytes) + sizeof(wave);
+    } else {
+        // W64
+        unsigned char chunkSize[8];
+        if (onRead(pUserData, chunkSize, sizeof(chunkSize)) != sizeof(chunkSize)) {
+            return DRWAV_FALSE;
+        }
 
-    // TODO: Lots of room for optimization here.
+        if (drwav__bytes_to_u64(chunkSize) < 84) {
+            return DRWAV_FALSE;
+        }
 
-    drwav_uint64 totalSamplesRead = 0;
+        drwav_uint8 wave[16];
+        if (onRead(pUserData, wave, sizeof(wave)) != sizeof(wave)) {
+            return DRWAV_FALSE;
+        }
 
-    while (samplesToRead > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
-        // If there are no cached samples we need to load a new block.
-        if (pWav->msadpcm.cachedSampleCount == 0 && pWav->msadpcm.bytesRemainingInBlock == 0) {
-            if (pWav->channels == 1) {
-                // Mono.
-                drwav_uint8 header[7];
-                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
-                    return totalSamplesRead;
-                }
-                pWav->msadpcm.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+        if (!drwav__guid_equal(wave, drwavGUID_W64_WAVE)) {
+            return DRWAV_FALSE;
+        }
 
-                pWav->msadpcm.predictor[0] = header[0];
-                pWav->msadpcm.delta[0] = drwav__bytes_to_s16(header + 1);
-                pWav->msadpcm.prevSamples[0][1] = (drwav_int32)drwav__bytes_to_s16(header + 3);
-                pWav->msadpcm.prevSamples[0][0] = (drwav_int32)drwav__bytes_to_s16(header + 5);
-                pWav->msadpcm.cachedSamples[2] = pWav->msadpcm.prevSamples[0][0];
-                pWav->msadpcm.cachedSamples[3] = pWav->msadpcm.prevSamples[0][1];
-                pWav->msadpcm.cachedSampleCount = 2;
-            } else {
-                // Stereo.
-                drwav_uint8 header[14];
-                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
-                    return totalSamplesRead;
-                }
-                pWav->msadpcm.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+        pWav->dataChunkDataPos = 16 + sizeof(chunkSize) + sizeof(wave);
+    }
 
-                pWav->msadpcm.predictor[0] = header[0];
-                pWav->msadpcm.predictor[1] = header[1];
-                pWav->msadpcm.delta[0] = drwav__bytes_to_s16(header + 2);
-                pWav->msadpcm.delta[1] = drwav__bytes_to_s16(header + 4);
-                pWav->msadpcm.prevSamples[0][1] = (drwav_int32)drwav__bytes_to_s16(header + 6);
-                pWav->msadpcm.prevSamples[1][1] = (drwav_int32)drwav__bytes_to_s16(header + 8);
-                pWav->msadpcm.prevSamples[0][0] = (drwav_int32)drwav__bytes_to_s16(header + 10);
-                pWav->msadpcm.prevSamples[1][0] = (drwav_int32)drwav__bytes_to_s16(header + 12);
 
-                pWav->msadpcm.cachedSamples[0] = pWav->msadpcm.prevSamples[0][0];
-                pWav->msadpcm.cachedSamples[1] = pWav->msadpcm.prevSamples[1][0];
-                pWav->msadpcm.cachedSamples[2] = pWav->msadpcm.prevSamples[0][1];
-                pWav->msadpcm.cachedSamples[3] = pWav->msadpcm.prevSamples[1][1];
-                pWav->msadpcm.cachedSampleCount = 4;
-            }
+    // RF64 files store their real sizes in a "ds64" chunk which must come straight after the "WAVE" identifier. The 32-bit
+    // sizes in the RIFF and data chunk headers are set to 0xFFFFFFFF.
+    drwav_uint64 dataSizeFromDS64 = 0;
+    if (pWav->container == drwav_container_rf64) {
+        drwav__chunk_header header;
+        if (!drwav__read_chunk_header(onRead, pUserData, pWav->container, &pWav->dataChunkDataPos, &header)) {
+            return DRWAV_FALSE;
         }
 
-        // Output anything that's cached.
-        while (samplesToRead > 0 && pWav->msadpcm.cachedSampleCount > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
-            pBufferOut[0] = (drwav_int16)pWav->msadpcm.cachedSamples[drwav_countof(pWav->msadpcm.cachedSamples) - pWav->msadpcm.cachedSampleCount];
-            pWav->msadpcm.cachedSampleCount -= 1;
-
-            pBufferOut += 1;
-            samplesToRead -= 1;
-            totalSamplesRead += 1;
-            pWav->compressed.iCurrentSample += 1;
+        if (!drwav__fourcc_equal(header.id.fourcc, "ds64") || header.sizeInBytes < 24) {
+            return DRWAV_FALSE;
         }
 
-        if (samplesToRead == 0) {
-            return totalSamplesRead;
+        unsigned char ds64[24];     // <-- RIFF size, data size, sample count. The table that may follow is not used.
+        if (onRead(pUserData, ds64, sizeof(ds64)) != sizeof(ds64)) {
+            return DRWAV_FALSE;
         }
 
+        dataSizeFromDS64 = drwav__bytes_to_u64(ds64 + 8);
 
-        // If there's nothing left in the cache, just go ahead and load more. If there's nothing left to load in the current block we just continue to the next
-        // loop iteration which will trigger the loading of a new block.
-        if (pWav->msadpcm.cachedSampleCount == 0) {
-            if (pWav->msadpcm.bytesRemainingInBlock == 0) {
-                continue;
-            } else {
-                drwav_uint8 nibbles;
-                if (pWav->onRead(pWav->pUserData, &nibbles, 1) != 1) {
-                    return totalSamplesRead;
-                }
-                pWav->msadpcm.bytesRemainingInBlock -= 1;
-
-                // TODO: Optimize away these if statements.
-                drwav_int32 nibble0 = ((nibbles & 0xF0) >> 4); if ((nibbles & 0x80)) { nibble0 |= 0xFFFFFFF0UL; }
-                drwav_int32 nibble1 = ((nibbles & 0x0F) >> 0); if ((nibbles & 0x08)) { nibble1 |= 0xFFFFFFF0UL; }
-
-                static drwav_int32 adaptationTable[] = { 
-                    230, 230, 230, 230, 307, 409, 512, 614, 
-                    768, 614, 512, 409, 307, 230, 230, 230 
-                };
-                static drwav_int32 coeff1Table[] = { 256, 512, 0, 192, 240, 460,  392 };
-                static drwav_int32 coeff2Table[] = { 0,  -256, 0, 64,  0,  -208, -232 };
-
-                if (pWav->channels == 1) {
-                    // Mono.
-                    drwav_int32 newSample0;
-                    newSample0  = ((pWav->msadpcm.prevSamples[0][1] * coeff1Table[pWav->msadpcm.predictor[0]]) + (pWav->msadpcm.prevSamples[0][0] * coeff2Table[pWav->msadpcm.predictor[0]])) >> 8;
-                    newSample0 += nibble0 * pWav->msadpcm.delta[0];
-                    newSample0  = drwav_clamp(newSample0, -32768, 32767);
-
-                    pWav->msadpcm.delta[0] = (adaptationTable[((nibbles & 0xF0) >> 4)] * pWav->msadpcm.delta[0]) >> 8;
-                    if (pWav->msadpcm.delta[0] < 16) {
-                        pWav->msadpcm.delta[0] = 16;
-                    }
+        if (!drwav__seek_forward(pWav, header.sizeInBytes - sizeof(ds64) + header.paddingSize)) {
+            return DRWAV_FALSE;
+        }
+        pWav->dataChunkDataPos += header.sizeInBytes + header.paddingSize;
+    }
 
-                    pWav->msadpcm.prevSamples[0][0] = pWav->msadpcm.prevSamples[0][1];
-                    pWav->msadpcm.prevSamples[0][1] = newSample0;
 
+    // The next 24 bytes should be the "fmt " chunk.
+    drwav_fmt fmt;
+    if (!drwav__read_fmt(pWav, &pWav->dataChunkDataPos, &fmt)) {
+        return DRWAV_FALSE;    // Failed to read the "fmt " chunk.
+    }
 
-                    drwav_int32 newSample1;
-                    newSample1  = ((pWav->msadpcm.prevSamples[0][1] * coeff1Table[pWav->msadpcm.predictor[0]]) + (pWav->msadpcm.prevSamples[0][0] * coeff2Table[pWav->msadpcm.predictor[0]])) >> 8;
-                    newSample1 += nibble1 * pWav->msadpcm.delta[0];
-                    newSample1  = drwav_clamp(newSample1, -32768, 32767);
 
-                    pWav->msadpcm.delta[0] = (adaptationTable[((nibbles & 0x0F) >> 0)] * pWav->msadpcm.delta[0]) >> 8;
-                    if (pWav->msadpcm.delta[0] < 16) {
-                        pWav->msadpcm.delta[0] = 16;
-                    }
+    // Translate the internal format.
+    unsigned short translatedFormatTag = fmt.formatTag;
+    if (translatedFormatTag == DR_WAVE_FORMAT_EXTENSIBLE) {
+        translatedFormatTag = drwav__bytes_to_u16(fmt.subFormat + 0);
+    }
+
+
+    drwav_uint64 sampleCountFromFactChunk = 0;
+
+    // The next chunk we care about is the "data" chunk. This is not necessarily the next chunk so we'll need to loop.
+    drwav_uint64 dataSize;
+    for (;;)
+    {
+        drwav__chunk_header header;
+        if (!drwav__read_chunk_header(onRead, pUserData, pWav->container, &pWav->dataChunkDataPos, &header)) {
+            return DRWAV_FALSE;
+        }
 
-                    pWav->msadpcm.prevSamples[0][0] = pWav->msadpcm.prevSamples[0][1];
-                    pWav->msadpcm.prevSamples[0][1] = newSample1;
+        dataSize = header.sizeInBytes;
+        if (pWav->container != drwav_container_w64) {
+            if (drwav__fourcc_equal(header.id.fourcc, "data")) {
+                if (pWav->container == drwav_container_rf64 && dataSize == 0xFFFFFFFF) {
+                    dataSize = dataSizeFromDS64;
+                }
+                break;
+            }
+        } else {
+            if (drwav__guid_equal(header.id.guid, drwavGUID_W64_DATA)) {
+                break;
+            }
+        }
 
+        // Optional. Get the total sample count from the FACT chunk. This is useful for compressed formats.
+        if (pWav->container != drwav_container_w64) {
+            if (drwav__fourcc_equal(header.id.fourcc, "fact")) {
+                drwav_uint32 sampleCount;
+                if (onRead(pUserData, &sampleCount, 4) != 4) {
+                    return DRWAV_FALSE;
+                }
+                pWav->dataChunkDataPos += 4;
+                dataSize -= 4;
 
-                    pWav->msadpcm.cachedSamples[2] = newSample0;
-                    pWav->msadpcm.cachedSamples[3] = newSample1;
-                    pWav->msadpcm.cachedSampleCount = 2;
+                // The sample count in the "fact" chunk is either unreliable, or I'm not understanding it properly. For now I am only enabling this
+                // for the ADPCM formats, where the last block is usually only partially used and the count can't be derived from the data size.
+                if (translatedFormatTag == DR_WAVE_FORMAT_ADPCM || translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+                    sampleCountFromFactChunk = sampleCount;
                 } else {
-                    // Stereo.
+                    sampleCountFromFactChunk = 0;
+                }
+            }
+        } else {
+            if (drwav__guid_equal(header.id.guid, drwavGUID_W64_FACT)) {
+                if (onRead(pUserData, &sampleCountFromFactChunk, 8) != 8) {
+                    return DRWAV_FALSE;
+                }
+                pWav->dataChunkDataPos += 8;
+                dataSize -= 8;
+            }
+        }
 
-                    // Left.
-                    drwav_int32 newSample0;
-                    newSample0  = ((pWav->msadpcm.prevSamples[0][1] * coeff1Table[pWav->msadpcm.predictor[0]]) + (pWav->msadpcm.prevSamples[0][0] * coeff2Table[pWav->msadpcm.predictor[0]])) >> 8;
-                    newSample0 += nibble0 * pWav->msadpcm.delta[0];
-                    newSample0  = drwav_clamp(newSample0, -32768, 32767);
+        // If we get here it means we didn't find the "data" chunk. Seek past it.
 
-                    pWav->msadpcm.delta[0] = (adaptationTable[((nibbles & 0xF0) >> 4)] * pWav->msadpcm.delta[0]) >> 8;
-                    if (pWav->msadpcm.delta[0] < 16) {
-                        pWav->msadpcm.delta[0] = 16;
-                    }
+        // Make sure we seek past the padding.
+        dataSize += header.paddingSize;
+        drwav__seek_forward(pWav, dataSize);
+        pWav->dataChunkDataPos += dataSize;
+    }
+
+    // At this point we should be sitting on the first byte of the raw audio data.
+
+    pWav->fmt                 = fmt;
+    pWav->sampleRate          = fmt.sampleRate;
+    pWav->channels            = fmt.channels;
+    pWav->bitsPerSample       = fmt.bitsPerSample;
+    pWav->bytesPerSample      = (unsigned int)(fmt.blockAlign / fmt.channels);
+    pWav->bytesRemaining      = dataSize;
+    pWav->translatedFormatTag = translatedFormatTag;
+    pWav->dataChunkDataSize   = dataSize;
+
+    if (sampleCountFromFactChunk != 0) {
+        pWav->totalSampleCount = sampleCountFromFactChunk * fmt.channels;
+    } else {
+        pWav->totalSampleCount = dataSize / pWav->bytesPerSample;
+
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+            drwav_uint64 blockCount = dataSize / fmt.blockAlign;
+            pWav->totalSampleCount = (blockCount * (fmt.blockAlign - (6*pWav->channels))) * 2;  // x2 because two samples per byte.
+        }
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+            drwav_uint64 blockCount = dataSize / fmt.blockAlign;
+            pWav->totalSampleCount = ((blockCount * (fmt.blockAlign - (4*pWav->channels))) * 2) + (blockCount * pWav->channels);
+        }
+    }
+    
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        pWav->bytesPerSample = 0;
+    }
+
+#ifdef DR_WAV_LIBSNDFILE_COMPAT
+    // I use libsndfile as a benchmark for testing, however in the version I'm using (from the Windows installer on the libsndfile website),
+    // it appears the total sample count libsndfile uses for MS-ADPCM is incorrect. It would seem they are computing the total sample count
+    // from the number of blocks, however this results in the inclusion of the extra silent samples at the end of the last block. The correct
+    // way to know the total sample count is to inspect the "fact" chunk which should always be present for compressed formats, and should
+    // always include the sample count. This little block of code below is only used to emulate the libsndfile logic so I can properly run my
+    // correctness tests against libsndfile and is disabled by default.
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        drwav_uint64 blockCount = dataSize / fmt.blockAlign;
+        pWav->totalSampleCount = (blockCount * (fmt.blockAlign - (6*pWav->channels))) * 2;  // x2 because two samples per byte.
+    }
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        drwav_uint64 blockCount = dataSize / fmt.blockAlign;
+        pWav->totalSampleCount = ((blockCount * (fmt.blockAlign - (4*pWav->channels))) * 2) + (blockCount * pWav->channels);
+    }
+#endif
 
-                    pWav->msadpcm.prevSamples[0][0] = pWav->msadpcm.prevSamples[0][1];
-                    pWav->msadpcm.prevSamples[0][1] = newSample0;
+    return DRWAV_TRUE;
+}
 
+drwav_bool32 drwav_init(drwav* pWav, drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData)
+{
+    if (onSeek == NULL) {
+        return DRWAV_FALSE;
+    }
 
-                    // Right.
-                    drwav_int32 newSample1;
-                    newSample1  = ((pWav->msadpcm.prevSamples[1][1] * coeff1Table[pWav->msadpcm.predictor[1]]) + (pWav->msadpcm.prevSamples[1][0] * coeff2Table[pWav->msadpcm.predictor[1]])) >> 8;
-                    newSample1 += nibble1 * pWav->msadpcm.delta[1];
-                    newSample1  = drwav_clamp(newSample1, -32768, 32767);
+    return drwav__init(pWav, onRead, onSeek, NULL, pUserData);
+}
 
-                    pWav->msadpcm.delta[1] = (adaptationTable[((nibbles & 0x0F) >> 0)] * pWav->msadpcm.delta[1]) >> 8;
-                    if (pWav->msadpcm.delta[1] < 16) {
-                        pWav->msadpcm.delta[1] = 16;
-                    }
+drwav_bool32 drwav_init_seek64(drwav* pWav, drwav_read_proc onRead, drwav_seek64_proc onSeek64, void* pUserData)
+{
+    if (onSeek64 == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    return drwav__init(pWav, onRead, NULL, onSeek64, pUserData);
+}
 
-                    pWav->msadpcm.prevSamples[1][0] = pWav->msadpcm.prevSamples[1][1];
-                    pWav->msadpcm.prevSamples[1][1] = newSample1;
+// RIFF files reserve space for a "ds64" chunk with a "JUNK" chunk of the same size so they can be converted to RF64 in place
+// once the final size is known. The reserved chunk holds the 64-bit RIFF size, data size and sample count, followed by an
+// empty table.
+#define DRWAV_DS64_CHUNK_DATA_SIZE  28
 
-                    pWav->msadpcm.cachedSamples[2] = newSample0;
-                    pWav->msadpcm.cachedSamples[3] = newSample1;
-                    pWav->msadpcm.cachedSampleCount = 2;
-                }
+// Most encoders use 256 bytes per channel for every 11025 Hz of sample rate. That's about 23 ms per block.
+static drwav_uint16 drwav__get_default_adpcm_block_align(drwav_uint32 channels, drwav_uint32 sampleRate)
+{
+    drwav_uint32 multiplier = drwav_clamp(sampleRate / 11025, 1, 32);
+    return (drwav_uint16)(256 * channels * multiplier);
+}
+
+#ifndef DR_WAV_NO_CONVERSION_API
+static drwav_bool32 drwav__is_valid_adpcm_block_align(drwav_uint16 formatTag, drwav_uint32 channels, drwav_uint16 blockAlign)
+{
+    // The header of each block holds the decoder state of each channel, followed by two samples per byte. The number of samples
+    // per channel is stored in the "fmt " chunk as a 16-bit value.
+    drwav_uint32 samplesPerBlock;
+    if (formatTag == DR_WAVE_FORMAT_ADPCM) {
+        if (blockAlign <= 7*channels) {
+            return DRWAV_FALSE;
+        }
+        samplesPerBlock = 2 + ((blockAlign - 7*channels) * 2) / channels;
+    } else {
+        // IMA ADPCM stores samples in groups of 4 bytes per channel.
+        if (blockAlign <= 4*channels || ((blockAlign - 4*channels) % (4*channels)) != 0) {
+            return DRWAV_FALSE;
+        }
+        samplesPerBlock = 1 + ((blockAlign - 4*channels) * 2) / channels;
+    }
+
+    return samplesPerBlock <= 0xFFFF;
+}
+#endif
+
+// Serializes the "fmt " chunk of a writer into <pOut>, which must have room for 50 bytes. Compressed formats are followed by the
+// number of samples per channel in each block and, for Microsoft ADPCM, the coefficients of each predictor. WAVE_FORMAT_EXTENSIBLE
+// is followed by the valid bits per sample, the channel mask and the sub-format. Returns the number of bytes written.
+static size_t drwav__fmt_to_bytes(drwav* pWav, unsigned char* pOut)
+{
+    size_t size = 0;
+    drwav__u16_to_bytes(pOut + size, pWav->fmt.formatTag);      size += 2;
+    drwav__u16_to_bytes(pOut + size, pWav->fmt.channels);       size += 2;
+    drwav__u32_to_bytes(pOut + size, pWav->fmt.sampleRate);     size += 4;
+    drwav__u32_to_bytes(pOut + size, pWav->fmt.avgBytesPerSec); size += 4;
+    drwav__u16_to_bytes(pOut + size, pWav->fmt.blockAlign);     size += 2;
+    drwav__u16_to_bytes(pOut + size, pWav->fmt.bitsPerSample);  size += 2;
+
+    if (drwav__is_compressed_format_tag(pWav->fmt.formatTag)) {
+        drwav__u16_to_bytes(pOut + size, pWav->fmt.extendedSize);                                                          size += 2;
+        drwav__u16_to_bytes(pOut + size, (drwav_uint16)(drwav__get_compressed_samples_per_block(pWav) / pWav->channels));  size += 2;
+
+        if (pWav->fmt.formatTag == DR_WAVE_FORMAT_ADPCM) {
+            drwav__u16_to_bytes(pOut + size, (drwav_uint16)drwav_countof(g_drwavMSADPCMCoeff1Table)); size += 2;
+            for (size_t iCoeff = 0; iCoeff < drwav_countof(g_drwavMSADPCMCoeff1Table); ++iCoeff) {
+                drwav__u16_to_bytes(pOut + size, (drwav_uint16)g_drwavMSADPCMCoeff1Table[iCoeff]);  size += 2;
+                drwav__u16_to_bytes(pOut + size, (drwav_uint16)g_drwavMSADPCMCoeff2Table[iCoeff]);  size += 2;
             }
         }
     }
 
-    return totalSamplesRead;
+    if (pWav->fmt.formatTag == DR_WAVE_FORMAT_EXTENSIBLE) {
+        drwav__u16_to_bytes(pOut + size, pWav->fmt.extendedSize);          size += 2;
+        drwav__u16_to_bytes(pOut + size, pWav->fmt.validBitsPerSample);    size += 2;
+        drwav__u32_to_bytes(pOut + size, pWav->fmt.channelMask);           size += 4;
+        drwav_copy_memory(pOut + size, pWav->fmt.subFormat, 16);           size += 16;
+    }
+
+    return size;
 }
 
-drwav_uint64 drwav_read_s16__ima(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+// The speaker positions used for the channel mask of WAVE_FORMAT_EXTENSIBLE streams written by dr_wav. These are the usual layouts
+// for mono, stereo, 3.0, quad, 5.0, 5.1, 6.1 and 7.1. Streams with more channels don't have speaker positions.
+static drwav_uint32 drwav__get_default_channel_mask(drwav_uint16 channels)
+{
+    static const drwav_uint32 masks[8] = {0x4, 0x3, 0x7, 0x33, 0x37, 0x3F, 0x70F, 0x63F};
+    if (channels == 0 || channels > drwav_countof(masks)) {
+        return 0;
+    }
+
+    return masks[channels - 1];
+}
+
+// Sets the block size of an ADPCM writer along with everything in the "fmt " chunk that depends on it.
+static drwav_bool32 drwav__set_adpcm_block_align(drwav* pWav, drwav_uint16 blockAlign)
+{
+    drwav_uint16 oldBlockAlign = pWav->fmt.blockAlign;
+    pWav->fmt.blockAlign = blockAlign;
+
+    size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
+    drwav_int16* pPendingSamples = (drwav_int16*)DRWAV_REALLOC(pWav->adpcmEncoder.pPendingSamples, samplesPerBlock * pWav->adpcmEncoder.pendingBlockCapacity * sizeof(drwav_int16));
+    if (pPendingSamples == NULL) {
+        pWav->fmt.blockAlign = oldBlockAlign;
+        return DRWAV_FALSE;
+    }
+
+    pWav->adpcmEncoder.pPendingSamples = pPendingSamples;
+    pWav->fmt.avgBytesPerSec = (drwav_uint32)(((drwav_uint64)blockAlign * pWav->fmt.sampleRate) / (samplesPerBlock / pWav->channels));
+    return DRWAV_TRUE;
+}
+
+static drwav_bool32 drwav__init_write(drwav* pWav, const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData)
+{
+    if (pFormat == NULL || onWrite == NULL || onSeek == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    // AIFF is only supported for reading.
+    if (pFormat->container == drwav_container_aiff) {
+        return DRWAV_FALSE;
+    }
+
+    if (pFormat->format == DR_WAVE_FORMAT_EXTENSIBLE) {
+        return DRWAV_FALSE;
+    }
+
+    if (pFormat->channels == 0 || pFormat->channels > 0xFFFF || pFormat->bitsPerSample == 0 || pFormat->bitsPerSample > 0xFFFF) {
+        return DRWAV_FALSE;
+    }
+
+    // Compressed formats are encoded by drwav_write(), which uses the same decoder state and tables as the conversion API.
+    drwav_bool32 isCompressed = drwav__is_compressed_format_tag((drwav_uint16)pFormat->format);
+    if (isCompressed) {
+#ifdef DR_WAV_NO_CONVERSION_API
+        return DRWAV_FALSE;
+#else
+        if ((pFormat->channels != 1 && pFormat->channels != 2) || pFormat->bitsPerSample != 4) {
+            return DRWAV_FALSE;
+        }
+#endif
+    }
+
+    pWav->onWrite   = onWrite;
+    pWav->onSeek    = onSeek;
+    pWav->pUserData = pUserData;
+    pWav->container = pFormat->container;
+
+    pWav->fmt.formatTag      = (drwav_uint16)pFormat->format;
+    pWav->fmt.channels       = (drwav_uint16)pFormat->channels;
+    pWav->fmt.sampleRate     = pFormat->sampleRate;
+    pWav->fmt.blockAlign     = (drwav_uint16)(pFormat->channels * ((pFormat->bitsPerSample + 7) / 8));
+    pWav->fmt.avgBytesPerSec = pWav->fmt.blockAlign * pFormat->sampleRate;
+    pWav->fmt.bitsPerSample  = (drwav_uint16)pFormat->bitsPerSample;
+    pWav->fmt.extendedSize   = 0;
+
+    pWav->sampleRate          = pWav->fmt.sampleRate;
+    pWav->channels            = pWav->fmt.channels;
+    pWav->bitsPerSample       = (drwav_uint16)pFormat->bitsPerSample;
+    pWav->bytesPerSample      = (drwav_uint16)(pWav->fmt.blockAlign / pWav->fmt.channels);
+    pWav->translatedFormatTag = (drwav_uint16)pFormat->format;
+
+    // WAVE_FORMAT_EXTENSIBLE is required for more than 2 channels or more than 16 bits per sample. The format that was asked for
+    // becomes the sub-format, and <bitsPerSample> becomes the size of the container, with the real number of bits stored separately.
+    if (!isCompressed && (pFormat->channels > 2 || pFormat->bitsPerSample > 16)) {
+        static const drwav_uint8 subFormatTail[14] = {0x00,0x00, 0x00,0x00, 0x10,0x00, 0x80,0x00, 0x00,0xAA,0x00,0x38,0x9B,0x71};
+
+        pWav->fmt.formatTag          = DR_WAVE_FORMAT_EXTENSIBLE;
+        pWav->fmt.bitsPerSample      = (drwav_uint16)(pWav->bytesPerSample * 8);
+        pWav->fmt.extendedSize       = 22;
+        pWav->fmt.validBitsPerSample = (drwav_uint16)pFormat->bitsPerSample;
+        pWav->fmt.channelMask        = drwav__get_default_channel_mask(pWav->fmt.channels);
+        drwav__u16_to_bytes(pWav->fmt.subFormat, (drwav_uint16)pFormat->format);
+        drwav_copy_memory(pWav->fmt.subFormat + 2, subFormatTail, sizeof(subFormatTail));
+    }
+
+    if (isCompressed) {
+        pWav->fmt.extendedSize = (pWav->fmt.formatTag == DR_WAVE_FORMAT_ADPCM) ? 32 : 2;
+        pWav->adpcmEncoder.threadCount = 1;
+        pWav->adpcmEncoder.pendingBlockCapacity = 1;
+        if (!drwav__set_adpcm_block_align(pWav, drwav__get_default_adpcm_block_align(pWav->channels, pWav->sampleRate))) {
+            return DRWAV_FALSE;
+        }
+    }
+
+    unsigned char fmt[50];
+    size_t fmtSize = drwav__fmt_to_bytes(pWav, fmt);
+    drwav_assert(fmtSize <= sizeof(fmt));
+
+
+    // The whole header is assembled in memory and written with a single call. The sizes are placeholders which are
+    // updated in drwav_uninit(). Formats other than PCM have a "fact" chunk before the "data" chunk for the sample count.
+    drwav_bool32 hasFactChunk = pWav->translatedFormatTag != DR_WAVE_FORMAT_PCM;
+    unsigned char header[200];
+    size_t headerSize = 0;
+
+    if (pWav->container != drwav_container_w64) {
+        // "RIFF" or "RF64", followed by "WAVE" and then either "JUNK" or "ds64".
+        drwav_copy_memory(header + headerSize, (pWav->container == drwav_container_rf64) ? "RF64" : "RIFF", 4); headerSize += 4;
+        drwav__u32_to_bytes(header + headerSize, 0xFFFFFFFF);                                                  headerSize += 4;
+        drwav_copy_memory(header + headerSize, "WAVE", 4);                                                     headerSize += 4;
+        drwav_copy_memory(header + headerSize, (pWav->container == drwav_container_rf64) ? "ds64" : "JUNK", 4); headerSize += 4;
+        drwav__u32_to_bytes(header + headerSize, DRWAV_DS64_CHUNK_DATA_SIZE);                                  headerSize += 4;
+        drwav_zero_memory(header + headerSize, DRWAV_DS64_CHUNK_DATA_SIZE);                                    headerSize += DRWAV_DS64_CHUNK_DATA_SIZE;
+
+        drwav_copy_memory(header + headerSize, "fmt ", 4);                                                     headerSize += 4;
+        drwav__u32_to_bytes(header + headerSize, (drwav_uint32)fmtSize);                                       headerSize += 4;
+        drwav_copy_memory(header + headerSize, fmt, fmtSize);                                                  headerSize += fmtSize;   // <-- Always even.
+
+        if (hasFactChunk) {
+            drwav_copy_memory(header + headerSize, "fact", 4);                                                 headerSize += 4;
+            drwav__u32_to_bytes(header + headerSize, 4);                                                       headerSize += 4;
+            drwav__u32_to_bytes(header + headerSize, 0);                                                       headerSize += 4;
+        }
+
+        drwav_copy_memory(header + headerSize, "data", 4);                                                     headerSize += 4;
+        drwav__u32_to_bytes(header + headerSize, 0xFFFFFFFF);                                                  headerSize += 4;
+    } else {
+        // W64 chunks are aligned to 8 bytes. Rather than padding the "fmt " chunk it is made a multiple of 8 bytes long, which is
+        // allowed because the fields that are used are described by the chunk itself.
+        size_t fmtChunkDataSize = (fmtSize + 7) & ~(size_t)7;
+
+        drwav_copy_memory(header + headerSize, drwavGUID_W64_RIFF, 16);                                        headerSize += 16;
+        drwav__u64_to_bytes(header + headerSize, 0);                                                           headerSize += 8;
+        drwav_copy_memory(header + headerSize, drwavGUID_W64_WAVE, 16);                                        headerSize += 16;
+
+        drwav_copy_memory(header + headerSize, drwavGUID_W64_FMT, 16);                                         headerSize += 16;
+        drwav__u64_to_bytes(header + headerSize, 24 + fmtChunkDataSize);                                       headerSize += 8;   // <-- W64 chunk sizes include the header.
+        drwav_zero_memory(header + headerSize, fmtChunkDataSize);
+        drwav_copy_memory(header + headerSize, fmt, fmtSize);                                                  headerSize += fmtChunkDataSize;
+
+        if (hasFactChunk) {
+            drwav_copy_memory(header + headerSize, drwavGUID_W64_FACT, 16);                                    headerSize += 16;
+            drwav__u64_to_bytes(header + headerSize, 24 + 8);                                                  headerSize += 8;
+            drwav__u64_to_bytes(header + headerSize, 0);                                                       headerSize += 8;
+        }
+
+        drwav_copy_memory(header + headerSize, drwavGUID_W64_DATA, 16);                                        headerSize += 16;
+        drwav__u64_to_bytes(header + headerSize, 24);                                                          headerSize += 8;
+    }
+
+    drwav_assert(headerSize <= sizeof(header));
+
+    if (onWrite(pUserData, header, headerSize) != headerSize) {
+        DRWAV_FREE(pWav->adpcmEncoder.pPendingSamples);
+        pWav->adpcmEncoder.pPendingSamples = NULL;
+        return DRWAV_FALSE;
+    }
+
+    pWav->dataChunkDataPos  = headerSize;
+    pWav->dataChunkDataSize = 0;
+
+    return DRWAV_TRUE;
+}
+
+drwav_bool32 drwav_init_write(drwav* pWav, const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData)
+{
+    if (pWav == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_zero_memory(pWav, sizeof(*pWav));
+    return drwav__init_write(pWav, pFormat, onWrite, onSeek, pUserData);
+}
+
+static drwav_bool32 drwav__write_at(drwav* pWav, drwav_uint64 offset, const void* pData, size_t dataSize)
+{
+    // Everything that gets patched lives in the header so the offset always fits in an int.
+    drwav_assert(offset <= INT_MAX);
+
+    if (!pWav->onSeek(pWav->pUserData, (int)offset, drwav_seek_origin_start)) {
+        return DRWAV_FALSE;
+    }
+
+    return pWav->onWrite(pWav->pUserData, pData, dataSize) == dataSize;
+}
+
+static drwav_bool32 drwav__finalize_write(drwav* pWav)
 {
     drwav_assert(pWav != NULL);
-    drwav_assert(samplesToRead > 0);
-    drwav_assert(pBufferOut != NULL);
+    drwav_assert(pWav->onWrite != NULL);
 
-    // TODO: Lots of room for optimization here.
+    drwav_bool32 isCompressed = drwav__is_compressed_format_tag(pWav->translatedFormatTag);
+#ifndef DR_WAV_NO_CONVERSION_API
+    if (isCompressed && !drwav__flush_adpcm(pWav)) {
+        return DRWAV_FALSE;
+    }
+#endif
 
-    drwav_uint64 totalSamplesRead = 0;
+    // The sample count of compressed formats can't be derived from the size of the data so it goes in the "fact" chunk, which is
+    // straight before the "data" chunk. Every format other than PCM has one.
+    drwav_bool32 hasFactChunk = pWav->translatedFormatTag != DR_WAVE_FORMAT_PCM;
+    drwav_uint64 frameCount = isCompressed ? (pWav->totalSampleCount / pWav->channels) : (pWav->dataChunkDataSize / pWav->fmt.blockAlign);
 
-    while (samplesToRead > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
-        // If there are no cached samples we need to load a new block.
-        if (pWav->ima.cachedSampleCount == 0 && pWav->ima.bytesRemainingInBlock == 0) {
-            if (pWav->channels == 1) {
-                // Mono.
-                drwav_uint8 header[4];
-                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
-                    return totalSamplesRead;
-                }
-                pWav->ima.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+    // Chunks are padded to 2 bytes for RIFF and RF64 and 8 bytes for W64.
+    drwav_uint32 paddingSize;
+    if (pWav->container != drwav_container_w64) {
+        paddingSize = (drwav_uint32)(pWav->dataChunkDataSize % 2);
+    } else {
+        paddingSize = (drwav_uint32)((8 - (pWav->dataChunkDataSize % 8)) % 8);
+    }
 
-                pWav->ima.predictor[0] = drwav__bytes_to_s16(header + 0);
-                pWav->ima.stepIndex[0] = header[2];
-                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 1] = pWav->ima.predictor[0];
-                pWav->ima.cachedSampleCount = 1;
-            } else {
-                // Stereo.
-                drwav_uint8 header[8];
-                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
-                    return totalSamplesRead;
-                }
-                pWav->ima.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+    if (paddingSize > 0) {
+        drwav_uint64 paddingData = 0;
+        if (pWav->onWrite(pWav->pUserData, &paddingData, paddingSize) != paddingSize) {
+            return DRWAV_FALSE;
+        }
+    }
 
-                pWav->ima.predictor[0] = drwav__bytes_to_s16(header + 0);
-                pWav->ima.stepIndex[0] = header[2];
-                pWav->ima.predictor[1] = drwav__bytes_to_s16(header + 4);
-                pWav->ima.stepIndex[1] = header[6];
+    unsigned char bytes[8 + DRWAV_DS64_CHUNK_DATA_SIZE];
 
-                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 2] = pWav->ima.predictor[0];
-                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 1] = pWav->ima.predictor[1];
-                pWav->ima.cachedSampleCount = 2;
+    if (pWav->container == drwav_container_w64) {
+        drwav_uint64 riffChunkSize = pWav->dataChunkDataPos + pWav->dataChunkDataSize + paddingSize;
+        drwav__u64_to_bytes(bytes, riffChunkSize);
+        if (!drwav__write_at(pWav, 16, bytes, 8)) {
+            return DRWAV_FALSE;
+        }
+
+        if (hasFactChunk) {
+            drwav__u64_to_bytes(bytes, frameCount);
+            if (!drwav__write_at(pWav, pWav->dataChunkDataPos - 24 - 8, bytes, 8)) {
+                return DRWAV_FALSE;
             }
         }
 
-        // Output anything that's cached.
-        while (samplesToRead > 0 && pWav->ima.cachedSampleCount > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
-            pBufferOut[0] = (drwav_int16)pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount];
-            pWav->ima.cachedSampleCount -= 1;
+        drwav_uint64 dataChunkSize = 24 + pWav->dataChunkDataSize;
+        drwav__u64_to_bytes(bytes, dataChunkSize);
+        if (!drwav__write_at(pWav, pWav->dataChunkDataPos - 8, bytes, 8)) {
+            return DRWAV_FALSE;
+        }
+
+        return DRWAV_TRUE;
+    }
+
+
+    // RIFF and RF64. The RIFF chunk size excludes the 8 byte RIFF chunk header.
+    drwav_uint64 riffChunkSize = (pWav->dataChunkDataPos - 8) + pWav->dataChunkDataSize + paddingSize;
+    if (riffChunkSize > 0xFFFFFFFF) {
+        pWav->container = drwav_container_rf64;
+    }
+
+    if (hasFactChunk) {
+        drwav__u32_to_bytes(bytes, (frameCount > 0xFFFFFFFF) ? 0xFFFFFFFF : (drwav_uint32)frameCount);  // <-- RF64 has the real count in "ds64".
+        if (!drwav__write_at(pWav, pWav->dataChunkDataPos - 8 - 4, bytes, 4)) {
+            return DRWAV_FALSE;
+        }
+    }
+
+    if (pWav->container == drwav_container_riff) {
+        drwav__u32_to_bytes(bytes, (drwav_uint32)riffChunkSize);
+        if (!drwav__write_at(pWav, 4, bytes, 4)) {
+            return DRWAV_FALSE;
+        }
+
+        drwav__u32_to_bytes(bytes, (drwav_uint32)pWav->dataChunkDataSize);
+        if (!drwav__write_at(pWav, pWav->dataChunkDataPos - 4, bytes, 4)) {
+            return DRWAV_FALSE;
+        }
+
+        return DRWAV_TRUE;
+    }
+
+
+    // RF64. The 32-bit sizes stay at 0xFFFFFFFF and the real sizes go into the "ds64" chunk that replaces the "JUNK" chunk.
+    drwav_copy_memory(bytes, "RF64", 4);
+    if (!drwav__write_at(pWav, 0, bytes, 4)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_copy_memory(bytes, "ds64", 4);
+    drwav__u32_to_bytes(bytes +  4, DRWAV_DS64_CHUNK_DATA_SIZE);
+    drwav__u64_to_bytes(bytes +  8, riffChunkSize);
+    drwav__u64_to_bytes(bytes + 16, pWav->dataChunkDataSize);
+    drwav__u64_to_bytes(bytes + 24, frameCount);
+    drwav__u32_to_bytes(bytes + 32, 0);     // <-- No table entries.
+    if (!drwav__write_at(pWav, 12, bytes, sizeof(bytes))) {
+        return DRWAV_FALSE;
+    }
+
+    return DRWAV_TRUE;
+}
+
+void drwav_uninit(drwav* pWav)
+{
+    if (pWav == NULL) {
+        return;
+    }
+
+    // If the drwav object was opened in write mode we need to update the sizes in the header now that they're known.
+    if (pWav->onWrite != NULL) {
+        drwav__finalize_write(pWav);
+    }
+
+    DRWAV_FREE(pWav->pChunks);
+    DRWAV_FREE(pWav->adpcmEncoder.pPendingSamples);
+
+#ifndef DR_WAV_NO_STDIO
+    // If we opened the file with drwav_open_file() we will want to close the file handle. We can know whether or not drwav_open_file()
+    // was used by looking at the onRead and onSeek callbacks.
+    if (pWav->onRead == drwav__on_read_stdio || pWav->onWrite == drwav__on_write_stdio) {
+        fclose((FILE*)pWav->pUserData);
+    }
+
+#ifdef DRWAV_HAS_MMAP
+    if (pWav->isMemoryMapped) {
+        drwav__unmap_file(pWav->memoryStream.data, pWav->memoryStream.dataSize);
+    }
+#endif
+#endif
+}
+
+
+drwav* drwav_open(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData)
+{
+    drwav* pWav = (drwav*)DRWAV_MALLOC(sizeof(*pWav));
+    if (pWav == NULL) {
+        return NULL;
+    }
+
+    if (!drwav_init(pWav, onRead, onSeek, pUserData)) {
+        DRWAV_FREE(pWav);
+        return NULL;
+    }
+
+    return pWav;
+}
+
+drwav* drwav_open_seek64(drwav_read_proc onRead, drwav_seek64_proc onSeek64, void* pUserData)
+{
+    drwav* pWav = (drwav*)DRWAV_MALLOC(sizeof(*pWav));
+    if (pWav == NULL) {
+        return NULL;
+    }
+
+    if (!drwav_init_seek64(pWav, onRead, onSeek64, pUserData)) {
+        DRWAV_FREE(pWav);
+        return NULL;
+    }
+
+    return pWav;
+}
+
+drwav* drwav_open_write(const drwav_data_format* pFormat, drwav_write_proc onWrite, drwav_seek_proc onSeek, void* pUserData)
+{
+    drwav* pWav = (drwav*)DRWAV_MALLOC(sizeof(*pWav));
+    if (pWav == NULL) {
+        return NULL;
+    }
+
+    if (!drwav_init_write(pWav, pFormat, onWrite, onSeek, pUserData)) {
+        DRWAV_FREE(pWav);
+        return NULL;
+    }
+
+    return pWav;
+}
+
+void drwav_close(drwav* pWav)
+{
+    drwav_uninit(pWav);
+    DRWAV_FREE(pWav);
+}
+
+
+size_t drwav_read_raw(drwav* pWav, size_t bytesToRead, void* pBufferOut)
+{
+    if (pWav == NULL || bytesToRead == 0 || pBufferOut == NULL) {
+        return 0;
+    }
+
+    if (bytesToRead > pWav->bytesRemaining) {
+        bytesToRead = (size_t)pWav->bytesRemaining;
+    }
+
+    size_t bytesRead = pWav->onRead(pWav->pUserData, pBufferOut, bytesToRead);
+
+    pWav->bytesRemaining -= bytesRead;
+    return bytesRead;
+}
+
+drwav_uint64 drwav_read(drwav* pWav, drwav_uint64 samplesToRead, void* pBufferOut)
+{
+    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
+        return 0;
+    }
+
+    // Cannot use this function for compressed formats.
+    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        return 0;
+    }
+
+    // Don't try to read more samples than can potentially fit in the output buffer.
+    if (samplesToRead * pWav->bytesPerSample > SIZE_MAX) {
+        samplesToRead = SIZE_MAX / pWav->bytesPerSample;
+    }
+
+    size_t bytesRead = drwav_read_raw(pWav, (size_t)(samplesToRead * pWav->bytesPerSample), pBufferOut);
+    return bytesRead / pWav->bytesPerSample;
+}
+
+// The noise shaping error of the previous sample doesn't apply after a seek. The channel of the next sample is kept in step with
+// the new position.
+static void drwav__dither_seek(drwav_dither* pDither, drwav_uint64 sample)
+{
+    if (pDither->channels == 0) {
+        return;
+    }
+
+    pDither->iChannel = (drwav_uint32)(sample % pDither->channels);
+    drwav_zero_memory(pDither->error, sizeof(pDither->error));
+}
+
+drwav_bool32 drwav_seek_to_first_sample(drwav* pWav)
+{
+    if (!drwav__seek(pWav, (drwav_int64)pWav->dataChunkDataPos, drwav_seek_origin_start)) {
+        return DRWAV_FALSE;
+    }
+
+    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        pWav->compressed.iCurrentSample = 0;
+
+        // Clearing the block state makes the next read start by loading a block header.
+        pWav->msadpcm.bytesRemainingInBlock = 0;
+        pWav->msadpcm.cachedSampleCount     = 0;
+        pWav->ima.bytesRemainingInBlock     = 0;
+        pWav->ima.cachedSampleCount         = 0;
+    }
+    
+    pWav->bytesRemaining = pWav->dataChunkDataSize;
+    drwav__dither_seek(&pWav->dither, 0);
+    return DRWAV_TRUE;
+}
+
+static drwav_uint64 drwav__get_compressed_samples_per_block(drwav* pWav)
+{
+    // Both formats start each block with a header holding the decoder state of each channel, followed by two samples per byte.
+    // For MS-ADPCM the header includes the first two samples of each channel and for IMA ADPCM it includes the first one.
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        if (pWav->fmt.blockAlign <= 7*pWav->channels) {
+            return 0;
+        }
+        return (2*pWav->channels) + ((pWav->fmt.blockAlign - (7*pWav->channels)) * 2);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        if (pWav->fmt.blockAlign <= 4*pWav->channels) {
+            return 0;
+        }
+        return pWav->channels + ((pWav->fmt.blockAlign - (4*pWav->channels)) * 2);
+    }
+
+    return 0;
+}
+
+static drwav_bool32 drwav__seek_to_sample__compressed(drwav* pWav, drwav_uint64 sample)
+{
+    drwav_uint64 samplesPerBlock = drwav__get_compressed_samples_per_block(pWav);
+    if (samplesPerBlock == 0) {
+        return DRWAV_FALSE;
+    }
+
+    // Every block can be decoded on its own. Unless the target is less than a block ahead of the current position, which is
+    // quicker to just decode up to, we jump straight to the start of the block containing the target.
+    if (sample < pWav->compressed.iCurrentSample || (sample - pWav->compressed.iCurrentSample) >= samplesPerBlock) {
+        drwav_uint64 blockIndex  = sample / samplesPerBlock;
+        drwav_uint64 blockOffset = blockIndex * pWav->fmt.blockAlign;
+
+        if (!drwav_seek_to_first_sample(pWav)) {
+            return DRWAV_FALSE;
+        }
+
+        if (!drwav__seek_forward(pWav, blockOffset)) {
+            return DRWAV_FALSE;
+        }
+
+        pWav->bytesRemaining            = pWav->dataChunkDataSize - blockOffset;
+        pWav->compressed.iCurrentSample = blockIndex * samplesPerBlock;
+    }
+
+    // Decode the remainder of the way.
+    drwav_int16 devnull[2048];
+    while (pWav->compressed.iCurrentSample < sample) {
+        drwav_uint64 samplesToRead = drwav_min(sample - pWav->compressed.iCurrentSample, drwav_countof(devnull));
+        drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, devnull);
+        if (samplesRead != samplesToRead) {
+            return DRWAV_FALSE;
+        }
+    }
+
+    return DRWAV_TRUE;
+}
+
+drwav_bool32 drwav_seek_to_sample(drwav* pWav, drwav_uint64 sample)
+{
+    // Seeking should be compatible with wave files > 2GB.
+
+    if (pWav == NULL || (pWav->onSeek == NULL && pWav->onSeek64 == NULL)) {
+        return DRWAV_FALSE;
+    }
+
+    // If there are no samples, just return DRWAV_TRUE without doing anything.
+    if (pWav->totalSampleCount == 0) {
+        return DRWAV_TRUE;
+    }
+
+    // Make sure the sample is clamped.
+    if (sample >= pWav->totalSampleCount) {
+        sample  = pWav->totalSampleCount - 1;
+    }
+
+    drwav__dither_seek(&pWav->dither, sample);
+
+
+    // Compressed formats seek to the block containing the sample and then decode from there. If the block layout doesn't make
+    // sense we just use the slow generic seek.
+    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        if (drwav__get_compressed_samples_per_block(pWav) == 0) {
+            goto fallback;
+        }
+
+        return drwav__seek_to_sample__compressed(pWav, sample);
+    } else {
+        drwav_uint64 totalSizeInBytes = pWav->totalSampleCount * pWav->bytesPerSample;
+        drwav_assert(totalSizeInBytes >= pWav->bytesRemaining);
+
+        drwav_uint64 currentBytePos = totalSizeInBytes - pWav->bytesRemaining;
+        drwav_uint64 targetBytePos  = sample * pWav->bytesPerSample;
+
+        if (currentBytePos <= targetBytePos) {
+            // Offset forwards.
+            drwav_uint64 offset = (targetBytePos - currentBytePos);
+            if (!drwav__seek_forward(pWav, offset)) {
+                return DRWAV_FALSE;
+            }
+
+            pWav->bytesRemaining -= offset;
+        } else {
+            // Offset backwards. This goes from the start of the stream, which is a single seek with a 64-bit callback.
+            if (!drwav__seek(pWav, (drwav_int64)(pWav->dataChunkDataPos + targetBytePos), drwav_seek_origin_start)) {
+                return DRWAV_FALSE;
+            }
+
+            pWav->bytesRemaining = pWav->dataChunkDataSize - targetBytePos;
+        }
+    }
+
+    return DRWAV_TRUE;
+
+fallback:
+    // This is a generic seek implementation that just continuously reads samples into a temporary buffer. This should work for all supported
+    // formats, but it is not efficient. This should be used as a fall back.
+    if (!drwav_seek_to_first_sample(pWav)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_int16 devnull[2048];
+    while (sample > 0) {
+        drwav_uint64 samplesToRead = sample;
+        if (samplesToRead > 2048) {
+            samplesToRead = 2048;
+        }
+
+        drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, devnull);
+        if (samplesRead != samplesToRead) {
+            return DRWAV_FALSE;
+        }
+
+        sample -= samplesRead;
+    }
+
+    return DRWAV_TRUE;
+}
+
+drwav_uint64 drwav_map_frames(drwav* pWav, drwav_uint64 firstFrame, drwav_uint64 frameCount, const void** ppFrames)
+{
+    if (pWav == NULL || ppFrames == NULL) {
+        return 0;
+    }
+
+    *ppFrames = NULL;
+
+    // The data must already be in memory, which is only the case when reading through the memory stream.
+    if (pWav->onRead != drwav__on_read_memory || drwav__is_compressed_format_tag(pWav->translatedFormatTag) || pWav->bytesPerSample == 0) {
+        return 0;
+    }
+
+    // The data can only be used in place if it's already laid out the way the fmt chunk describes it for a WAV file. Big-endian
+    // AIFF samples and signed 8-bit AIFF samples need converting first.
+    if (pWav->aiff.isBigEndian || pWav->aiff.isSigned8Bit) {
+        return 0;
+    }
+
+    // WAV data is little-endian so multi-byte samples can only be used in place on little-endian architectures.
+    if (pWav->bytesPerSample > 1 && !drwav__is_little_endian()) {
+        return 0;
+    }
+
+    drwav_uint64 bytesPerFrame = (drwav_uint64)pWav->bytesPerSample * pWav->channels;
+    drwav_uint64 totalFrameCount = pWav->dataChunkDataSize / bytesPerFrame;
+
+    // Make sure the data chunk doesn't extend past the end of the buffer, which would be the case with a truncated file.
+    drwav_uint64 bufferSize = pWav->memoryStream.dataSize;
+    if (pWav->dataChunkDataPos >= bufferSize) {
+        return 0;
+    }
+    if (totalFrameCount > (bufferSize - pWav->dataChunkDataPos) / bytesPerFrame) {
+        totalFrameCount = (bufferSize - pWav->dataChunkDataPos) / bytesPerFrame;
+    }
+
+    if (firstFrame >= totalFrameCount) {
+        return 0;
+    }
+
+    if (frameCount > totalFrameCount - firstFrame) {
+        frameCount = totalFrameCount - firstFrame;
+    }
+
+    *ppFrames = pWav->memoryStream.data + (size_t)(pWav->dataChunkDataPos + firstFrame*bytesPerFrame);
+    return frameCount;
+}
+
+
+static drwav_bool32 drwav__seek_to_stream_pos(drwav* pWav, drwav_uint64 pos)
+{
+    return drwav__seek(pWav, (drwav_int64)pos, drwav_seek_origin_start);
+}
+
+// Moves the stream back to where drwav_read() and family expect it to be after the metadata functions have moved it.
+static drwav_bool32 drwav__restore_read_position(drwav* pWav)
+{
+    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        // Compressed formats only track the position in samples so we need to go through the seeking logic.
+        drwav_uint64 iCurrentSample = pWav->compressed.iCurrentSample;
+        if (!drwav_seek_to_first_sample(pWav)) {
+            return DRWAV_FALSE;
+        }
+
+        if (iCurrentSample == 0) {
+            return DRWAV_TRUE;
+        }
+
+        if (drwav__get_compressed_samples_per_block(pWav) == 0) {
+            return drwav_seek_to_sample(pWav, iCurrentSample);
+        }
+
+        return drwav__seek_to_sample__compressed(pWav, iCurrentSample);
+    }
+
+    return drwav__seek_to_stream_pos(pWav, pWav->dataChunkDataPos + (pWav->dataChunkDataSize - pWav->bytesRemaining));
+}
+
+drwav_bool32 drwav_index_chunks(drwav* pWav)
+{
+    if (pWav == NULL || pWav->onRead == NULL || (pWav->onSeek == NULL && pWav->onSeek64 == NULL)) {
+        return DRWAV_FALSE;
+    }
+
+    if (pWav->pChunks != NULL) {
+        return DRWAV_TRUE;  // Already indexed.
+    }
+
+    // The first chunk sits straight after the "RIFF" and "WAVE" identifiers, or "FORM" and "AIFF" for AIFF files.
+    drwav_uint64 runningPos = (pWav->container == drwav_container_w64) ? 40 : 12;
+    if (!drwav__seek_to_stream_pos(pWav, runningPos)) {
+        drwav__restore_read_position(pWav);
+        return DRWAV_FALSE;
+    }
+
+    drwav_chunk_info* pChunks = NULL;
+    drwav_uint32 chunkCount = 0;
+    drwav_uint32 chunkCapacity = 0;
+    drwav_bool32 result = DRWAV_TRUE;
+
+    // We keep going until we run out of chunk headers. Only the headers are read - the content of each chunk is seeked past.
+    for (;;) {
+        drwav__chunk_header header;
+        if (!drwav__read_chunk_header(pWav->onRead, pWav->pUserData, pWav->container, &runningPos, &header)) {
+            break;
+        }
+
+        // The size in the header of an RF64 data chunk is a placeholder. The real size has already been loaded from the ds64 chunk.
+        if (runningPos == pWav->dataChunkDataPos) {
+            header.sizeInBytes = pWav->dataChunkDataSize;
+            header.paddingSize = (unsigned int)(pWav->dataChunkDataSize % ((pWav->container == drwav_container_w64) ? 8 : 2));
+        }
+
+        if (chunkCount == chunkCapacity) {
+            drwav_uint32 newCapacity = (chunkCapacity == 0) ? 16 : chunkCapacity*2;
+            drwav_chunk_info* pNewChunks = (drwav_chunk_info*)DRWAV_REALLOC(pChunks, newCapacity * sizeof(*pChunks));
+            if (pNewChunks == NULL) {
+                result = DRWAV_FALSE;   // Out of memory.
+                break;
+            }
+
+            pChunks = pNewChunks;
+            chunkCapacity = newCapacity;
+        }
+
+        drwav_chunk_info* pChunk = &pChunks[chunkCount];
+        drwav_zero_memory(pChunk->id, sizeof(pChunk->id));
+        if (pWav->container == drwav_container_w64) {
+            drwav_copy_memory(pChunk->id, header.id.guid, 16);
+        } else {
+            drwav_copy_memory(pChunk->id, header.id.fourcc, 4);
+        }
+        pChunk->dataPos     = runningPos;
+        pChunk->sizeInBytes = header.sizeInBytes;
+        chunkCount += 1;
+
+        if (!drwav__seek_forward(pWav, header.sizeInBytes + header.paddingSize)) {
+            break;
+        }
+        runningPos += header.sizeInBytes + header.paddingSize;
+    }
+
+    if (result) {
+        pWav->pChunks    = pChunks;
+        pWav->chunkCount = chunkCount;
+    } else {
+        DRWAV_FREE(pChunks);
+    }
+
+    if (!drwav__restore_read_position(pWav)) {
+        return DRWAV_FALSE;
+    }
+
+    return result;
+}
+
+static drwav_bool32 drwav__chunk_id_equal(drwav* pWav, const drwav_uint8* id, const char* fourcc)
+{
+    if (!drwav__fourcc_equal(id, fourcc)) {
+        return DRWAV_FALSE;
+    }
+
+    if (pWav->container == drwav_container_w64) {
+        for (int i = 4; i < 16; ++i) {
+            if (id[i] != drwavGUID_W64_FMT[i]) {
+                return DRWAV_FALSE;
+            }
+        }
+    }
+
+    return DRWAV_TRUE;
+}
+
+const drwav_chunk_info* drwav_find_chunk(drwav* pWav, const char* fourcc)
+{
+    if (pWav == NULL || fourcc == NULL) {
+        return NULL;
+    }
+
+    if (pWav->pChunks == NULL && !drwav_index_chunks(pWav)) {
+        return NULL;
+    }
+
+    for (drwav_uint32 iChunk = 0; iChunk < pWav->chunkCount; ++iChunk) {
+        if (drwav__chunk_id_equal(pWav, pWav->pChunks[iChunk].id, fourcc)) {
+            return &pWav->pChunks[iChunk];
+        }
+    }
+
+    return NULL;
+}
+
+size_t drwav_read_chunk(drwav* pWav, const drwav_chunk_info* pChunk, void* pBufferOut, size_t bufferSize)
+{
+    if (pWav == NULL || pChunk == NULL || pBufferOut == NULL) {
+        return 0;
+    }
+
+    size_t bytesToRead = (size_t)drwav_min(pChunk->sizeInBytes, bufferSize);
+    size_t bytesRead = 0;
+    if (drwav__seek_to_stream_pos(pWav, pChunk->dataPos)) {
+        bytesRead = pWav->onRead(pWav->pUserData, pBufferOut, bytesToRead);
+    }
+
+    if (!drwav__restore_read_position(pWav)) {
+        return 0;
+    }
+
+    return bytesRead;
+}
+
+// Loads the entire content of the first chunk with the given FOURCC. Free the returned buffer with DRWAV_FREE().
+static drwav_uint8* drwav__load_chunk(drwav* pWav, const char* fourcc, size_t* pSizeOut)
+{
+    const drwav_chunk_info* pChunk = drwav_find_chunk(pWav, fourcc);
+    if (pChunk == NULL || pChunk->sizeInBytes > SIZE_MAX) {
+        return NULL;
+    }
+
+    size_t size = (size_t)pChunk->sizeInBytes;
+    drwav_uint8* pData = (drwav_uint8*)DRWAV_MALLOC(size + 1);   // <-- +1 so a 0 sized chunk still gives us a valid pointer.
+    if (pData == NULL) {
+        return NULL;
+    }
+
+    if (drwav_read_chunk(pWav, pChunk, pData, size) != size) {
+        DRWAV_FREE(pData);
+        return NULL;
+    }
+
+    *pSizeOut = size;
+    return pData;
+}
+
+drwav_bool32 drwav_read_smpl(drwav* pWav, drwav_smpl* pSmpl, drwav_smpl_loop* pLoops, drwav_uint32 maxLoops)
+{
+    if (pSmpl == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    size_t size;
+    drwav_uint8* pData = drwav__load_chunk(pWav, "smpl", &size);
+    if (pData == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    if (size < 36) {
+        DRWAV_FREE(pData);
+        return DRWAV_FALSE;
+    }
+
+    pSmpl->manufacturer      = drwav__bytes_to_u32(pData +  0);
+    pSmpl->product           = drwav__bytes_to_u32(pData +  4);
+    pSmpl->samplePeriod      = drwav__bytes_to_u32(pData +  8);
+    pSmpl->midiUnityNote     = drwav__bytes_to_u32(pData + 12);
+    pSmpl->midiPitchFraction = drwav__bytes_to_u32(pData + 16);
+    pSmpl->smpteFormat       = drwav__bytes_to_u32(pData + 20);
+    pSmpl->smpteOffset       = drwav__bytes_to_u32(pData + 24);
+    pSmpl->loopCount         = drwav__bytes_to_u32(pData + 28);
+    pSmpl->samplerDataSize   = drwav__bytes_to_u32(pData + 32);
+
+    // Each loop is 24 bytes. Never go past the end of the chunk even if the loop count says otherwise.
+    drwav_uint32 loopsToRead = (drwav_uint32)drwav_min(drwav_min(pSmpl->loopCount, maxLoops), (size - 36) / 24);
+    for (drwav_uint32 iLoop = 0; iLoop < loopsToRead; ++iLoop) {
+        const drwav_uint8* pLoop = pData + 36 + iLoop*24;
+        pLoops[iLoop].cuePointId = drwav__bytes_to_u32(pLoop +  0);
+        pLoops[iLoop].type       = drwav__bytes_to_u32(pLoop +  4);
+        pLoops[iLoop].start      = drwav__bytes_to_u32(pLoop +  8);
+        pLoops[iLoop].end        = drwav__bytes_to_u32(pLoop + 12);
+        pLoops[iLoop].fraction   = drwav__bytes_to_u32(pLoop + 16);
+        pLoops[iLoop].playCount  = drwav__bytes_to_u32(pLoop + 20);
+    }
+
+    DRWAV_FREE(pData);
+    return DRWAV_TRUE;
+}
+
+drwav_uint32 drwav_read_cue_points(drwav* pWav, drwav_cue_point* pPoints, drwav_uint32 maxPoints)
+{
+    size_t size;
+    drwav_uint8* pData = drwav__load_chunk(pWav, "cue ", &size);
+    if (pData == NULL) {
+        return 0;
+    }
+
+    if (size < 4) {
+        DRWAV_FREE(pData);
+        return 0;
+    }
+
+    // Each point is 24 bytes. Never go past the end of the chunk even if the point count says otherwise.
+    drwav_uint32 pointCount = (drwav_uint32)drwav_min(drwav__bytes_to_u32(pData), (size - 4) / 24);
+    drwav_uint32 pointsToRead = drwav_min(pointCount, maxPoints);
+    for (drwav_uint32 iPoint = 0; iPoint < pointsToRead; ++iPoint) {
+        const drwav_uint8* pPoint = pData + 4 + iPoint*24;
+        pPoints[iPoint].id           = drwav__bytes_to_u32(pPoint +  0);
+        pPoints[iPoint].position     = drwav__bytes_to_u32(pPoint +  4);
+        drwav_copy_memory(pPoints[iPoint].dataChunkId, pPoint + 8, 4);
+        pPoints[iPoint].chunkStart   = drwav__bytes_to_u32(pPoint + 12);
+        pPoints[iPoint].blockStart   = drwav__bytes_to_u32(pPoint + 16);
+        pPoints[iPoint].sampleOffset = drwav__bytes_to_u32(pPoint + 20);
+    }
+
+    DRWAV_FREE(pData);
+    return pointCount;
+}
+
+size_t drwav_read_info_string(drwav* pWav, const char* id, char* pBufferOut, size_t bufferSize)
+{
+    if (pBufferOut != NULL && bufferSize > 0) {
+        pBufferOut[0] = '\0';
+    }
+
+    if (pWav == NULL || id == NULL) {
+        return 0;
+    }
+
+    if (pWav->pChunks == NULL && !drwav_index_chunks(pWav)) {
+        return 0;
+    }
+
+    // There can be multiple LIST chunks of different types so we need to look at each one.
+    for (drwav_uint32 iChunk = 0; iChunk < pWav->chunkCount; ++iChunk) {
+        const drwav_chunk_info* pChunk = &pWav->pChunks[iChunk];
+        if (!drwav__chunk_id_equal(pWav, pChunk->id, "LIST") || pChunk->sizeInBytes < 4 || pChunk->sizeInBytes > SIZE_MAX) {
+            continue;
+        }
+
+        size_t size = (size_t)pChunk->sizeInBytes;
+        drwav_uint8* pData = (drwav_uint8*)DRWAV_MALLOC(size);
+        if (pData == NULL) {
+            return 0;
+        }
+
+        if (drwav_read_chunk(pWav, pChunk, pData, size) != size || !drwav__fourcc_equal(pData, "INFO")) {
+            DRWAV_FREE(pData);
+            continue;
+        }
+
+        // The sub-chunks have a RIFF style header with 2 byte alignment.
+        size_t offset = 4;
+        while (offset + 8 <= size) {
+            drwav_uint32 subchunkSize = drwav__bytes_to_u32(pData + offset + 4);
+            if (subchunkSize > size - offset - 8) {
+                break;  // Corrupt.
+            }
+
+            if (drwav__fourcc_equal(pData + offset, id)) {
+                // The string will usually include a null terminator, but not always.
+                const char* pString = (const char*)pData + offset + 8;
+                size_t length = 0;
+                while (length < subchunkSize && pString[length] != '\0') {
+                    length += 1;
+                }
+
+                if (pBufferOut != NULL && bufferSize > 0) {
+                    size_t lengthToCopy = drwav_min(length, bufferSize - 1);
+                    drwav_copy_memory(pBufferOut, pString, lengthToCopy);
+                    pBufferOut[lengthToCopy] = '\0';
+                }
+
+                DRWAV_FREE(pData);
+                return length;
+            }
+
+            offset += 8 + subchunkSize + (subchunkSize % 2);
+        }
+
+        DRWAV_FREE(pData);
+    }
+
+    return 0;
+}
+
+static void drwav__copy_bext_string(char* pOut, const drwav_uint8* pIn, size_t maxLength)
+{
+    size_t length = 0;
+    while (length < maxLength && pIn[length] != '\0') {
+        pOut[length] = (char)pIn[length];
+        length += 1;
+    }
+    pOut[length] = '\0';
+}
+
+drwav_bool32 drwav_read_bext(drwav* pWav, drwav_bext* pBext)
+{
+    if (pBext == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    // The fixed part of the chunk is 602 bytes. We only need the first 602 so there's no need to load the coding history.
+    const drwav_chunk_info* pChunk = drwav_find_chunk(pWav, "bext");
+    if (pChunk == NULL || pChunk->sizeInBytes < 602) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_uint8 data[602];
+    if (drwav_read_chunk(pWav, pChunk, data, sizeof(data)) != sizeof(data)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_zero_memory(pBext, sizeof(*pBext));
+    drwav__copy_bext_string(pBext->description,         data +   0, 256);
+    drwav__copy_bext_string(pBext->originator,          data + 256,  32);
+    drwav__copy_bext_string(pBext->originatorReference, data + 288,  32);
+    drwav__copy_bext_string(pBext->originationDate,     data + 320,  10);
+    drwav__copy_bext_string(pBext->originationTime,     data + 330,   8);
+    pBext->timeReference = drwav__bytes_to_u64(data + 338);
+    pBext->version       = drwav__bytes_to_u16(data + 346);
+
+    if (pBext->version >= 1) {
+        drwav_copy_memory(pBext->umid, data + 348, 64);
+    }
+    if (pBext->version >= 2) {
+        pBext->loudnessValue        = drwav__bytes_to_s16(data + 412);
+        pBext->loudnessRange        = drwav__bytes_to_s16(data + 414);
+        pBext->maxTruePeakLevel     = drwav__bytes_to_s16(data + 416);
+        pBext->maxMomentaryLoudness = drwav__bytes_to_s16(data + 418);
+        pBext->maxShortTermLoudness = drwav__bytes_to_s16(data + 420);
+    }
+
+    pBext->codingHistorySize = pChunk->sizeInBytes - 602;
+    return DRWAV_TRUE;
+}
+
+
+size_t drwav_write_raw(drwav* pWav, size_t bytesToWrite, const void* pData)
+{
+    if (pWav == NULL || pWav->onWrite == NULL || bytesToWrite == 0 || pData == NULL) {
+        return 0;
+    }
+
+    size_t bytesWritten = pWav->onWrite(pWav->pUserData, pData, bytesToWrite);
+    pWav->dataChunkDataSize += bytesWritten;
+
+    return bytesWritten;
+}
+
+drwav_uint64 drwav_write(drwav* pWav, drwav_uint64 samplesToWrite, const void* pData)
+{
+    if (pWav == NULL || samplesToWrite == 0 || pData == NULL) {
+        return 0;
+    }
+
+#ifndef DR_WAV_NO_CONVERSION_API
+    if (drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        return drwav__write_adpcm(pWav, samplesToWrite, (const drwav_int16*)pData);
+    }
+#endif
+
+    // Don't try to write more samples than can potentially be passed to the write callback in one go.
+    if (samplesToWrite * pWav->bytesPerSample > SIZE_MAX) {
+        samplesToWrite = SIZE_MAX / pWav->bytesPerSample;
+    }
+
+    // The application's buffer is handed straight to the write callback. Splitting it up would only add calls.
+    size_t bytesWritten = drwav_write_raw(pWav, (size_t)(samplesToWrite * pWav->bytesPerSample), pData);
+    pWav->totalSampleCount += bytesWritten / pWav->bytesPerSample;
+
+    return bytesWritten / pWav->bytesPerSample;
+}
+
+#ifndef DR_WAV_NO_CONVERSION_API
+drwav_bool32 drwav_set_adpcm_config(drwav* pWav, const drwav_adpcm_config* pConfig)
+{
+    if (pWav == NULL || pConfig == NULL || pWav->onWrite == NULL || !drwav__is_compressed_format_tag(pWav->translatedFormatTag)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_uint16 blockAlign = pConfig->blockAlign;
+    if (blockAlign == 0) {
+        blockAlign = drwav__get_default_adpcm_block_align(pWav->channels, pWav->sampleRate);
+    }
+
+    if (blockAlign != pWav->fmt.blockAlign) {
+        if (pWav->totalSampleCount > 0 || !drwav__is_valid_adpcm_block_align(pWav->translatedFormatTag, pWav->channels, blockAlign)) {
+            return DRWAV_FALSE;
+        }
+
+        if (!drwav__set_adpcm_block_align(pWav, blockAlign)) {
+            return DRWAV_FALSE;
+        }
+
+        // Nothing has been written after the header yet, so the "fmt " chunk can be rewritten in place before moving back to the
+        // start of the data.
+        unsigned char fmt[50];
+        size_t fmtSize = drwav__fmt_to_bytes(pWav, fmt);
+        drwav_uint64 fmtPos = (pWav->container == drwav_container_w64) ? (40 + 24) : (12 + 8 + DRWAV_DS64_CHUNK_DATA_SIZE + 8);
+        if (!drwav__write_at(pWav, fmtPos, fmt, fmtSize) || !pWav->onSeek(pWav->pUserData, (int)pWav->dataChunkDataPos, drwav_seek_origin_start)) {
+            return DRWAV_FALSE;
+        }
+    }
+
+    if (!drwav__set_adpcm_thread_count(pWav, pConfig->threadCount)) {
+        return DRWAV_FALSE;
+    }
+
+    pWav->adpcmEncoder.exhaustiveSearch = pConfig->exhaustiveSearch;
+    return DRWAV_TRUE;
+}
+#endif
+
+
+#ifndef DR_WAV_NO_CONVERSION_API
+#ifdef DRWAV_SUPPORT_SSE2
+static drwav_bool32 drwav__has_ssse3(void)
+{
+#if defined(__SSSE3__)
+    return DRWAV_TRUE;  // <-- The compiler is targeting it so it's guaranteed to be available.
+#elif defined(DRWAV_SUPPORT_SSSE3)
+    static int isSSSE3Supported = -1;
+    if (isSSSE3Supported == -1) {
+        int info[4];
+        __cpuid(info, 1);
+        isSSSE3Supported = (info[2] & (1 << 9)) != 0;
+    }
+
+    return (drwav_bool32)isSSSE3Supported;
+#else
+    return DRWAV_FALSE;
+#endif
+}
+#endif
+
+static unsigned short g_drwavAlawTable[256] = {
+    0xEA80, 0xEB80, 0xE880, 0xE980, 0xEE80, 0xEF80, 0xEC80, 0xED80, 0xE280, 0xE380, 0xE080, 0xE180, 0xE680, 0xE780, 0xE480, 0xE580, 
+    0xF540, 0xF5C0, 0xF440, 0xF4C0, 0xF740, 0xF7C0, 0xF640, 0xF6C0, 0xF140, 0xF1C0, 0xF040, 0xF0C0, 0xF340, 0xF3C0, 0xF240, 0xF2C0, 
+    0xAA00, 0xAE00, 0xA200, 0xA600, 0xBA00, 0xBE00, 0xB200, 0xB600, 0x8A00, 0x8E00, 0x8200, 0x8600, 0x9A00, 0x9E00, 0x9200, 0x9600, 
+    0xD500, 0xD700, 0xD100, 0xD300, 0xDD00, 0xDF00, 0xD900, 0xDB00, 0xC500, 0xC700, 0xC100, 0xC300, 0xCD00, 0xCF00, 0xC900, 0xCB00, 
+    0xFEA8, 0xFEB8, 0xFE88, 0xFE98, 0xFEE8, 0xFEF8, 0xFEC8, 0xFED8, 0xFE28, 0xFE38, 0xFE08, 0xFE18, 0xFE68, 0xFE78, 0xFE48, 0xFE58, 
+    0xFFA8, 0xFFB8, 0xFF88, 0xFF98, 0xFFE8, 0xFFF8, 0xFFC8, 0xFFD8, 0xFF28, 0xFF38, 0xFF08, 0xFF18, 0xFF68, 0xFF78, 0xFF48, 0xFF58, 
+    0xFAA0, 0xFAE0, 0xFA20, 0xFA60, 0xFBA0, 0xFBE0, 0xFB20, 0xFB60, 0xF8A0, 0xF8E0, 0xF820, 0xF860, 0xF9A0, 0xF9E0, 0xF920, 0xF960, 
+    0xFD50, 0xFD70, 0xFD10, 0xFD30, 0xFDD0, 0xFDF0, 0xFD90, 0xFDB0, 0xFC50, 0xFC70, 0xFC10, 0xFC30, 0xFCD0, 0xFCF0, 0xFC90, 0xFCB0, 
+    0x1580, 0x1480, 0x1780, 0x1680, 0x1180, 0x1080, 0x1380, 0x1280, 0x1D80, 0x1C80, 0x1F80, 0x1E80, 0x1980, 0x1880, 0x1B80, 0x1A80, 
+    0x0AC0, 0x0A40, 0x0BC0, 0x0B40, 0x08C0, 0x0840, 0x09C0, 0x0940, 0x0EC0, 0x0E40, 0x0FC0, 0x0F40, 0x0CC0, 0x0C40, 0x0DC0, 0x0D40, 
+    0x5600, 0x5200, 0x5E00, 0x5A00, 0x4600, 0x4200, 0x4E00, 0x4A00, 0x7600, 0x7200, 0x7E00, 0x7A00, 0x6600, 0x6200, 0x6E00, 0x6A00, 
+    0x2B00, 0x2900, 0x2F00, 0x2D00, 0x2300, 0x2100, 0x2700, 0x2500, 0x3B00, 0x3900, 0x3F00, 0x3D00, 0x3300, 0x3100, 0x3700, 0x3500, 
+    0x0158, 0x0148, 0x0178, 0x0168, 0x0118, 0x0108, 0x0138, 0x0128, 0x01D8, 0x01C8, 0x01F8, 0x01E8, 0x0198, 0x0188, 0x01B8, 0x01A8, 
+    0x0058, 0x0048, 0x0078, 0x0068, 0x0018, 0x0008, 0x0038, 0x0028, 0x00D8, 0x00C8, 0x00F8, 0x00E8, 0x0098, 0x0088, 0x00B8, 0x00A8, 
+    0x0560, 0x0520, 0x05E0, 0x05A0, 0x0460, 0x0420, 0x04E0, 0x04A0, 0x0760, 0x0720, 0x07E0, 0x07A0, 0x0660, 0x0620, 0x06E0, 0x06A0, 
+    0x02B0, 0x0290, 0x02F0, 0x02D0, 0x0230, 0x0210, 0x0270, 0x0250, 0x03B0, 0x0390, 0x03F0, 0x03D0, 0x0330, 0x0310, 0x0370, 0x0350
+};
+
+static unsigned short g_drwavMulawTable[256] = {
+    0x8284, 0x8684, 0x8A84, 0x8E84, 0x9284, 0x9684, 0x9A84, 0x9E84, 0xA284, 0xA684, 0xAA84, 0xAE84, 0xB284, 0xB684, 0xBA84, 0xBE84, 
+    0xC184, 0xC384, 0xC584, 0xC784, 0xC984, 0xCB84, 0xCD84, 0xCF84, 0xD184, 0xD384, 0xD584, 0xD784, 0xD984, 0xDB84, 0xDD84, 0xDF84, 
+    0xE104, 0xE204, 0xE304, 0xE404, 0xE504, 0xE604, 0xE704, 0xE804, 0xE904, 0xEA04, 0xEB04, 0xEC04, 0xED04, 0xEE04, 0xEF04, 0xF004, 
+    0xF0C4, 0xF144, 0xF1C4, 0xF244, 0xF2C4, 0xF344, 0xF3C4, 0xF444, 0xF4C4, 0xF544, 0xF5C4, 0xF644, 0xF6C4, 0xF744, 0xF7C4, 0xF844, 
+    0xF8A4, 0xF8E4, 0xF924, 0xF964, 0xF9A4, 0xF9E4, 0xFA24, 0xFA64, 0xFAA4, 0xFAE4, 0xFB24, 0xFB64, 0xFBA4, 0xFBE4, 0xFC24, 0xFC64, 
+    0xFC94, 0xFCB4, 0xFCD4, 0xFCF4, 0xFD14, 0xFD34, 0xFD54, 0xFD74, 0xFD94, 0xFDB4, 0xFDD4, 0xFDF4, 0xFE14, 0xFE34, 0xFE54, 0xFE74, 
+    0xFE8C, 0xFE9C, 0xFEAC, 0xFEBC, 0xFECC, 0xFEDC, 0xFEEC, 0xFEFC, 0xFF0C, 0xFF1C, 0xFF2C, 0xFF3C, 0xFF4C, 0xFF5C, 0xFF6C, 0xFF7C, 
+    0xFF88, 0xFF90, 0xFF98, 0xFFA0, 0xFFA8, 0xFFB0, 0xFFB8, 0xFFC0, 0xFFC8, 0xFFD0, 0xFFD8, 0xFFE0, 0xFFE8, 0xFFF0, 0xFFF8, 0x0000, 
+    0x7D7C, 0x797C, 0x757C, 0x717C, 0x6D7C, 0x697C, 0x657C, 0x617C, 0x5D7C, 0x597C, 0x557C, 0x517C, 0x4D7C, 0x497C, 0x457C, 0x417C, 
+    0x3E7C, 0x3C7C, 0x3A7C, 0x387C, 0x367C, 0x347C, 0x327C, 0x307C, 0x2E7C, 0x2C7C, 0x2A7C, 0x287C, 0x267C, 0x247C, 0x227C, 0x207C, 
+    0x1EFC, 0x1DFC, 0x1CFC, 0x1BFC, 0x1AFC, 0x19FC, 0x18FC, 0x17FC, 0x16FC, 0x15FC, 0x14FC, 0x13FC, 0x12FC, 0x11FC, 0x10FC, 0x0FFC, 
+    0x0F3C, 0x0EBC, 0x0E3C, 0x0DBC, 0x0D3C, 0x0CBC, 0x0C3C, 0x0BBC, 0x0B3C, 0x0ABC, 0x0A3C, 0x09BC, 0x093C, 0x08BC, 0x083C, 0x07BC, 
+    0x075C, 0x071C, 0x06DC, 0x069C, 0x065C, 0x061C, 0x05DC, 0x059C, 0x055C, 0x051C, 0x04DC, 0x049C, 0x045C, 0x041C, 0x03DC, 0x039C, 
+    0x036C, 0x034C, 0x032C, 0x030C, 0x02EC, 0x02CC, 0x02AC, 0x028C, 0x026C, 0x024C, 0x022C, 0x020C, 0x01EC, 0x01CC, 0x01AC, 0x018C, 
+    0x0174, 0x0164, 0x0154, 0x0144, 0x0134, 0x0124, 0x0114, 0x0104, 0x00F4, 0x00E4, 0x00D4, 0x00C4, 0x00B4, 0x00A4, 0x0094, 0x0084, 
+    0x0078, 0x0070, 0x0068, 0x0060, 0x0058, 0x0050, 0x0048, 0x0040, 0x0038, 0x0030, 0x0028, 0x0020, 0x0018, 0x0010, 0x0008, 0x0000
+};
+
+// The tables above scaled to the range of -1..1 so conversions to f32 are a single lookup.
+static float g_drwavAlawTableF32[256] = {
+    -0.16796875f, -0.16015625f, -0.18359375f, -0.17578125f, -0.13671875f, -0.12890625f, -0.15234375f, -0.14453125f,
+    -0.23046875f, -0.22265625f, -0.24609375f, -0.23828125f, -0.19921875f, -0.19140625f, -0.21484375f, -0.20703125f,
+    -0.083984375f, -0.080078125f, -0.091796875f, -0.087890625f, -0.068359375f, -0.064453125f, -0.076171875f, -0.072265625f,
+    -0.115234375f, -0.111328125f, -0.123046875f, -0.119140625f, -0.099609375f, -0.095703125f, -0.107421875f, -0.103515625f,
+    -0.671875f, -0.640625f, -0.734375f, -0.703125f, -0.546875f, -0.515625f, -0.609375f, -0.578125f,
+    -0.921875f, -0.890625f, -0.984375f, -0.953125f, -0.796875f, -0.765625f, -0.859375f, -0.828125f,
+    -0.3359375f, -0.3203125f, -0.3671875f, -0.3515625f, -0.2734375f, -0.2578125f, -0.3046875f, -0.2890625f,
+    -0.4609375f, -0.4453125f, -0.4921875f, -0.4765625f, -0.3984375f, -0.3828125f, -0.4296875f, -0.4140625f,
+    -0.010498046875f, -0.010009765625f, -0.011474609375f, -0.010986328125f, -0.008544921875f, -0.008056640625f, -0.009521484375f, -0.009033203125f,
+    -0.014404296875f, -0.013916015625f, -0.015380859375f, -0.014892578125f, -0.012451171875f, -0.011962890625f, -0.013427734375f, -0.012939453125f,
+    -0.002685546875f, -0.002197265625f, -0.003662109375f, -0.003173828125f, -0.000732421875f, -0.000244140625f, -0.001708984375f, -0.001220703125f,
+    -0.006591796875f, -0.006103515625f, -0.007568359375f, -0.007080078125f, -0.004638671875f, -0.004150390625f, -0.005615234375f, -0.005126953125f,
+    -0.0419921875f, -0.0400390625f, -0.0458984375f, -0.0439453125f, -0.0341796875f, -0.0322265625f, -0.0380859375f, -0.0361328125f,
+    -0.0576171875f, -0.0556640625f, -0.0615234375f, -0.0595703125f, -0.0498046875f, -0.0478515625f, -0.0537109375f, -0.0517578125f,
+    -0.02099609375f, -0.02001953125f, -0.02294921875f, -0.02197265625f, -0.01708984375f, -0.01611328125f, -0.01904296875f, -0.01806640625f,
+    -0.02880859375f, -0.02783203125f, -0.03076171875f, -0.02978515625f, -0.02490234375f, -0.02392578125f, -0.02685546875f, -0.02587890625f,
+    0.16796875f, 0.16015625f, 0.18359375f, 0.17578125f, 0.13671875f, 0.12890625f, 0.15234375f, 0.14453125f,
+    0.23046875f, 0.22265625f, 0.24609375f, 0.23828125f, 0.19921875f, 0.19140625f, 0.21484375f, 0.20703125f,
+    0.083984375f, 0.080078125f, 0.091796875f, 0.087890625f, 0.068359375f, 0.064453125f, 0.076171875f, 0.072265625f,
+    0.115234375f, 0.111328125f, 0.123046875f, 0.119140625f, 0.099609375f, 0.095703125f, 0.107421875f, 0.103515625f,
+    0.671875f, 0.640625f, 0.734375f, 0.703125f, 0.546875f, 0.515625f, 0.609375f, 0.578125f,
+    0.921875f, 0.890625f, 0.984375f, 0.953125f, 0.796875f, 0.765625f, 0.859375f, 0.828125f,
+    0.3359375f, 0.3203125f, 0.3671875f, 0.3515625f, 0.2734375f, 0.2578125f, 0.3046875f, 0.2890625f,
+    0.4609375f, 0.4453125f, 0.4921875f, 0.4765625f, 0.3984375f, 0.3828125f, 0.4296875f, 0.4140625f,
+    0.010498046875f, 0.010009765625f, 0.011474609375f, 0.010986328125f, 0.008544921875f, 0.008056640625f, 0.009521484375f, 0.009033203125f,
+    0.014404296875f, 0.013916015625f, 0.015380859375f, 0.014892578125f, 0.012451171875f, 0.011962890625f, 0.013427734375f, 0.012939453125f,
+    0.002685546875f, 0.002197265625f, 0.003662109375f, 0.003173828125f, 0.000732421875f, 0.000244140625f, 0.001708984375f, 0.001220703125f,
+    0.006591796875f, 0.006103515625f, 0.007568359375f, 0.007080078125f, 0.004638671875f, 0.004150390625f, 0.005615234375f, 0.005126953125f,
+    0.0419921875f, 0.0400390625f, 0.0458984375f, 0.0439453125f, 0.0341796875f, 0.0322265625f, 0.0380859375f, 0.0361328125f,
+    0.0576171875f, 0.0556640625f, 0.0615234375f, 0.0595703125f, 0.0498046875f, 0.0478515625f, 0.0537109375f, 0.0517578125f,
+    0.02099609375f, 0.02001953125f, 0.02294921875f, 0.02197265625f, 0.01708984375f, 0.01611328125f, 0.01904296875f, 0.01806640625f,
+    0.02880859375f, 0.02783203125f, 0.03076171875f, 0.02978515625f, 0.02490234375f, 0.02392578125f, 0.02685546875f, 0.02587890625f
+};
+
+static float g_drwavMulawTableF32[256] = {
+    -0.9803466796875f, -0.9490966796875f, -0.9178466796875f, -0.8865966796875f, -0.8553466796875f, -0.8240966796875f, -0.7928466796875f, -0.7615966796875f,
+    -0.7303466796875f, -0.6990966796875f, -0.6678466796875f, -0.6365966796875f, -0.6053466796875f, -0.5740966796875f, -0.5428466796875f, -0.5115966796875f,
+    -0.4881591796875f, -0.4725341796875f, -0.4569091796875f, -0.4412841796875f, -0.4256591796875f, -0.4100341796875f, -0.3944091796875f, -0.3787841796875f,
+    -0.3631591796875f, -0.3475341796875f, -0.3319091796875f, -0.3162841796875f, -0.3006591796875f, -0.2850341796875f, -0.2694091796875f, -0.2537841796875f,
+    -0.2420654296875f, -0.2342529296875f, -0.2264404296875f, -0.2186279296875f, -0.2108154296875f, -0.2030029296875f, -0.1951904296875f, -0.1873779296875f,
+    -0.1795654296875f, -0.1717529296875f, -0.1639404296875f, -0.1561279296875f, -0.1483154296875f, -0.1405029296875f, -0.1326904296875f, -0.1248779296875f,
+    -0.1190185546875f, -0.1151123046875f, -0.1112060546875f, -0.1072998046875f, -0.1033935546875f, -0.0994873046875f, -0.0955810546875f, -0.0916748046875f,
+    -0.0877685546875f, -0.0838623046875f, -0.0799560546875f, -0.0760498046875f, -0.0721435546875f, -0.0682373046875f, -0.0643310546875f, -0.0604248046875f,
+    -0.0574951171875f, -0.0555419921875f, -0.0535888671875f, -0.0516357421875f, -0.0496826171875f, -0.0477294921875f, -0.0457763671875f, -0.0438232421875f,
+    -0.0418701171875f, -0.0399169921875f, -0.0379638671875f, -0.0360107421875f, -0.0340576171875f, -0.0321044921875f, -0.0301513671875f, -0.0281982421875f,
+    -0.0267333984375f, -0.0257568359375f, -0.0247802734375f, -0.0238037109375f, -0.0228271484375f, -0.0218505859375f, -0.0208740234375f, -0.0198974609375f,
+    -0.0189208984375f, -0.0179443359375f, -0.0169677734375f, -0.0159912109375f, -0.0150146484375f, -0.0140380859375f, -0.0130615234375f, -0.0120849609375f,
+    -0.0113525390625f, -0.0108642578125f, -0.0103759765625f, -0.0098876953125f, -0.0093994140625f, -0.0089111328125f, -0.0084228515625f, -0.0079345703125f,
+    -0.0074462890625f, -0.0069580078125f, -0.0064697265625f, -0.0059814453125f, -0.0054931640625f, -0.0050048828125f, -0.0045166015625f, -0.0040283203125f,
+    -0.003662109375f, -0.00341796875f, -0.003173828125f, -0.0029296875f, -0.002685546875f, -0.00244140625f, -0.002197265625f, -0.001953125f,
+    -0.001708984375f, -0.00146484375f, -0.001220703125f, -0.0009765625f, -0.000732421875f, -0.00048828125f, -0.000244140625f, 0.0f,
+    0.9803466796875f, 0.9490966796875f, 0.9178466796875f, 0.8865966796875f, 0.8553466796875f, 0.8240966796875f, 0.7928466796875f, 0.7615966796875f,
+    0.7303466796875f, 0.6990966796875f, 0.6678466796875f, 0.6365966796875f, 0.6053466796875f, 0.5740966796875f, 0.5428466796875f, 0.5115966796875f,
+    0.4881591796875f, 0.4725341796875f, 0.4569091796875f, 0.4412841796875f, 0.4256591796875f, 0.4100341796875f, 0.3944091796875f, 0.3787841796875f,
+    0.3631591796875f, 0.3475341796875f, 0.3319091796875f, 0.3162841796875f, 0.3006591796875f, 0.2850341796875f, 0.2694091796875f, 0.2537841796875f,
+    0.2420654296875f, 0.2342529296875f, 0.2264404296875f, 0.2186279296875f, 0.2108154296875f, 0.2030029296875f, 0.1951904296875f, 0.1873779296875f,
+    0.1795654296875f, 0.1717529296875f, 0.1639404296875f, 0.1561279296875f, 0.1483154296875f, 0.1405029296875f, 0.1326904296875f, 0.1248779296875f,
+    0.1190185546875f, 0.1151123046875f, 0.1112060546875f, 0.1072998046875f, 0.1033935546875f, 0.0994873046875f, 0.0955810546875f, 0.0916748046875f,
+    0.0877685546875f, 0.0838623046875f, 0.0799560546875f, 0.0760498046875f, 0.0721435546875f, 0.0682373046875f, 0.0643310546875f, 0.0604248046875f,
+    0.0574951171875f, 0.0555419921875f, 0.0535888671875f, 0.0516357421875f, 0.0496826171875f, 0.0477294921875f, 0.0457763671875f, 0.0438232421875f,
+    0.0418701171875f, 0.0399169921875f, 0.0379638671875f, 0.0360107421875f, 0.0340576171875f, 0.0321044921875f, 0.0301513671875f, 0.0281982421875f,
+    0.0267333984375f, 0.0257568359375f, 0.0247802734375f, 0.0238037109375f, 0.0228271484375f, 0.0218505859375f, 0.0208740234375f, 0.0198974609375f,
+    0.0189208984375f, 0.0179443359375f, 0.0169677734375f, 0.0159912109375f, 0.0150146484375f, 0.0140380859375f, 0.0130615234375f, 0.0120849609375f,
+    0.0113525390625f, 0.0108642578125f, 0.0103759765625f, 0.0098876953125f, 0.0093994140625f, 0.0089111328125f, 0.0084228515625f, 0.0079345703125f,
+    0.0074462890625f, 0.0069580078125f, 0.0064697265625f, 0.0059814453125f, 0.0054931640625f, 0.0050048828125f, 0.0045166015625f, 0.0040283203125f,
+    0.003662109375f, 0.00341796875f, 0.003173828125f, 0.0029296875f, 0.002685546875f, 0.00244140625f, 0.002197265625f, 0.001953125f,
+    0.001708984375f, 0.00146484375f, 0.001220703125f, 0.0009765625f, 0.000732421875f, 0.00048828125f, 0.000244140625f, 0.0f
+};
+
+static DRWAV_INLINE drwav_int16 drwav__alaw_to_s16(drwav_uint8 sampleIn)
+{
+    return (short)g_drwavAlawTable[sampleIn];
+}
+
+static DRWAV_INLINE drwav_int16 drwav__mulaw_to_s16(drwav_uint8 sampleIn)
+{
+    return (short)g_drwavMulawTable[sampleIn];
+}
+
+#ifdef DRWAV_SUPPORT_SSSE3
+// Decodes 16 A-law or u-law samples into two vectors of 8 signed 16-bit samples. This produces exactly the same values as the
+// tables. Each code is a sign bit, a 3-bit exponent and a 4-bit mantissa, and the power of two selected by the exponent is looked
+// up with pshufb so the whole thing stays in registers.
+//
+//   A-law: ((mantissa*2 + (exponent == 0 ? 1 : 33)) << max(exponent-1, 0)) * 8, negative when the sign bit is clear.
+//   u-law: (((mantissa*8 + 0x84) << exponent) - 0x84, negative when the sign bit is set.
+static DRWAV_INLINE void drwav__g711_to_s16x16__ssse3(__m128i in, drwav_bool32 isALaw, __m128i* pLo, __m128i* pHi)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i x = _mm_xor_si128(in, isALaw ? _mm_set1_epi8(0x55) : _mm_set1_epi8(-1));   // Undo the bit inversion.
+    __m128i exponent = _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(7));
+    __m128i mantissa = _mm_and_si128(x, _mm_set1_epi8(15));
+    __m128i lo;
+    __m128i hi;
+    __m128i negateLo;
+    __m128i negateHi;
+
+    if (isALaw) {
+        __m128i base  = _mm_add_epi8(_mm_add_epi8(mantissa, mantissa), _mm_shuffle_epi8(_mm_setr_epi8(1, 33, 33, 33, 33, 33, 33, 33, 0, 0, 0, 0, 0, 0, 0, 0), exponent));
+        __m128i scale = _mm_shuffle_epi8(_mm_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0), exponent);
+        lo = _mm_slli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(base, zero), _mm_unpacklo_epi8(scale, zero)), 3);
+        hi = _mm_slli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(base, zero), _mm_unpackhi_epi8(scale, zero)), 3);
+    } else {
+        __m128i bias  = _mm_set1_epi16(0x84);
+        __m128i scale = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0), exponent);
+        lo = _mm_sub_epi16(_mm_mullo_epi16(_mm_add_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(mantissa, zero), 3), bias), _mm_unpacklo_epi8(scale, zero)), bias);
+        hi = _mm_sub_epi16(_mm_mullo_epi16(_mm_add_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(mantissa, zero), 3), bias), _mm_unpackhi_epi8(scale, zero)), bias);
+    }
+
+    // All bits set in the lanes that need to be negated.
+    negateLo = _mm_srai_epi16(_mm_unpacklo_epi8(zero, x), 15);
+    negateHi = _mm_srai_epi16(_mm_unpackhi_epi8(zero, x), 15);
+    if (isALaw) {
+        negateLo = _mm_xor_si128(negateLo, _mm_set1_epi16(-1));
+        negateHi = _mm_xor_si128(negateHi, _mm_set1_epi16(-1));
+    }
+
+    *pLo = _mm_sub_epi16(_mm_xor_si128(lo, negateLo), negateLo);
+    *pHi = _mm_sub_epi16(_mm_xor_si128(hi, negateHi), negateHi);
+}
+
+static size_t drwav__g711_to_s16__ssse3(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount, drwav_bool32 isALaw)
+{
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i lo;
+        __m128i hi;
+        drwav__g711_to_s16x16__ssse3(_mm_loadu_si128((const __m128i*)(pIn + i)), isALaw, &lo, &hi);
+        _mm_storeu_si128((__m128i*)(pOut + i + 0), lo);
+        _mm_storeu_si128((__m128i*)(pOut + i + 8), hi);
+    }
+
+    return i;
+}
+
+static size_t drwav__g711_to_f32__ssse3(float* pOut, const drwav_uint8* pIn, size_t sampleCount, drwav_bool32 isALaw)
+{
+    __m128 factor = _mm_set1_ps(1 / 32768.0f);
+
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i lo;
+        __m128i hi;
+        drwav__g711_to_s16x16__ssse3(_mm_loadu_si128((const __m128i*)(pIn + i)), isALaw, &lo, &hi);
+        _mm_storeu_ps(pOut + i +  0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16)), factor));
+        _mm_storeu_ps(pOut + i +  4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16)), factor));
+        _mm_storeu_ps(pOut + i +  8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16)), factor));
+        _mm_storeu_ps(pOut + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16)), factor));
+    }
+
+    return i;
+}
+
+static size_t drwav__g711_to_s32__ssse3(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount, drwav_bool32 isALaw)
+{
+    __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i lo;
+        __m128i hi;
+        drwav__g711_to_s16x16__ssse3(_mm_loadu_si128((const __m128i*)(pIn + i)), isALaw, &lo, &hi);
+        _mm_storeu_si128((__m128i*)(pOut + i +  0), _mm_unpacklo_epi16(zero, lo));
+        _mm_storeu_si128((__m128i*)(pOut + i +  4), _mm_unpackhi_epi16(zero, lo));
+        _mm_storeu_si128((__m128i*)(pOut + i +  8), _mm_unpacklo_epi16(zero, hi));
+        _mm_storeu_si128((__m128i*)(pOut + i + 12), _mm_unpackhi_epi16(zero, hi));
+    }
+
+    return i;
+}
+#endif
+
+
+
+#ifndef DR_WAV_CONVERSION_BUFFER_SIZE
+#define DR_WAV_CONVERSION_BUFFER_SIZE   16384
+#endif
+
+// Reads raw samples into the end of an output buffer of <samplesToRead> samples that are each <bytesPerOutputSample> wide, which
+// must be at least as wide as the raw samples. Converting front to back from there never overwrites a raw sample before it has
+// been converted, so the conversion can be done in place without a staging buffer and with a single call to onRead.
+static drwav_uint64 drwav__read_raw_to_end_of_buffer(drwav* pWav, drwav_uint64 samplesToRead, void* pBufferOut, size_t bytesPerOutputSample, unsigned char** ppRawData)
+{
+    drwav_assert(pWav->bytesPerSample <= bytesPerOutputSample);
+
+    // The raw data must end where the samples that will actually be read end, not where the caller's request does.
+    if (samplesToRead > pWav->bytesRemaining / pWav->bytesPerSample) {
+        samplesToRead = pWav->bytesRemaining / pWav->bytesPerSample;
+    }
+
+    *ppRawData = (unsigned char*)pBufferOut + (size_t)samplesToRead * (bytesPerOutputSample - pWav->bytesPerSample);
+    return drwav_read(pWav, samplesToRead, *ppRawData);
+}
+
+// AIFF samples are fixed up to the layout of WAV samples before conversion. Multi-byte samples are byte swapped and 8-bit
+// samples have their sign bit flipped to make them unsigned. This works in place.
+static void drwav__fixup_samples__reference(unsigned char* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+{
+    if (bytesPerSample == 1) {
+        for (size_t i = 0; i < sampleCount; ++i) {
+            pOut[i] = pIn[i] ^ 0x80;
+        }
+        return;
+    }
+
+    if (bytesPerSample == 3) {
+        for (size_t i = 0; i < sampleCount*3; i += 3) {
+            unsigned char lo = pIn[i+0];
+            pOut[i+0] = pIn[i+2];
+            pOut[i+1] = pIn[i+1];
+            pOut[i+2] = lo;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < sampleCount; ++i) {
+        for (unsigned short j = 0; j < bytesPerSample/2; ++j) {
+            unsigned char lo = pIn[j];
+            unsigned char hi = pIn[bytesPerSample-1-j];
+            pOut[j] = hi;
+            pOut[bytesPerSample-1-j] = lo;
+        }
+        if ((bytesPerSample & 1) != 0) {
+            pOut[bytesPerSample/2] = pIn[bytesPerSample/2];
+        }
+
+        pIn  += bytesPerSample;
+        pOut += bytesPerSample;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static DRWAV_INLINE __m128i drwav__swap_bytes_16x8__sse2(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+static void drwav__fixup_samples__sse2(unsigned char* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+{
+    size_t byteCount = sampleCount * bytesPerSample;
+    size_t i = 0;
+
+    if (bytesPerSample == 1) {
+        __m128i signBit = _mm_set1_epi8((char)0x80);
+        for (; i + 16 <= byteCount; i += 16) {
+            _mm_storeu_si128((__m128i*)(pOut + i), _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pIn + i)), signBit));
+        }
+    } else if (bytesPerSample == 2) {
+        for (; i + 16 <= byteCount; i += 16) {
+            _mm_storeu_si128((__m128i*)(pOut + i), drwav__swap_bytes_16x8__sse2(_mm_loadu_si128((const __m128i*)(pIn + i))));
+        }
+    } else if (bytesPerSample == 4) {
+        for (; i + 16 <= byteCount; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(pIn + i));
+            x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            _mm_storeu_si128((__m128i*)(pOut + i), drwav__swap_bytes_16x8__sse2(x));
+        }
+    } else if (bytesPerSample == 8) {
+        for (; i + 16 <= byteCount; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(pIn + i));
+            x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+            _mm_storeu_si128((__m128i*)(pOut + i), drwav__swap_bytes_16x8__sse2(x));
+        }
+    }
+#ifdef DRWAV_SUPPORT_SSSE3
+    else if (bytesPerSample == 3 && drwav__has_ssse3()) {
+        // 5 samples at a time. The last byte belongs to the next sample and is passed through untouched, to be fixed up by the next
+        // iteration or the reference implementation.
+        __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+        for (; i + 16 <= byteCount; i += 15) {
+            _mm_storeu_si128((__m128i*)(pOut + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pIn + i)), mask));
+        }
+    }
+#endif
+
+    drwav__fixup_samples__reference(pOut + i, pIn + i, (byteCount - i) / bytesPerSample, bytesPerSample);
+}
+#endif
+
+static void drwav__fixup_samples(unsigned char* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__fixup_samples__sse2(pOut, pIn, sampleCount, bytesPerSample);
+#else
+    drwav__fixup_samples__reference(pOut, pIn, sampleCount, bytesPerSample);
+#endif
+}
+
+static DRWAV_INLINE drwav_bool32 drwav__needs_sample_fixup(drwav* pWav)
+{
+    return pWav->aiff.isBigEndian || pWav->aiff.isSigned8Bit;
+}
+
+// Samples that need fixing up are done a block at a time into a buffer that stays in cache, and then converted from there.
+#define DRWAV_FIXUP_BUFFER_SIZE     4096
+
+// The number of samples that are converted to floating point at a time before being dithered to 16 bits.
+#define DRWAV_DITHER_CHUNK_SIZE     256
+
+static DRWAV_INLINE size_t drwav__fixup_samples_for_conversion(drwav* pWav, unsigned char* pFixupBuffer, const unsigned char** ppIn, size_t sampleCount)
+{
+    if (!drwav__needs_sample_fixup(pWav)) {
+        return sampleCount;
+    }
+
+    size_t samplesToFix = drwav_min(sampleCount, DRWAV_FIXUP_BUFFER_SIZE / pWav->bytesPerSample);
+    drwav__fixup_samples(pFixupBuffer, *ppIn, samplesToFix, pWav->bytesPerSample);
+    *ppIn = pFixupBuffer;
+
+    return samplesToFix;
+}
+
+static void drwav__pcm_to_s16(drwav_int16* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample, drwav_dither* pDither)
+{
+    // Special case for 8-bit sample data because it's treated as unsigned.
+    if (bytesPerSample == 1) {
+        drwav_u8_to_s16(pOut, pIn, totalSampleCount);
+        return;
+    }
+
+
+    // Slightly more optimal implementation for common formats.
+    if (bytesPerSample == 2) {
+        drwav_copy_memory(pOut, pIn, totalSampleCount * sizeof(drwav_int16));
+        return;
+    }
+    if (bytesPerSample == 3) {
+        drwav_s24_to_s16_dithered(pOut, pIn, totalSampleCount, pDither);
+        return;
+    }
+    if (bytesPerSample == 4) {
+        drwav_s32_to_s16_dithered(pOut, (const drwav_int32*)pIn, totalSampleCount, pDither);
+        return;
+    }
+
+    // Wider samples are dithered from their upper 32 bits.
+    if (pDither != NULL && pDither->mode != drwav_dither_mode_none) {
+        drwav_int32 samples32[DRWAV_DITHER_CHUNK_SIZE];
+        while (totalSampleCount > 0) {
+            size_t samplesToConvert = drwav_min(totalSampleCount, DRWAV_DITHER_CHUNK_SIZE);
+            for (size_t i = 0; i < samplesToConvert; ++i) {
+                const unsigned char* pTop = pIn + (i * bytesPerSample) + (bytesPerSample - 4);
+                samples32[i] = (drwav_int32)((drwav_uint32)pTop[0] | ((drwav_uint32)pTop[1] << 8) | ((drwav_uint32)pTop[2] << 16) | ((drwav_uint32)pTop[3] << 24));
+            }
+
+            drwav_s32_to_s16_dithered(pOut, samples32, samplesToConvert, pDither);
+
+            pOut             += samplesToConvert;
+            pIn              += samplesToConvert * bytesPerSample;
+            totalSampleCount -= samplesToConvert;
+        }
+        return;
+    }
+
+
+    // Generic, slow converter.
+    for (unsigned int i = 0; i < totalSampleCount; ++i) {
+        unsigned short sample = 0;
+        unsigned short shift  = (8 - bytesPerSample) * 8;
+        for (unsigned short j = 0; j < bytesPerSample && j < 2; ++j) {
+            sample |= (unsigned short)(pIn[j]) << shift;
+            shift  += 8;
+        }
+
+        pIn += bytesPerSample;
+        *pOut++ = sample;
+    }
+}
+
+static void drwav__ieee_to_s16(drwav_int16* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample, drwav_dither* pDither)
+{
+    if (bytesPerSample == 4) {
+        drwav_f32_to_s16_dithered(pOut, (float*)pIn, totalSampleCount, pDither);
+        return;
+    } else {
+        drwav_f64_to_s16_dithered(pOut, (double*)pIn, totalSampleCount, pDither);
+        return;
+    }
+}
+
+// Converts raw PCM or floating point samples straight from the file, fixing up AIFF samples on the way.
+static void drwav__raw_to_s16(drwav* pWav, drwav_int16* pOut, const unsigned char* pIn, size_t sampleCount, drwav_dither* pDither)
+{
+    unsigned char fixupBuffer[DRWAV_FIXUP_BUFFER_SIZE];
+    while (sampleCount > 0) {
+        const unsigned char* pSamples = pIn;
+        size_t samplesToConvert = drwav__fixup_samples_for_conversion(pWav, fixupBuffer, &pSamples, sampleCount);
+
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+            drwav__ieee_to_s16(pOut, pSamples, samplesToConvert, pWav->bytesPerSample, pDither);
+        } else {
+            drwav__pcm_to_s16(pOut, pSamples, samplesToConvert, pWav->bytesPerSample, pDither);
+        }
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert * pWav->bytesPerSample;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+drwav_uint64 drwav_read_s16__pcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut, drwav_dither* pDither)
+{
+    // Fast path.
+    if (pWav->bytesPerSample == 2) {
+        drwav_uint64 samplesRead = drwav_read(pWav, samplesToRead, pBufferOut);
+        if (drwav__needs_sample_fixup(pWav)) {
+            drwav__fixup_samples((unsigned char*)pBufferOut, (unsigned char*)pBufferOut, (size_t)samplesRead, pWav->bytesPerSample);
+        }
+        return samplesRead;
+    }
+
+    if (pWav->bytesPerSample <= sizeof(drwav_int16)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int16), &pRawData);
+        drwav__raw_to_s16(pWav, pBufferOut, pRawData, (size_t)samplesRead, NULL);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_s16(pWav, pBufferOut, sampleData, (size_t)samplesRead, pDither);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+static drwav_int32 g_drwavMSADPCMAdaptationTable[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+static drwav_int32 g_drwavIMAStepTable[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+// The IMA ADPCM step can be collapsed into a lookup keyed on the step index and the nibble. These tables are derived from the step table above,
+// with one row per step index. The first gives the difference to apply to the predictor and the second gives the next step index, which is the
+// current one adjusted by {-1, -1, -1, -1, 2, 4, 6, 8} based on the magnitude bits of the nibble and clamped to the range of the step table.
+static drwav_int32 g_drwavIMADiffTable[89*16] = {
+         0,      1,      3,      4,      7,      8,     10,     11,      0,     -1,     -3,     -4,     -7,     -8,    -10,    -11,
+         1,      3,      5,      7,      9,     11,     13,     15,     -1,     -3,     -5,     -7,     -9,    -11,    -13,    -15,
+         1,      3,      5,      7,     10,     12,     14,     16,     -1,     -3,     -5,     -7,    -10,    -12,    -14,    -16,
+         1,      3,      6,      8,     11,     13,     16,     18,     -1,     -3,     -6,     -8,    -11,    -13,    -16,    -18,
+         1,      3,      6,      8,     12,     14,     17,     19,     -1,     -3,     -6,     -8,    -12,    -14,    -17,    -19,
+         1,      4,      7,     10,     13,     16,     19,     22,     -1,     -4,     -7,    -10,    -13,    -16,    -19,    -22,
+         1,      4,      7,     10,     14,     17,     20,     23,     -1,     -4,     -7,    -10,    -14,    -17,    -20,    -23,
+         1,      4,      8,     11,     15,     18,     22,     25,     -1,     -4,     -8,    -11,    -15,    -18,    -22,    -25,
+         2,      6,     10,     14,     18,     22,     26,     30,     -2,     -6,    -10,    -14,    -18,    -22,    -26,    -30,
+         2,      6,     10,     14,     19,     23,     27,     31,     -2,     -6,    -10,    -14,    -19,    -23,    -27,    -31,
+         2,      6,     11,     15,     21,     25,     30,     34,     -2,     -6,    -11,    -15,    -21,    -25,    -30,    -34,
+         2,      7,     12,     17,     23,     28,     33,     38,     -2,     -7,    -12,    -17,    -23,    -28,    -33,    -38,
+         2,      7,     13,     18,     25,     30,     36,     41,     -2,     -7,    -13,    -18,    -25,    -30,    -36,    -41,
+         3,      9,     15,     21,     28,     34,     40,     46,     -3,     -9,    -15,    -21,    -28,    -34,    -40,    -46,
+         3,     10,     17,     24,     31,     38,     45,     52,     -3,    -10,    -17,    -24,    -31,    -38,    -45,    -52,
+         3,     10,     18,     25,     34,     41,     49,     56,     -3,    -10,    -18,    -25,    -34,    -41,    -49,    -56,
+         4,     12,     21,     29,     38,     46,     55,     63,     -4,    -12,    -21,    -29,    -38,    -46,    -55,    -63,
+         4,     13,     22,     31,     41,     50,     59,     68,     -4,    -13,    -22,    -31,    -41,    -50,    -59,    -68,
+         5,     15,     25,     35,     46,     56,     66,     76,     -5,    -15,    -25,    -35,    -46,    -56,    -66,    -76,
+         5,     16,     27,     38,     50,     61,     72,     83,     -5,    -16,    -27,    -38,    -50,    -61,    -72,    -83,
+         6,     18,     31,     43,     56,     68,     81,     93,     -6,    -18,    -31,    -43,    -56,    -68,    -81,    -93,
+         6,     19,     33,     46,     61,     74,     88,    101,     -6,    -19,    -33,    -46,    -61,    -74,    -88,   -101,
+         7,     22,     37,     52,     67,     82,     97,    112,     -7,    -22,    -37,    -52,    -67,    -82,    -97,   -112,
+         8,     24,     41,     57,     74,     90,    107,    123,     -8,    -24,    -41,    -57,    -74,    -90,   -107,   -123,
+         9,     27,     45,     63,     82,    100,    118,    136,     -9,    -27,    -45,    -63,    -82,   -100,   -118,   -136,
+        10,     30,     50,     70,     90,    110,    130,    150,    -10,    -30,    -50,    -70,    -90,   -110,   -130,   -150,
+        11,     33,     55,     77,     99,    121,    143,    165,    -11,    -33,    -55,    -77,    -99,   -121,   -143,   -165,
+        12,     36,     60,     84,    109,    133,    157,    181,    -12,    -36,    -60,    -84,   -109,   -133,   -157,   -181,
+        13,     39,     66,     92,    120,    146,    173,    199,    -13,    -39,    -66,    -92,   -120,   -146,   -173,   -199,
+        14,     43,     73,    102,    132,    161,    191,    220,    -14,    -43,    -73,   -102,   -132,   -161,   -191,   -220,
+        16,     48,     81,    113,    146,    178,    211,    243,    -16,    -48,    -81,   -113,   -146,   -178,   -211,   -243,
+        17,     52,     88,    123,    160,    195,    231,    266,    -17,    -52,    -88,   -123,   -160,   -195,   -231,   -266,
+        19,     58,     97,    136,    176,    215,    254,    293,    -19,    -58,    -97,   -136,   -176,   -215,   -254,   -293,
+        21,     64,    107,    150,    194,    237,    280,    323,    -21,    -64,   -107,   -150,   -194,   -237,   -280,   -323,
+        23,     70,    118,    165,    213,    260,    308,    355,    -23,    -70,   -118,   -165,   -213,   -260,   -308,   -355,
+        26,     78,    130,    182,    235,    287,    339,    391,    -26,    -78,   -130,   -182,   -235,   -287,   -339,   -391,
+        28,     85,    143,    200,    258,    315,    373,    430,    -28,    -85,   -143,   -200,   -258,   -315,   -373,   -430,
+        31,     94,    157,    220,    284,    347,    410,    473,    -31,    -94,   -157,   -220,   -284,   -347,   -410,   -473,
+        34,    103,    173,    242,    313,    382,    452,    521,    -34,   -103,   -173,   -242,   -313,   -382,   -452,   -521,
+        38,    114,    191,    267,    345,    421,    498,    574,    -38,   -114,   -191,   -267,   -345,   -421,   -498,   -574,
+        42,    126,    210,    294,    379,    463,    547,    631,    -42,   -126,   -210,   -294,   -379,   -463,   -547,   -631,
+        46,    138,    231,    323,    417,    509,    602,    694,    -46,   -138,   -231,   -323,   -417,   -509,   -602,   -694,
+        51,    153,    255,    357,    459,    561,    663,    765,    -51,   -153,   -255,   -357,   -459,   -561,   -663,   -765,
+        56,    168,    280,    392,    505,    617,    729,    841,    -56,   -168,   -280,   -392,   -505,   -617,   -729,   -841,
+        61,    184,    308,    431,    555,    678,    802,    925,    -61,   -184,   -308,   -431,   -555,   -678,   -802,   -925,
+        68,    204,    340,    476,    612,    748,    884,   1020,    -68,   -204,   -340,   -476,   -612,   -748,   -884,  -1020,
+        74,    223,    373,    522,    672,    821,    971,   1120,    -74,   -223,   -373,   -522,   -672,   -821,   -971,  -1120,
+        82,    246,    411,    575,    740,    904,   1069,   1233,    -82,   -246,   -411,   -575,   -740,   -904,  -1069,  -1233,
+        90,    271,    452,    633,    814,    995,   1176,   1357,    -90,   -271,   -452,   -633,   -814,   -995,  -1176,  -1357,
+        99,    298,    497,    696,    895,   1094,   1293,   1492,    -99,   -298,   -497,   -696,   -895,  -1094,  -1293,  -1492,
+       109,    328,    547,    766,    985,   1204,   1423,   1642,   -109,   -328,   -547,   -766,   -985,  -1204,  -1423,  -1642,
+       120,    360,    601,    841,   1083,   1323,   1564,   1804,   -120,   -360,   -601,   -841,  -1083,  -1323,  -1564,  -1804,
+       132,    397,    662,    927,   1192,   1457,   1722,   1987,   -132,   -397,   -662,   -927,  -1192,  -1457,  -1722,  -1987,
+       145,    436,    728,   1019,   1311,   1602,   1894,   2185,   -145,   -436,   -728,  -1019,  -1311,  -1602,  -1894,  -2185,
+       160,    480,    801,   1121,   1442,   1762,   2083,   2403,   -160,   -480,   -801,  -1121,  -1442,  -1762,  -2083,  -2403,
+       176,    528,    881,   1233,   1587,   1939,   2292,   2644,   -176,   -528,   -881,  -1233,  -1587,  -1939,  -2292,  -2644,
+       194,    582,    970,   1358,   1746,   2134,   2522,   2910,   -194,   -582,   -970,  -1358,  -1746,  -2134,  -2522,  -2910,
+       213,    639,   1066,   1492,   1920,   2346,   2773,   3199,   -213,   -639,  -1066,  -1492,  -1920,  -2346,  -2773,  -3199,
+       234,    703,   1173,   1642,   2112,   2581,   3051,   3520,   -234,   -703,  -1173,  -1642,  -2112,  -2581,  -3051,  -3520,
+       258,    774,   1291,   1807,   2324,   2840,   3357,   3873,   -258,   -774,  -1291,  -1807,  -2324,  -2840,  -3357,  -3873,
+       284,    852,   1420,   1988,   2556,   3124,   3692,   4260,   -284,   -852,  -1420,  -1988,  -2556,  -3124,  -3692,  -4260,
+       312,    936,   1561,   2185,   2811,   3435,   4060,   4684,   -312,   -936,  -1561,  -2185,  -2811,  -3435,  -4060,  -4684,
+       343,   1030,   1717,   2404,   3092,   3779,   4466,   5153,   -343,  -1030,  -1717,  -2404,  -3092,  -3779,  -4466,  -5153,
+       378,   1134,   1890,   2646,   3402,   4158,   4914,   5670,   -378,  -1134,  -1890,  -2646,  -3402,  -4158,  -4914,  -5670,
+       415,   1246,   2078,   2909,   3742,   4573,   5405,   6236,   -415,  -1246,  -2078,  -2909,  -3742,  -4573,  -5405,  -6236,
+       457,   1372,   2287,   3202,   4117,   5032,   5947,   6862,   -457,  -1372,  -2287,  -3202,  -4117,  -5032,  -5947,  -6862,
+       503,   1509,   2516,   3522,   4529,   5535,   6542,   7548,   -503,  -1509,  -2516,  -3522,  -4529,  -5535,  -6542,  -7548,
+       553,   1660,   2767,   3874,   4981,   6088,   7195,   8302,   -553,  -1660,  -2767,  -3874,  -4981,  -6088,  -7195,  -8302,
+       608,   1825,   3043,   4260,   5479,   6696,   7914,   9131,   -608,  -1825,  -3043,  -4260,  -5479,  -6696,  -7914,  -9131,
+       669,   2008,   3348,   4687,   6027,   7366,   8706,  10045,   -669,  -2008,  -3348,  -4687,  -6027,  -7366,  -8706, -10045,
+       736,   2209,   3683,   5156,   6630,   8103,   9577,  11050,   -736,  -2209,  -3683,  -5156,  -6630,  -8103,  -9577, -11050,
+       810,   2431,   4052,   5673,   7294,   8915,  10536,  12157,   -810,  -2431,  -4052,  -5673,  -7294,  -8915, -10536, -12157,
+       891,   2674,   4457,   6240,   8023,   9806,  11589,  13372,   -891,  -2674,  -4457,  -6240,  -8023,  -9806, -11589, -13372,
+       980,   2941,   4902,   6863,   8825,  10786,  12747,  14708,   -980,  -2941,  -4902,  -6863,  -8825, -10786, -12747, -14708,
+      1078,   3235,   5393,   7550,   9708,  11865,  14023,  16180,  -1078,  -3235,  -5393,  -7550,  -9708, -11865, -14023, -16180,
+      1186,   3559,   5932,   8305,  10679,  13052,  15425,  17798,  -1186,  -3559,  -5932,  -8305, -10679, -13052, -15425, -17798,
+      1305,   3915,   6526,   9136,  11747,  14357,  16968,  19578,  -1305,  -3915,  -6526,  -9136, -11747, -14357, -16968, -19578,
+      1435,   4306,   7178,  10049,  12922,  15793,  18665,  21536,  -1435,  -4306,  -7178, -10049, -12922, -15793, -18665, -21536,
+      1579,   4737,   7896,  11054,  14214,  17372,  20531,  23689,  -1579,  -4737,  -7896, -11054, -14214, -17372, -20531, -23689,
+      1737,   5211,   8686,  12160,  15636,  19110,  22585,  26059,  -1737,  -5211,  -8686, -12160, -15636, -19110, -22585, -26059,
+      1911,   5733,   9555,  13377,  17200,  21022,  24844,  28666,  -1911,  -5733,  -9555, -13377, -17200, -21022, -24844, -28666,
+      2102,   6306,  10511,  14715,  18920,  23124,  27329,  31533,  -2102,  -6306, -10511, -14715, -18920, -23124, -27329, -31533,
+      2312,   6937,  11562,  16187,  20812,  25437,  30062,  34687,  -2312,  -6937, -11562, -16187, -20812, -25437, -30062, -34687,
+      2543,   7630,  12718,  17805,  22893,  27980,  33068,  38155,  -2543,  -7630, -12718, -17805, -22893, -27980, -33068, -38155,
+      2798,   8394,  13990,  19586,  25183,  30779,  36375,  41971,  -2798,  -8394, -13990, -19586, -25183, -30779, -36375, -41971,
+      3077,   9232,  15388,  21543,  27700,  33855,  40011,  46166,  -3077,  -9232, -15388, -21543, -27700, -33855, -40011, -46166,
+      3385,  10156,  16928,  23699,  30471,  37242,  44014,  50785,  -3385, -10156, -16928, -23699, -30471, -37242, -44014, -50785,
+      3724,  11172,  18621,  26069,  33518,  40966,  48415,  55863,  -3724, -11172, -18621, -26069, -33518, -40966, -48415, -55863,
+      4095,  12286,  20478,  28669,  36862,  45053,  53245,  61436,  -4095, -12286, -20478, -28669, -36862, -45053, -53245, -61436
+};
+
+static drwav_uint8 g_drwavIMANextStepIndexTable[89*16] = {
+     0,  0,  0,  0,  2,  4,  6,  8,  0,  0,  0,  0,  2,  4,  6,  8,
+     0,  0,  0,  0,  3,  5,  7,  9,  0,  0,  0,  0,  3,  5,  7,  9,
+     1,  1,  1,  1,  4,  6,  8, 10,  1,  1,  1,  1,  4,  6,  8, 10,
+     2,  2,  2,  2,  5,  7,  9, 11,  2,  2,  2,  2,  5,  7,  9, 11,
+     3,  3,  3,  3,  6,  8, 10, 12,  3,  3,  3,  3,  6,  8, 10, 12,
+     4,  4,  4,  4,  7,  9, 11, 13,  4,  4,  4,  4,  7,  9, 11, 13,
+     5,  5,  5,  5,  8, 10, 12, 14,  5,  5,  5,  5,  8, 10, 12, 14,
+     6,  6,  6,  6,  9, 11, 13, 15,  6,  6,  6,  6,  9, 11, 13, 15,
+     7,  7,  7,  7, 10, 12, 14, 16,  7,  7,  7,  7, 10, 12, 14, 16,
+     8,  8,  8,  8, 11, 13, 15, 17,  8,  8,  8,  8, 11, 13, 15, 17,
+     9,  9,  9,  9, 12, 14, 16, 18,  9,  9,  9,  9, 12, 14, 16, 18,
+    10, 10, 10, 10, 13, 15, 17, 19, 10, 10, 10, 10, 13, 15, 17, 19,
+    11, 11, 11, 11, 14, 16, 18, 20, 11, 11, 11, 11, 14, 16, 18, 20,
+    12, 12, 12, 12, 15, 17, 19, 21, 12, 12, 12, 12, 15, 17, 19, 21,
+    13, 13, 13, 13, 16, 18, 20, 22, 13, 13, 13, 13, 16, 18, 20, 22,
+    14, 14, 14, 14, 17, 19, 21, 23, 14, 14, 14, 14, 17, 19, 21, 23,
+    15, 15, 15, 15, 18, 20, 22, 24, 15, 15, 15, 15, 18, 20, 22, 24,
+    16, 16, 16, 16, 19, 21, 23, 25, 16, 16, 16, 16, 19, 21, 23, 25,
+    17, 17, 17, 17, 20, 22, 24, 26, 17, 17, 17, 17, 20, 22, 24, 26,
+    18, 18, 18, 18, 21, 23, 25, 27, 18, 18, 18, 18, 21, 23, 25, 27,
+    19, 19, 19, 19, 22, 24, 26, 28, 19, 19, 19, 19, 22, 24, 26, 28,
+    20, 20, 20, 20, 23, 25, 27, 29, 20, 20, 20, 20, 23, 25, 27, 29,
+    21, 21, 21, 21, 24, 26, 28, 30, 21, 21, 21, 21, 24, 26, 28, 30,
+    22, 22, 22, 22, 25, 27, 29, 31, 22, 22, 22, 22, 25, 27, 29, 31,
+    23, 23, 23, 23, 26, 28, 30, 32, 23, 23, 23, 23, 26, 28, 30, 32,
+    24, 24, 24, 24, 27, 29, 31, 33, 24, 24, 24, 24, 27, 29, 31, 33,
+    25, 25, 25, 25, 28, 30, 32, 34, 25, 25, 25, 25, 28, 30, 32, 34,
+    26, 26, 26, 26, 29, 31, 33, 35, 26, 26, 26, 26, 29, 31, 33, 35,
+    27, 27, 27, 27, 30, 32, 34, 36, 27, 27, 27, 27, 30, 32, 34, 36,
+    28, 28, 28, 28, 31, 33, 35, 37, 28, 28, 28, 28, 31, 33, 35, 37,
+    29, 29, 29, 29, 32, 34, 36, 38, 29, 29, 29, 29, 32, 34, 36, 38,
+    30, 30, 30, 30, 33, 35, 37, 39, 30, 30, 30, 30, 33, 35, 37, 39,
+    31, 31, 31, 31, 34, 36, 38, 40, 31, 31, 31, 31, 34, 36, 38, 40,
+    32, 32, 32, 32, 35, 37, 39, 41, 32, 32, 32, 32, 35, 37, 39, 41,
+    33, 33, 33, 33, 36, 38, 40, 42, 33, 33, 33, 33, 36, 38, 40, 42,
+    34, 34, 34, 34, 37, 39, 41, 43, 34, 34, 34, 34, 37, 39, 41, 43,
+    35, 35, 35, 35, 38, 40, 42, 44, 35, 35, 35, 35, 38, 40, 42, 44,
+    36, 36, 36, 36, 39, 41, 43, 45, 36, 36, 36, 36, 39, 41, 43, 45,
+    37, 37, 37, 37, 40, 42, 44, 46, 37, 37, 37, 37, 40, 42, 44, 46,
+    38, 38, 38, 38, 41, 43, 45, 47, 38, 38, 38, 38, 41, 43, 45, 47,
+    39, 39, 39, 39, 42, 44, 46, 48, 39, 39, 39, 39, 42, 44, 46, 48,
+    40, 40, 40, 40, 43, 45, 47, 49, 40, 40, 40, 40, 43, 45, 47, 49,
+    41, 41, 41, 41, 44, 46, 48, 50, 41, 41, 41, 41, 44, 46, 48, 50,
+    42, 42, 42, 42, 45, 47, 49, 51, 42, 42, 42, 42, 45, 47, 49, 51,
+    43, 43, 43, 43, 46, 48, 50, 52, 43, 43, 43, 43, 46, 48, 50, 52,
+    44, 44, 44, 44, 47, 49, 51, 53, 44, 44, 44, 44, 47, 49, 51, 53,
+    45, 45, 45, 45, 48, 50, 52, 54, 45, 45, 45, 45, 48, 50, 52, 54,
+    46, 46, 46, 46, 49, 51, 53, 55, 46, 46, 46, 46, 49, 51, 53, 55,
+    47, 47, 47, 47, 50, 52, 54, 56, 47, 47, 47, 47, 50, 52, 54, 56,
+    48, 48, 48, 48, 51, 53, 55, 57, 48, 48, 48, 48, 51, 53, 55, 57,
+    49, 49, 49, 49, 52, 54, 56, 58, 49, 49, 49, 49, 52, 54, 56, 58,
+    50, 50, 50, 50, 53, 55, 57, 59, 50, 50, 50, 50, 53, 55, 57, 59,
+    51, 51, 51, 51, 54, 56, 58, 60, 51, 51, 51, 51, 54, 56, 58, 60,
+    52, 52, 52, 52, 55, 57, 59, 61, 52, 52, 52, 52, 55, 57, 59, 61,
+    53, 53, 53, 53, 56, 58, 60, 62, 53, 53, 53, 53, 56, 58, 60, 62,
+    54, 54, 54, 54, 57, 59, 61, 63, 54, 54, 54, 54, 57, 59, 61, 63,
+    55, 55, 55, 55, 58, 60, 62, 64, 55, 55, 55, 55, 58, 60, 62, 64,
+    56, 56, 56, 56, 59, 61, 63, 65, 56, 56, 56, 56, 59, 61, 63, 65,
+    57, 57, 57, 57, 60, 62, 64, 66, 57, 57, 57, 57, 60, 62, 64, 66,
+    58, 58, 58, 58, 61, 63, 65, 67, 58, 58, 58, 58, 61, 63, 65, 67,
+    59, 59, 59, 59, 62, 64, 66, 68, 59, 59, 59, 59, 62, 64, 66, 68,
+    60, 60, 60, 60, 63, 65, 67, 69, 60, 60, 60, 60, 63, 65, 67, 69,
+    61, 61, 61, 61, 64, 66, 68, 70, 61, 61, 61, 61, 64, 66, 68, 70,
+    62, 62, 62, 62, 65, 67, 69, 71, 62, 62, 62, 62, 65, 67, 69, 71,
+    63, 63, 63, 63, 66, 68, 70, 72, 63, 63, 63, 63, 66, 68, 70, 72,
+    64, 64, 64, 64, 67, 69, 71, 73, 64, 64, 64, 64, 67, 69, 71, 73,
+    65, 65, 65, 65, 68, 70, 72, 74, 65, 65, 65, 65, 68, 70, 72, 74,
+    66, 66, 66, 66, 69, 71, 73, 75, 66, 66, 66, 66, 69, 71, 73, 75,
+    67, 67, 67, 67, 70, 72, 74, 76, 67, 67, 67, 67, 70, 72, 74, 76,
+    68, 68, 68, 68, 71, 73, 75, 77, 68, 68, 68, 68, 71, 73, 75, 77,
+    69, 69, 69, 69, 72, 74, 76, 78, 69, 69, 69, 69, 72, 74, 76, 78,
+    70, 70, 70, 70, 73, 75, 77, 79, 70, 70, 70, 70, 73, 75, 77, 79,
+    71, 71, 71, 71, 74, 76, 78, 80, 71, 71, 71, 71, 74, 76, 78, 80,
+    72, 72, 72, 72, 75, 77, 79, 81, 72, 72, 72, 72, 75, 77, 79, 81,
+    73, 73, 73, 73, 76, 78, 80, 82, 73, 73, 73, 73, 76, 78, 80, 82,
+    74, 74, 74, 74, 77, 79, 81, 83, 74, 74, 74, 74, 77, 79, 81, 83,
+    75, 75, 75, 75, 78, 80, 82, 84, 75, 75, 75, 75, 78, 80, 82, 84,
+    76, 76, 76, 76, 79, 81, 83, 85, 76, 76, 76, 76, 79, 81, 83, 85,
+    77, 77, 77, 77, 80, 82, 84, 86, 77, 77, 77, 77, 80, 82, 84, 86,
+    78, 78, 78, 78, 81, 83, 85, 87, 78, 78, 78, 78, 81, 83, 85, 87,
+    79, 79, 79, 79, 82, 84, 86, 88, 79, 79, 79, 79, 82, 84, 86, 88,
+    80, 80, 80, 80, 83, 85, 87, 88, 80, 80, 80, 80, 83, 85, 87, 88,
+    81, 81, 81, 81, 84, 86, 88, 88, 81, 81, 81, 81, 84, 86, 88, 88,
+    82, 82, 82, 82, 85, 87, 88, 88, 82, 82, 82, 82, 85, 87, 88, 88,
+    83, 83, 83, 83, 86, 88, 88, 88, 83, 83, 83, 83, 86, 88, 88, 88,
+    84, 84, 84, 84, 87, 88, 88, 88, 84, 84, 84, 84, 87, 88, 88, 88,
+    85, 85, 85, 85, 88, 88, 88, 88, 85, 85, 85, 85, 88, 88, 88, 88,
+    86, 86, 86, 86, 88, 88, 88, 88, 86, 86, 86, 86, 88, 88, 88, 88,
+    87, 87, 87, 87, 88, 88, 88, 88, 87, 87, 87, 87, 88, 88, 88, 88
+};
+
+static DRWAV_INLINE drwav_int16 drwav__msadpcm_decode_nibble(drwav_uint8 nibble, drwav_int32 coeff1, drwav_int32 coeff2, drwav_int32* pDelta, drwav_int32* pPrevSamples)
+{
+    drwav_int32 newSample;
+    newSample  = ((pPrevSamples[1] * coeff1) + (pPrevSamples[0] * coeff2)) >> 8;
+    newSample += ((drwav_int32)(nibble ^ 0x08) - 0x08) * (*pDelta);    // <-- Sign extends the nibble.
+    newSample  = drwav_clamp(newSample, -32768, 32767);
+
+    *pDelta = (g_drwavMSADPCMAdaptationTable[nibble] * (*pDelta)) >> 8;
+    if (*pDelta < 16) {
+        *pDelta = 16;
+    }
+
+    pPrevSamples[0] = pPrevSamples[1];
+    pPrevSamples[1] = newSample;
+
+    return (drwav_int16)newSample;
+}
+
+// Decodes an entire MS-ADPCM block straight into the output buffer, which must have room for a whole block's worth of samples. If the
+// block is cut short by the end of the stream only what's available is decoded. Returns the number of samples written.
+static drwav_uint64 drwav__decode_msadpcm_block(drwav* pWav, const drwav_uint8* pBlock, size_t blockSize, drwav_int16* pBufferOut)
+{
+    drwav_uint32 channels = pWav->channels;
+    drwav_assert(channels == 1 || channels == 2);
+
+    if (blockSize < 7*channels) {
+        return 0;
+    }
+
+    // The header stores the predictors, then the deltas, then the second sample of each channel, then the first.
+    drwav_int32 coeff1[2];
+    drwav_int32 coeff2[2];
+    drwav_int32 delta[2];
+    drwav_int32 prevSamples[2][2];
+    for (drwav_uint32 iChannel = 0; iChannel < channels; ++iChannel) {
+        drwav_uint8 predictor = pBlock[iChannel];
+        if (predictor >= drwav_countof(g_drwavMSADPCMCoeff1Table)) {
+            return 0;   // Corrupt block.
+        }
+
+        coeff1[iChannel]         = g_drwavMSADPCMCoeff1Table[predictor];
+        coeff2[iChannel]         = g_drwavMSADPCMCoeff2Table[predictor];
+        delta[iChannel]          = drwav__bytes_to_s16(pBlock + 1*channels + iChannel*2);
+        prevSamples[iChannel][1] = drwav__bytes_to_s16(pBlock + 3*channels + iChannel*2);
+        prevSamples[iChannel][0] = drwav__bytes_to_s16(pBlock + 5*channels + iChannel*2);
+
+        pBufferOut[iChannel]            = (drwav_int16)prevSamples[iChannel][0];
+        pBufferOut[iChannel + channels] = (drwav_int16)prevSamples[iChannel][1];
+    }
+
+    const drwav_uint8* pNibbles = pBlock + 7*channels;
+    size_t nibbleByteCount = blockSize - 7*channels;
+    drwav_int16* pOut = pBufferOut + 2*channels;
+
+    // Each byte holds two samples, high nibble first. For stereo streams the high nibble is the left channel.
+    if (channels == 1) {
+        for (size_t iByte = 0; iByte < nibbleByteCount; ++iByte) {
+            pOut[0] = drwav__msadpcm_decode_nibble((pNibbles[iByte] & 0xF0) >> 4, coeff1[0], coeff2[0], &delta[0], prevSamples[0]);
+            pOut[1] = drwav__msadpcm_decode_nibble((pNibbles[iByte] & 0x0F) >> 0, coeff1[0], coeff2[0], &delta[0], prevSamples[0]);
+            pOut += 2;
+        }
+    } else {
+        for (size_t iByte = 0; iByte < nibbleByteCount; ++iByte) {
+            pOut[0] = drwav__msadpcm_decode_nibble((pNibbles[iByte] & 0xF0) >> 4, coeff1[0], coeff2[0], &delta[0], prevSamples[0]);
+            pOut[1] = drwav__msadpcm_decode_nibble((pNibbles[iByte] & 0x0F) >> 0, coeff1[1], coeff2[1], &delta[1], prevSamples[1]);
+            pOut += 2;
+        }
+    }
+
+    return (drwav_uint64)(pOut - pBufferOut);
+}
+
+static DRWAV_INLINE drwav_int16 drwav__ima_decode_nibble(drwav_uint8 nibble, drwav_int32* pPredictor, drwav_int32* pStepIndex)
+{
+    drwav_uint32 index = ((drwav_uint32)*pStepIndex << 4) | nibble;
+    *pPredictor = drwav_clamp(*pPredictor + g_drwavIMADiffTable[index], -32768, 32767);
+    *pStepIndex = g_drwavIMANextStepIndexTable[index];
+
+    return (drwav_int16)*pPredictor;
+}
+
+// Decodes an entire IMA ADPCM block straight into the output buffer, which must have room for a whole block's worth of samples. If the
+// block is cut short by the end of the stream only what's available is decoded. Returns the number of samples written.
+static drwav_uint64 drwav__decode_ima_block(drwav* pWav, const drwav_uint8* pBlock, size_t blockSize, drwav_int16* pBufferOut)
+{
+    drwav_uint32 channels = pWav->channels;
+    drwav_assert(channels == 1 || channels == 2);
+
+    if (blockSize < 4*channels) {
+        return 0;
+    }
+
+    drwav_int32 predictor[2];
+    drwav_int32 stepIndex[2];
+    for (drwav_uint32 iChannel = 0; iChannel < channels; ++iChannel) {
+        predictor[iChannel] = drwav__bytes_to_s16(pBlock + iChannel*4 + 0);
+        stepIndex[iChannel] = drwav_min(pBlock[iChannel*4 + 2], (drwav_int32)drwav_countof(g_drwavIMAStepTable)-1);
+        pBufferOut[iChannel] = (drwav_int16)predictor[iChannel];
+    }
+
+    // The data is laid out in groups of 4 bytes (8 samples) per channel, low nibble first. Each channel is a serial dependency chain through
+    // the step table, so for stereo streams both channels are decoded in lockstep which lets the CPU overlap the two chains.
+    size_t groupSize  = 4*channels;
+    size_t groupCount = (blockSize - 4*channels) / groupSize;
+    const drwav_uint8* pGroup = pBlock + 4*channels;
+    drwav_int16* pOut = pBufferOut + channels;
+
+    if (channels == 1) {
+        for (size_t iGroup = 0; iGroup < groupCount; ++iGroup) {
+            for (drwav_uint32 iByte = 0; iByte < 4; ++iByte) {
+                pOut[iByte*2 + 0] = drwav__ima_decode_nibble((pGroup[iByte] & 0x0F) >> 0, &predictor[0], &stepIndex[0]);
+                pOut[iByte*2 + 1] = drwav__ima_decode_nibble((pGroup[iByte] & 0xF0) >> 4, &predictor[0], &stepIndex[0]);
+            }
+
+            pGroup += 4;
+            pOut   += 8;
+        }
+    } else {
+        for (size_t iGroup = 0; iGroup < groupCount; ++iGroup) {
+            for (drwav_uint32 iByte = 0; iByte < 4; ++iByte) {
+                pOut[iByte*4 + 0] = drwav__ima_decode_nibble((pGroup[iByte + 0] & 0x0F) >> 0, &predictor[0], &stepIndex[0]);
+                pOut[iByte*4 + 1] = drwav__ima_decode_nibble((pGroup[iByte + 4] & 0x0F) >> 0, &predictor[1], &stepIndex[1]);
+                pOut[iByte*4 + 2] = drwav__ima_decode_nibble((pGroup[iByte + 0] & 0xF0) >> 4, &predictor[0], &stepIndex[0]);
+                pOut[iByte*4 + 3] = drwav__ima_decode_nibble((pGroup[iByte + 4] & 0xF0) >> 4, &predictor[1], &stepIndex[1]);
+            }
+
+            pGroup += 8;
+            pOut   += 16;
+        }
+    }
+
+    return channels + (groupCount * 8 * channels);
+}
+
+drwav_uint64 drwav_read_s16__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+{
+    drwav_assert(pWav != NULL);
+    drwav_assert(samplesToRead > 0);
+    drwav_assert(pBufferOut != NULL);
+
+    drwav_uint64 totalSamplesRead = 0;
+    drwav_uint64 samplesPerBlock = drwav__get_compressed_samples_per_block(pWav);
+    drwav_uint8 blockData[4096];
+
+    while (samplesToRead > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
+        // Fast path. When we're sitting on a block boundary and the output buffer can take the whole block we can read the block in one go
+        // and decode it directly into the output buffer.
+        if (pWav->msadpcm.cachedSampleCount == 0 && pWav->msadpcm.bytesRemainingInBlock == 0 && samplesPerBlock > 0 && pWav->fmt.blockAlign <= sizeof(blockData) &&
+            samplesToRead >= samplesPerBlock && (pWav->totalSampleCount - pWav->compressed.iCurrentSample) >= samplesPerBlock) {
+            size_t bytesRead = pWav->onRead(pWav->pUserData, blockData, pWav->fmt.blockAlign);
+            drwav_uint64 samplesDecoded = drwav__decode_msadpcm_block(pWav, blockData, bytesRead, pBufferOut);
+
+            pBufferOut       += samplesDecoded;
+            samplesToRead    -= samplesDecoded;
+            totalSamplesRead += samplesDecoded;
+            pWav->compressed.iCurrentSample += samplesDecoded;
+
+            if (bytesRead != pWav->fmt.blockAlign || samplesDecoded == 0) {
+                return totalSamplesRead;
+            }
+
+            continue;
+        }
+
+        // If there are no cached samples we need to load a new block.
+        if (pWav->msadpcm.cachedSampleCount == 0 && pWav->msadpcm.bytesRemainingInBlock == 0) {
+            if (pWav->channels == 1) {
+                // Mono.
+                drwav_uint8 header[7];
+                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
+                    return totalSamplesRead;
+                }
+                pWav->msadpcm.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+
+                if (header[0] >= drwav_countof(g_drwavMSADPCMCoeff1Table)) {
+                    return totalSamplesRead;    // Corrupt block.
+                }
+
+                pWav->msadpcm.predictor[0] = header[0];
+                pWav->msadpcm.delta[0] = drwav__bytes_to_s16(header + 1);
+                pWav->msadpcm.prevSamples[0][1] = (drwav_int32)drwav__bytes_to_s16(header + 3);
+                pWav->msadpcm.prevSamples[0][0] = (drwav_int32)drwav__bytes_to_s16(header + 5);
+                pWav->msadpcm.cachedSamples[2] = pWav->msadpcm.prevSamples[0][0];
+                pWav->msadpcm.cachedSamples[3] = pWav->msadpcm.prevSamples[0][1];
+                pWav->msadpcm.cachedSampleCount = 2;
+            } else {
+                // Stereo.
+                drwav_uint8 header[14];
+                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
+                    return totalSamplesRead;
+                }
+                pWav->msadpcm.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+
+                if (header[0] >= drwav_countof(g_drwavMSADPCMCoeff1Table) || header[1] >= drwav_countof(g_drwavMSADPCMCoeff1Table)) {
+                    return totalSamplesRead;    // Corrupt block.
+                }
+
+                pWav->msadpcm.predictor[0] = header[0];
+                pWav->msadpcm.predictor[1] = header[1];
+                pWav->msadpcm.delta[0] = drwav__bytes_to_s16(header + 2);
+                pWav->msadpcm.delta[1] = drwav__bytes_to_s16(header + 4);
+                pWav->msadpcm.prevSamples[0][1] = (drwav_int32)drwav__bytes_to_s16(header + 6);
+                pWav->msadpcm.prevSamples[1][1] = (drwav_int32)drwav__bytes_to_s16(header + 8);
+                pWav->msadpcm.prevSamples[0][0] = (drwav_int32)drwav__bytes_to_s16(header + 10);
+                pWav->msadpcm.prevSamples[1][0] = (drwav_int32)drwav__bytes_to_s16(header + 12);
+
+                pWav->msadpcm.cachedSamples[0] = pWav->msadpcm.prevSamples[0][0];
+                pWav->msadpcm.cachedSamples[1] = pWav->msadpcm.prevSamples[1][0];
+                pWav->msadpcm.cachedSamples[2] = pWav->msadpcm.prevSamples[0][1];
+                pWav->msadpcm.cachedSamples[3] = pWav->msadpcm.prevSamples[1][1];
+                pWav->msadpcm.cachedSampleCount = 4;
+            }
+        }
+
+        // Output anything that's cached.
+        while (samplesToRead > 0 && pWav->msadpcm.cachedSampleCount > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
+            pBufferOut[0] = (drwav_int16)pWav->msadpcm.cachedSamples[drwav_countof(pWav->msadpcm.cachedSamples) - pWav->msadpcm.cachedSampleCount];
+            pWav->msadpcm.cachedSampleCount -= 1;
+
+            pBufferOut += 1;
+            samplesToRead -= 1;
+            totalSamplesRead += 1;
+            pWav->compressed.iCurrentSample += 1;
+        }
+
+        if (samplesToRead == 0) {
+            return totalSamplesRead;
+        }
+
+
+        // If there's nothing left in the cache, just go ahead and load more. If there's nothing left to load in the current block we just continue to the next
+        // loop iteration which will trigger the loading of a new block.
+        if (pWav->msadpcm.cachedSampleCount == 0) {
+            if (pWav->msadpcm.bytesRemainingInBlock == 0) {
+                continue;
+            } else {
+                drwav_uint8 nibbles;
+                if (pWav->onRead(pWav->pUserData, &nibbles, 1) != 1) {
+                    return totalSamplesRead;
+                }
+                pWav->msadpcm.bytesRemainingInBlock -= 1;
+
+                // For stereo streams the high nibble is the left channel and the low nibble is the right channel.
+                drwav_uint32 iChannel0 = 0;
+                drwav_uint32 iChannel1 = (pWav->channels == 1) ? 0 : 1;
+
+                pWav->msadpcm.cachedSamples[2] = drwav__msadpcm_decode_nibble((nibbles & 0xF0) >> 4,
+                    g_drwavMSADPCMCoeff1Table[pWav->msadpcm.predictor[iChannel0]], g_drwavMSADPCMCoeff2Table[pWav->msadpcm.predictor[iChannel0]], &pWav->msadpcm.delta[iChannel0], pWav->msadpcm.prevSamples[iChannel0]);
+                pWav->msadpcm.cachedSamples[3] = drwav__msadpcm_decode_nibble((nibbles & 0x0F) >> 0,
+                    g_drwavMSADPCMCoeff1Table[pWav->msadpcm.predictor[iChannel1]], g_drwavMSADPCMCoeff2Table[pWav->msadpcm.predictor[iChannel1]], &pWav->msadpcm.delta[iChannel1], pWav->msadpcm.prevSamples[iChannel1]);
+                pWav->msadpcm.cachedSampleCount = 2;
+            }
+        }
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s16__ima(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+{
+    drwav_assert(pWav != NULL);
+    drwav_assert(samplesToRead > 0);
+    drwav_assert(pBufferOut != NULL);
+
+    drwav_uint64 totalSamplesRead = 0;
+    drwav_uint64 samplesPerBlock = drwav__get_compressed_samples_per_block(pWav);
+    drwav_uint8 blockData[4096];
+
+    while (samplesToRead > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
+        // Fast path. When we're sitting on a block boundary and the output buffer can take the whole block we can read the block in one go
+        // and decode it directly into the output buffer.
+        if (pWav->ima.cachedSampleCount == 0 && pWav->ima.bytesRemainingInBlock == 0 && samplesPerBlock > 0 && pWav->fmt.blockAlign <= sizeof(blockData) &&
+            samplesToRead >= samplesPerBlock && (pWav->totalSampleCount - pWav->compressed.iCurrentSample) >= samplesPerBlock) {
+            size_t bytesRead = pWav->onRead(pWav->pUserData, blockData, pWav->fmt.blockAlign);
+            drwav_uint64 samplesDecoded = drwav__decode_ima_block(pWav, blockData, bytesRead, pBufferOut);
+
+            pBufferOut       += samplesDecoded;
+            samplesToRead    -= samplesDecoded;
+            totalSamplesRead += samplesDecoded;
+            pWav->compressed.iCurrentSample += samplesDecoded;
+
+            if (bytesRead != pWav->fmt.blockAlign || samplesDecoded == 0) {
+                return totalSamplesRead;
+            }
+
+            continue;
+        }
+
+        // If there are no cached samples we need to load a new block.
+        if (pWav->ima.cachedSampleCount == 0 && pWav->ima.bytesRemainingInBlock == 0) {
+            if (pWav->channels == 1) {
+                // Mono.
+                drwav_uint8 header[4];
+                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
+                    return totalSamplesRead;
+                }
+                pWav->ima.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+
+                pWav->ima.predictor[0] = drwav__bytes_to_s16(header + 0);
+                pWav->ima.stepIndex[0] = drwav_min(header[2], (drwav_int32)drwav_countof(g_drwavIMAStepTable)-1);
+                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 1] = pWav->ima.predictor[0];
+                pWav->ima.cachedSampleCount = 1;
+            } else {
+                // Stereo.
+                drwav_uint8 header[8];
+                if (pWav->onRead(pWav->pUserData, header, sizeof(header)) != sizeof(header)) {
+                    return totalSamplesRead;
+                }
+                pWav->ima.bytesRemainingInBlock = pWav->fmt.blockAlign - sizeof(header);
+
+                pWav->ima.predictor[0] = drwav__bytes_to_s16(header + 0);
+                pWav->ima.stepIndex[0] = drwav_min(header[2], (drwav_int32)drwav_countof(g_drwavIMAStepTable)-1);
+                pWav->ima.predictor[1] = drwav__bytes_to_s16(header + 4);
+                pWav->ima.stepIndex[1] = drwav_min(header[6], (drwav_int32)drwav_countof(g_drwavIMAStepTable)-1);
+
+                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 2] = pWav->ima.predictor[0];
+                pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - 1] = pWav->ima.predictor[1];
+                pWav->ima.cachedSampleCount = 2;
+            }
+        }
+
+        // Output anything that's cached.
+        while (samplesToRead > 0 && pWav->ima.cachedSampleCount > 0 && pWav->compressed.iCurrentSample < pWav->totalSampleCount) {
+            pBufferOut[0] = (drwav_int16)pWav->ima.cachedSamples[drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount];
+            pWav->ima.cachedSampleCount -= 1;
 
             pBufferOut += 1;
             samplesToRead -= 1;
@@ -1753,1092 +5037,4157 @@ drwav_uint64 drwav_read_s16__ima(drwav* pWav, drwav_uint64 samplesToRead, drwav_
             pWav->compressed.iCurrentSample += 1;
         }
 
-        if (samplesToRead == 0) {
-            return totalSamplesRead;
+        if (samplesToRead == 0) {
+            return totalSamplesRead;
+        }
+
+        // If there's nothing left in the cache, just go ahead and load more. If there's nothing left to load in the current block we just continue to the next
+        // loop iteration which will trigger the loading of a new block.
+        if (pWav->ima.cachedSampleCount == 0) {
+            if (pWav->ima.bytesRemainingInBlock == 0) {
+                continue;
+            } else {
+                // From what I can tell with stereo streams, it looks like every 4 bytes (8 samples) is for one channel. So it goes 4 bytes for the
+                // left channel, 4 bytes for the right channel.
+                pWav->ima.cachedSampleCount = 8 * pWav->channels;
+                for (drwav_uint32 iChannel = 0; iChannel < pWav->channels; ++iChannel) {
+                    drwav_uint8 nibbles[4];
+                    if (pWav->onRead(pWav->pUserData, &nibbles, 4) != 4) {
+                        return totalSamplesRead;
+                    }
+                    pWav->ima.bytesRemainingInBlock -= 4;
+
+                    for (drwav_uint32 iByte = 0; iByte < 4; ++iByte) {
+                        drwav_uint8 nibble0 = ((nibbles[iByte] & 0x0F) >> 0);
+                        drwav_uint8 nibble1 = ((nibbles[iByte] & 0xF0) >> 4);
+
+                        pWav->ima.cachedSamples[(drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount) + (iByte*2+0)*pWav->channels + iChannel] = drwav__ima_decode_nibble(nibble0, &pWav->ima.predictor[iChannel], &pWav->ima.stepIndex[iChannel]);
+                        pWav->ima.cachedSamples[(drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount) + (iByte*2+1)*pWav->channels + iChannel] = drwav__ima_decode_nibble(nibble1, &pWav->ima.predictor[iChannel], &pWav->ima.stepIndex[iChannel]);
+                    }
+                }
+            }
+        }
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s16__ieee(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut, drwav_dither* pDither)
+{
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_s16(pWav, pBufferOut, sampleData, (size_t)samplesRead, pDither);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s16__alaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(drwav_int16)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int16), &pRawData);
+        drwav_alaw_to_s16(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_alaw_to_s16(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s16__mulaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(drwav_int16)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int16), &pRawData);
+        drwav_mulaw_to_s16(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_mulaw_to_s16(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s16(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+{
+    if (pWav == NULL) {
+        return 0;
+    }
+
+    return drwav_read_s16_dithered(pWav, samplesToRead, pBufferOut, &pWav->dither);
+}
+
+drwav_uint64 drwav_read_s16_dithered(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut, drwav_dither* pDither)
+{
+    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
+        return 0;
+    }
+
+    // Don't try to read more samples than can potentially fit in the output buffer.
+    if (samplesToRead * sizeof(drwav_int16) > SIZE_MAX) {
+        samplesToRead = SIZE_MAX / sizeof(drwav_int16);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
+        return drwav_read_s16__pcm(pWav, samplesToRead, pBufferOut, pDither);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        return drwav_read_s16__msadpcm(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        return drwav_read_s16__ieee(pWav, samplesToRead, pBufferOut, pDither);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
+        return drwav_read_s16__alaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
+        return drwav_read_s16__mulaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        return drwav_read_s16__ima(pWav, samplesToRead, pBufferOut);
+    }
+
+    return 0;
+}
+
+// The SIMD converters below produce exactly the same output as the reference implementations, which are also used for
+// any samples left over at the end of the SIMD loops.
+#ifdef DRWAV_SUPPORT_SSE2
+// Unpacks four 24-bit samples into the upper 24 bits of each 32-bit lane. This loads 16 bytes, 4 more than the samples
+// occupy, so the caller must make sure those are readable.
+static DRWAV_INLINE __m128i drwav__unpack_s24x4__sse2(const drwav_uint8* pIn, drwav_bool32 useSSSE3)
+{
+    __m128i x = _mm_loadu_si128((const __m128i*)pIn);
+#ifdef DRWAV_SUPPORT_SSSE3
+    if (useSSSE3) {
+        return _mm_shuffle_epi8(x, _mm_set_epi8(11, 10, 9, -128, 8, 7, 6, -128, 5, 4, 3, -128, 2, 1, 0, -128));
+    }
+#else
+    (void)useSSSE3;
+#endif
+
+    __m128i a = _mm_unpacklo_epi32(x, _mm_srli_si128(x, 3));
+    __m128i b = _mm_unpacklo_epi32(_mm_srli_si128(x, 6), _mm_srli_si128(x, 9));
+    return _mm_slli_epi32(_mm_unpacklo_epi64(a, b), 8);
+}
+#endif
+
+static void drwav__u8_to_s16__reference(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    int r;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        int x = pIn[i];
+        r = x - 128;
+        r = r << 8;
+        pOut[i] = (short)r;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__u8_to_s16__sse2(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pIn + i)), bias);  // <-- Same as subtracting 128.
+        _mm_storeu_si128((__m128i*)(pOut + i + 0), _mm_unpacklo_epi8(zero, x));
+        _mm_storeu_si128((__m128i*)(pOut + i + 8), _mm_unpackhi_epi8(zero, x));
+    }
+
+    drwav__u8_to_s16__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_u8_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__u8_to_s16__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__u8_to_s16__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s24_to_s16__reference(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    int r;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        int x = ((int)(((unsigned int)(((unsigned char*)pIn)[i*3+0]) << 8) | ((unsigned int)(((unsigned char*)pIn)[i*3+1]) << 16) | ((unsigned int)(((unsigned char*)pIn)[i*3+2])) << 24)) >> 8;
+        r = x >> 8;
+        pOut[i] = (short)r;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s24_to_s16__sse2(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    drwav_bool32 useSSSE3 = drwav__has_ssse3();
+
+    // The +2 keeps the 16 byte loads of the last group inside the input buffer.
+    size_t i = 0;
+    for (; i + 8 + 2 <= sampleCount; i += 8) {
+        __m128i a = _mm_srai_epi32(drwav__unpack_s24x4__sse2(pIn + (i+0)*3, useSSSE3), 16);
+        __m128i b = _mm_srai_epi32(drwav__unpack_s24x4__sse2(pIn + (i+4)*3, useSSSE3), 16);
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    drwav__s24_to_s16__reference(pOut + i, pIn + i*3, sampleCount - i);
+}
+#endif
+
+void drwav_s24_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s24_to_s16__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s24_to_s16__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s32_to_s16__reference(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+    int r;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        int x = pIn[i];
+        r = x >> 16;
+        pOut[i] = (short)r;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s32_to_s16__sse2(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i a = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(pIn + i + 0)), 16);
+        __m128i b = _mm_srai_epi32(_mm_loadu_si128((const __m128i*)(pIn + i + 4)), 16);
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    drwav__s32_to_s16__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_s32_to_s16(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s32_to_s16__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s32_to_s16__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__f32_to_s16__reference(drwav_int16* pOut, const float* pIn, size_t sampleCount)
+{
+    int r;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        float x = pIn[i];
+        float c;
+        int s;
+        c = ((x < -1) ? -1 : ((x > 1) ? 1 : x));
+        s = ((*((int*)&x)) & 0x80000000) >> 31;
+        s = s + 32767;
+        r = (int)(c * s);
+        pOut[i] = (short)r;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static DRWAV_INLINE __m128i drwav__f32_to_s32x4_for_s16__sse2(__m128 x)
+{
+    // Negative samples are scaled by 32768 and positive ones by 32767, as in the reference implementation. NaN is
+    // mapped to 0, which is what the reference implementation produces on this architecture.
+    __m128 c = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(1)), _mm_set1_ps(-1));
+    c = _mm_and_ps(c, _mm_cmpord_ps(x, x));
+
+    __m128i sign  = _mm_srli_epi32(_mm_castps_si128(x), 31);
+    __m128  scale = _mm_cvtepi32_ps(_mm_add_epi32(sign, _mm_set1_epi32(32767)));
+
+    return _mm_cvttps_epi32(_mm_mul_ps(c, scale));
+}
+
+static void drwav__f32_to_s16__sse2(drwav_int16* pOut, const float* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i a = drwav__f32_to_s32x4_for_s16__sse2(_mm_loadu_ps(pIn + i + 0));
+        __m128i b = drwav__f32_to_s32x4_for_s16__sse2(_mm_loadu_ps(pIn + i + 4));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    drwav__f32_to_s16__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_f32_to_s16(drwav_int16* pOut, const float* pIn, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__f32_to_s16__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__f32_to_s16__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__f64_to_s16__reference(drwav_int16* pOut, const double* pIn, size_t sampleCount)
+{
+    int r;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        double x = pIn[i];
+        double c;
+        int s;
+        c = ((x < -1) ? -1 : ((x > 1) ? 1 : x));
+        s = (int)(((*((drwav_uint64*)&x)) & (drwav_uint64)0x8000000000000000) >> 63);
+        s = s + 32767;
+        r = (int)(c * s);
+        pOut[i] = (short)r;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static DRWAV_INLINE __m128i drwav__f64_to_s32x2_for_s16__sse2(__m128d x)
+{
+    __m128d c = _mm_max_pd(_mm_min_pd(x, _mm_set1_pd(1)), _mm_set1_pd(-1));
+    c = _mm_and_pd(c, _mm_cmpord_pd(x, x));
+
+    // The sign bits end up in the upper 32 bits of each 64-bit lane. Shuffle them down to the low two 32-bit lanes.
+    __m128i sign  = _mm_shuffle_epi32(_mm_srli_epi32(_mm_castpd_si128(x), 31), _MM_SHUFFLE(3, 1, 3, 1));
+    __m128d scale = _mm_cvtepi32_pd(_mm_add_epi32(sign, _mm_set1_epi32(32767)));
+
+    return _mm_cvttpd_epi32(_mm_mul_pd(c, scale));
+}
+
+static void drwav__f64_to_s16__sse2(drwav_int16* pOut, const double* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i a = _mm_unpacklo_epi64(drwav__f64_to_s32x2_for_s16__sse2(_mm_loadu_pd(pIn + i + 0)), drwav__f64_to_s32x2_for_s16__sse2(_mm_loadu_pd(pIn + i + 2)));
+        __m128i b = _mm_unpacklo_epi64(drwav__f64_to_s32x2_for_s16__sse2(_mm_loadu_pd(pIn + i + 4)), drwav__f64_to_s32x2_for_s16__sse2(_mm_loadu_pd(pIn + i + 6)));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    drwav__f64_to_s16__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_f64_to_s16(drwav_int16* pOut, const double* pIn, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__f64_to_s16__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__f64_to_s16__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+// Dithering.
+//
+// Samples are first converted to doubles in units of the output's least significant bit, a small chunk at a time so they stay in
+// cache, and are then dithered and rounded straight into the output buffer. A float doesn't have enough precision for 32-bit
+// samples. The random numbers come from four xorshift
+// generators that are stepped together by the SIMD path and one at a time by the reference path, so both give the same output.
+
+static DRWAV_INLINE drwav_uint32 drwav__dither_next_random(drwav_dither* pDither)
+{
+    drwav_uint32 x = pDither->lanes[pDither->iLane];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pDither->lanes[pDither->iLane] = x;
+    pDither->iLane = (pDither->iLane + 1) & 3;
+    return x;
+}
+
+// The two halves of each random number are added together for triangular noise between -1 and 1.
+static DRWAV_INLINE float drwav__dither_random_to_triangle(drwav_uint32 x)
+{
+    return (float)((drwav_int32)(x & 0xFFFF) + (drwav_int32)(x >> 16) - 65535) * (1.0f / 65536);
+}
+
+static void drwav__dither_noise__reference(drwav_dither* pDither, float* pNoise, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        pNoise[i] = drwav__dither_random_to_triangle(drwav__dither_next_random(pDither));
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__dither_noise__sse2(drwav_dither* pDither, float* pNoise, size_t sampleCount)
+{
+    // The SIMD path can only be used when the next sample belongs to the first lane.
+    size_t i = 0;
+    for (; i < sampleCount && pDither->iLane != 0; ++i) {
+        pNoise[i] = drwav__dither_random_to_triangle(drwav__dither_next_random(pDither));
+    }
+
+    __m128i x = _mm_loadu_si128((const __m128i*)pDither->lanes);
+    for (; i + 4 <= sampleCount; i += 4) {
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+
+        __m128i sum = _mm_add_epi32(_mm_and_si128(x, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(x, 16));
+        _mm_storeu_ps(pNoise + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(sum, _mm_set1_epi32(65535))), _mm_set1_ps(1.0f / 65536)));
+    }
+    _mm_storeu_si128((__m128i*)pDither->lanes, x);
+
+    drwav__dither_noise__reference(pDither, pNoise + i, sampleCount - i);
+}
+#endif
+
+static void drwav__dither_noise(drwav_dither* pDither, float* pNoise, size_t sampleCount)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__dither_noise__sse2(pDither, pNoise, sampleCount);
+#else
+    drwav__dither_noise__reference(pDither, pNoise, sampleCount);
+#endif
+}
+
+// Rounds <x> + <noise> to the nearest 16-bit sample. The offset makes the value positive so truncation is the same as rounding
+// down, which is also what the SIMD path does. This is done with doubles because a float doesn't have enough precision for the
+// sum, and rounding it would bias the output.
+static DRWAV_INLINE drwav_int16 drwav__dither_round(double x, float noise)
+{
+    double r = (double)x + (double)noise + 32768.5;
+    r = ((r < 0) ? 0 : ((r > 65535) ? 65535 : r));
+    return (drwav_int16)((drwav_int32)r - 32768);
+}
+
+static void drwav__dither_triangle__reference(drwav_int16* pOut, const double* pIn, const float* pNoise, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        pOut[i] = drwav__dither_round(pIn[i], pNoise[i]);
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static DRWAV_INLINE __m128i drwav__dither_round_x2__sse2(__m128d x, __m128d noise)
+{
+    __m128d r = _mm_add_pd(_mm_add_pd(x, noise), _mm_set1_pd(32768.5));
+    r = _mm_min_pd(_mm_max_pd(r, _mm_setzero_pd()), _mm_set1_pd(65535));
+    return _mm_sub_epi32(_mm_cvttpd_epi32(r), _mm_set1_epi32(32768));
+}
+
+static DRWAV_INLINE __m128i drwav__dither_round_x4__sse2(const double* pIn, __m128 noise)
+{
+    __m128i lo = drwav__dither_round_x2__sse2(_mm_loadu_pd(pIn + 0), _mm_cvtps_pd(noise));
+    __m128i hi = drwav__dither_round_x2__sse2(_mm_loadu_pd(pIn + 2), _mm_cvtps_pd(_mm_movehl_ps(noise, noise)));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+static void drwav__dither_triangle__sse2(drwav_int16* pOut, const double* pIn, const float* pNoise, size_t sampleCount)
+{
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i a = drwav__dither_round_x4__sse2(pIn + i + 0, _mm_loadu_ps(pNoise + i + 0));
+        __m128i b = drwav__dither_round_x4__sse2(pIn + i + 4, _mm_loadu_ps(pNoise + i + 4));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
+    }
+
+    drwav__dither_triangle__reference(pOut + i, pIn + i, pNoise + i, sampleCount - i);
+}
+#endif
+
+// First-order noise shaping feeds the error of each sample back into the next sample of the same channel. This is inherently
+// serial so only the noise is generated with SIMD.
+static void drwav__dither_triangle_shaped(drwav_dither* pDither, drwav_int16* pOut, const double* pIn, const float* pNoise, size_t sampleCount)
+{
+    drwav_uint32 iChannel = pDither->iChannel;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        double x = pIn[i] - pDither->error[iChannel];
+        pOut[i] = drwav__dither_round(x, pNoise[i]);
+
+        // The error is limited to what rounding and the dither can produce so that clipping doesn't build up.
+        double error = (double)pOut[i] - x;
+        pDither->error[iChannel] = (error < -1.5) ? -1.5 : ((error > 1.5) ? 1.5 : error);
+
+        iChannel += 1;
+        if (iChannel == pDither->channels) {
+            iChannel = 0;
+        }
+    }
+    pDither->iChannel = iChannel;
+}
+
+// Dithers samples that have already been scaled so that 1 is the least significant bit of the output.
+static void drwav__dither_f64_to_s16(drwav_dither* pDither, drwav_int16* pOut, const double* pIn, size_t sampleCount)
+{
+    float noise[DRWAV_DITHER_CHUNK_SIZE];
+    drwav_assert(sampleCount <= DRWAV_DITHER_CHUNK_SIZE);
+    drwav_assert(pDither->channels > 0);    // <-- The dither must be initialized with drwav_dither_init().
+
+    drwav__dither_noise(pDither, noise, sampleCount);
+
+    if (pDither->mode == drwav_dither_mode_triangle_shaped) {
+        drwav__dither_triangle_shaped(pDither, pOut, pIn, noise, sampleCount);
+    } else {
+#ifdef DRWAV_SUPPORT_SSE2
+        drwav__dither_triangle__sse2(pOut, pIn, noise, sampleCount);
+#else
+        drwav__dither_triangle__reference(pOut, pIn, noise, sampleCount);
+#endif
+
+        pDither->iChannel = (drwav_uint32)((pDither->iChannel + sampleCount) % pDither->channels);
+    }
+}
+
+drwav_bool32 drwav_dither_init(drwav_dither* pDither, drwav_dither_mode mode, drwav_uint32 channels, drwav_uint32 seed)
+{
+    if (pDither == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_zero_memory(pDither, sizeof(*pDither));
+
+    if (channels == 0 || (mode == drwav_dither_mode_triangle_shaped && channels > DRWAV_MAX_DITHER_CHANNELS)) {
+        return DRWAV_FALSE;
+    }
+
+    pDither->mode     = mode;
+    pDither->channels = channels;
+
+    // Each lane is seeded with a hash of the seed so that similar seeds give unrelated sequences. Xorshift gets stuck at 0.
+    for (drwav_uint32 iLane = 0; iLane < 4; ++iLane) {
+        drwav_uint32 x = seed + (iLane + 1) * 0x9E3779B9;
+        x = (x ^ (x >> 16)) * 0x7FEB352D;
+        x = (x ^ (x >> 15)) * 0x846CA68B;
+        x =  x ^ (x >> 16);
+        pDither->lanes[iLane] = (x != 0) ? x : (iLane + 1);
+    }
+
+    return DRWAV_TRUE;
+}
+
+drwav_bool32 drwav_set_dither(drwav* pWav, drwav_dither_mode mode)
+{
+    if (pWav == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_dither dither;
+    if (!drwav_dither_init(&dither, mode, pWav->channels, 0)) {
+        return DRWAV_FALSE;
+    }
+
+    pWav->dither = dither;
+    return DRWAV_TRUE;
+}
+
+void drwav_s24_to_s16_dithered(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount, drwav_dither* pDither)
+{
+    if (pDither == NULL || pDither->mode == drwav_dither_mode_none) {
+        drwav_s24_to_s16(pOut, pIn, sampleCount);
+        return;
+    }
+
+    double samples[DRWAV_DITHER_CHUNK_SIZE];
+    while (sampleCount > 0) {
+        size_t samplesToConvert = drwav_min(sampleCount, DRWAV_DITHER_CHUNK_SIZE);
+        for (size_t i = 0; i < samplesToConvert; ++i) {
+            drwav_int32 x = (drwav_int32)(((drwav_uint32)pIn[i*3+0] << 8) | ((drwav_uint32)pIn[i*3+1] << 16) | ((drwav_uint32)pIn[i*3+2] << 24));
+            samples[i] = (double)x * (1.0 / 65536);
+        }
+
+        drwav__dither_f64_to_s16(pDither, pOut, samples, samplesToConvert);
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert * 3;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+void drwav_s32_to_s16_dithered(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount, drwav_dither* pDither)
+{
+    if (pDither == NULL || pDither->mode == drwav_dither_mode_none) {
+        drwav_s32_to_s16(pOut, pIn, sampleCount);
+        return;
+    }
+
+    double samples[DRWAV_DITHER_CHUNK_SIZE];
+    while (sampleCount > 0) {
+        size_t samplesToConvert = drwav_min(sampleCount, DRWAV_DITHER_CHUNK_SIZE);
+        for (size_t i = 0; i < samplesToConvert; ++i) {
+            samples[i] = (double)pIn[i] * (1.0 / 65536);
+        }
+
+        drwav__dither_f64_to_s16(pDither, pOut, samples, samplesToConvert);
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+void drwav_f32_to_s16_dithered(drwav_int16* pOut, const float* pIn, size_t sampleCount, drwav_dither* pDither)
+{
+    if (pDither == NULL || pDither->mode == drwav_dither_mode_none) {
+        drwav_f32_to_s16(pOut, pIn, sampleCount);
+        return;
+    }
+
+    double samples[DRWAV_DITHER_CHUNK_SIZE];
+    while (sampleCount > 0) {
+        size_t samplesToConvert = drwav_min(sampleCount, DRWAV_DITHER_CHUNK_SIZE);
+        for (size_t i = 0; i < samplesToConvert; ++i) {
+            samples[i] = (pIn[i] == pIn[i]) ? (double)pIn[i] * 32768 : 0;    // <-- NaN is treated as silence.
+        }
+
+        drwav__dither_f64_to_s16(pDither, pOut, samples, samplesToConvert);
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+void drwav_f64_to_s16_dithered(drwav_int16* pOut, const double* pIn, size_t sampleCount, drwav_dither* pDither)
+{
+    if (pDither == NULL || pDither->mode == drwav_dither_mode_none) {
+        drwav_f64_to_s16(pOut, pIn, sampleCount);
+        return;
+    }
+
+    double samples[DRWAV_DITHER_CHUNK_SIZE];
+    while (sampleCount > 0) {
+        size_t samplesToConvert = drwav_min(sampleCount, DRWAV_DITHER_CHUNK_SIZE);
+        for (size_t i = 0; i < samplesToConvert; ++i) {
+            // Clamped first so that huge values don't overflow to infinity. NaN is treated as silence.
+            double x = (pIn[i] == pIn[i]) ? pIn[i] : 0;
+            samples[i] = ((x < -2) ? -2 : ((x > 2) ? 2 : x)) * 32768;
+        }
+
+        drwav__dither_f64_to_s16(pDither, pOut, samples, samplesToConvert);
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+void drwav_alaw_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_s16__ssse3(pOut, pIn, sampleCount, DRWAV_TRUE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = drwav__alaw_to_s16(pIn[i]);
+    }
+}
+
+void drwav_mulaw_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_s16__ssse3(pOut, pIn, sampleCount, DRWAV_FALSE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = drwav__mulaw_to_s16(pIn[i]);
+    }
+}
+
+
+
+static void drwav__pcm_to_f32(float* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+{
+    // Special case for 8-bit sample data because it's treated as unsigned.
+    if (bytesPerSample == 1) {
+        drwav_u8_to_f32(pOut, pIn, sampleCount);
+        return;
+    }
+
+    // Slightly more optimal implementation for common formats.
+    if (bytesPerSample == 2) {
+        drwav_s16_to_f32(pOut, (const drwav_int16*)pIn, sampleCount);
+        return;
+    }
+    if (bytesPerSample == 3) {
+        drwav_s24_to_f32(pOut, pIn, sampleCount);
+        return;
+    }
+    if (bytesPerSample == 4) {
+        drwav_s32_to_f32(pOut, (const drwav_int32*)pIn, sampleCount);
+        return;
+    }
+
+    // Generic, slow converter.
+    for (unsigned int i = 0; i < sampleCount; ++i) {
+        unsigned int sample = 0;
+        unsigned int shift  = (8 - bytesPerSample) * 8;
+        for (unsigned short j = 0; j < bytesPerSample && j < 4; ++j) {
+            sample |= (unsigned int)(pIn[j]) << shift;
+            shift  += 8;
+        }
+
+        pIn += bytesPerSample;
+        *pOut++ = (float)((int)sample / 2147483648.0);
+    }
+}
+
+static void drwav__ieee_to_f32(float* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+{
+    if (bytesPerSample == 4) {
+        drwav_copy_memory(pOut, pIn, sampleCount * sizeof(float));
+        return;
+    } else {
+        drwav_f64_to_f32(pOut, (double*)pIn, sampleCount);
+        return;
+    }
+}
+
+// Converts raw PCM or floating point samples straight from the file, fixing up AIFF samples on the way.
+static void drwav__raw_to_f32(drwav* pWav, float* pOut, const unsigned char* pIn, size_t sampleCount)
+{
+    unsigned char fixupBuffer[DRWAV_FIXUP_BUFFER_SIZE];
+    while (sampleCount > 0) {
+        const unsigned char* pSamples = pIn;
+        size_t samplesToConvert = drwav__fixup_samples_for_conversion(pWav, fixupBuffer, &pSamples, sampleCount);
+
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+            drwav__ieee_to_f32(pOut, pSamples, samplesToConvert, pWav->bytesPerSample);
+        } else {
+            drwav__pcm_to_f32(pOut, pSamples, samplesToConvert, pWav->bytesPerSample);
+        }
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert * pWav->bytesPerSample;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+
+drwav_uint64 drwav_read_f32__pcm(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(float)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(float), &pRawData);
+        drwav__raw_to_f32(pWav, pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_f32(pWav, pBufferOut, sampleData, (size_t)samplesRead);
+        pBufferOut += samplesRead;
+
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_f32__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    // We're just going to borrow the implementation from the drwav_read_s16() since ADPCM is a little bit more complicated than other formats and I don't
+    // want to duplicate that code. The samples are decoded into the end of the output buffer and widened in place.
+    if (samplesToRead > pWav->totalSampleCount - pWav->compressed.iCurrentSample) {
+        samplesToRead = pWav->totalSampleCount - pWav->compressed.iCurrentSample;
+    }
+
+    drwav_int16* pSamples16 = (drwav_int16*)(pBufferOut + samplesToRead) - samplesToRead;
+    drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, pSamples16);
+
+    drwav_s16_to_f32(pBufferOut, pSamples16, (size_t)samplesRead);
+    return samplesRead;
+}
+
+drwav_uint64 drwav_read_f32__ima(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    // We're just going to borrow the implementation from the drwav_read_s16() since IMA-ADPCM is a little bit more complicated than other formats and I don't
+    // want to duplicate that code. The samples are decoded into the end of the output buffer and widened in place.
+    if (samplesToRead > pWav->totalSampleCount - pWav->compressed.iCurrentSample) {
+        samplesToRead = pWav->totalSampleCount - pWav->compressed.iCurrentSample;
+    }
+
+    drwav_int16* pSamples16 = (drwav_int16*)(pBufferOut + samplesToRead) - samplesToRead;
+    drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, pSamples16);
+
+    drwav_s16_to_f32(pBufferOut, pSamples16, (size_t)samplesRead);
+    return samplesRead;
+}
+
+drwav_uint64 drwav_read_f32__ieee(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    // Fast path.
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT && pWav->bytesPerSample == 4) {
+        drwav_uint64 samplesRead = drwav_read(pWav, samplesToRead, pBufferOut);
+        if (drwav__needs_sample_fixup(pWav)) {
+            drwav__fixup_samples((unsigned char*)pBufferOut, (unsigned char*)pBufferOut, (size_t)samplesRead, pWav->bytesPerSample);
+        }
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_f32(pWav, pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_f32__alaw(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(float)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(float), &pRawData);
+        drwav_alaw_to_f32(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_alaw_to_f32(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_f32__mulaw(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(float)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(float), &pRawData);
+        drwav_mulaw_to_f32(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_mulaw_to_f32(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_f32(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+{
+    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
+        return 0;
+    }
+
+    // Don't try to read more samples than can potentially fit in the output buffer.
+    if (samplesToRead * sizeof(float) > SIZE_MAX) {
+        samplesToRead = SIZE_MAX / sizeof(float);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
+        return drwav_read_f32__pcm(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        return drwav_read_f32__msadpcm(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        return drwav_read_f32__ieee(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
+        return drwav_read_f32__alaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
+        return drwav_read_f32__mulaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        return drwav_read_f32__ima(pWav, samplesToRead, pBufferOut);
+    }
+
+    return 0;
+}
+
+#ifdef DR_WAV_LIBSNDFILE_COMPAT
+// It appears libsndfile uses slightly different logic for the u8 -> f32 conversion to dr_wav, which in my opinion is incorrect. It appears
+// libsndfile performs the conversion something like "f32 = (u8 / 256) * 2 - 1", however I think it should be "f32 = (u8 / 255) * 2 - 1" (note
+// the divisor of 256 vs 255). I use libsndfile as a benchmark for testing, so I'm therefore leaving this block here just for my automated
+// correctness testing. This is disabled by default.
+#define DRWAV_U8_TO_F32_DIVISOR 256.0f
+#else
+#define DRWAV_U8_TO_F32_DIVISOR 255.0f
+#endif
+
+static void drwav__u8_to_f32__reference(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = (pIn[i] / DRWAV_U8_TO_F32_DIVISOR) * 2 - 1;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static DRWAV_INLINE void drwav__u8x4_to_f32__sse2(float* pOut, __m128i x)
+{
+    __m128 f = _mm_cvtepi32_ps(x);
+    f = _mm_div_ps(f, _mm_set1_ps(DRWAV_U8_TO_F32_DIVISOR));
+    f = _mm_sub_ps(_mm_mul_ps(f, _mm_set1_ps(2)), _mm_set1_ps(1));
+    _mm_storeu_ps(pOut, f);
+}
+
+static void drwav__u8_to_f32__sse2(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i x  = _mm_loadu_si128((const __m128i*)(pIn + i));
+        __m128i lo = _mm_unpacklo_epi8(x, zero);
+        __m128i hi = _mm_unpackhi_epi8(x, zero);
+        drwav__u8x4_to_f32__sse2(pOut + i +  0, _mm_unpacklo_epi16(lo, zero));
+        drwav__u8x4_to_f32__sse2(pOut + i +  4, _mm_unpackhi_epi16(lo, zero));
+        drwav__u8x4_to_f32__sse2(pOut + i +  8, _mm_unpacklo_epi16(hi, zero));
+        drwav__u8x4_to_f32__sse2(pOut + i + 12, _mm_unpackhi_epi16(hi, zero));
+    }
+
+    drwav__u8_to_f32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_u8_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__u8_to_f32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__u8_to_f32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s16_to_f32__reference(float* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = pIn[i] / 32768.0f;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s16_to_f32__sse2(float* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    // Dividing by a power of two is exact, so multiplying by the reciprocal gives the same result.
+    const __m128 scale = _mm_set1_ps(1 / 32768.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i x  = _mm_loadu_si128((const __m128i*)(pIn + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(pOut + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(pOut + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    drwav__s16_to_f32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_s16_to_f32(float* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s16_to_f32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s16_to_f32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s24_to_f32__reference(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        unsigned int s0 = pIn[i*3 + 0];
+        unsigned int s1 = pIn[i*3 + 1];
+        unsigned int s2 = pIn[i*3 + 2];
+
+        int sample32 = (int)((s0 << 8) | (s1 << 16) | (s2 << 24));
+        *pOut++ = (float)(sample32 / 2147483648.0);
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s24_to_f32__sse2(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    // 24-bit samples convert to float exactly, so there's no need to go through double precision.
+    const __m128 scale = _mm_set1_ps(1 / 2147483648.0f);
+    drwav_bool32 useSSSE3 = drwav__has_ssse3();
+
+    // The +2 keeps the 16 byte loads of the last group inside the input buffer.
+    size_t i = 0;
+    for (; i + 8 + 2 <= sampleCount; i += 8) {
+        __m128i a = drwav__unpack_s24x4__sse2(pIn + (i+0)*3, useSSSE3);
+        __m128i b = drwav__unpack_s24x4__sse2(pIn + (i+4)*3, useSSSE3);
+        _mm_storeu_ps(pOut + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(pOut + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+    }
+
+    drwav__s24_to_f32__reference(pOut + i, pIn + i*3, sampleCount - i);
+}
+#endif
+
+void drwav_s24_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s24_to_f32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s24_to_f32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s32_to_f32__reference(float* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = (float)(pIn[i] / 2147483648.0);
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s32_to_f32__sse2(float* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+    // Rounding to single precision and then scaling by a power of two gives the same result as the reference, which scales
+    // in double precision first.
+    const __m128 scale = _mm_set1_ps(1 / 2147483648.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(pIn + i + 0));
+        __m128i b = _mm_loadu_si128((const __m128i*)(pIn + i + 4));
+        _mm_storeu_ps(pOut + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+        _mm_storeu_ps(pOut + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+    }
+
+    drwav__s32_to_f32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_s32_to_f32(float* pOut, const drwav_int32* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s32_to_f32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s32_to_f32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__f64_to_f32__reference(float* pOut, const double* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = (float)pIn[i];
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__f64_to_f32__sse2(float* pOut, const double* pIn, size_t sampleCount)
+{
+    size_t i = 0;
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(pIn + i + 0));
+        __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(pIn + i + 2));
+        _mm_storeu_ps(pOut + i, _mm_movelh_ps(a, b));
+    }
+
+    drwav__f64_to_f32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_f64_to_f32(float* pOut, const double* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__f64_to_f32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__f64_to_f32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+void drwav_alaw_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_f32__ssse3(pOut, pIn, sampleCount, DRWAV_TRUE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = g_drwavAlawTableF32[pIn[i]];
+    }
+}
+
+void drwav_mulaw_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_f32__ssse3(pOut, pIn, sampleCount, DRWAV_FALSE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = g_drwavMulawTableF32[pIn[i]];
+    }
+}
+
+
+
+static void drwav__pcm_to_s32(drwav_int32* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
+{
+    // Special case for 8-bit sample data because it's treated as unsigned.
+    if (bytesPerSample == 1) {
+        drwav_u8_to_s32(pOut, pIn, totalSampleCount);
+        return;
+    }
+
+    // Slightly more optimal implementation for common formats.
+    if (bytesPerSample == 2) {
+        drwav_s16_to_s32(pOut, (const drwav_int16*)pIn, totalSampleCount);
+        return;
+    }
+    if (bytesPerSample == 3) {
+        drwav_s24_to_s32(pOut, pIn, totalSampleCount);
+        return;
+    }
+    if (bytesPerSample == 4) {
+        drwav_copy_memory(pOut, pIn, totalSampleCount * sizeof(drwav_int32));
+        return;
+    }
+
+    // Generic, slow converter.
+    for (unsigned int i = 0; i < totalSampleCount; ++i) {
+        unsigned int sample = 0;
+        unsigned int shift  = (8 - bytesPerSample) * 8;
+        for (unsigned short j = 0; j < bytesPerSample && j < 4; ++j) {
+            sample |= (unsigned int)(pIn[j]) << shift;
+            shift  += 8;
+        }
+
+        pIn += bytesPerSample;
+        *pOut++ = sample;
+    }
+}
+
+static void drwav__ieee_to_s32(drwav_int32* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
+{
+    if (bytesPerSample == 4) {
+        drwav_f32_to_s32(pOut, (float*)pIn, totalSampleCount);
+        return;
+    } else {
+        drwav_f64_to_s32(pOut, (double*)pIn, totalSampleCount);
+        return;
+    }
+}
+
+// Converts raw PCM or floating point samples straight from the file, fixing up AIFF samples on the way.
+static void drwav__raw_to_s32(drwav* pWav, drwav_int32* pOut, const unsigned char* pIn, size_t sampleCount)
+{
+    unsigned char fixupBuffer[DRWAV_FIXUP_BUFFER_SIZE];
+    while (sampleCount > 0) {
+        const unsigned char* pSamples = pIn;
+        size_t samplesToConvert = drwav__fixup_samples_for_conversion(pWav, fixupBuffer, &pSamples, sampleCount);
+
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+            drwav__ieee_to_s32(pOut, pSamples, samplesToConvert, pWav->bytesPerSample);
+        } else {
+            drwav__pcm_to_s32(pOut, pSamples, samplesToConvert, pWav->bytesPerSample);
+        }
+
+        pOut        += samplesToConvert;
+        pIn         += samplesToConvert * pWav->bytesPerSample;
+        sampleCount -= samplesToConvert;
+    }
+}
+
+
+drwav_uint64 drwav_read_s32__pcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    // Fast path.
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM && pWav->bytesPerSample == 4) {
+        drwav_uint64 samplesRead = drwav_read(pWav, samplesToRead, pBufferOut);
+        if (drwav__needs_sample_fixup(pWav)) {
+            drwav__fixup_samples((unsigned char*)pBufferOut, (unsigned char*)pBufferOut, (size_t)samplesRead, pWav->bytesPerSample);
+        }
+        return samplesRead;
+    }
+
+    if (pWav->bytesPerSample <= sizeof(drwav_int32)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int32), &pRawData);
+        drwav__raw_to_s32(pWav, pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_s32(pWav, pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s32__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    // We're just going to borrow the implementation from the drwav_read_s16() since ADPCM is a little bit more complicated than other formats and I don't
+    // want to duplicate that code. The samples are decoded into the end of the output buffer and widened in place.
+    if (samplesToRead > pWav->totalSampleCount - pWav->compressed.iCurrentSample) {
+        samplesToRead = pWav->totalSampleCount - pWav->compressed.iCurrentSample;
+    }
+
+    drwav_int16* pSamples16 = (drwav_int16*)(pBufferOut + samplesToRead) - samplesToRead;
+    drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, pSamples16);
+
+    drwav_s16_to_s32(pBufferOut, pSamples16, (size_t)samplesRead);
+    return samplesRead;
+}
+
+drwav_uint64 drwav_read_s32__ima(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    // We're just going to borrow the implementation from the drwav_read_s16() since IMA-ADPCM is a little bit more complicated than other formats and I don't
+    // want to duplicate that code. The samples are decoded into the end of the output buffer and widened in place.
+    if (samplesToRead > pWav->totalSampleCount - pWav->compressed.iCurrentSample) {
+        samplesToRead = pWav->totalSampleCount - pWav->compressed.iCurrentSample;
+    }
+
+    drwav_int16* pSamples16 = (drwav_int16*)(pBufferOut + samplesToRead) - samplesToRead;
+    drwav_uint64 samplesRead = drwav_read_s16(pWav, samplesToRead, pSamples16);
+
+    drwav_s16_to_s32(pBufferOut, pSamples16, (size_t)samplesRead);
+    return samplesRead;
+}
+
+drwav_uint64 drwav_read_s32__ieee(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(drwav_int32)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int32), &pRawData);
+        drwav__raw_to_s32(pWav, pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav__raw_to_s32(pWav, pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s32__alaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(drwav_int32)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int32), &pRawData);
+        drwav_alaw_to_s32(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_alaw_to_s32(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s32__mulaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    if (pWav->bytesPerSample <= sizeof(drwav_int32)) {
+        unsigned char* pRawData;
+        drwav_uint64 samplesRead = drwav__read_raw_to_end_of_buffer(pWav, samplesToRead, pBufferOut, sizeof(drwav_int32), &pRawData);
+        drwav_mulaw_to_s32(pBufferOut, pRawData, (size_t)samplesRead);
+        return samplesRead;
+    }
+
+    drwav_uint64 totalSamplesRead = 0;
+    unsigned char sampleData[DR_WAV_CONVERSION_BUFFER_SIZE];
+    while (samplesToRead > 0) {
+        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
+        if (samplesRead == 0) {
+            break;
+        }
+
+        drwav_mulaw_to_s32(pBufferOut, sampleData, (size_t)samplesRead);
+
+        pBufferOut       += samplesRead;
+        samplesToRead    -= samplesRead;
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+drwav_uint64 drwav_read_s32(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+{
+    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
+        return 0;
+    }
+
+    // Don't try to read more samples than can potentially fit in the output buffer.
+    if (samplesToRead * sizeof(drwav_int32) > SIZE_MAX) {
+        samplesToRead = SIZE_MAX / sizeof(drwav_int32);
+    }
+
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
+        return drwav_read_s32__pcm(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+        return drwav_read_s32__msadpcm(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        return drwav_read_s32__ieee(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
+        return drwav_read_s32__alaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
+        return drwav_read_s32__mulaw(pWav, samplesToRead, pBufferOut);
+    }
+
+    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        return drwav_read_s32__ima(pWav, samplesToRead, pBufferOut);
+    }
+
+    return 0;
+}
+
+static void drwav__u8_to_s32__reference(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = ((int)pIn[i] - 128) << 24;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__u8_to_s32__sse2(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+
+    size_t i = 0;
+    for (; i + 16 <= sampleCount; i += 16) {
+        __m128i x  = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pIn + i)), bias);  // <-- Same as subtracting 128.
+        __m128i lo = _mm_unpacklo_epi8(zero, x);
+        __m128i hi = _mm_unpackhi_epi8(zero, x);
+        _mm_storeu_si128((__m128i*)(pOut + i +  0), _mm_unpacklo_epi16(zero, lo));
+        _mm_storeu_si128((__m128i*)(pOut + i +  4), _mm_unpackhi_epi16(zero, lo));
+        _mm_storeu_si128((__m128i*)(pOut + i +  8), _mm_unpacklo_epi16(zero, hi));
+        _mm_storeu_si128((__m128i*)(pOut + i + 12), _mm_unpackhi_epi16(zero, hi));
+    }
+
+    drwav__u8_to_s32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_u8_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__u8_to_s32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__u8_to_s32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s16_to_s32__reference(drwav_int32* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = pIn[i] << 16;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s16_to_s32__sse2(drwav_int32* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(pIn + i));
+        _mm_storeu_si128((__m128i*)(pOut + i + 0), _mm_unpacklo_epi16(zero, x));
+        _mm_storeu_si128((__m128i*)(pOut + i + 4), _mm_unpackhi_epi16(zero, x));
+    }
+
+    drwav__s16_to_s32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_s16_to_s32(drwav_int32* pOut, const drwav_int16* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s16_to_s32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s16_to_s32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__s24_to_s32__reference(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        unsigned int s0 = pIn[i*3 + 0];
+        unsigned int s1 = pIn[i*3 + 1];
+        unsigned int s2 = pIn[i*3 + 2];
+
+        drwav_int32 sample32 = (drwav_int32)((s0 << 8) | (s1 << 16) | (s2 << 24));
+        *pOut++ = sample32;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__s24_to_s32__sse2(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    drwav_bool32 useSSSE3 = drwav__has_ssse3();
+
+    // The +2 keeps the 16 byte loads of the last group inside the input buffer.
+    size_t i = 0;
+    for (; i + 8 + 2 <= sampleCount; i += 8) {
+        _mm_storeu_si128((__m128i*)(pOut + i + 0), drwav__unpack_s24x4__sse2(pIn + (i+0)*3, useSSSE3));
+        _mm_storeu_si128((__m128i*)(pOut + i + 4), drwav__unpack_s24x4__sse2(pIn + (i+4)*3, useSSSE3));
+    }
+
+    drwav__s24_to_s32__reference(pOut + i, pIn + i*3, sampleCount - i);
+}
+#endif
+
+void drwav_s24_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__s24_to_s32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__s24_to_s32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__f32_to_s32__reference(drwav_int32* pOut, const float* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = (drwav_int32)(2147483648.0 * pIn[i]);
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__f32_to_s32__sse2(drwav_int32* pOut, const float* pIn, size_t sampleCount)
+{
+    // The scaling is done in double precision, as in the reference implementation.
+    const __m128d scale = _mm_set1_pd(2147483648.0);
+
+    size_t i = 0;
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m128  x  = _mm_loadu_ps(pIn + i);
+        __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(x), scale));
+        __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), scale));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_unpacklo_epi64(lo, hi));
+    }
+
+    drwav__f32_to_s32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_f32_to_s32(drwav_int32* pOut, const float* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__f32_to_s32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__f32_to_s32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+static void drwav__f64_to_s32__reference(drwav_int32* pOut, const double* pIn, size_t sampleCount)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        *pOut++ = (drwav_int32)(2147483648.0 * pIn[i]);
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__f64_to_s32__sse2(drwav_int32* pOut, const double* pIn, size_t sampleCount)
+{
+    const __m128d scale = _mm_set1_pd(2147483648.0);
+
+    size_t i = 0;
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(pIn + i + 0), scale));
+        __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(pIn + i + 2), scale));
+        _mm_storeu_si128((__m128i*)(pOut + i), _mm_unpacklo_epi64(lo, hi));
+    }
+
+    drwav__f64_to_s32__reference(pOut + i, pIn + i, sampleCount - i);
+}
+#endif
+
+void drwav_f64_to_s32(drwav_int32* pOut, const double* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__f64_to_s32__sse2(pOut, pIn, sampleCount);
+#else
+    drwav__f64_to_s32__reference(pOut, pIn, sampleCount);
+#endif
+}
+
+void drwav_alaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_s32__ssse3(pOut, pIn, sampleCount, DRWAV_TRUE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = ((drwav_int32)drwav__alaw_to_s16(pIn[i])) << 16;
+    }
+}
+
+void drwav_mulaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+{
+    if (pOut == NULL || pIn == NULL) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(DRWAV_SUPPORT_SSSE3)
+    if (drwav__has_ssse3()) {
+        i = drwav__g711_to_s32__ssse3(pOut, pIn, sampleCount, DRWAV_FALSE);
+    }
+#endif
+
+    for (; i < sampleCount; ++i) {
+        pOut[i] = ((drwav_int32)drwav__mulaw_to_s16(pIn[i])) << 16;
+    }
+}
+
+
+// Planar (deinterleaved) reading.
+//
+// Samples are read and converted into a small staging buffer that stays in cache, and are then scattered out to each of the
+// channel buffers. The common channel counts transpose whole groups of frames at a time with SSE2. The staging buffers are
+// padded so that the 6 channel kernels can load a full vector from the last frame of the group. Those extra lanes are never
+// stored, so the staging buffers are left uninitialized rather than clearing 4KB on every call.
+#define DRWAV_STAGING_SAMPLE_COUNT  1024
+#define DRWAV_STAGING_PADDING       8
+
+static void drwav__deinterleave_f32__reference(float** ppOut, drwav_uint64 outOffset, const float* pIn, size_t frameCount, drwav_uint16 channels)
+{
+    for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        float* pOut = ppOut[iChannel] + outOffset;
+        const float* pSrc = pIn + iChannel;
+        for (size_t iFrame = 0; iFrame < frameCount; ++iFrame) {
+            pOut[iFrame] = *pSrc;
+            pSrc += channels;
+        }
+    }
+}
+
+static void drwav__deinterleave_s16__reference(drwav_int16** ppOut, drwav_uint64 outOffset, const drwav_int16* pIn, size_t frameCount, drwav_uint16 channels)
+{
+    for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        drwav_int16* pOut = ppOut[iChannel] + outOffset;
+        const drwav_int16* pSrc = pIn + iChannel;
+        for (size_t iFrame = 0; iFrame < frameCount; ++iFrame) {
+            pOut[iFrame] = *pSrc;
+            pSrc += channels;
+        }
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+// Transposes 4 frames of 4 consecutive channels, starting at channel <firstChannel>, into 4 channel vectors.
+static DRWAV_INLINE void drwav__store_f32x4x4_transposed__sse2(float** ppOut, size_t iOut, const float* pIn, drwav_uint16 channels, drwav_uint16 firstChannel, drwav_uint16 channelCount)
+{
+    __m128 r0 = _mm_loadu_ps(pIn + channels*0 + firstChannel);
+    __m128 r1 = _mm_loadu_ps(pIn + channels*1 + firstChannel);
+    __m128 r2 = _mm_loadu_ps(pIn + channels*2 + firstChannel);
+    __m128 r3 = _mm_loadu_ps(pIn + channels*3 + firstChannel);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(ppOut[firstChannel+0] + iOut, r0);
+    _mm_storeu_ps(ppOut[firstChannel+1] + iOut, r1);
+    if (channelCount > 2) {
+        _mm_storeu_ps(ppOut[firstChannel+2] + iOut, r2);
+        _mm_storeu_ps(ppOut[firstChannel+3] + iOut, r3);
+    }
+}
+
+static void drwav__deinterleave_f32__sse2(float** ppOut, drwav_uint64 outOffset, const float* pIn, size_t frameCount, drwav_uint16 channels)
+{
+    size_t i = 0;
+
+    if (channels == 2) {
+        float* pOutL = ppOut[0] + outOffset;
+        float* pOutR = ppOut[1] + outOffset;
+        for (; i + 4 <= frameCount; i += 4) {
+            __m128 a = _mm_loadu_ps(pIn + i*2 + 0);
+            __m128 b = _mm_loadu_ps(pIn + i*2 + 4);
+            _mm_storeu_ps(pOutL + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(pOutR + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    } else if (channels == 6 || channels == 8) {
+        for (; i + 4 <= frameCount; i += 4) {
+            const float* pFrames = pIn + i*channels;
+            size_t iOut = (size_t)outOffset + i;
+            drwav__store_f32x4x4_transposed__sse2(ppOut, iOut, pFrames, channels, 0, 4);
+            drwav__store_f32x4x4_transposed__sse2(ppOut, iOut, pFrames, channels, 4, channels - 4);     // The last 2 lanes are the next frame when channels == 6.
+        }
+    }
+
+    if (i < frameCount) {
+        float* ppTail[8];
+        for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+            ppTail[iChannel] = ppOut[iChannel] + i;
+        }
+        drwav__deinterleave_f32__reference(ppTail, outOffset, pIn + i*channels, frameCount - i, channels);
+    }
+}
+
+// Transposes 8 frames of 8 consecutive channels into 8 channel vectors. Only the first <channels> vectors are stored.
+static void drwav__store_s16x8x8_transposed__sse2(drwav_int16** ppOut, size_t iOut, const drwav_int16* pIn, drwav_uint16 channels)
+{
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(pIn + channels*0));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(pIn + channels*1));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(pIn + channels*2));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(pIn + channels*3));
+    __m128i r4 = _mm_loadu_si128((const __m128i*)(pIn + channels*4));
+    __m128i r5 = _mm_loadu_si128((const __m128i*)(pIn + channels*5));
+    __m128i r6 = _mm_loadu_si128((const __m128i*)(pIn + channels*6));
+    __m128i r7 = _mm_loadu_si128((const __m128i*)(pIn + channels*7));
+
+    __m128i a0 = _mm_unpacklo_epi16(r0, r1);
+    __m128i a1 = _mm_unpackhi_epi16(r0, r1);
+    __m128i a2 = _mm_unpacklo_epi16(r2, r3);
+    __m128i a3 = _mm_unpackhi_epi16(r2, r3);
+    __m128i a4 = _mm_unpacklo_epi16(r4, r5);
+    __m128i a5 = _mm_unpackhi_epi16(r4, r5);
+    __m128i a6 = _mm_unpacklo_epi16(r6, r7);
+    __m128i a7 = _mm_unpackhi_epi16(r6, r7);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+    __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+    __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+    __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+    __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+    __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+    _mm_storeu_si128((__m128i*)(ppOut[0] + iOut), _mm_unpacklo_epi64(b0, b4));
+    _mm_storeu_si128((__m128i*)(ppOut[1] + iOut), _mm_unpackhi_epi64(b0, b4));
+    _mm_storeu_si128((__m128i*)(ppOut[2] + iOut), _mm_unpacklo_epi64(b1, b5));
+    _mm_storeu_si128((__m128i*)(ppOut[3] + iOut), _mm_unpackhi_epi64(b1, b5));
+    _mm_storeu_si128((__m128i*)(ppOut[4] + iOut), _mm_unpacklo_epi64(b2, b6));
+    _mm_storeu_si128((__m128i*)(ppOut[5] + iOut), _mm_unpackhi_epi64(b2, b6));
+    if (channels == 8) {
+        _mm_storeu_si128((__m128i*)(ppOut[6] + iOut), _mm_unpacklo_epi64(b3, b7));
+        _mm_storeu_si128((__m128i*)(ppOut[7] + iOut), _mm_unpackhi_epi64(b3, b7));
+    }
+}
+
+static void drwav__deinterleave_s16__sse2(drwav_int16** ppOut, drwav_uint64 outOffset, const drwav_int16* pIn, size_t frameCount, drwav_uint16 channels)
+{
+    size_t i = 0;
+
+    if (channels == 2) {
+        drwav_int16* pOutL = ppOut[0] + outOffset;
+        drwav_int16* pOutR = ppOut[1] + outOffset;
+        for (; i + 8 <= frameCount; i += 8) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(pIn + i*2 + 0));
+            __m128i b = _mm_loadu_si128((const __m128i*)(pIn + i*2 + 8));
+            __m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+            __m128i r = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+            _mm_storeu_si128((__m128i*)(pOutL + i), l);
+            _mm_storeu_si128((__m128i*)(pOutR + i), r);
+        }
+    } else if (channels == 6 || channels == 8) {
+        for (; i + 8 <= frameCount; i += 8) {
+            drwav__store_s16x8x8_transposed__sse2(ppOut, (size_t)outOffset + i, pIn + i*channels, channels);   // The last 2 lanes of each row are the next frame when channels == 6.
+        }
+    }
+
+    if (i < frameCount) {
+        drwav_int16* ppTail[8];
+        for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+            ppTail[iChannel] = ppOut[iChannel] + i;
+        }
+        drwav__deinterleave_s16__reference(ppTail, outOffset, pIn + i*channels, frameCount - i, channels);
+    }
+}
+#endif
+
+static void drwav__deinterleave_f32(float** ppOut, drwav_uint64 outOffset, const float* pIn, size_t frameCount, drwav_uint16 channels)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    if (channels == 2 || channels == 6 || channels == 8) {
+        drwav__deinterleave_f32__sse2(ppOut, outOffset, pIn, frameCount, channels);
+        return;
+    }
+#endif
+    drwav__deinterleave_f32__reference(ppOut, outOffset, pIn, frameCount, channels);
+}
+
+static void drwav__deinterleave_s16(drwav_int16** ppOut, drwav_uint64 outOffset, const drwav_int16* pIn, size_t frameCount, drwav_uint16 channels)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    if (channels == 2 || channels == 6 || channels == 8) {
+        drwav__deinterleave_s16__sse2(ppOut, outOffset, pIn, frameCount, channels);
+        return;
+    }
+#endif
+    drwav__deinterleave_s16__reference(ppOut, outOffset, pIn, frameCount, channels);
+}
+
+drwav_uint64 drwav_read_f32_planar(drwav* pWav, drwav_uint64 framesToRead, float** ppChannelsOut)
+{
+    if (pWav == NULL || framesToRead == 0 || ppChannelsOut == NULL || pWav->channels == 0) {
+        return 0;
+    }
+
+    drwav_uint16 channels = pWav->channels;
+    size_t framesPerIteration = DRWAV_STAGING_SAMPLE_COUNT / channels;
+    if (framesPerIteration == 0) {
+        return 0;   // Too many channels to fit a whole frame in the staging buffer.
+    }
+
+    float staging[DRWAV_STAGING_SAMPLE_COUNT + DRWAV_STAGING_PADDING];
+
+    drwav_uint64 totalFramesRead = 0;
+    while (framesToRead > 0) {
+        size_t framesToReadThisIteration = (framesToRead < framesPerIteration) ? (size_t)framesToRead : framesPerIteration;
+        drwav_uint64 samplesRead = drwav_read_f32(pWav, (drwav_uint64)framesToReadThisIteration * channels, staging);
+        size_t framesRead = (size_t)(samplesRead / channels);
+        if (framesRead == 0) {
+            break;
+        }
+
+        drwav__deinterleave_f32(ppChannelsOut, totalFramesRead, staging, framesRead, channels);
+
+        framesToRead    -= framesRead;
+        totalFramesRead += framesRead;
+
+        if (framesRead < framesToReadThisIteration) {
+            break;
+        }
+    }
+
+    return totalFramesRead;
+}
+
+drwav_uint64 drwav_read_s16_planar(drwav* pWav, drwav_uint64 framesToRead, drwav_int16** ppChannelsOut)
+{
+    if (pWav == NULL || framesToRead == 0 || ppChannelsOut == NULL || pWav->channels == 0) {
+        return 0;
+    }
+
+    drwav_uint16 channels = pWav->channels;
+    size_t framesPerIteration = DRWAV_STAGING_SAMPLE_COUNT / channels;
+    if (framesPerIteration == 0) {
+        return 0;   // Too many channels to fit a whole frame in the staging buffer.
+    }
+
+    drwav_int16 staging[DRWAV_STAGING_SAMPLE_COUNT + DRWAV_STAGING_PADDING];
+
+    drwav_uint64 totalFramesRead = 0;
+    while (framesToRead > 0) {
+        size_t framesToReadThisIteration = (framesToRead < framesPerIteration) ? (size_t)framesToRead : framesPerIteration;
+        drwav_uint64 samplesRead = drwav_read_s16(pWav, (drwav_uint64)framesToReadThisIteration * channels, staging);
+        size_t framesRead = (size_t)(samplesRead / channels);
+        if (framesRead == 0) {
+            break;
+        }
+
+        drwav__deinterleave_s16(ppChannelsOut, totalFramesRead, staging, framesRead, channels);
+
+        framesToRead    -= framesRead;
+        totalFramesRead += framesRead;
+
+        if (framesRead < framesToReadThisIteration) {
+            break;
+        }
+    }
+
+    return totalFramesRead;
+}
+
+
+// Remixing and gain.
+//
+// Like the planar readers, samples are converted into a staging buffer that stays in cache and are then remixed straight into the
+// output buffer. The common layouts have dedicated SSE2 kernels which accumulate in the same order as the reference implementation.
+static void drwav__mix_f32__reference(float* pOut, const float* pIn, size_t frameCount, drwav_uint16 inputChannels, drwav_uint16 outputChannels, const float* pMatrix, float gain)
+{
+    for (size_t iFrame = 0; iFrame < frameCount; ++iFrame) {
+        for (drwav_uint16 iOut = 0; iOut < outputChannels; ++iOut) {
+            float sum;
+            if (pMatrix == NULL) {
+                sum = (iOut < inputChannels) ? pIn[iOut] : 0;
+            } else {
+                const float* pRow = pMatrix + (size_t)iOut*inputChannels;
+                sum = 0;
+                for (drwav_uint16 iIn = 0; iIn < inputChannels; ++iIn) {
+                    sum += pRow[iIn] * pIn[iIn];
+                }
+            }
+
+            pOut[iOut] = sum * gain;
+        }
+
+        pIn  += inputChannels;
+        pOut += outputChannels;
+    }
+}
+
+#ifdef DRWAV_SUPPORT_SSE2
+static void drwav__mix_f32__sse2(float* pOut, const float* pIn, size_t frameCount, drwav_uint16 inputChannels, drwav_uint16 outputChannels, const float* pMatrix, float gain)
+{
+    __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+
+    if (pMatrix == NULL && inputChannels == outputChannels) {
+        // Gain only.
+        size_t sampleCount = frameCount * inputChannels;
+        for (; i + 4 <= sampleCount; i += 4) {
+            _mm_storeu_ps(pOut + i, _mm_mul_ps(_mm_loadu_ps(pIn + i), g));
+        }
+        for (; i < sampleCount; ++i) {
+            pOut[i] = pIn[i] * gain;
+        }
+        return;
+    }
+
+    if (pMatrix != NULL && inputChannels == 1 && outputChannels == 2) {
+        __m128 m0 = _mm_set1_ps(pMatrix[0]);
+        __m128 m1 = _mm_set1_ps(pMatrix[1]);
+        for (; i + 4 <= frameCount; i += 4) {
+            __m128 x = _mm_loadu_ps(pIn + i);
+            __m128 l = _mm_mul_ps(_mm_mul_ps(m0, x), g);
+            __m128 r = _mm_mul_ps(_mm_mul_ps(m1, x), g);
+            _mm_storeu_ps(pOut + i*2 + 0, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(pOut + i*2 + 4, _mm_unpackhi_ps(l, r));
+        }
+    } else if (pMatrix != NULL && inputChannels == 2 && outputChannels == 1) {
+        __m128 m0 = _mm_set1_ps(pMatrix[0]);
+        __m128 m1 = _mm_set1_ps(pMatrix[1]);
+        for (; i + 4 <= frameCount; i += 4) {
+            __m128 a = _mm_loadu_ps(pIn + i*2 + 0);
+            __m128 b = _mm_loadu_ps(pIn + i*2 + 4);
+            __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(pOut + i, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(m0, l), _mm_mul_ps(m1, r)), g));
+        }
+    } else if (pMatrix != NULL && inputChannels == 2 && outputChannels == 2) {
+        // Each vector holds two frames. Both outputs of a frame are computed together from the frame's left and right inputs
+        // broadcast across its two lanes.
+        __m128 mL = _mm_setr_ps(pMatrix[0], pMatrix[2], pMatrix[0], pMatrix[2]);
+        __m128 mR = _mm_setr_ps(pMatrix[1], pMatrix[3], pMatrix[1], pMatrix[3]);
+        for (; i + 2 <= frameCount; i += 2) {
+            __m128 x = _mm_loadu_ps(pIn + i*2);
+            __m128 l = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 r = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 1, 1));
+            _mm_storeu_ps(pOut + i*2, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(mL, l), _mm_mul_ps(mR, r)), g));
+        }
+    } else if (pMatrix != NULL && inputChannels == 6 && outputChannels == 2) {
+        __m128 mL[6];
+        __m128 mR[6];
+        for (int iIn = 0; iIn < 6; ++iIn) {
+            mL[iIn] = _mm_set1_ps(pMatrix[0 + iIn]);
+            mR[iIn] = _mm_set1_ps(pMatrix[6 + iIn]);
+        }
+
+        for (; i + 4 <= frameCount; i += 4) {
+            // Transpose 4 frames into one vector per channel. Channels 4 and 5 are gathered in pairs so nothing past the 4th frame
+            // is touched.
+            const float* pFrames = pIn + i*6;
+            __m128 c0 = _mm_loadu_ps(pFrames +  0);
+            __m128 c1 = _mm_loadu_ps(pFrames +  6);
+            __m128 c2 = _mm_loadu_ps(pFrames + 12);
+            __m128 c3 = _mm_loadu_ps(pFrames + 18);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+            __m128 p01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(pFrames +  4)), (const __m64*)(pFrames + 10));
+            __m128 p23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(pFrames + 16)), (const __m64*)(pFrames + 22));
+            __m128 c4  = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 c5  = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+
+            __m128 l = _mm_mul_ps(mL[0], c0);
+            l = _mm_add_ps(l, _mm_mul_ps(mL[1], c1));
+            l = _mm_add_ps(l, _mm_mul_ps(mL[2], c2));
+            l = _mm_add_ps(l, _mm_mul_ps(mL[3], c3));
+            l = _mm_add_ps(l, _mm_mul_ps(mL[4], c4));
+            l = _mm_add_ps(l, _mm_mul_ps(mL[5], c5));
+            l = _mm_mul_ps(l, g);
+
+            __m128 r = _mm_mul_ps(mR[0], c0);
+            r = _mm_add_ps(r, _mm_mul_ps(mR[1], c1));
+            r = _mm_add_ps(r, _mm_mul_ps(mR[2], c2));
+            r = _mm_add_ps(r, _mm_mul_ps(mR[3], c3));
+            r = _mm_add_ps(r, _mm_mul_ps(mR[4], c4));
+            r = _mm_add_ps(r, _mm_mul_ps(mR[5], c5));
+            r = _mm_mul_ps(r, g);
+
+            _mm_storeu_ps(pOut + i*2 + 0, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(pOut + i*2 + 4, _mm_unpackhi_ps(l, r));
+        }
+    }
+
+    drwav__mix_f32__reference(pOut + i*outputChannels, pIn + i*inputChannels, frameCount - i, inputChannels, outputChannels, pMatrix, gain);
+}
+#endif
+
+static void drwav__mix_f32(float* pOut, const float* pIn, size_t frameCount, drwav_uint16 inputChannels, drwav_uint16 outputChannels, const float* pMatrix, float gain)
+{
+#ifdef DRWAV_SUPPORT_SSE2
+    drwav__mix_f32__sse2(pOut, pIn, frameCount, inputChannels, outputChannels, pMatrix, gain);
+#else
+    drwav__mix_f32__reference(pOut, pIn, frameCount, inputChannels, outputChannels, pMatrix, gain);
+#endif
+}
+
+drwav_uint64 drwav_read_f32_ex(drwav* pWav, drwav_uint64 framesToRead, float* pFramesOut, const drwav_mix_params* pMix)
+{
+    if (pWav == NULL || framesToRead == 0 || pFramesOut == NULL || pWav->channels == 0) {
+        return 0;
+    }
+
+    drwav_uint16 inputChannels  = pWav->channels;
+    drwav_uint16 outputChannels = inputChannels;
+    const float* pMatrix = NULL;
+    float gain = 1;
+    if (pMix != NULL) {
+        if (pMix->outputChannels != 0) {
+            outputChannels = pMix->outputChannels;
+        }
+        pMatrix = pMix->pMatrix;
+        if (pMix->gain != 0) {
+            gain = pMix->gain;
+        }
+    }
+
+    size_t framesPerIteration = DRWAV_STAGING_SAMPLE_COUNT / inputChannels;
+    if (framesPerIteration == 0) {
+        return 0;   // Too many channels to fit a whole frame in the staging buffer.
+    }
+
+    float staging[DRWAV_STAGING_SAMPLE_COUNT];
+
+    drwav_uint64 totalFramesRead = 0;
+    while (framesToRead > 0) {
+        size_t framesToReadThisIteration = (framesToRead < framesPerIteration) ? (size_t)framesToRead : framesPerIteration;
+        drwav_uint64 samplesRead = drwav_read_f32(pWav, (drwav_uint64)framesToReadThisIteration * inputChannels, staging);
+        size_t framesRead = (size_t)(samplesRead / inputChannels);
+        if (framesRead == 0) {
+            break;
+        }
+
+        drwav__mix_f32(pFramesOut, staging, framesRead, inputChannels, outputChannels, pMatrix, gain);
+
+        pFramesOut      += framesRead * outputChannels;
+        framesToRead    -= framesRead;
+        totalFramesRead += framesRead;
+
+        if (framesRead < framesToReadThisIteration) {
+            break;
+        }
+    }
+
+    return totalFramesRead;
+}
+
+// Moves the read position to the given PCM frame, which must be before the end of the stream.
+static drwav_bool32 drwav__seek_to_frame(drwav* pWav, drwav_uint64 frameIndex)
+{
+    drwav_uint64 sample = frameIndex * pWav->channels;
+
+    // A cursor's read position is just a number, so uncompressed formats can set it directly.
+    if (pWav->onRead == drwav__on_read_at_stream && !drwav__is_compressed_format_tag(pWav->translatedFormatTag) && pWav->bytesPerSample > 0) {
+        drwav_uint64 bytePos = sample * pWav->bytesPerSample;
+        if (bytePos > pWav->dataChunkDataSize) {
+            return DRWAV_FALSE;
+        }
+
+        drwav__read_at_stream* pStream = (drwav__read_at_stream*)pWav->pUserData;
+        pStream->readPos     = pWav->dataChunkDataPos + bytePos;
+        pWav->bytesRemaining = pWav->dataChunkDataSize - bytePos;
+        return DRWAV_TRUE;
+    }
+
+    return drwav_seek_to_sample(pWav, sample);
+}
+
+drwav_uint64 drwav_read_f32_at(drwav* pWav, drwav_uint64 frameIndex, drwav_uint64 frameCount, float* pFramesOut)
+{
+    if (pWav == NULL || frameCount == 0 || pFramesOut == NULL || pWav->channels == 0) {
+        return 0;
+    }
+
+    drwav_uint64 totalFrameCount = pWav->totalSampleCount / pWav->channels;
+    if (frameIndex >= totalFrameCount) {
+        return 0;
+    }
+
+    frameCount = drwav_min(frameCount, totalFrameCount - frameIndex);
+
+    if (!drwav__seek_to_frame(pWav, frameIndex)) {
+        return 0;
+    }
+
+    return drwav_read_f32(pWav, frameCount * pWav->channels, pFramesOut) / pWav->channels;
+}
+
+static int drwav__compare_read_windows(const void* a, const void* b)
+{
+    const drwav_read_window* pA = *(const drwav_read_window* const*)a;
+    const drwav_read_window* pB = *(const drwav_read_window* const*)b;
+
+    if (pA->frameIndex != pB->frameIndex) {
+        return (pA->frameIndex < pB->frameIndex) ? -1 : 1;
+    }
+
+    // Longest first so that later windows starting at the same frame can be copied from it.
+    if (pA->frameCount != pB->frameCount) {
+        return (pA->frameCount > pB->frameCount) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+drwav_bool32 drwav_read_f32_at_batch(drwav* pWav, drwav_read_window* pWindows, size_t windowCount)
+{
+    if (pWav == NULL || (pWindows == NULL && windowCount > 0) || pWav->channels == 0) {
+        return DRWAV_FALSE;
+    }
+
+    if (windowCount > SIZE_MAX / sizeof(drwav_read_window*)) {
+        return DRWAV_FALSE;
+    }
+
+    drwav_read_window** ppSortedWindows = (drwav_read_window**)DRWAV_MALLOC(drwav_max(windowCount, 1) * sizeof(drwav_read_window*));
+    if (ppSortedWindows == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    for (size_t iWindow = 0; iWindow < windowCount; ++iWindow) {
+        ppSortedWindows[iWindow] = &pWindows[iWindow];
+        pWindows[iWindow].framesRead = 0;
+    }
+
+    qsort(ppSortedWindows, windowCount, sizeof(*ppSortedWindows), drwav__compare_read_windows);
+
+    // <pCover> is the window that reaches furthest into the stream so far. Any window starting before its end can copy its
+    // first frames from it.
+    drwav_uint16 channels = pWav->channels;
+    const drwav_read_window* pCover = NULL;
+    drwav_uint64 coverEnd = 0;
+    drwav_uint64 streamFrame = ~(drwav_uint64)0;   // <-- The frame the stream is sitting on, if known.
+
+    for (size_t iWindow = 0; iWindow < windowCount; ++iWindow) {
+        drwav_read_window* pWindow = ppSortedWindows[iWindow];
+        if (pWindow->frameCount == 0 || pWindow->pFramesOut == NULL) {
+            continue;
+        }
+
+        drwav_uint64 framesCopied = 0;
+        if (pCover != NULL && pWindow->frameIndex < coverEnd) {
+            framesCopied = drwav_min(pWindow->frameCount, coverEnd - pWindow->frameIndex);
+            drwav_copy_memory(pWindow->pFramesOut, pCover->pFramesOut + ((pWindow->frameIndex - pCover->frameIndex) * channels), (size_t)(framesCopied * channels * sizeof(float)));
+        }
+
+        drwav_uint64 framesRead = 0;
+        if (framesCopied < pWindow->frameCount) {
+            drwav_uint64 frameIndex = pWindow->frameIndex + framesCopied;
+            drwav_uint64 frameCount = pWindow->frameCount - framesCopied;
+            float* pFramesOut = pWindow->pFramesOut + (framesCopied * channels);
+
+            if (frameIndex == streamFrame) {
+                framesRead = drwav_read_f32(pWav, frameCount * channels, pFramesOut) / channels;    // <-- Already in position.
+            } else {
+                framesRead = drwav_read_f32_at(pWav, frameIndex, frameCount, pFramesOut);
+            }
+
+            streamFrame = (framesRead > 0) ? frameIndex + framesRead : ~(drwav_uint64)0;
+        }
+
+        pWindow->framesRead = framesCopied + framesRead;
+
+        if (framesRead > 0) {
+            pCover   = pWindow;
+            coverEnd = pWindow->frameIndex + pWindow->framesRead;
+        }
+    }
+
+    DRWAV_FREE(ppSortedWindows);
+    return DRWAV_TRUE;
+}
+
+
+
+drwav_int16* drwav__read_and_close_s16(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int16);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
+    }
+
+    drwav_int16* pSampleData = (drwav_int16*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
+    }
+
+    drwav_uint64 samplesRead = drwav_read_s16(pWav, (size_t)pWav->totalSampleCount, pSampleData);
+    if (samplesRead != pWav->totalSampleCount) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error reading the samples.
+    }
+
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
+}
+
+float* drwav__read_and_close_f32(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(float);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
+    }
+
+    float* pSampleData = (float*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
+    }
+
+    drwav_uint64 samplesRead = drwav_read_f32(pWav, (size_t)pWav->totalSampleCount, pSampleData);
+    if (samplesRead != pWav->totalSampleCount) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error reading the samples.
+    }
+
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
+}
+
+drwav_int32* drwav__read_and_close_s32(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int32);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
+    }
+
+    drwav_int32* pSampleData = (drwav_int32*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
+    }
+
+    drwav_uint64 samplesRead = drwav_read_s32(pWav, (size_t)pWav->totalSampleCount, pSampleData);
+    if (samplesRead != pWav->totalSampleCount) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error reading the samples.
+    }
+
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
+}
+
+
+drwav_int16* drwav_open_and_read_s16(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
+}
+
+float* drwav_open_and_read_f32(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
+}
+
+drwav_int32* drwav_open_and_read_s32(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
+}
+
+#ifndef DR_WAV_NO_STDIO
+drwav_int16* drwav_open_and_read_file_s16(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
+}
+
+float* drwav_open_and_read_file_f32(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
+}
+
+drwav_int32* drwav_open_and_read_file_s32(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
+}
+#endif
+
+drwav_int16* drwav_open_and_read_memory_s16(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
+}
+
+float* drwav_open_and_read_memory_f32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
+}
+
+drwav_int32* drwav_open_and_read_memory_s32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
+    }
+
+    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
+}
+
+
+#ifndef DR_WAV_NO_THREADS
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE drwav__thread;
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t drwav__thread;
+#endif
+#endif
+
+// Jobs run by drwav__run_jobs() start with the function that runs them.
+typedef void (* drwav__job_proc)(void* pJob);
+
+typedef struct
+{
+    drwav__job_proc onRun;
+    drwav* pWav;
+    const drwav_uint8* pData;       // The start of the data chunk.
+    drwav_uint64 dataSize;
+    drwav_uint64 samplesPerBlock;
+    drwav_uint64 firstBlock;
+    drwav_uint64 blockCount;
+    drwav_int16* pScratch;          // Room for one block. Used for blocks that can't be decoded straight into the output buffer.
+
+    // Only one of these will be set.
+    drwav_int16* pOutS16;
+    float* pOutF32;
+    drwav_int32* pOutS32;
+
+    drwav_bool32 result;
+} drwav__parallel_job;
+
+static void drwav__run_parallel_job(void* pUserData)
+{
+    drwav__parallel_job* pJob = (drwav__parallel_job*)pUserData;
+    drwav* pWav = pJob->pWav;
+    pJob->result = DRWAV_FALSE;
+
+    for (drwav_uint64 iBlock = pJob->firstBlock; iBlock < pJob->firstBlock + pJob->blockCount; ++iBlock) {
+        drwav_uint64 blockOffset = iBlock * pWav->fmt.blockAlign;
+        if (blockOffset >= pJob->dataSize) {
+            return; // Ran out of data.
+        }
+
+        size_t blockSize = (size_t)drwav_min(pWav->fmt.blockAlign, pJob->dataSize - blockOffset);
+
+        // The last block may be cut short by the total sample count, in which case it's decoded into the scratch buffer.
+        drwav_uint64 firstSample = iBlock * pJob->samplesPerBlock;
+        drwav_uint64 sampleCount = drwav_min(pJob->samplesPerBlock, pWav->totalSampleCount - firstSample);
+
+        drwav_int16* pDecoded = pJob->pScratch;
+        if (pJob->pOutS16 != NULL && sampleCount == pJob->samplesPerBlock) {
+            pDecoded = pJob->pOutS16 + firstSample;
+        }
+
+        drwav_uint64 samplesDecoded;
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+            samplesDecoded = drwav__decode_msadpcm_block(pWav, pJob->pData + blockOffset, blockSize, pDecoded);
+        } else {
+            samplesDecoded = drwav__decode_ima_block(pWav, pJob->pData + blockOffset, blockSize, pDecoded);
         }
 
-        // If there's nothing left in the cache, just go ahead and load more. If there's nothing left to load in the current block we just continue to the next
-        // loop iteration which will trigger the loading of a new block.
-        if (pWav->ima.cachedSampleCount == 0) {
-            if (pWav->ima.bytesRemainingInBlock == 0) {
-                continue;
-            } else {
-                static drwav_int32 indexTable[16] = {
-                    -1, -1, -1, -1, 2, 4, 6, 8,
-                    -1, -1, -1, -1, 2, 4, 6, 8
-                };
-
-                static drwav_int32 stepTable[89] = { 
-                    7,     8,     9,     10,    11,    12,    13,    14,    16,    17, 
-                    19,    21,    23,    25,    28,    31,    34,    37,    41,    45, 
-                    50,    55,    60,    66,    73,    80,    88,    97,    107,   118, 
-                    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
-                    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
-                    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066, 
-                    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
-                    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899, 
-                    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767 
-                };
+        if (samplesDecoded < sampleCount) {
+            return; // Truncated or corrupt block.
+        }
 
-                // From what I can tell with stereo streams, it looks like every 4 bytes (8 samples) is for one channel. So it goes 4 bytes for the
-                // left channel, 4 bytes for the right channel.
-                pWav->ima.cachedSampleCount = 8 * pWav->channels;
-                for (drwav_uint32 iChannel = 0; iChannel < pWav->channels; ++iChannel) {
-                    drwav_uint8 nibbles[4];
-                    if (pWav->onRead(pWav->pUserData, &nibbles, 4) != 4) {
-                        return totalSamplesRead;
-                    }
-                    pWav->ima.bytesRemainingInBlock -= 4;
+        if (pDecoded == pJob->pScratch) {
+            if (pJob->pOutS16 != NULL) {
+                drwav_copy_memory(pJob->pOutS16 + firstSample, pJob->pScratch, (size_t)sampleCount * sizeof(drwav_int16));
+            } else if (pJob->pOutF32 != NULL) {
+                drwav_s16_to_f32(pJob->pOutF32 + firstSample, pJob->pScratch, (size_t)sampleCount);
+            } else {
+                drwav_s16_to_s32(pJob->pOutS32 + firstSample, pJob->pScratch, (size_t)sampleCount);
+            }
+        }
+    }
 
-                    for (drwav_uint32 iByte = 0; iByte < 4; ++iByte) {
-                        drwav_uint8 nibble0 = ((nibbles[iByte] & 0x0F) >> 0);
-                        drwav_uint8 nibble1 = ((nibbles[iByte] & 0xF0) >> 4);
+    pJob->result = DRWAV_TRUE;
+}
 
-                        drwav_int32 step      = stepTable[pWav->ima.stepIndex[iChannel]];
-                        drwav_int32 predictor = pWav->ima.predictor[iChannel];
+#ifndef DR_WAV_NO_THREADS
+#if defined(_WIN32)
+static DWORD WINAPI drwav__job_thread(LPVOID pUserData)
+{
+    (*(drwav__job_proc*)pUserData)(pUserData);
+    return 0;
+}
 
-                        drwav_int32      diff  = step >> 3;
-                        if (nibble0 & 1) diff += step >> 2;
-                        if (nibble0 & 2) diff += step >> 1;
-                        if (nibble0 & 4) diff += step;
-                        if (nibble0 & 8) diff  = -diff;
+static drwav_bool32 drwav__thread_create(drwav__thread* pThread, void* pJob)
+{
+    *pThread = CreateThread(NULL, 0, drwav__job_thread, pJob, 0, NULL);
+    return *pThread != NULL;
+}
 
-                        predictor = drwav_clamp(predictor + diff, -32768, 32767);
-                        pWav->ima.predictor[iChannel] = predictor;
-                        pWav->ima.stepIndex[iChannel] = drwav_clamp(pWav->ima.stepIndex[iChannel] + indexTable[nibble0], 0, (drwav_int32)drwav_countof(stepTable)-1);
-                        pWav->ima.cachedSamples[(drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount) + (iByte*2+0)*pWav->channels + iChannel] = predictor;
+static void drwav__thread_wait(drwav__thread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
 
+static unsigned int drwav__get_processor_count()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (unsigned int)info.dwNumberOfProcessors;
+}
+#else
+static void* drwav__job_thread(void* pUserData)
+{
+    (*(drwav__job_proc*)pUserData)(pUserData);
+    return NULL;
+}
 
-                        step      = stepTable[pWav->ima.stepIndex[iChannel]];
-                        predictor = pWav->ima.predictor[iChannel];
+static drwav_bool32 drwav__thread_create(drwav__thread* pThread, void* pJob)
+{
+    return pthread_create(pThread, NULL, drwav__job_thread, pJob) == 0;
+}
 
-                                         diff  = step >> 3;
-                        if (nibble1 & 1) diff += step >> 2;
-                        if (nibble1 & 2) diff += step >> 1;
-                        if (nibble1 & 4) diff += step;
-                        if (nibble1 & 8) diff  = -diff;
+static void drwav__thread_wait(drwav__thread thread)
+{
+    pthread_join(thread, NULL);
+}
 
-                        predictor = drwav_clamp(predictor + diff, -32768, 32767);
-                        pWav->ima.predictor[iChannel] = predictor;
-                        pWav->ima.stepIndex[iChannel] = drwav_clamp(pWav->ima.stepIndex[iChannel] + indexTable[nibble1], 0, (drwav_int32)drwav_countof(stepTable)-1);
-                        pWav->ima.cachedSamples[(drwav_countof(pWav->ima.cachedSamples) - pWav->ima.cachedSampleCount) + (iByte*2+1)*pWav->channels + iChannel] = predictor;
-                    }
-                }
-            }
-        }
+static unsigned int drwav__get_processor_count()
+{
+#if defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count > 0) {
+        return (unsigned int)count;
     }
+#endif
+    return 1;
+}
+#endif
+#endif  //DR_WAV_NO_THREADS
 
-    return totalSamplesRead;
+// Resolves the number of threads to use for <jobLimit> independent pieces of work. A <threadCount> of 0 means one thread per processor.
+static unsigned int drwav__get_job_count(unsigned int threadCount, drwav_uint64 jobLimit)
+{
+#ifdef DR_WAV_NO_THREADS
+    (void)threadCount;
+    (void)jobLimit;
+    return 1;
+#else
+    if (threadCount == 0) {
+        threadCount = drwav__get_processor_count();
+    }
+    if (threadCount > jobLimit) {
+        threadCount = (unsigned int)jobLimit;
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    return threadCount;
+#endif
 }
 
-drwav_uint64 drwav_read_s16__ieee(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+// Runs each of the <jobCount> jobs in <pJobs>, which are <jobSize> bytes apart, on its own thread. The first job is run on the calling
+// thread, as is any job whose thread fails to start.
+static void drwav__run_jobs(void* pJobs, size_t jobSize, unsigned int jobCount)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+#ifndef DR_WAV_NO_THREADS
+    drwav__thread* pThreads = NULL;
+    drwav_bool32* pThreadStarted = NULL;
+    if (jobCount > 1) {
+        pThreads = (drwav__thread*)DRWAV_MALLOC((jobCount - 1) * sizeof(*pThreads));
+        pThreadStarted = (drwav_bool32*)DRWAV_MALLOC((jobCount - 1) * sizeof(*pThreadStarted));
+        if (pThreads == NULL || pThreadStarted == NULL) {
+            DRWAV_FREE(pThreads);
+            DRWAV_FREE(pThreadStarted);
+            pThreads = NULL;
+            pThreadStarted = NULL;
+        } else {
+            for (unsigned int iThread = 0; iThread < jobCount - 1; ++iThread) {
+                pThreadStarted[iThread] = drwav__thread_create(&pThreads[iThread], (drwav_uint8*)pJobs + ((iThread + 1) * jobSize));
+            }
         }
+    }
+#endif
 
-        drwav__ieee_to_s16(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
+    (*(drwav__job_proc*)pJobs)(pJobs);
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+    for (unsigned int iJob = 1; iJob < jobCount; ++iJob) {
+        void* pJob = (drwav_uint8*)pJobs + (iJob * jobSize);
+#ifndef DR_WAV_NO_THREADS
+        if (pThreads != NULL && pThreadStarted[iJob - 1]) {
+            drwav__thread_wait(pThreads[iJob - 1]);
+            continue;
+        }
+#endif
+        (*(drwav__job_proc*)pJob)(pJob);
     }
 
-    return totalSamplesRead;
+#ifndef DR_WAV_NO_THREADS
+    DRWAV_FREE(pThreads);
+    DRWAV_FREE(pThreadStarted);
+#endif
 }
 
-drwav_uint64 drwav_read_s16__alaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+static drwav_bool32 drwav__can_decode_parallel(drwav* pWav)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
-        }
-
-        drwav_alaw_to_s16(pBufferOut, sampleData, (size_t)samplesRead);
+    // The blocks are read straight out of memory so this only works for memory and memory mapped streams.
+    if (pWav->onRead != drwav__on_read_memory || pWav->dataChunkDataPos > pWav->memoryStream.dataSize) {
+        return DRWAV_FALSE;
+    }
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+    if (!drwav__is_compressed_format_tag(pWav->translatedFormatTag) || (pWav->channels != 1 && pWav->channels != 2)) {
+        return DRWAV_FALSE;
     }
 
-    return totalSamplesRead;
+    return pWav->totalSampleCount > 0 && drwav__get_compressed_samples_per_block(pWav) > 0;
 }
 
-drwav_uint64 drwav_read_s16__mulaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+static drwav_bool32 drwav__decode_parallel(drwav* pWav, unsigned int threadCount, drwav_int16* pOutS16, float* pOutF32, drwav_int32* pOutS32)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
-        }
+    drwav_assert(drwav__can_decode_parallel(pWav));
 
-        drwav_mulaw_to_s16(pBufferOut, sampleData, (size_t)samplesRead);
+    drwav_uint64 samplesPerBlock = drwav__get_compressed_samples_per_block(pWav);
+    drwav_uint64 blockCount = (pWav->totalSampleCount + samplesPerBlock - 1) / samplesPerBlock;
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+    threadCount = drwav__get_job_count(threadCount, blockCount);
+
+    drwav__parallel_job* pJobs = (drwav__parallel_job*)DRWAV_MALLOC(threadCount * sizeof(*pJobs));
+    drwav_int16* pScratch = (drwav_int16*)DRWAV_MALLOC((size_t)(threadCount * samplesPerBlock * sizeof(drwav_int16)));
+    if (pJobs == NULL || pScratch == NULL) {
+        DRWAV_FREE(pJobs);
+        DRWAV_FREE(pScratch);
+        return DRWAV_FALSE;
     }
 
-    return totalSamplesRead;
+    // Blocks are divided evenly with the remainder going to the first few jobs.
+    drwav_uint64 firstBlock = 0;
+    for (unsigned int iJob = 0; iJob < threadCount; ++iJob) {
+        drwav__parallel_job* pJob = &pJobs[iJob];
+        pJob->onRun           = drwav__run_parallel_job;
+        pJob->pWav            = pWav;
+        pJob->pData           = (const drwav_uint8*)pWav->memoryStream.data + pWav->dataChunkDataPos;
+        pJob->dataSize        = drwav_min(pWav->dataChunkDataSize, pWav->memoryStream.dataSize - pWav->dataChunkDataPos);
+        pJob->samplesPerBlock = samplesPerBlock;
+        pJob->firstBlock      = firstBlock;
+        pJob->blockCount      = (blockCount / threadCount) + ((iJob < (blockCount % threadCount)) ? 1 : 0);
+        pJob->pScratch        = pScratch + (iJob * samplesPerBlock);
+        pJob->pOutS16         = pOutS16;
+        pJob->pOutF32         = pOutF32;
+        pJob->pOutS32         = pOutS32;
+        pJob->result          = DRWAV_FALSE;
+
+        firstBlock += pJob->blockCount;
+    }
+
+    drwav__run_jobs(pJobs, sizeof(*pJobs), threadCount);
+
+    drwav_bool32 result = DRWAV_TRUE;
+    for (unsigned int iJob = 0; iJob < threadCount; ++iJob) {
+        if (!pJobs[iJob].result) {
+            result = DRWAV_FALSE;
+        }
+    }
+
+    DRWAV_FREE(pJobs);
+    DRWAV_FREE(pScratch);
+    return result;
 }
 
-drwav_uint64 drwav_read_s16(drwav* pWav, drwav_uint64 samplesToRead, drwav_int16* pBufferOut)
+static drwav_int16* drwav__read_and_close_s16_parallel(drwav* pWav, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
-        return 0;
+    drwav_assert(pWav != NULL);
+
+    if (!drwav__can_decode_parallel(pWav)) {
+        return drwav__read_and_close_s16(pWav, channels, sampleRate, totalSampleCount);
     }
 
-    // Don't try to read more samples than can potentially fit in the output buffer.
-    if (samplesToRead * sizeof(drwav_int16) > SIZE_MAX) {
-        samplesToRead = SIZE_MAX / sizeof(drwav_int16);
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int16);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
-        return drwav_read_s16__pcm(pWav, samplesToRead, pBufferOut);
+    drwav_int16* pSampleData = (drwav_int16*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-        return drwav_read_s16__msadpcm(pWav, samplesToRead, pBufferOut);
+    if (!drwav__decode_parallel(pWav, threadCount, pSampleData, NULL, NULL)) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error decoding the samples.
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
-        return drwav_read_s16__ieee(pWav, samplesToRead, pBufferOut);
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
+}
+
+static float* drwav__read_and_close_f32_parallel(drwav* pWav, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    if (!drwav__can_decode_parallel(pWav)) {
+        return drwav__read_and_close_f32(pWav, channels, sampleRate, totalSampleCount);
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
-        return drwav_read_s16__alaw(pWav, samplesToRead, pBufferOut);
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(float);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
-        return drwav_read_s16__mulaw(pWav, samplesToRead, pBufferOut);
+    float* pSampleData = (float*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
-        return drwav_read_s16__ima(pWav, samplesToRead, pBufferOut);
+    if (!drwav__decode_parallel(pWav, threadCount, NULL, pSampleData, NULL)) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error decoding the samples.
     }
 
-    return 0;
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
 }
 
-void drwav_u8_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+static drwav_int32* drwav__read_and_close_s32_parallel(drwav* pWav, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    int r;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        int x = pIn[i];
-        r = x - 128;
-        r = r << 8;
-        pOut[i] = (short)r;
+    drwav_assert(pWav != NULL);
+
+    if (!drwav__can_decode_parallel(pWav)) {
+        return drwav__read_and_close_s32(pWav, channels, sampleRate, totalSampleCount);
+    }
+
+    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int32);
+    if (sampleDataSize > SIZE_MAX) {
+        drwav_uninit(pWav);
+        return NULL;    // File's too big.
+    }
+
+    drwav_int32* pSampleData = (drwav_int32*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
+    if (pSampleData == NULL) {
+        drwav_uninit(pWav);
+        return NULL;    // Failed to allocate memory.
+    }
+
+    if (!drwav__decode_parallel(pWav, threadCount, NULL, NULL, pSampleData)) {
+        DRWAV_FREE(pSampleData);
+        drwav_uninit(pWav);
+        return NULL;    // There was an error decoding the samples.
     }
+
+    drwav_uninit(pWav);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+    return pSampleData;
 }
 
-void drwav_s24_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+drwav_int16* drwav_open_and_read_memory_s16_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    int r;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        int x = ((int)(((unsigned int)(((unsigned char*)pIn)[i*3+0]) << 8) | ((unsigned int)(((unsigned char*)pIn)[i*3+1]) << 16) | ((unsigned int)(((unsigned char*)pIn)[i*3+2])) << 24)) >> 8;
-        r = x >> 8;
-        pOut[i] = (short)r;
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
     }
+
+    return drwav__read_and_close_s16_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_s32_to_s16(drwav_int16* pOut, const drwav_int32* pIn, size_t sampleCount)
+float* drwav_open_and_read_memory_f32_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    int r;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        int x = pIn[i];
-        r = x >> 16;
-        pOut[i] = (short)r;
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
     }
+
+    return drwav__read_and_close_f32_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_f32_to_s16(drwav_int16* pOut, const float* pIn, size_t sampleCount)
+drwav_int32* drwav_open_and_read_memory_s32_parallel(const void* data, size_t dataSize, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    int r;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        float x = pIn[i];
-        float c;
-        int s;
-        c = ((x < -1) ? -1 : ((x > 1) ? 1 : x));
-        s = ((*((int*)&x)) & 0x80000000) >> 31;
-        s = s + 32767;
-        r = (int)(c * s);
-        pOut[i] = (short)r;
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return NULL;
     }
+
+    return drwav__read_and_close_s32_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_f64_to_s16(drwav_int16* pOut, const double* pIn, size_t sampleCount)
+#ifndef DR_WAV_NO_STDIO
+drwav_int16* drwav_open_and_read_file_s16_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    int r;
-    for (size_t i = 0; i < sampleCount; ++i) {
-        double x = pIn[i];
-        double c;
-        int s;
-        c = ((x < -1) ? -1 : ((x > 1) ? 1 : x));
-        s = (int)(((*((drwav_uint64*)&x)) & (drwav_uint64)0x8000000000000000) >> 63);
-        s = s + 32767;
-        r = (int)(c * s);
-        pOut[i] = (short)r;
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file_mmap(&wav, filename)) {
+        if (!drwav_init_file(&wav, filename)) {
+            return NULL;
+        }
     }
+
+    return drwav__read_and_close_s16_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_alaw_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+float* drwav_open_and_read_file_f32_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    for (size_t i = 0; i < sampleCount; ++i) {
-        pOut[i] = drwav__alaw_to_s16(pIn[i]);
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file_mmap(&wav, filename)) {
+        if (!drwav_init_file(&wav, filename)) {
+            return NULL;
+        }
     }
+
+    return drwav__read_and_close_f32_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_mulaw_to_s16(drwav_int16* pOut, const drwav_uint8* pIn, size_t sampleCount)
+drwav_int32* drwav_open_and_read_file_s32_parallel(const char* filename, unsigned int threadCount, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    for (size_t i = 0; i < sampleCount; ++i) {
-        pOut[i] = drwav__mulaw_to_s16(pIn[i]);
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init_file_mmap(&wav, filename)) {
+        if (!drwav_init_file(&wav, filename)) {
+            return NULL;
+        }
     }
+
+    return drwav__read_and_close_s32_parallel(&wav, threadCount, channels, sampleRate, totalSampleCount);
 }
+#endif
 
 
+//// ADPCM Encoding ////
 
-static void drwav__pcm_to_f32(float* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+// The number of blocks each job encodes per call to the write callback. Larger batches make better use of the threads but need
+// a bigger output buffer.
+#define DRWAV_ADPCM_BLOCKS_PER_JOB  64
+
+static DRWAV_INLINE drwav_uint8 drwav__ima_encode_nibble(drwav_int32 sample, drwav_int32* pPredictor, drwav_int32* pStepIndex)
 {
-    // Special case for 8-bit sample data because it's treated as unsigned.
-    if (bytesPerSample == 1) {
-        drwav_u8_to_f32(pOut, pIn, sampleCount);
-        return;
-    }
+    // The decoder adds an eighth of a step to the sum of the set bits, so truncating here gives the nearest of its outputs.
+    drwav_int32 step = g_drwavIMAStepTable[*pStepIndex];
+    drwav_int32 diff = sample - *pPredictor;
 
-    // Slightly more optimal implementation for common formats.
-    if (bytesPerSample == 2) {
-        drwav_s16_to_f32(pOut, (const drwav_int16*)pIn, sampleCount);
-        return;
+    drwav_uint8 nibble = 0;
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
     }
-    if (bytesPerSample == 3) {
-        drwav_s24_to_f32(pOut, pIn, sampleCount);
-        return;
+    if (diff >= step) {
+        nibble |= 4;
+        diff -= step;
     }
-    if (bytesPerSample == 4) {
-        drwav_s32_to_f32(pOut, (const drwav_int32*)pIn, sampleCount);
-        return;
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 1;
     }
 
-    // Generic, slow converter.
-    for (unsigned int i = 0; i < sampleCount; ++i) {
-        unsigned int sample = 0;
-        unsigned int shift  = (8 - bytesPerSample) * 8;
-        for (unsigned short j = 0; j < bytesPerSample && j < 4; ++j) {
-            sample |= (unsigned int)(pIn[j]) << shift;
-            shift  += 8;
+    // The predictor and step index are moved on exactly as the decoder will move them so the two never drift apart.
+    drwav__ima_decode_nibble(nibble, pPredictor, pStepIndex);
+    return nibble;
+}
+
+// Encodes one whole block of interleaved samples. Blocks are independent of each other so the step index to start with is
+// guessed from the first few samples rather than carried over from the previous block.
+static void drwav__encode_ima_block(drwav* pWav, const drwav_int16* pSamples, drwav_uint8* pBlockOut)
+{
+    drwav_uint32 channels = pWav->channels;
+    size_t framesPerBlock = (size_t)(drwav__get_compressed_samples_per_block(pWav) / channels);
+
+    drwav_zero_memory(pBlockOut, pWav->fmt.blockAlign);
+
+    for (drwav_uint32 iChannel = 0; iChannel < channels; ++iChannel) {
+        drwav_int32 sumOfDiffs = 0;
+        size_t diffCount = drwav_min(framesPerBlock - 1, 8);
+        for (size_t iFrame = 1; iFrame <= diffCount; ++iFrame) {
+            drwav_int32 diff = pSamples[iFrame*channels + iChannel] - pSamples[(iFrame-1)*channels + iChannel];
+            sumOfDiffs += (diff < 0) ? -diff : diff;
         }
 
-        pIn += bytesPerSample;
-        *pOut++ = (float)((int)sample / 2147483648.0);
+        drwav_int32 averageDiff = (diffCount > 0) ? (sumOfDiffs / (drwav_int32)diffCount) : 0;
+        drwav_int32 stepIndex = 0;
+        while (stepIndex < (drwav_int32)drwav_countof(g_drwavIMAStepTable)-1 && g_drwavIMAStepTable[stepIndex] < averageDiff) {
+            stepIndex += 1;
+        }
+
+        drwav_int32 predictor = pSamples[iChannel];
+        drwav__u16_to_bytes(pBlockOut + iChannel*4, (drwav_uint16)predictor);
+        pBlockOut[iChannel*4 + 2] = (drwav_uint8)stepIndex;
+
+        // Samples are stored in groups of 8 per channel, 4 bytes each, low nibble first.
+        drwav_uint8* pGroups = pBlockOut + 4*channels + iChannel*4;
+        for (size_t iFrame = 1; iFrame < framesPerBlock; ++iFrame) {
+            size_t iSample = iFrame - 1;
+            drwav_uint8 nibble = drwav__ima_encode_nibble(pSamples[iFrame*channels + iChannel], &predictor, &stepIndex);
+            pGroups[(iSample / 8)*4*channels + (iSample % 8)/2] |= (drwav_uint8)(nibble << ((iSample & 1) * 4));
+        }
     }
 }
 
-static void drwav__ieee_to_f32(float* pOut, const unsigned char* pIn, size_t sampleCount, unsigned short bytesPerSample)
+static DRWAV_INLINE drwav_uint8 drwav__msadpcm_encode_nibble(drwav_int32 sample, drwav_int32 coeff1, drwav_int32 coeff2, drwav_int32* pDelta, drwav_int32* pPrevSamples)
 {
-    if (bytesPerSample == 4) {
-        for (unsigned int i = 0; i < sampleCount; ++i) {
-            *pOut++ = ((float*)pIn)[i];
+    drwav_int32 predicted = ((pPrevSamples[1] * coeff1) + (pPrevSamples[0] * coeff2)) >> 8;
+    drwav_int32 error = sample - predicted;
+
+    // The error is rounded to the nearest multiple of delta.
+    drwav_int32 halfDelta = *pDelta / 2;
+    drwav_int32 quantized = (error >= 0) ? ((error + halfDelta) / *pDelta) : -((-error + halfDelta) / *pDelta);
+    drwav_uint8 nibble = (drwav_uint8)(drwav_clamp(quantized, -8, 7) & 0x0F);
+
+    drwav__msadpcm_decode_nibble(nibble, coeff1, coeff2, pDelta, pPrevSamples);
+    return nibble;
+}
+
+// Encodes one channel of a Microsoft ADPCM block with the given predictor, filling in its part of the header and, if <pNibblesOut>
+// is not NULL, its nibbles. Returns the sum of the squared differences between the input and what the decoder will output.
+static drwav_uint64 drwav__encode_msadpcm_channel(drwav* pWav, const drwav_int16* pSamples, drwav_uint32 iChannel, drwav_uint8 predictor, drwav_uint8* pBlockOut)
+{
+    drwav_uint32 channels = pWav->channels;
+    size_t framesPerBlock = (size_t)(drwav__get_compressed_samples_per_block(pWav) / channels);
+    drwav_int32 coeff1 = g_drwavMSADPCMCoeff1Table[predictor];
+    drwav_int32 coeff2 = g_drwavMSADPCMCoeff2Table[predictor];
+
+    // The first two samples are stored as they are. The starting delta is about a quarter of the prediction error over the first
+    // few samples, which is roughly where the decoder's adaptation settles.
+    drwav_int32 prevSamples[2];
+    prevSamples[0] = pSamples[0*channels + iChannel];
+    prevSamples[1] = pSamples[1*channels + iChannel];
+
+    drwav_int64 sumOfErrors = 0;
+    size_t errorCount = drwav_min(framesPerBlock - 2, 16);
+    for (size_t iFrame = 2; iFrame < 2 + errorCount; ++iFrame) {
+        drwav_int32 predicted = ((pSamples[(iFrame-1)*channels + iChannel] * coeff1) + (pSamples[(iFrame-2)*channels + iChannel] * coeff2)) >> 8;
+        drwav_int32 error = pSamples[iFrame*channels + iChannel] - predicted;
+        sumOfErrors += (error < 0) ? -error : error;
+    }
+
+    drwav_int32 delta = (errorCount > 0) ? (drwav_int32)(sumOfErrors / (drwav_int64)(errorCount * 4)) : 0;
+    delta = drwav_clamp(delta, 16, 0x7FFF);
+
+    if (pBlockOut != NULL) {
+        pBlockOut[iChannel] = predictor;
+        drwav__u16_to_bytes(pBlockOut + 1*channels + iChannel*2, (drwav_uint16)delta);
+        drwav__u16_to_bytes(pBlockOut + 3*channels + iChannel*2, (drwav_uint16)prevSamples[1]);
+        drwav__u16_to_bytes(pBlockOut + 5*channels + iChannel*2, (drwav_uint16)prevSamples[0]);
+    }
+
+    // Each byte holds two samples, high nibble first, in the same interleaved order as the input.
+    drwav_uint8* pNibbles = (pBlockOut != NULL) ? pBlockOut + 7*channels : NULL;
+    drwav_uint64 squaredError = 0;
+    for (size_t iFrame = 2; iFrame < framesPerBlock; ++iFrame) {
+        drwav_int32 sample = pSamples[iFrame*channels + iChannel];
+        drwav_uint8 nibble = drwav__msadpcm_encode_nibble(sample, coeff1, coeff2, &delta, prevSamples);
+
+        drwav_int64 error = sample - prevSamples[1];
+        squaredError += (drwav_uint64)(error * error);
+
+        if (pNibbles != NULL) {
+            size_t iNibble = (iFrame - 2)*channels + iChannel;
+            pNibbles[iNibble / 2] |= (drwav_uint8)(nibble << (((iNibble & 1) ^ 1) * 4));
         }
-        return;
-    } else {
-        drwav_f64_to_f32(pOut, (double*)pIn, sampleCount);
-        return;
     }
-}
 
+    return squaredError;
+}
 
-drwav_uint64 drwav_read_f32__pcm(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+// Picks the predictor for one channel of a Microsoft ADPCM block by how well each one predicts the input samples. This ignores the
+// quantization error the encoder feeds back into the prediction, which is what an exhaustive search accounts for.
+static drwav_uint8 drwav__guess_msadpcm_predictor(drwav* pWav, const drwav_int16* pSamples, drwav_uint32 iChannel)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+    drwav_uint32 channels = pWav->channels;
+    size_t framesPerBlock = (size_t)(drwav__get_compressed_samples_per_block(pWav) / channels);
+
+    drwav_uint8 bestPredictor = 0;
+    drwav_uint64 bestError = ~(drwav_uint64)0;
+    for (drwav_uint8 predictor = 0; predictor < drwav_countof(g_drwavMSADPCMCoeff1Table); ++predictor) {
+        drwav_int32 coeff1 = g_drwavMSADPCMCoeff1Table[predictor];
+        drwav_int32 coeff2 = g_drwavMSADPCMCoeff2Table[predictor];
+
+        drwav_uint64 squaredError = 0;
+        for (size_t iFrame = 2; iFrame < framesPerBlock; ++iFrame) {
+            drwav_int64 predicted = ((pSamples[(iFrame-1)*channels + iChannel] * coeff1) + (pSamples[(iFrame-2)*channels + iChannel] * coeff2)) >> 8;
+            drwav_int64 error = pSamples[iFrame*channels + iChannel] - predicted;
+            squaredError += (drwav_uint64)(error * error);
         }
 
-        drwav__pcm_to_f32(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
-        pBufferOut += samplesRead;
-
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+        if (squaredError < bestError) {
+            bestError = squaredError;
+            bestPredictor = predictor;
+        }
     }
 
-    return totalSamplesRead;
+    return bestPredictor;
 }
 
-drwav_uint64 drwav_read_f32__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+// Encodes one whole block of interleaved samples.
+static void drwav__encode_msadpcm_block(drwav* pWav, const drwav_int16* pSamples, drwav_uint8* pBlockOut)
 {
-    // We're just going to borrow the implementation from the drwav_read_s16() since ADPCM is a little bit more complicated than other formats and I don't
-    // want to duplicate that code.
-    drwav_uint64 totalSamplesRead = 0;
-    drwav_int16 samples16[2048];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read_s16(pWav, drwav_min(samplesToRead, 2048), samples16);
-        if (samplesRead == 0) {
-            break;
+    drwav_zero_memory(pBlockOut, pWav->fmt.blockAlign);
+
+    for (drwav_uint32 iChannel = 0; iChannel < pWav->channels; ++iChannel) {
+        drwav_uint8 predictor;
+        if (pWav->adpcmEncoder.exhaustiveSearch) {
+            predictor = 0;
+            drwav_uint64 bestError = ~(drwav_uint64)0;
+            for (drwav_uint8 candidate = 0; candidate < drwav_countof(g_drwavMSADPCMCoeff1Table); ++candidate) {
+                drwav_uint64 squaredError = drwav__encode_msadpcm_channel(pWav, pSamples, iChannel, candidate, NULL);
+                if (squaredError < bestError) {
+                    bestError = squaredError;
+                    predictor = candidate;
+                }
+            }
+        } else {
+            predictor = drwav__guess_msadpcm_predictor(pWav, pSamples, iChannel);
         }
 
-        drwav_s16_to_f32(pBufferOut, samples16, (size_t)samplesRead);   // <-- Safe cast because we're clamping to 2048.
-
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+        drwav__encode_msadpcm_channel(pWav, pSamples, iChannel, predictor, pBlockOut);
     }
-
-    return totalSamplesRead;
 }
 
-drwav_uint64 drwav_read_f32__ima(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+typedef struct
 {
-    // We're just going to borrow the implementation from the drwav_read_s16() since IMA-ADPCM is a little bit more complicated than other formats and I don't
-    // want to duplicate that code.
-    drwav_uint64 totalSamplesRead = 0;
-    drwav_int16 samples16[2048];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read_s16(pWav, drwav_min(samplesToRead, 2048), samples16);
-        if (samplesRead == 0) {
-            break;
-        }
+    drwav__job_proc onRun;
+    drwav* pWav;
+    const drwav_int16* pSamples;    // The first sample of the first block of this job.
+    drwav_uint8* pBlocksOut;
+    drwav_uint64 blockCount;
+} drwav__encode_job;
+
+static void drwav__run_encode_job(void* pUserData)
+{
+    drwav__encode_job* pJob = (drwav__encode_job*)pUserData;
+    drwav* pWav = pJob->pWav;
+    size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
 
-        drwav_s16_to_f32(pBufferOut, samples16, (size_t)samplesRead);   // <-- Safe cast because we're clamping to 2048.
+    for (drwav_uint64 iBlock = 0; iBlock < pJob->blockCount; ++iBlock) {
+        const drwav_int16* pSamples = pJob->pSamples + (iBlock * samplesPerBlock);
+        drwav_uint8* pBlockOut = pJob->pBlocksOut + (iBlock * pWav->fmt.blockAlign);
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+        if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
+            drwav__encode_msadpcm_block(pWav, pSamples, pBlockOut);
+        } else {
+            drwav__encode_ima_block(pWav, pSamples, pBlockOut);
+        }
     }
-
-    return totalSamplesRead;
 }
 
-drwav_uint64 drwav_read_f32__ieee(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+// Encodes and writes <blockCount> whole blocks. Returns the number of blocks that were written.
+static drwav_uint64 drwav__encode_adpcm_blocks(drwav* pWav, const drwav_int16* pSamples, drwav_uint64 blockCount)
 {
-    // Fast path.
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT && pWav->bytesPerSample == 4) {
-        return drwav_read(pWav, samplesToRead, pBufferOut);
+    size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
+    unsigned int jobCount = drwav__get_job_count(pWav->adpcmEncoder.threadCount, blockCount);
+    drwav_uint64 blocksPerBatch = drwav_min(blockCount, (drwav_uint64)jobCount * DRWAV_ADPCM_BLOCKS_PER_JOB);
+
+    drwav__encode_job* pJobs = (drwav__encode_job*)DRWAV_MALLOC(jobCount * sizeof(*pJobs));
+    drwav_uint8* pBlocks = (drwav_uint8*)DRWAV_MALLOC((size_t)blocksPerBatch * pWav->fmt.blockAlign);
+    if (pJobs == NULL || pBlocks == NULL) {
+        DRWAV_FREE(pJobs);
+        DRWAV_FREE(pBlocks);
+        return 0;
     }
 
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
-        }
+    drwav_uint64 blocksWritten = 0;
+    while (blocksWritten < blockCount) {
+        drwav_uint64 batchSize = drwav_min(blockCount - blocksWritten, blocksPerBatch);
+        unsigned int batchJobCount = (unsigned int)drwav_min(jobCount, batchSize);
 
-        drwav__ieee_to_f32(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
+        // Blocks are divided evenly with the remainder going to the first few jobs.
+        drwav_uint64 firstBlock = 0;
+        for (unsigned int iJob = 0; iJob < batchJobCount; ++iJob) {
+            drwav__encode_job* pJob = &pJobs[iJob];
+            pJob->onRun      = drwav__run_encode_job;
+            pJob->pWav       = pWav;
+            pJob->pSamples   = pSamples + ((blocksWritten + firstBlock) * samplesPerBlock);
+            pJob->pBlocksOut = pBlocks + (firstBlock * pWav->fmt.blockAlign);
+            pJob->blockCount = (batchSize / batchJobCount) + ((iJob < (batchSize % batchJobCount)) ? 1 : 0);
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
-    }
+            firstBlock += pJob->blockCount;
+        }
 
-    return totalSamplesRead;
-}
+        drwav__run_jobs(pJobs, sizeof(*pJobs), batchJobCount);
 
-drwav_uint64 drwav_read_f32__alaw(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
-{
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
+        size_t bytesToWrite = (size_t)batchSize * pWav->fmt.blockAlign;
+        size_t bytesWritten = pWav->onWrite(pWav->pUserData, pBlocks, bytesToWrite);
+        pWav->dataChunkDataSize += bytesWritten;
+        blocksWritten += bytesWritten / pWav->fmt.blockAlign;
+
+        if (bytesWritten != bytesToWrite) {
             break;
         }
+    }
 
-        drwav_alaw_to_f32(pBufferOut, sampleData, (size_t)samplesRead);
+    DRWAV_FREE(pJobs);
+    DRWAV_FREE(pBlocks);
+    return blocksWritten;
+}
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+// Drops the first <sampleCount> pending samples after they have been written.
+static void drwav__remove_pending_adpcm_samples(drwav* pWav, size_t sampleCount)
+{
+    drwav_int16* pPendingSamples = pWav->adpcmEncoder.pPendingSamples;
+    size_t samplesRemaining = pWav->adpcmEncoder.pendingSampleCount - sampleCount;
+    for (size_t iSample = 0; iSample < samplesRemaining; ++iSample) {
+        pPendingSamples[iSample] = pPendingSamples[sampleCount + iSample];
     }
 
-    return totalSamplesRead;
+    pWav->adpcmEncoder.pendingSampleCount = (drwav_uint32)samplesRemaining;
 }
 
-drwav_uint64 drwav_read_f32__mulaw(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+// Changes the number of threads blocks are encoded on. With more than one thread the pending samples are collected into batches
+// of DRWAV_ADPCM_BLOCKS_PER_JOB blocks per thread, so the pending buffer is resized to hold a whole batch.
+static drwav_bool32 drwav__set_adpcm_thread_count(drwav* pWav, unsigned int threadCount)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+    unsigned int jobCount = drwav__get_job_count(threadCount, ~(drwav_uint64)0);
+    drwav_uint32 blockCapacity = (jobCount > 1) ? jobCount * DRWAV_ADPCM_BLOCKS_PER_JOB : 1;
+
+    if (blockCapacity != pWav->adpcmEncoder.pendingBlockCapacity) {
+        size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
+
+        // Whole blocks that are already waiting are written now so that what's left fits in a buffer of any size.
+        drwav_uint64 blockCount = pWav->adpcmEncoder.pendingSampleCount / samplesPerBlock;
+        if (blockCount > 0) {
+            drwav_uint64 blocksWritten = drwav__encode_adpcm_blocks(pWav, pWav->adpcmEncoder.pPendingSamples, blockCount);
+            drwav__remove_pending_adpcm_samples(pWav, (size_t)blocksWritten * samplesPerBlock);
+            if (blocksWritten != blockCount) {
+                return DRWAV_FALSE;
+            }
         }
 
-        drwav_mulaw_to_f32(pBufferOut, sampleData, (size_t)samplesRead);
+        drwav_int16* pPendingSamples = (drwav_int16*)DRWAV_REALLOC(pWav->adpcmEncoder.pPendingSamples, samplesPerBlock * blockCapacity * sizeof(drwav_int16));
+        if (pPendingSamples == NULL) {
+            return DRWAV_FALSE;
+        }
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+        pWav->adpcmEncoder.pPendingSamples = pPendingSamples;
+        pWav->adpcmEncoder.pendingBlockCapacity = blockCapacity;
     }
 
-    return totalSamplesRead;
+    pWav->adpcmEncoder.threadCount = threadCount;
+    return DRWAV_TRUE;
 }
 
-drwav_uint64 drwav_read_f32(drwav* pWav, drwav_uint64 samplesToRead, float* pBufferOut)
+static drwav_uint64 drwav__write_adpcm(drwav* pWav, drwav_uint64 samplesToWrite, const drwav_int16* pSamples)
 {
-    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
+    if (pWav->onWrite == NULL) {
         return 0;
     }
 
-    // Don't try to read more samples than can potentially fit in the output buffer.
-    if (samplesToRead * sizeof(float) > SIZE_MAX) {
-        samplesToRead = SIZE_MAX / sizeof(float);
-    }
+    size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
+    size_t samplesPerBatch = samplesPerBlock * pWav->adpcmEncoder.pendingBlockCapacity;
+    drwav_uint64 samplesWritten = 0;
+
+    // A batch that was started by an earlier call is finished off first.
+    if (pWav->adpcmEncoder.pendingSampleCount > 0) {
+        size_t samplesPendingBefore = pWav->adpcmEncoder.pendingSampleCount;
+        size_t samplesToCopy = (size_t)drwav_min(samplesPerBatch - samplesPendingBefore, samplesToWrite);
+        drwav_copy_memory(pWav->adpcmEncoder.pPendingSamples + samplesPendingBefore, pSamples, samplesToCopy * sizeof(drwav_int16));
+        pWav->adpcmEncoder.pendingSampleCount += (drwav_uint32)samplesToCopy;
+        samplesWritten += samplesToCopy;
+
+        if (pWav->adpcmEncoder.pendingSampleCount == samplesPerBatch) {
+            drwav_uint64 blockCount = pWav->adpcmEncoder.pendingBlockCapacity;
+            drwav_uint64 blocksWritten = drwav__encode_adpcm_blocks(pWav, pWav->adpcmEncoder.pPendingSamples, blockCount);
+            if (blocksWritten != blockCount) {
+                // Only the samples of this call that made it out count as written. Anything after them is handed back rather than
+                // held onto for the next call.
+                size_t samplesDone = (size_t)blocksWritten * samplesPerBlock;
+                pWav->adpcmEncoder.pendingSampleCount = (drwav_uint32)samplesPendingBefore;
+                if (samplesDone < samplesPendingBefore) {
+                    drwav__remove_pending_adpcm_samples(pWav, samplesDone);
+                    return 0;
+                }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
-        return drwav_read_f32__pcm(pWav, samplesToRead, pBufferOut);
+                pWav->adpcmEncoder.pendingSampleCount = 0;
+                pWav->totalSampleCount += samplesDone - samplesPendingBefore;
+                return samplesDone - samplesPendingBefore;
+            }
+            pWav->adpcmEncoder.pendingSampleCount = 0;
+        }
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-        return drwav_read_f32__msadpcm(pWav, samplesToRead, pBufferOut);
+    // Whole batches are encoded straight from the application's buffer.
+    drwav_uint64 blockCount = ((samplesToWrite - samplesWritten) / samplesPerBatch) * pWav->adpcmEncoder.pendingBlockCapacity;
+    if (blockCount > 0) {
+        drwav_uint64 blocksWritten = drwav__encode_adpcm_blocks(pWav, pSamples + samplesWritten, blockCount);
+        samplesWritten += blocksWritten * samplesPerBlock;
+        if (blocksWritten != blockCount) {
+            pWav->totalSampleCount += samplesWritten;
+            return samplesWritten;
+        }
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
-        return drwav_read_f32__ieee(pWav, samplesToRead, pBufferOut);
+    // Whatever is left over is kept for the next call.
+    size_t samplesRemaining = (size_t)(samplesToWrite - samplesWritten);
+    if (samplesRemaining > 0) {
+        drwav_assert(pWav->adpcmEncoder.pendingSampleCount == 0);
+        drwav_copy_memory(pWav->adpcmEncoder.pPendingSamples, pSamples + samplesWritten, samplesRemaining * sizeof(drwav_int16));
+        pWav->adpcmEncoder.pendingSampleCount = (drwav_uint32)samplesRemaining;
+        samplesWritten += samplesRemaining;
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
-        return drwav_read_f32__alaw(pWav, samplesToRead, pBufferOut);
+    pWav->totalSampleCount += samplesWritten;
+    return samplesWritten;
+}
+
+// Writes the pending samples, padding the last block with silence.
+static drwav_bool32 drwav__flush_adpcm(drwav* pWav)
+{
+    if (pWav->adpcmEncoder.pendingSampleCount == 0) {
+        return DRWAV_TRUE;
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
-        return drwav_read_f32__mulaw(pWav, samplesToRead, pBufferOut);
+    size_t samplesPerBlock = (size_t)drwav__get_compressed_samples_per_block(pWav);
+    size_t blockCount = (pWav->adpcmEncoder.pendingSampleCount + samplesPerBlock - 1) / samplesPerBlock;
+    drwav_zero_memory(pWav->adpcmEncoder.pPendingSamples + pWav->adpcmEncoder.pendingSampleCount, ((blockCount * samplesPerBlock) - pWav->adpcmEncoder.pendingSampleCount) * sizeof(drwav_int16));
+    pWav->adpcmEncoder.pendingSampleCount = 0;
+
+    return drwav__encode_adpcm_blocks(pWav, pWav->adpcmEncoder.pPendingSamples, blockCount) == blockCount;
+}
+
+
+static drwav_uint64 drwav__read_into_and_close_s16(drwav* pWav, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+
+    drwav_uint64 samplesRead = 0;
+    if (pBufferOut != NULL && pWav->totalSampleCount <= bufferSizeInSamples) {
+        samplesRead = drwav_read_s16(pWav, pWav->totalSampleCount, pBufferOut);
+        if (samplesRead != pWav->totalSampleCount) {
+            samplesRead = 0;    // There was an error reading the samples.
+        }
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
-        return drwav_read_f32__ima(pWav, samplesToRead, pBufferOut);
+    drwav_uninit(pWav);
+    return samplesRead;
+}
+
+static drwav_uint64 drwav__read_into_and_close_f32(drwav* pWav, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    drwav_assert(pWav != NULL);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+
+    drwav_uint64 samplesRead = 0;
+    if (pBufferOut != NULL && pWav->totalSampleCount <= bufferSizeInSamples) {
+        samplesRead = drwav_read_f32(pWav, pWav->totalSampleCount, pBufferOut);
+        if (samplesRead != pWav->totalSampleCount) {
+            samplesRead = 0;    // There was an error reading the samples.
+        }
     }
 
-    return 0;
+    drwav_uninit(pWav);
+    return samplesRead;
 }
 
-void drwav_u8_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+static drwav_uint64 drwav__read_into_and_close_s32(drwav* pWav, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    drwav_assert(pWav != NULL);
+
+    if (sampleRate) *sampleRate = pWav->sampleRate;
+    if (channels) *channels = pWav->channels;
+    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
+
+    drwav_uint64 samplesRead = 0;
+    if (pBufferOut != NULL && pWav->totalSampleCount <= bufferSizeInSamples) {
+        samplesRead = drwav_read_s32(pWav, pWav->totalSampleCount, pBufferOut);
+        if (samplesRead != pWav->totalSampleCount) {
+            samplesRead = 0;    // There was an error reading the samples.
+        }
     }
 
-#ifdef DR_WAV_LIBSNDFILE_COMPAT
-    // It appears libsndfile uses slightly different logic for the u8 -> f32 conversion to dr_wav, which in my opinion is incorrect. It appears
-    // libsndfile performs the conversion something like "f32 = (u8 / 256) * 2 - 1", however I think it should be "f32 = (u8 / 255) * 2 - 1" (note
-    // the divisor of 256 vs 255). I use libsndfile as a benchmark for testing, so I'm therefore leaving this block here just for my automated
-    // correctness testing. This is disabled by default.
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (pIn[i] / 256.0f) * 2 - 1;
+    drwav_uninit(pWav);
+    return samplesRead;
+}
+
+
+drwav_uint64 drwav_open_and_read_s16_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return 0;
     }
-#else
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (pIn[i] / 255.0f) * 2 - 1;
+
+    return drwav__read_into_and_close_s16(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
+}
+
+drwav_uint64 drwav_open_and_read_f32_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+{
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
+
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return 0;
     }
-#endif
+
+    return drwav__read_into_and_close_f32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_s16_to_f32(float* pOut, const drwav_int16* pIn, size_t sampleCount)
+drwav_uint64 drwav_open_and_read_s32_into(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = pIn[i] / 32768.0f;
+    drwav wav;
+    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
+        return 0;
     }
+
+    return drwav__read_into_and_close_s32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_s24_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+#ifndef DR_WAV_NO_STDIO
+drwav_uint64 drwav_open_and_read_file_s16_into(const char* filename, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
-
-    for (size_t i = 0; i < sampleCount; ++i) {
-        unsigned int s0 = pIn[i*3 + 0];
-        unsigned int s1 = pIn[i*3 + 1];
-        unsigned int s2 = pIn[i*3 + 2];
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-        int sample32 = (int)((s0 << 8) | (s1 << 16) | (s2 << 24));
-        *pOut++ = (float)(sample32 / 2147483648.0);
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return 0;
     }
+
+    return drwav__read_into_and_close_s16(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_s32_to_f32(float* pOut, const drwav_int32* pIn, size_t sampleCount)
+drwav_uint64 drwav_open_and_read_file_f32_into(const char* filename, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (float)(pIn[i] / 2147483648.0);
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return 0;
     }
+
+    return drwav__read_into_and_close_f32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_f64_to_f32(float* pOut, const double* pIn, size_t sampleCount)
+drwav_uint64 drwav_open_and_read_file_s32_into(const char* filename, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (float)pIn[i];
+    drwav wav;
+    if (!drwav_init_file(&wav, filename)) {
+        return 0;
     }
+
+    return drwav__read_into_and_close_s32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
+#endif
 
-void drwav_alaw_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+drwav_uint64 drwav_open_and_read_memory_s16_into(const void* data, size_t dataSize, drwav_int16* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = drwav__alaw_to_s16(pIn[i]) / 32768.0f;
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return 0;
     }
+
+    return drwav__read_into_and_close_s16(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-void drwav_mulaw_to_f32(float* pOut, const drwav_uint8* pIn, size_t sampleCount)
+drwav_uint64 drwav_open_and_read_memory_f32_into(const void* data, size_t dataSize, float* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = drwav__mulaw_to_s16(pIn[i]) / 32768.0f;
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return 0;
     }
-}
-
 
+    return drwav__read_into_and_close_f32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
+}
 
-static void drwav__pcm_to_s32(drwav_int32* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
+drwav_uint64 drwav_open_and_read_memory_s32_into(const void* data, size_t dataSize, drwav_int32* pBufferOut, drwav_uint64 bufferSizeInSamples, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
 {
-    // Special case for 8-bit sample data because it's treated as unsigned.
-    if (bytesPerSample == 1) {
-        drwav_u8_to_s32(pOut, pIn, totalSampleCount);
-        return;
-    }
+    if (sampleRate) *sampleRate = 0;
+    if (channels) *channels = 0;
+    if (totalSampleCount) *totalSampleCount = 0;
 
-    // Slightly more optimal implementation for common formats.
-    if (bytesPerSample == 2) {
-        drwav_s16_to_s32(pOut, (const drwav_int16*)pIn, totalSampleCount);
-        return;
-    }
-    if (bytesPerSample == 3) {
-        drwav_s24_to_s32(pOut, pIn, totalSampleCount);
-        return;
-    }
-    if (bytesPerSample == 4) {
-        for (unsigned int i = 0; i < totalSampleCount; ++i) {
-           *pOut++ = ((drwav_int32*)pIn)[i];
-        }
-        return;
+    drwav wav;
+    if (!drwav_init_memory(&wav, data, dataSize)) {
+        return 0;
     }
 
-    // Generic, slow converter.
-    for (unsigned int i = 0; i < totalSampleCount; ++i) {
-        unsigned int sample = 0;
-        unsigned int shift  = (8 - bytesPerSample) * 8;
-        for (unsigned short j = 0; j < bytesPerSample && j < 4; ++j) {
-            sample |= (unsigned int)(pIn[j]) << shift;
-            shift  += 8;
-        }
-
-        pIn += bytesPerSample;
-        *pOut++ = sample;
-    }
+    return drwav__read_into_and_close_s32(&wav, pBufferOut, bufferSizeInSamples, channels, sampleRate, totalSampleCount);
 }
 
-static void drwav__ieee_to_s32(drwav_int32* pOut, const unsigned char* pIn, size_t totalSampleCount, unsigned short bytesPerSample)
+
+#define DRWAV_OVERVIEW_DEFAULT_FRAMES_PER_POINT     256
+#define DRWAV_OVERVIEW_MAX_LEVELS                   64
+#define DRWAV_OVERVIEW_CHUNK_SAMPLE_COUNT           16384   // The number of samples decoded at a time, per thread.
+#define DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE       24
+#define DRWAV_OVERVIEW_SERIALIZED_VERSION           1
+
+// These stand in for HUGE_VAL, sqrt(), floor() and ceil() so the library doesn't need to be linked with the math library.
+static DRWAV_INLINE float drwav__overview_infinity(void)
 {
-    if (bytesPerSample == 4) {
-        drwav_f32_to_s32(pOut, (float*)pIn, totalSampleCount);
-        return;
-    } else {
-        drwav_f64_to_s32(pOut, (double*)pIn, totalSampleCount);
-        return;
-    }
+    drwav_uint32 bits = 0x7F800000;
+    float x;
+    memcpy(&x, &bits, sizeof(x));
+    return x;
 }
 
-
-drwav_uint64 drwav_read_s32__pcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+static double drwav__sqrt_f64(double x)
 {
-    // Fast path.
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM && pWav->bytesPerSample == 4) {
-        return drwav_read(pWav, samplesToRead, pBufferOut);
+    if (!(x > 0)) {
+        return 0;
+    }
+    if (x - x != 0) {
+        return x;   // Infinity.
     }
 
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
+    // Halving the exponent gets within a factor of two of the root. After one step of Newton's method the estimate is never
+    // below the root, so the rest of the steps only get smaller until they can't improve it any more.
+    drwav_uint64 bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = (bits >> 1) + ((drwav_uint64)0x1FF8 << 48);
+
+    double y;
+    memcpy(&y, &bits, sizeof(y));
+    y = 0.5 * (y + x/y);
+    for (;;) {
+        double next = 0.5 * (y + x/y);
+        if (next >= y) {
             break;
         }
-
-        drwav__pcm_to_s32(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
-
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+        y = next;
     }
 
-    return totalSamplesRead;
+    return y;
 }
 
-drwav_uint64 drwav_read_s32__msadpcm(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+static DRWAV_INLINE double drwav__floor_f64(double x)
 {
-    // We're just going to borrow the implementation from the drwav_read_s16() since ADPCM is a little bit more complicated than other formats and I don't
-    // want to duplicate that code.
-    drwav_uint64 totalSamplesRead = 0;
-    drwav_int16 samples16[2048];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read_s16(pWav, drwav_min(samplesToRead, 2048), samples16);
-        if (samplesRead == 0) {
-            break;
-        }
-
-        drwav_s16_to_s32(pBufferOut, samples16, (size_t)samplesRead);   // <-- Safe cast because we're clamping to 2048.
-
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+    if (!(x > -4503599627370496.0 && x < 4503599627370496.0)) {
+        return x;   // Already a whole number, or NaN.
     }
 
-    return totalSamplesRead;
+    double i = (double)(drwav_int64)x;
+    return (i > x) ? i - 1 : i;
 }
 
-drwav_uint64 drwav_read_s32__ima(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+static DRWAV_INLINE double drwav__ceil_f64(double x)
 {
-    // We're just going to borrow the implementation from the drwav_read_s16() since IMA-ADPCM is a little bit more complicated than other formats and I don't
-    // want to duplicate that code.
-    drwav_uint64 totalSamplesRead = 0;
-    drwav_int16 samples16[2048];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read_s16(pWav, drwav_min(samplesToRead, 2048), samples16);
-        if (samplesRead == 0) {
-            break;
-        }
+    return -drwav__floor_f64(-x);
+}
 
-        drwav_s16_to_s32(pBufferOut, samples16, (size_t)samplesRead);   // <-- Safe cast because we're clamping to 2048.
+typedef struct
+{
+    float min;
+    float max;
+    double sumSquares;
+} drwav__overview_accumulator;
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+static void drwav__overview_reset_accumulators(drwav__overview_accumulator* pAccumulators, drwav_uint16 channels)
+{
+    for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        pAccumulators[iChannel].min =  drwav__overview_infinity();
+        pAccumulators[iChannel].max = -drwav__overview_infinity();
+        pAccumulators[iChannel].sumSquares = 0;
     }
-
-    return totalSamplesRead;
 }
 
-drwav_uint64 drwav_read_s32__ieee(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+static void drwav__overview_accumulate__reference(drwav__overview_accumulator* pAccumulators, const float* pSamples, drwav_uint64 frameCount, drwav_uint16 channels)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+    for (drwav_uint64 iFrame = 0; iFrame < frameCount; ++iFrame) {
+        for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+            float x = *pSamples++;
+            drwav__overview_accumulator* pAccumulator = &pAccumulators[iChannel];
+            pAccumulator->min = drwav_min(pAccumulator->min, x);
+            pAccumulator->max = drwav_max(pAccumulator->max, x);
+            pAccumulator->sumSquares += (double)x*x;
         }
-
-        drwav__ieee_to_s32(pBufferOut, sampleData, (size_t)samplesRead, pWav->bytesPerSample);
-
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
     }
+}
 
-    return totalSamplesRead;
+#if defined(DRWAV_SUPPORT_SSE2)
+// Squares are summed in double precision, like the reference implementation, so that the result doesn't depend on how the frames
+// were split between calls (and therefore threads) beyond rounding far below what survives the conversion of the RMS to float.
+static DRWAV_INLINE void drwav__overview_accumulate_squares__sse2(__m128d* pSumLo, __m128d* pSumHi, __m128 x)
+{
+    __m128d lo = _mm_cvtps_pd(x);
+    __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+    *pSumLo = _mm_add_pd(*pSumLo, _mm_mul_pd(lo, lo));
+    *pSumHi = _mm_add_pd(*pSumHi, _mm_mul_pd(hi, hi));
 }
 
-drwav_uint64 drwav_read_s32__alaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+// Lane <j> of vector <v> of each group always holds a sample of channel (v*4 + j) % channels, where a group is the smallest number
+// of vectors covering a whole number of frames. Each lane is reduced on its own and then sorted into its channel at the end.
+static void drwav__overview_accumulate__sse2(drwav__overview_accumulator* pAccumulators, const float* pSamples, drwav_uint64 frameCount, drwav_uint16 channels)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
+    drwav_assert(channels <= 8);
+
+    drwav_uint32 vectorsPerGroup = (channels % 4 == 0) ? channels / 4 : ((channels % 2 == 0) ? channels / 2 : channels);
+    drwav_uint64 groupCount = (frameCount * channels) / (vectorsPerGroup * 4);
+    if (groupCount == 0) {
+        drwav__overview_accumulate__reference(pAccumulators, pSamples, frameCount, channels);
+        return;
+    }
+
+    __m128  mins[8];
+    __m128  maxs[8];
+    __m128d sumsLo[8];  // Lanes 0 and 1.
+    __m128d sumsHi[8];  // Lanes 2 and 3.
+    for (drwav_uint32 iVector = 0; iVector < vectorsPerGroup; ++iVector) {
+        mins[iVector]   = _mm_set1_ps( drwav__overview_infinity());
+        maxs[iVector]   = _mm_set1_ps(-drwav__overview_infinity());
+        sumsLo[iVector] = _mm_setzero_pd();
+        sumsHi[iVector] = _mm_setzero_pd();
+    }
+
+    const float* pRunningSamples = pSamples;
+    if (vectorsPerGroup == 1) {
+        // Two sets of accumulators so consecutive iterations don't wait on each other.
+        __m128  min1   = mins[0];
+        __m128  max1   = maxs[0];
+        __m128d sumLo1 = sumsLo[0];
+        __m128d sumHi1 = sumsHi[0];
+        for (drwav_uint64 iGroup = 0; iGroup + 1 < groupCount; iGroup += 2) {
+            __m128 x0 = _mm_loadu_ps(pRunningSamples + 0);
+            __m128 x1 = _mm_loadu_ps(pRunningSamples + 4);
+            mins[0] = _mm_min_ps(mins[0], x0);
+            min1    = _mm_min_ps(min1,    x1);
+            maxs[0] = _mm_max_ps(maxs[0], x0);
+            max1    = _mm_max_ps(max1,    x1);
+            drwav__overview_accumulate_squares__sse2(&sumsLo[0], &sumsHi[0], x0);
+            drwav__overview_accumulate_squares__sse2(&sumLo1,    &sumHi1,    x1);
+            pRunningSamples += 8;
+        }
+        if (groupCount & 1) {
+            __m128 x = _mm_loadu_ps(pRunningSamples);
+            mins[0] = _mm_min_ps(mins[0], x);
+            maxs[0] = _mm_max_ps(maxs[0], x);
+            drwav__overview_accumulate_squares__sse2(&sumsLo[0], &sumsHi[0], x);
+            pRunningSamples += 4;
         }
 
-        drwav_alaw_to_s32(pBufferOut, sampleData, (size_t)samplesRead);
+        mins[0]   = _mm_min_ps(mins[0], min1);
+        maxs[0]   = _mm_max_ps(maxs[0], max1);
+        sumsLo[0] = _mm_add_pd(sumsLo[0], sumLo1);
+        sumsHi[0] = _mm_add_pd(sumsHi[0], sumHi1);
+    } else {
+        for (drwav_uint64 iGroup = 0; iGroup < groupCount; ++iGroup) {
+            for (drwav_uint32 iVector = 0; iVector < vectorsPerGroup; ++iVector) {
+                __m128 x = _mm_loadu_ps(pRunningSamples);
+                mins[iVector] = _mm_min_ps(mins[iVector], x);
+                maxs[iVector] = _mm_max_ps(maxs[iVector], x);
+                drwav__overview_accumulate_squares__sse2(&sumsLo[iVector], &sumsHi[iVector], x);
+                pRunningSamples += 4;
+            }
+        }
+    }
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+    // With 1 or 2 channels the lanes can be folded together until there is one per channel.
+    drwav_uint32 laneCount = 4;
+    if (channels <= 2) {
+        mins[0]   = _mm_min_ps(mins[0], _mm_movehl_ps(mins[0], mins[0]));
+        maxs[0]   = _mm_max_ps(maxs[0], _mm_movehl_ps(maxs[0], maxs[0]));
+        sumsLo[0] = _mm_add_pd(sumsLo[0], sumsHi[0]);
+        laneCount = 2;
+    }
+    if (channels == 1) {
+        mins[0]   = _mm_min_ps(mins[0], _mm_shuffle_ps(mins[0], mins[0], _MM_SHUFFLE(1, 1, 1, 1)));
+        maxs[0]   = _mm_max_ps(maxs[0], _mm_shuffle_ps(maxs[0], maxs[0], _MM_SHUFFLE(1, 1, 1, 1)));
+        sumsLo[0] = _mm_add_pd(sumsLo[0], _mm_unpackhi_pd(sumsLo[0], sumsLo[0]));
+        laneCount = 1;
+    }
+
+    drwav_uint32 iChannel = 0;
+    for (drwav_uint32 iVector = 0; iVector < vectorsPerGroup; ++iVector) {
+        float  laneMins[4];
+        float  laneMaxs[4];
+        double laneSums[4];
+        _mm_storeu_ps(laneMins, mins[iVector]);
+        _mm_storeu_ps(laneMaxs, maxs[iVector]);
+        _mm_storeu_pd(laneSums + 0, sumsLo[iVector]);
+        _mm_storeu_pd(laneSums + 2, sumsHi[iVector]);
+
+        for (drwav_uint32 iLane = 0; iLane < laneCount; ++iLane) {
+            drwav__overview_accumulator* pAccumulator = &pAccumulators[iChannel];
+            pAccumulator->min = drwav_min(pAccumulator->min, laneMins[iLane]);
+            pAccumulator->max = drwav_max(pAccumulator->max, laneMaxs[iLane]);
+            pAccumulator->sumSquares += laneSums[iLane];
+
+            iChannel += 1;
+            if (iChannel == channels) {
+                iChannel = 0;
+            }
+        }
     }
 
-    return totalSamplesRead;
+    drwav_uint64 framesProcessed = (groupCount * vectorsPerGroup * 4) / channels;
+    drwav__overview_accumulate__reference(pAccumulators, pRunningSamples, frameCount - framesProcessed, channels);
 }
+#endif
 
-drwav_uint64 drwav_read_s32__mulaw(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+static void drwav__overview_accumulate(drwav__overview_accumulator* pAccumulators, const float* pSamples, drwav_uint64 frameCount, drwav_uint16 channels)
 {
-    drwav_uint64 totalSamplesRead = 0;
-    unsigned char sampleData[4096];
-    while (samplesToRead > 0) {
-        drwav_uint64 samplesRead = drwav_read(pWav, drwav_min(samplesToRead, sizeof(sampleData)/pWav->bytesPerSample), sampleData);
-        if (samplesRead == 0) {
-            break;
-        }
+#if defined(DRWAV_SUPPORT_SSE2)
+    if (channels <= 8) {
+        drwav__overview_accumulate__sse2(pAccumulators, pSamples, frameCount, channels);
+        return;
+    }
+#endif
 
-        drwav_mulaw_to_s32(pBufferOut, sampleData, (size_t)samplesRead);
+    drwav__overview_accumulate__reference(pAccumulators, pSamples, frameCount, channels);
+}
 
-        pBufferOut       += samplesRead;
-        samplesToRead    -= samplesRead;
-        totalSamplesRead += samplesRead;
+static void drwav__overview_emit_point(drwav_overview_point* pPointsOut, drwav__overview_accumulator* pAccumulators, drwav_uint16 channels, drwav_uint32 frameCount)
+{
+    for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+        pPointsOut[iChannel].min = pAccumulators[iChannel].min;
+        pPointsOut[iChannel].max = pAccumulators[iChannel].max;
+        pPointsOut[iChannel].rms = (float)drwav__sqrt_f64(pAccumulators[iChannel].sumSquares / frameCount);
     }
 
-    return totalSamplesRead;
+    drwav__overview_reset_accumulators(pAccumulators, channels);
 }
 
-drwav_uint64 drwav_read_s32(drwav* pWav, drwav_uint64 samplesToRead, drwav_int32* pBufferOut)
+// Summarizes the next <frameCount> frames of <pWav> into level 0 points starting at <pPointsOut>. <*pFramesRead> will be less than
+// <frameCount> if the stream ends early.
+static drwav_bool32 drwav__overview_read_points(drwav* pWav, drwav_uint64 frameCount, drwav_uint32 framesPerPoint, drwav_overview_point* pPointsOut, drwav_uint64* pFramesRead)
 {
-    if (pWav == NULL || samplesToRead == 0 || pBufferOut == NULL) {
-        return 0;
-    }
+    drwav_uint16 channels = pWav->channels;
+    size_t chunkFrameCount = drwav_max(1, DRWAV_OVERVIEW_CHUNK_SAMPLE_COUNT / channels);
 
-    // Don't try to read more samples than can potentially fit in the output buffer.
-    if (samplesToRead * sizeof(drwav_int32) > SIZE_MAX) {
-        samplesToRead = SIZE_MAX / sizeof(drwav_int32);
+    *pFramesRead = 0;
+
+    float* pChunk = (float*)DRWAV_MALLOC(chunkFrameCount * channels * sizeof(float));
+    drwav__overview_accumulator* pAccumulators = (drwav__overview_accumulator*)DRWAV_MALLOC(channels * sizeof(*pAccumulators));
+    if (pChunk == NULL || pAccumulators == NULL) {
+        DRWAV_FREE(pChunk);
+        DRWAV_FREE(pAccumulators);
+        return DRWAV_FALSE;
     }
 
+    drwav__overview_reset_accumulators(pAccumulators, channels);
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_PCM) {
-        return drwav_read_s32__pcm(pWav, samplesToRead, pBufferOut);
-    }
+    drwav_uint32 framesInPoint = 0;
+    while (*pFramesRead < frameCount) {
+        drwav_uint64 framesToRead = drwav_min(chunkFrameCount, frameCount - *pFramesRead);
+        drwav_uint64 framesRead = drwav_read_f32(pWav, framesToRead * channels, pChunk) / channels;
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ADPCM) {
-        return drwav_read_s32__msadpcm(pWav, samplesToRead, pBufferOut);
-    }
+        // A chunk can span any number of points, and a point any number of chunks.
+        drwav_uint64 iFrame = 0;
+        while (iFrame < framesRead) {
+            drwav_uint32 framesToAccumulate = (drwav_uint32)drwav_min(framesRead - iFrame, framesPerPoint - framesInPoint);
+            drwav__overview_accumulate(pAccumulators, pChunk + (iFrame * channels), framesToAccumulate, channels);
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
-        return drwav_read_s32__ieee(pWav, samplesToRead, pBufferOut);
-    }
+            framesInPoint += framesToAccumulate;
+            iFrame += framesToAccumulate;
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_ALAW) {
-        return drwav_read_s32__alaw(pWav, samplesToRead, pBufferOut);
-    }
+            if (framesInPoint == framesPerPoint) {
+                drwav__overview_emit_point(pPointsOut, pAccumulators, channels, framesInPoint);
+                pPointsOut += channels;
+                framesInPoint = 0;
+            }
+        }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_MULAW) {
-        return drwav_read_s32__mulaw(pWav, samplesToRead, pBufferOut);
+        *pFramesRead += framesRead;
+        if (framesRead < framesToRead) {
+            break;
+        }
     }
 
-    if (pWav->translatedFormatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
-        return drwav_read_s32__ima(pWav, samplesToRead, pBufferOut);
+    if (framesInPoint > 0) {
+        drwav__overview_emit_point(pPointsOut, pAccumulators, channels, framesInPoint);
     }
 
-    return 0;
+    DRWAV_FREE(pChunk);
+    DRWAV_FREE(pAccumulators);
+    return DRWAV_TRUE;
 }
 
-void drwav_u8_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+static drwav_uint64 drwav__overview_get_point_count(drwav_uint64 frameCount, drwav_uint32 framesPerPoint, drwav_uint32 level)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    drwav_uint64 pointCount = (frameCount / framesPerPoint) + ((frameCount % framesPerPoint) ? 1 : 0);
+    for (drwav_uint32 iLevel = 0; iLevel < level; ++iLevel) {
+        pointCount = (pointCount + 1) / 2;
     }
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = ((int)pIn[i] - 128) << 24;
-    }
+    return pointCount;
 }
 
-void drwav_s16_to_s32(drwav_int32* pOut, const drwav_int16* pIn, size_t sampleCount)
+// The index of the first point of <level>, counting every channel.
+static drwav_uint64 drwav__overview_get_level_offset(const drwav_overview* pOverview, drwav_uint32 level)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    drwav_uint64 offset = 0;
+    drwav_uint64 pointCount = drwav__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, 0);
+    for (drwav_uint32 iLevel = 0; iLevel < level; ++iLevel) {
+        offset += pointCount * pOverview->channels;
+        pointCount = (pointCount + 1) / 2;
     }
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = pIn[i] << 16;
-    }
+    return offset;
 }
 
-void drwav_s24_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+static void drwav__overview_set_frame_count(drwav_overview* pOverview, drwav_uint64 frameCount, drwav_uint32 maxLevels)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    pOverview->frameCount = frameCount;
+    pOverview->levelCount = 1;
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        unsigned int s0 = pIn[i*3 + 0];
-        unsigned int s1 = pIn[i*3 + 1];
-        unsigned int s2 = pIn[i*3 + 2];
-
-        drwav_int32 sample32 = (drwav_int32)((s0 << 8) | (s1 << 16) | (s2 << 24));
-        *pOut++ = sample32;
+    drwav_uint64 pointCount = drwav__overview_get_point_count(frameCount, pOverview->framesPerPoint, 0);
+    while (pointCount > 1 && pOverview->levelCount < maxLevels) {
+        pointCount = (pointCount + 1) / 2;
+        pOverview->levelCount += 1;
     }
 }
 
-void drwav_f32_to_s32(drwav_int32* pOut, const float* pIn, size_t sampleCount)
+// Sets up everything except the points, which are allocated for <frameCount> frames.
+static drwav_bool32 drwav__overview_alloc(drwav_overview* pOverview, drwav_uint16 channels, drwav_uint64 frameCount, drwav_uint32 framesPerPoint, drwav_uint32 maxLevels)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    drwav_zero_memory(pOverview, sizeof(*pOverview));
+    if (channels == 0 || framesPerPoint == 0) {
+        return DRWAV_FALSE;
     }
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (drwav_int32)(2147483648.0 * pIn[i]);
+    pOverview->channels = channels;
+    pOverview->framesPerPoint = framesPerPoint;
+    drwav__overview_set_frame_count(pOverview, frameCount, maxLevels);
+
+    // Each level is about half the size of the one before it so this is less than twice the size of level 0, which keeps it
+    // from overflowing.
+    drwav_uint64 pointCount = drwav__overview_get_level_offset(pOverview, pOverview->levelCount);
+    if (drwav__overview_get_point_count(frameCount, framesPerPoint, 0) > SIZE_MAX / 2 / channels / sizeof(drwav_overview_point)) {
+        return DRWAV_FALSE;
     }
+
+    pOverview->pPoints = (drwav_overview_point*)DRWAV_MALLOC((size_t)drwav_max(pointCount, 1) * sizeof(drwav_overview_point));
+    return pOverview->pPoints != NULL;
 }
 
-void drwav_f64_to_s32(drwav_int32* pOut, const double* pIn, size_t sampleCount)
+static drwav_uint32 drwav__overview_get_max_levels(const drwav_overview_config* pConfig)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    if (pConfig == NULL || pConfig->maxLevels == 0 || pConfig->maxLevels > DRWAV_OVERVIEW_MAX_LEVELS) {
+        return DRWAV_OVERVIEW_MAX_LEVELS;
     }
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = (drwav_int32)(2147483648.0 * pIn[i]);
-    }
+    return pConfig->maxLevels;
 }
 
-void drwav_alaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+static drwav_uint32 drwav__overview_get_frames_per_point(const drwav_overview_config* pConfig)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
+    if (pConfig == NULL || pConfig->framesPerPoint == 0) {
+        return DRWAV_OVERVIEW_DEFAULT_FRAMES_PER_POINT;
     }
 
-    for (size_t i = 0; i < sampleCount; ++i) {
-        *pOut++ = ((drwav_int32)drwav__alaw_to_s16(pIn[i])) << 16;
-    }
+    return pConfig->framesPerPoint;
 }
 
-void drwav_mulaw_to_s32(drwav_int32* pOut, const drwav_uint8* pIn, size_t sampleCount)
+// Each point of a level is made from two points of the level before it.
+static void drwav__overview_build_levels(drwav_overview* pOverview)
 {
-    if (pOut == NULL || pIn == NULL) {
-        return;
-    }
+    drwav_uint16 channels = pOverview->channels;
+    for (drwav_uint32 iLevel = 1; iLevel < pOverview->levelCount; ++iLevel) {
+        drwav_uint64 srcPointCount;
+        drwav_uint64 dstPointCount;
+        const drwav_overview_point* pSrc = drwav_overview_get_level(pOverview, iLevel - 1, &srcPointCount);
+        drwav_overview_point* pDst = (drwav_overview_point*)drwav_overview_get_level(pOverview, iLevel, &dstPointCount);
+        drwav_uint64 framesPerSrcPoint = (drwav_uint64)pOverview->framesPerPoint << (iLevel - 1);
+
+        for (drwav_uint64 iPoint = 0; iPoint < dstPointCount; ++iPoint) {
+            drwav_uint64 iSrcPoint = iPoint*2;
+            const drwav_overview_point* pA = pSrc + (iSrcPoint * channels);
+            if (iSrcPoint + 1 == srcPointCount) {
+                drwav_copy_memory(pDst, pA, channels * sizeof(*pDst));
+            } else {
+                const drwav_overview_point* pB = pA + channels;
 
-    for (size_t i= 0; i < sampleCount; ++i) {
-        *pOut++ = ((drwav_int32)drwav__mulaw_to_s16(pIn[i])) << 16;
-    }
-}
+                // The second point may be the last one of the level, which covers fewer frames.
+                double frameCountA = (double)framesPerSrcPoint;
+                double frameCountB = (double)drwav_min(framesPerSrcPoint, pOverview->frameCount - ((iSrcPoint + 1) * framesPerSrcPoint));
 
+                for (drwav_uint16 iChannel = 0; iChannel < channels; ++iChannel) {
+                    double sumSquares = ((double)pA[iChannel].rms * pA[iChannel].rms * frameCountA) + ((double)pB[iChannel].rms * pB[iChannel].rms * frameCountB);
+                    pDst[iChannel].min = drwav_min(pA[iChannel].min, pB[iChannel].min);
+                    pDst[iChannel].max = drwav_max(pA[iChannel].max, pB[iChannel].max);
+                    pDst[iChannel].rms = (float)drwav__sqrt_f64(sumSquares / (frameCountA + frameCountB));
+                }
+            }
 
+            pDst += channels;
+        }
+    }
+}
 
-drwav_int16* drwav__read_and_close_s16(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+drwav_bool32 drwav_overview_init(drwav_overview* pOverview, drwav* pWav, const drwav_overview_config* pConfig)
 {
-    drwav_assert(pWav != NULL);
-
-    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int16);
-    if (sampleDataSize > SIZE_MAX) {
-        drwav_uninit(pWav);
-        return NULL;    // File's too big.
+    if (pOverview == NULL || pWav == NULL) {
+        return DRWAV_FALSE;
     }
 
-    drwav_int16* pSampleData = (drwav_int16*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
-    if (pSampleData == NULL) {
-        drwav_uninit(pWav);
-        return NULL;    // Failed to allocate memory.
+    drwav_uint32 maxLevels = drwav__overview_get_max_levels(pConfig);
+    if (!drwav__overview_alloc(pOverview, pWav->channels, pWav->totalSampleCount / drwav_max(pWav->channels, 1), drwav__overview_get_frames_per_point(pConfig), maxLevels)) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
     }
 
-    drwav_uint64 samplesRead = drwav_read_s16(pWav, (size_t)pWav->totalSampleCount, pSampleData);
-    if (samplesRead != pWav->totalSampleCount) {
-        DRWAV_FREE(pSampleData);
-        drwav_uninit(pWav);
-        return NULL;    // There was an error reading the samples.
+    drwav_uint64 framesRead;
+    if (!drwav_seek_to_sample(pWav, 0) || !drwav__overview_read_points(pWav, pOverview->frameCount, pOverview->framesPerPoint, pOverview->pPoints, &framesRead)) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
     }
 
-    drwav_uninit(pWav);
+    // A truncated file has fewer frames than the header says. Level 0 is at the start of the buffer so it's already in place.
+    if (framesRead < pOverview->frameCount) {
+        drwav__overview_set_frame_count(pOverview, framesRead, maxLevels);
+    }
 
-    if (sampleRate) *sampleRate = pWav->sampleRate;
-    if (channels) *channels = pWav->channels;
-    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
-    return pSampleData;
+    drwav__overview_build_levels(pOverview);
+    return DRWAV_TRUE;
 }
 
-float* drwav__read_and_close_f32(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+typedef struct
 {
-    drwav_assert(pWav != NULL);
-
-    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(float);
-    if (sampleDataSize > SIZE_MAX) {
-        drwav_uninit(pWav);
-        return NULL;    // File's too big.
-    }
+    drwav__job_proc onRun;
+    const drwav_source* pSource;
+    drwav_uint32 framesPerPoint;
+    drwav_uint64 firstFrame;
+    drwav_uint64 frameCount;
+    drwav_overview_point* pPointsOut;
+    drwav_uint64 framesRead;
+    drwav_bool32 result;
+} drwav__overview_job;
+
+static void drwav__run_overview_job(void* pUserData)
+{
+    drwav__overview_job* pJob = (drwav__overview_job*)pUserData;
+    pJob->framesRead = 0;
+    pJob->result = DRWAV_FALSE;
 
-    float* pSampleData = (float*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
-    if (pSampleData == NULL) {
-        drwav_uninit(pWav);
-        return NULL;    // Failed to allocate memory.
+    drwav_cursor cursor;
+    if (!drwav_cursor_init(&cursor, pJob->pSource)) {
+        return;
     }
 
-    drwav_uint64 samplesRead = drwav_read_f32(pWav, (size_t)pWav->totalSampleCount, pSampleData);
-    if (samplesRead != pWav->totalSampleCount) {
-        DRWAV_FREE(pSampleData);
-        drwav_uninit(pWav);
-        return NULL;    // There was an error reading the samples.
+    if (drwav_seek_to_sample(&cursor.wav, pJob->firstFrame * cursor.wav.channels)) {
+        pJob->result = drwav__overview_read_points(&cursor.wav, pJob->frameCount, pJob->framesPerPoint, pJob->pPointsOut, &pJob->framesRead);
     }
 
-    drwav_uninit(pWav);
-
-    if (sampleRate) *sampleRate = pWav->sampleRate;
-    if (channels) *channels = pWav->channels;
-    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
-    return pSampleData;
+    drwav_cursor_uninit(&cursor);
 }
 
-drwav_int32* drwav__read_and_close_s32(drwav* pWav, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+drwav_bool32 drwav_overview_init_source(drwav_overview* pOverview, const drwav_source* pSource, const drwav_overview_config* pConfig)
 {
-    drwav_assert(pWav != NULL);
-
-    drwav_uint64 sampleDataSize = pWav->totalSampleCount * sizeof(drwav_int32);
-    if (sampleDataSize > SIZE_MAX) {
-        drwav_uninit(pWav);
-        return NULL;    // File's too big.
+    if (pOverview == NULL || pSource == NULL) {
+        return DRWAV_FALSE;
     }
 
-    drwav_int32* pSampleData = (drwav_int32*)DRWAV_MALLOC((size_t)sampleDataSize);    // <-- Safe cast due to the check above.
-    if (pSampleData == NULL) {
-        drwav_uninit(pWav);
-        return NULL;    // Failed to allocate memory.
+    drwav_uint32 maxLevels = drwav__overview_get_max_levels(pConfig);
+    if (!drwav__overview_alloc(pOverview, pSource->wav.channels, pSource->wav.totalSampleCount / drwav_max(pSource->wav.channels, 1), drwav__overview_get_frames_per_point(pConfig), maxLevels)) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
     }
 
-    drwav_uint64 samplesRead = drwav_read_s32(pWav, (size_t)pWav->totalSampleCount, pSampleData);
-    if (samplesRead != pWav->totalSampleCount) {
-        DRWAV_FREE(pSampleData);
-        drwav_uninit(pWav);
-        return NULL;    // There was an error reading the samples.
+    drwav_uint64 pointCount = drwav__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, 0);
+    unsigned int jobCount = drwav__get_job_count((pConfig != NULL) ? pConfig->threadCount : 0, pointCount);
+
+    drwav__overview_job* pJobs = (drwav__overview_job*)DRWAV_MALLOC(jobCount * sizeof(*pJobs));
+    if (pJobs == NULL) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
     }
 
-    drwav_uninit(pWav);
+    // Points are divided evenly with the remainder going to the first few jobs.
+    drwav_uint64 firstPoint = 0;
+    for (unsigned int iJob = 0; iJob < jobCount; ++iJob) {
+        drwav_uint64 jobPointCount = (pointCount / jobCount) + ((iJob < (pointCount % jobCount)) ? 1 : 0);
 
-    if (sampleRate) *sampleRate = pWav->sampleRate;
-    if (channels) *channels = pWav->channels;
-    if (totalSampleCount) *totalSampleCount = pWav->totalSampleCount;
-    return pSampleData;
-}
+        drwav__overview_job* pJob = &pJobs[iJob];
+        pJob->onRun          = drwav__run_overview_job;
+        pJob->pSource        = pSource;
+        pJob->framesPerPoint = pOverview->framesPerPoint;
+        pJob->firstFrame     = firstPoint * pOverview->framesPerPoint;
+        pJob->frameCount     = drwav_min(jobPointCount * pOverview->framesPerPoint, pOverview->frameCount - pJob->firstFrame);
+        pJob->pPointsOut     = pOverview->pPoints + (firstPoint * pOverview->channels);
 
+        firstPoint += jobPointCount;
+    }
 
-drwav_int16* drwav_open_and_read_s16(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
-{
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    drwav__run_jobs(pJobs, sizeof(*pJobs), jobCount);
 
-    drwav wav;
-    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
-        return NULL;
+    // If the stream ends early the overview ends with the first job that came up short, just like drwav_overview_init().
+    drwav_bool32 result = DRWAV_TRUE;
+    for (unsigned int iJob = 0; iJob < jobCount; ++iJob) {
+        if (!pJobs[iJob].result) {
+            result = DRWAV_FALSE;
+            break;
+        }
+        if (pJobs[iJob].framesRead < pJobs[iJob].frameCount) {
+            drwav__overview_set_frame_count(pOverview, pJobs[iJob].firstFrame + pJobs[iJob].framesRead, maxLevels);
+            break;
+        }
     }
 
-    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
-}
-
-float* drwav_open_and_read_f32(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
-{
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    DRWAV_FREE(pJobs);
 
-    drwav wav;
-    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
-        return NULL;
+    if (!result) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
     }
 
-    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
+    drwav__overview_build_levels(pOverview);
+    return DRWAV_TRUE;
 }
 
-drwav_int32* drwav_open_and_read_s32(drwav_read_proc onRead, drwav_seek_proc onSeek, void* pUserData, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+void drwav_overview_uninit(drwav_overview* pOverview)
 {
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
-
-    drwav wav;
-    if (!drwav_init(&wav, onRead, onSeek, pUserData)) {
-        return NULL;
+    if (pOverview == NULL) {
+        return;
     }
 
-    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
+    DRWAV_FREE(pOverview->pPoints);
+    pOverview->pPoints = NULL;
 }
 
-#ifndef DR_WAV_NO_STDIO
-drwav_int16* drwav_open_and_read_file_s16(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+const drwav_overview_point* drwav_overview_get_level(const drwav_overview* pOverview, drwav_uint32 level, drwav_uint64* pPointCount)
 {
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    if (pPointCount != NULL) {
+        *pPointCount = 0;
+    }
 
-    drwav wav;
-    if (!drwav_init_file(&wav, filename)) {
+    if (pOverview == NULL || pOverview->pPoints == NULL || level >= pOverview->levelCount) {
         return NULL;
     }
 
-    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
+    if (pPointCount != NULL) {
+        *pPointCount = drwav__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, level);
+    }
+
+    return pOverview->pPoints + drwav__overview_get_level_offset(pOverview, level);
 }
 
-float* drwav_open_and_read_file_f32(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+static DRWAV_INLINE drwav_uint16 drwav__overview_quantize(double x)
 {
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
-
-    drwav wav;
-    if (!drwav_init_file(&wav, filename)) {
-        return NULL;
-    }
-
-    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
+    return (drwav_uint16)(drwav_int16)drwav_clamp(x, -32768.0, 32767.0);
 }
 
-drwav_int32* drwav_open_and_read_file_s32(const char* filename, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+// Serialized overviews are little-endian. After a 24 byte header come the level 0 points, each of which is the minimum, maximum
+// and RMS as signed 16-bit values.
+//
+//   0  "DROV"
+//   4  Version (u16)
+//   6  Channels (u16)
+//   8  Frames per point (u32)
+//   12 Level count (u32)
+//   16 Frame count (u64)
+size_t drwav_overview_serialize(const drwav_overview* pOverview, void* pBufferOut, size_t bufferSize)
 {
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    if (pOverview == NULL || pOverview->pPoints == NULL) {
+        return 0;
+    }
 
-    drwav wav;
-    if (!drwav_init_file(&wav, filename)) {
-        return NULL;
+    drwav_uint64 pointCount = drwav__overview_get_point_count(pOverview->frameCount, pOverview->framesPerPoint, 0) * pOverview->channels;
+    drwav_uint64 dataSize = DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE + (pointCount * 6);
+    if (dataSize > SIZE_MAX) {
+        return 0;
     }
 
-    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
-}
-#endif
+    if (pBufferOut == NULL) {
+        return (size_t)dataSize;
+    }
+    if (bufferSize < dataSize) {
+        return 0;
+    }
 
-drwav_int16* drwav_open_and_read_memory_s16(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
-{
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    unsigned char* pRunningData = (unsigned char*)pBufferOut;
+    pRunningData[0] = 'D'; pRunningData[1] = 'R'; pRunningData[2] = 'O'; pRunningData[3] = 'V';
+    drwav__u16_to_bytes(pRunningData +  4, DRWAV_OVERVIEW_SERIALIZED_VERSION);
+    drwav__u16_to_bytes(pRunningData +  6, pOverview->channels);
+    drwav__u32_to_bytes(pRunningData +  8, pOverview->framesPerPoint);
+    drwav__u32_to_bytes(pRunningData + 12, pOverview->levelCount);
+    drwav__u64_to_bytes(pRunningData + 16, pOverview->frameCount);
+    pRunningData += DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE;
 
-    drwav wav;
-    if (!drwav_init_memory(&wav, data, dataSize)) {
-        return NULL;
+    for (drwav_uint64 iPoint = 0; iPoint < pointCount; ++iPoint) {
+        const drwav_overview_point* pPoint = &pOverview->pPoints[iPoint];
+        drwav__u16_to_bytes(pRunningData + 0, drwav__overview_quantize(drwav__floor_f64(pPoint->min * 32768.0)));
+        drwav__u16_to_bytes(pRunningData + 2, drwav__overview_quantize(drwav__ceil_f64(pPoint->max * 32768.0)));
+        drwav__u16_to_bytes(pRunningData + 4, drwav__overview_quantize(drwav__floor_f64(pPoint->rms * 32768.0 + 0.5)));
+        pRunningData += 6;
     }
 
-    return drwav__read_and_close_s16(&wav, channels, sampleRate, totalSampleCount);
+    return (size_t)dataSize;
 }
 
-float* drwav_open_and_read_memory_f32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
+drwav_bool32 drwav_overview_init_serialized(drwav_overview* pOverview, const void* pData, size_t dataSize)
 {
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    if (pOverview == NULL) {
+        return DRWAV_FALSE;
+    }
 
-    drwav wav;
-    if (!drwav_init_memory(&wav, data, dataSize)) {
-        return NULL;
+    drwav_zero_memory(pOverview, sizeof(*pOverview));
+
+    const unsigned char* pRunningData = (const unsigned char*)pData;
+    if (pRunningData == NULL || dataSize < DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE || !drwav__fourcc_equal(pRunningData, "DROV") || drwav__bytes_to_u16(pRunningData + 4) != DRWAV_OVERVIEW_SERIALIZED_VERSION) {
+        return DRWAV_FALSE;
     }
 
-    return drwav__read_and_close_f32(&wav, channels, sampleRate, totalSampleCount);
-}
+    drwav_uint16 channels       = drwav__bytes_to_u16(pRunningData + 6);
+    drwav_uint32 framesPerPoint = drwav__bytes_to_u32(pRunningData + 8);
+    drwav_uint32 levelCount     = drwav__bytes_to_u32(pRunningData + 12);
+    drwav_uint64 frameCount     = drwav__bytes_to_u64(pRunningData + 16);
+    pRunningData += DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE;
 
-drwav_int32* drwav_open_and_read_memory_s32(const void* data, size_t dataSize, unsigned int* channels, unsigned int* sampleRate, drwav_uint64* totalSampleCount)
-{
-    if (sampleRate) *sampleRate = 0;
-    if (channels) *channels = 0;
-    if (totalSampleCount) *totalSampleCount = 0;
+    if (channels == 0 || framesPerPoint == 0 || levelCount == 0 || levelCount > DRWAV_OVERVIEW_MAX_LEVELS) {
+        return DRWAV_FALSE;
+    }
 
-    drwav wav;
-    if (!drwav_init_memory(&wav, data, dataSize)) {
-        return NULL;
+    drwav_uint64 pointCount = drwav__overview_get_point_count(frameCount, framesPerPoint, 0);
+    if (pointCount > (dataSize - DRWAV_OVERVIEW_SERIALIZED_HEADER_SIZE) / 6 / channels) {
+        return DRWAV_FALSE;     // Truncated.
     }
 
-    return drwav__read_and_close_s32(&wav, channels, sampleRate, totalSampleCount);
+    if (!drwav__overview_alloc(pOverview, channels, frameCount, framesPerPoint, levelCount) || pOverview->levelCount != levelCount) {
+        drwav_overview_uninit(pOverview);
+        return DRWAV_FALSE;
+    }
+
+    for (drwav_uint64 iPoint = 0; iPoint < pointCount * channels; ++iPoint) {
+        drwav_overview_point* pPoint = &pOverview->pPoints[iPoint];
+        pPoint->min = drwav__bytes_to_s16(pRunningData + 0) / 32768.0f;
+        pPoint->max = drwav__bytes_to_s16(pRunningData + 2) / 32768.0f;
+        pPoint->rms = drwav__bytes_to_s16(pRunningData + 4) / 32768.0f;
+        pRunningData += 6;
+    }
+
+    drwav__overview_build_levels(pOverview);
+    return DRWAV_TRUE;
 }
 #endif  //DR_WAV_NO_CONVERSION_API
 
@@ -0,0 +1,854 @@
+// Decoding and conversion benchmarks for dr_wav. Public domain.
+// cc -O2 -std=gnu99 tests/bench_dr_wav.c -o bench_dr_wav -lm -lpthread
+//
+// USAGE
+//
+//     bench_dr_wav [iterations] [frames] [temp directory]
+//
+// Synthesizes stereo files of every supported format in the RIFF, W64 and RF64 containers and times drwav_init_memory(),
+// drwav_read_s16(), drwav_read_f32(), drwav_read_s32(), seeking and each drwav_*_to_* converter. Files are built in memory
+// with their own writer rather than through drwav_init_write() so the compressed formats can be covered as well. The audio
+// is random noise.
+//
+// The "cursor" section decodes files from disk through stdio and through a drwav_cursor. The "windows" section reads random
+// 512-frame windows from a 16-bit stereo file with drwav_read_f32_at() one window at a time, and with drwav_read_f32_at_batch().
+// These need [temp directory], which defaults to the current directory. The files are deleted afterwards.
+//
+// Results are written to stdout as JSON. Every time is the fastest of [iterations] runs (default 5), in milliseconds.
+// Compare a build with -DDR_WAV_NO_SIMD against one without it, or with -mssse3, to measure the SIMD paths.
+#define DR_WAV_IMPLEMENTATION
+#include "../dr_wav.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define BENCH_CHANNELS          2
+#define BENCH_SAMPLE_RATE       44100
+#define BENCH_READ_CHUNK        4096    // In PCM frames.
+#define BENCH_INIT_REPEATS      1000
+#define BENCH_SEEK_COUNT        1000
+#define BENCH_SEEK_READ         256     // PCM frames read after each seek.
+#define BENCH_WINDOW_COUNT      20000
+#define BENCH_WINDOW_FRAMES     512
+
+static double bench_now_ms(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+#endif
+}
+
+static drwav_uint32 g_benchRandomState = 0x12345678;
+
+static drwav_uint32 bench_rand(void)
+{
+    // xorshift32. Fixed seed so every run reads the same data at the same positions.
+    g_benchRandomState ^= g_benchRandomState << 13;
+    g_benchRandomState ^= g_benchRandomState >> 17;
+    g_benchRandomState ^= g_benchRandomState << 5;
+    return g_benchRandomState;
+}
+
+static float bench_rand_f32(void)
+{
+    return (float)((double)bench_rand() / 2147483648.0 - 1.0);
+}
+
+static void bench_rand_bytes(drwav_uint8* p, size_t size)
+{
+    size_t i;
+    for (i = 0; i < size; ++i) {
+        p[i] = (drwav_uint8)(bench_rand() >> 24);
+    }
+}
+
+
+//// In-Memory Files ////
+
+typedef struct
+{
+    drwav_uint8* pData;
+    size_t size;
+    size_t capacity;
+} bench_buffer;
+
+static void bench_put(bench_buffer* pBuffer, const void* pData, size_t size)
+{
+    if (pBuffer->size + size > pBuffer->capacity) {
+        size_t newCapacity = (pBuffer->capacity == 0) ? 4096 : pBuffer->capacity * 2;
+        while (newCapacity < pBuffer->size + size) {
+            newCapacity *= 2;
+        }
+
+        pBuffer->pData = (drwav_uint8*)realloc(pBuffer->pData, newCapacity);
+        if (pBuffer->pData == NULL) {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+        pBuffer->capacity = newCapacity;
+    }
+
+    if (pData != NULL) {
+        memcpy(pBuffer->pData + pBuffer->size, pData, size);
+    } else {
+        memset(pBuffer->pData + pBuffer->size, 0, size);
+    }
+    pBuffer->size += size;
+}
+
+static void bench_put_u16(bench_buffer* pBuffer, drwav_uint16 value)
+{
+    drwav_uint8 bytes[2];
+    bytes[0] = (drwav_uint8)(value >> 0);
+    bytes[1] = (drwav_uint8)(value >> 8);
+    bench_put(pBuffer, bytes, 2);
+}
+
+static void bench_put_u32(bench_buffer* pBuffer, drwav_uint32 value)
+{
+    bench_put_u16(pBuffer, (drwav_uint16)(value >>  0));
+    bench_put_u16(pBuffer, (drwav_uint16)(value >> 16));
+}
+
+static void bench_put_u64(bench_buffer* pBuffer, drwav_uint64 value)
+{
+    bench_put_u32(pBuffer, (drwav_uint32)(value >>  0));
+    bench_put_u32(pBuffer, (drwav_uint32)(value >> 32));
+}
+
+static void bench_set_u32(bench_buffer* pBuffer, size_t offset, drwav_uint32 value)
+{
+    int i;
+    for (i = 0; i < 4; ++i) {
+        pBuffer->pData[offset + i] = (drwav_uint8)(value >> (i*8));
+    }
+}
+
+static void bench_set_u64(bench_buffer* pBuffer, size_t offset, drwav_uint64 value)
+{
+    bench_set_u32(pBuffer, offset + 0, (drwav_uint32)(value >>  0));
+    bench_set_u32(pBuffer, offset + 4, (drwav_uint32)(value >> 32));
+}
+
+// The ID of a chunk. W64 GUIDs for "fmt ", "fact", "data" and "wave" are the FOURCC followed by the same 12 bytes.
+static void bench_put_chunk_id(bench_buffer* pBuffer, drwav_container container, const char* fourcc)
+{
+    static const drwav_uint8 w64Tail[12] = {0xF3,0xAC, 0xD3,0x11, 0x8C,0xD1, 0x00,0xC0,0x4F,0x8E,0xDB,0x8A};
+    bench_put(pBuffer, fourcc, 4);
+    if (container == drwav_container_w64) {
+        bench_put(pBuffer, w64Tail, sizeof(w64Tail));
+    }
+}
+
+static void bench_put_chunk(bench_buffer* pBuffer, drwav_container container, const char* fourcc, const void* pData, drwav_uint64 size)
+{
+    bench_put_chunk_id(pBuffer, container, fourcc);
+    if (container == drwav_container_w64) {
+        bench_put_u64(pBuffer, size + 24);  // <-- W64 sizes include the 24 byte header.
+    } else if (container == drwav_container_rf64 && memcmp(fourcc, "data", 4) == 0) {
+        bench_put_u32(pBuffer, 0xFFFFFFFF); // <-- The real size is in the "ds64" chunk.
+    } else {
+        bench_put_u32(pBuffer, (drwav_uint32)size);
+    }
+
+    bench_put(pBuffer, pData, (size_t)size);
+
+    // Chunks are padded to 2 bytes for RIFF and RF64 and 8 bytes for W64.
+    if (container == drwav_container_w64) {
+        bench_put(pBuffer, NULL, (size_t)((8 - (size % 8)) % 8));
+    } else {
+        bench_put(pBuffer, NULL, (size_t)(size % 2));
+    }
+}
+
+typedef struct
+{
+    const char* name;
+    drwav_uint16 formatTag;
+    drwav_uint16 bitsPerSample;
+} bench_format;
+
+static const bench_format g_benchFormats[] = {
+    {"u8",      DR_WAVE_FORMAT_PCM,        8},
+    {"s16",     DR_WAVE_FORMAT_PCM,       16},
+    {"s24",     DR_WAVE_FORMAT_PCM,       24},
+    {"s32",     DR_WAVE_FORMAT_PCM,       32},
+    {"f32",     DR_WAVE_FORMAT_IEEE_FLOAT, 32},
+    {"f64",     DR_WAVE_FORMAT_IEEE_FLOAT, 64},
+    {"alaw",    DR_WAVE_FORMAT_ALAW,       8},
+    {"mulaw",   DR_WAVE_FORMAT_MULAW,      8},
+    {"msadpcm", DR_WAVE_FORMAT_ADPCM,      4},
+    {"ima",     DR_WAVE_FORMAT_DVI_ADPCM,  4}
+};
+
+static const char* g_benchContainerNames[] = {"riff", "w64", "rf64"};
+static const drwav_container g_benchContainers[] = {drwav_container_riff, drwav_container_w64, drwav_container_rf64};
+
+// Generates <frameCount> PCM frames of random audio data in the given format, with valid block headers for ADPCM.
+static void bench_make_audio(const bench_format* pFormat, drwav_uint64 frameCount, drwav_uint16* pBlockAlign, drwav_uint16* pSamplesPerBlock, bench_buffer* pAudio)
+{
+    drwav_uint16 channels = BENCH_CHANNELS;
+
+    if (pFormat->formatTag == DR_WAVE_FORMAT_ADPCM || pFormat->formatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        drwav_uint16 blockAlign = 512 * channels;
+        drwav_uint16 samplesPerBlock;
+        drwav_uint64 blockCount;
+        drwav_uint64 iBlock;
+
+        if (pFormat->formatTag == DR_WAVE_FORMAT_ADPCM) {
+            samplesPerBlock = (drwav_uint16)(((blockAlign - 7*channels) * 8) / (4*channels) + 2);
+        } else {
+            samplesPerBlock = (drwav_uint16)(((blockAlign - 4*channels) * 8) / (4*channels) + 1);
+        }
+
+        blockCount = (frameCount + samplesPerBlock - 1) / samplesPerBlock;
+        for (iBlock = 0; iBlock < blockCount; ++iBlock) {
+            size_t blockStart = pAudio->size;
+            drwav_uint16 iChannel;
+
+            bench_put(pAudio, NULL, blockAlign);
+            bench_rand_bytes(pAudio->pData + blockStart, blockAlign);
+
+            if (pFormat->formatTag == DR_WAVE_FORMAT_ADPCM) {
+                // Predictor indices, then the 16-bit delta, sample 1 and sample 2 of each channel.
+                drwav_uint8* pHeader = pAudio->pData + blockStart;
+                for (iChannel = 0; iChannel < channels; ++iChannel) {
+                    pHeader[iChannel] = (drwav_uint8)(bench_rand() % 7);
+                    pHeader[channels + iChannel*2 + 0] = (drwav_uint8)(16 + bench_rand() % 240);
+                    pHeader[channels + iChannel*2 + 1] = 0;
+                }
+            } else {
+                // A 16-bit predictor, a step index and a reserved byte for each channel.
+                drwav_uint8* pHeader = pAudio->pData + blockStart;
+                for (iChannel = 0; iChannel < channels; ++iChannel) {
+                    pHeader[iChannel*4 + 2] = (drwav_uint8)(bench_rand() % 89);
+                    pHeader[iChannel*4 + 3] = 0;
+                }
+            }
+        }
+
+        *pBlockAlign = blockAlign;
+        *pSamplesPerBlock = samplesPerBlock;
+    } else {
+        drwav_uint64 sampleCount = frameCount * channels;
+        size_t start = pAudio->size;
+        drwav_uint64 i;
+
+        bench_put(pAudio, NULL, (size_t)(sampleCount * (pFormat->bitsPerSample / 8)));
+
+        if (pFormat->formatTag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+            // Random bytes would be mostly NaN and denormals. Keep to the normal range.
+            for (i = 0; i < sampleCount; ++i) {
+                if (pFormat->bitsPerSample == 32) {
+                    float x = bench_rand_f32();
+                    memcpy(pAudio->pData + start + i*4, &x, 4);
+                } else {
+                    double x = (double)bench_rand_f32();
+                    memcpy(pAudio->pData + start + i*8, &x, 8);
+                }
+            }
+        } else {
+            bench_rand_bytes(pAudio->pData + start, pAudio->size - start);
+        }
+
+        *pBlockAlign = (drwav_uint16)(channels * pFormat->bitsPerSample / 8);
+        *pSamplesPerBlock = 1;
+    }
+}
+
+static void bench_make_file(drwav_container container, const bench_format* pFormat, drwav_uint64 frameCount, bench_buffer* pFile)
+{
+    static const drwav_uint8 w64Riff[16] = {0x72,0x69,0x66,0x66, 0x2E,0x91, 0xCF,0x11, 0xA5,0xD6, 0x28,0xDB,0x04,0xC1,0x00,0x00};
+    static const drwav_int16 msadpcmCoefficients[7][2] = {{256, 0}, {512, -256}, {0, 0}, {192, 64}, {240, 0}, {460, -208}, {392, -232}};
+    bench_buffer audio = {NULL, 0, 0};
+    bench_buffer fmt = {NULL, 0, 0};
+    drwav_uint16 blockAlign;
+    drwav_uint16 samplesPerBlock;
+    drwav_bool32 isCompressed = pFormat->formatTag == DR_WAVE_FORMAT_ADPCM || pFormat->formatTag == DR_WAVE_FORMAT_DVI_ADPCM;
+    size_t ds64Pos = 0;
+    int i;
+
+    bench_make_audio(pFormat, frameCount, &blockAlign, &samplesPerBlock, &audio);
+
+    bench_put_u16(&fmt, pFormat->formatTag);
+    bench_put_u16(&fmt, BENCH_CHANNELS);
+    bench_put_u32(&fmt, BENCH_SAMPLE_RATE);
+    bench_put_u32(&fmt, (drwav_uint32)((drwav_uint64)BENCH_SAMPLE_RATE * blockAlign / samplesPerBlock));
+    bench_put_u16(&fmt, blockAlign);
+    bench_put_u16(&fmt, pFormat->bitsPerSample);
+    if (pFormat->formatTag == DR_WAVE_FORMAT_ADPCM) {
+        bench_put_u16(&fmt, 32);
+        bench_put_u16(&fmt, samplesPerBlock);
+        bench_put_u16(&fmt, 7);
+        for (i = 0; i < 7; ++i) {
+            bench_put_u16(&fmt, (drwav_uint16)msadpcmCoefficients[i][0]);
+            bench_put_u16(&fmt, (drwav_uint16)msadpcmCoefficients[i][1]);
+        }
+    } else if (pFormat->formatTag == DR_WAVE_FORMAT_DVI_ADPCM) {
+        bench_put_u16(&fmt, 2);
+        bench_put_u16(&fmt, samplesPerBlock);
+    } else if (pFormat->formatTag != DR_WAVE_FORMAT_PCM) {
+        bench_put_u16(&fmt, 0);
+    }
+
+    // dr_wav expects the fmt chunk of a W64 file to be a multiple of 8 bytes, the same as its own writer.
+    if (container == drwav_container_w64) {
+        bench_put(&fmt, NULL, (8 - (fmt.size % 8)) % 8);
+    }
+
+    pFile->size = 0;
+    if (container == drwav_container_w64) {
+        bench_put(pFile, w64Riff, sizeof(w64Riff));
+        bench_put_u64(pFile, 0);
+        bench_put_chunk_id(pFile, container, "wave");
+    } else {
+        bench_put(pFile, (container == drwav_container_rf64) ? "RF64" : "RIFF", 4);
+        bench_put_u32(pFile, 0xFFFFFFFF);
+        bench_put(pFile, "WAVE", 4);
+        if (container == drwav_container_rf64) {
+            // RIFF size, data size, sample count and an empty table. Filled in at the end.
+            bench_put(pFile, "ds64", 4);
+            bench_put_u32(pFile, 28);
+            ds64Pos = pFile->size;
+            bench_put(pFile, NULL, 28);
+        }
+    }
+
+    bench_put_chunk(pFile, container, "fmt ", fmt.pData, fmt.size);
+    if (isCompressed) {
+        // The number of PCM frames, so the last block's padding isn't decoded as audio.
+        bench_buffer fact = {NULL, 0, 0};
+        bench_put_u64(&fact, frameCount);
+        bench_put_chunk(pFile, container, "fact", fact.pData, (container == drwav_container_w64) ? 8 : 4);
+        free(fact.pData);
+    }
+    bench_put_chunk(pFile, container, "data", audio.pData, audio.size);
+
+    if (container == drwav_container_w64) {
+        bench_set_u64(pFile, 16, pFile->size);
+    } else if (container == drwav_container_rf64) {
+        bench_set_u64(pFile, ds64Pos +  0, pFile->size - 8);
+        bench_set_u64(pFile, ds64Pos +  8, audio.size);
+        bench_set_u64(pFile, ds64Pos + 16, frameCount);
+    } else {
+        bench_set_u32(pFile, 4, (drwav_uint32)(pFile->size - 8));
+    }
+
+    free(audio.pData);
+    free(fmt.pData);
+}
+
+static drwav_bool32 bench_save_file(const char* path, const bench_buffer* pFile)
+{
+    FILE* pOut = fopen(path, "wb");
+    size_t written;
+    if (pOut == NULL) {
+        return DRWAV_FALSE;
+    }
+
+    written = fwrite(pFile->pData, 1, pFile->size, pOut);
+    fclose(pOut);
+    return written == pFile->size;
+}
+
+
+//// Decoding ////
+
+typedef enum
+{
+    bench_read_s16,
+    bench_read_f32,
+    bench_read_s32
+} bench_read_type;
+
+// Reads the rest of the stream in chunks. Returns the number of samples read.
+static drwav_uint64 bench_read_all(drwav* pWav, bench_read_type type, void* pBuffer)
+{
+    drwav_uint64 chunkSize = BENCH_READ_CHUNK * pWav->channels;
+    drwav_uint64 totalSamplesRead = 0;
+    for (;;) {
+        drwav_uint64 samplesRead;
+        switch (type) {
+            case bench_read_s16: samplesRead = drwav_read_s16(pWav, chunkSize, (drwav_int16*)pBuffer); break;
+            case bench_read_f32: samplesRead = drwav_read_f32(pWav, chunkSize, (float*)pBuffer);       break;
+            default:             samplesRead = drwav_read_s32(pWav, chunkSize, (drwav_int32*)pBuffer); break;
+        }
+
+        if (samplesRead == 0) {
+            break;
+        }
+        totalSamplesRead += samplesRead;
+    }
+
+    return totalSamplesRead;
+}
+
+static double bench_decode_read(const bench_buffer* pFile, bench_read_type type, int iterations, void* pBuffer)
+{
+    double best = 1e30;
+    int iIteration;
+    for (iIteration = 0; iIteration < iterations; ++iIteration) {
+        drwav wav;
+        double start = bench_now_ms();
+        double elapsed;
+        if (!drwav_init_memory(&wav, pFile->pData, pFile->size)) {
+            return -1;
+        }
+        bench_read_all(&wav, type, pBuffer);
+        drwav_uninit(&wav);
+
+        elapsed = bench_now_ms() - start;
+        if (best > elapsed) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+// The time for one call to drwav_init_memory() and drwav_uninit(), in microseconds.
+static double bench_decode_init(const bench_buffer* pFile, int iterations)
+{
+    double best = 1e30;
+    int iIteration;
+    for (iIteration = 0; iIteration < iterations; ++iIteration) {
+        double start = bench_now_ms();
+        double elapsed;
+        int i;
+        for (i = 0; i < BENCH_INIT_REPEATS; ++i) {
+            drwav wav;
+            if (!drwav_init_memory(&wav, pFile->pData, pFile->size)) {
+                return -1;
+            }
+            drwav_uninit(&wav);
+        }
+
+        elapsed = (bench_now_ms() - start) * 1000.0 / BENCH_INIT_REPEATS;
+        if (best > elapsed) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+// BENCH_SEEK_COUNT seeks to random positions, each followed by a short read.
+static double bench_decode_seek(const bench_buffer* pFile, int iterations, float* pBuffer)
+{
+    double best = 1e30;
+    int iIteration;
+    for (iIteration = 0; iIteration < iterations; ++iIteration) {
+        drwav wav;
+        double start;
+        double elapsed;
+        drwav_uint64 frameCount;
+        int i;
+
+        if (!drwav_init_memory(&wav, pFile->pData, pFile->size)) {
+            return -1;
+        }
+
+        g_benchRandomState = 0x9E3779B9;
+        frameCount = wav.totalSampleCount / wav.channels;
+
+        start = bench_now_ms();
+        for (i = 0; i < BENCH_SEEK_COUNT; ++i) {
+            drwav_uint64 frameIndex = ((drwav_uint64)bench_rand() * frameCount) >> 32;
+            drwav_seek_to_sample(&wav, frameIndex * wav.channels);
+            drwav_read_f32(&wav, BENCH_SEEK_READ * wav.channels, pBuffer);
+        }
+        elapsed = bench_now_ms() - start;
+
+        drwav_uninit(&wav);
+        if (best > elapsed) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+static void bench_run_decode(int iterations, drwav_uint64 frameCount)
+{
+    bench_buffer file = {NULL, 0, 0};
+    void* pBuffer = malloc(BENCH_READ_CHUNK * BENCH_CHANNELS * sizeof(drwav_int32));
+    size_t iContainer;
+    size_t iFormat;
+    drwav_bool32 isFirst = DRWAV_TRUE;
+
+    printf("  \"decode\": [\n");
+    for (iContainer = 0; iContainer < sizeof(g_benchContainers) / sizeof(g_benchContainers[0]); ++iContainer) {
+        for (iFormat = 0; iFormat < sizeof(g_benchFormats) / sizeof(g_benchFormats[0]); ++iFormat) {
+            const bench_format* pFormat = &g_benchFormats[iFormat];
+            drwav wav;
+            drwav_uint64 framesInFile = 0;
+
+            g_benchRandomState = 0x12345678;
+            bench_make_file(g_benchContainers[iContainer], pFormat, frameCount, &file);
+            if (drwav_init_memory(&wav, file.pData, file.size)) {
+                framesInFile = wav.totalSampleCount / wav.channels;
+                drwav_uninit(&wav);
+            }
+
+            printf("%s    {\"container\": \"%s\", \"format\": \"%s\", \"frames\": %llu, \"bytes\": %llu, ",
+                isFirst ? "" : ",\n", g_benchContainerNames[iContainer], pFormat->name, (unsigned long long)framesInFile, (unsigned long long)file.size);
+            printf("\"init_us\": %.3f, ",   bench_decode_init(&file, iterations));
+            printf("\"read_s16_ms\": %.3f, ", bench_decode_read(&file, bench_read_s16, iterations, pBuffer));
+            printf("\"read_f32_ms\": %.3f, ", bench_decode_read(&file, bench_read_f32, iterations, pBuffer));
+            printf("\"read_s32_ms\": %.3f, ", bench_decode_read(&file, bench_read_s32, iterations, pBuffer));
+            printf("\"seek_ms\": %.3f}", bench_decode_seek(&file, iterations, (float*)pBuffer));
+            fflush(stdout);
+            isFirst = DRWAV_FALSE;
+        }
+    }
+    printf("\n  ],\n");
+
+    free(pBuffer);
+    free(file.pData);
+}
+
+
+//// Conversion ////
+
+typedef enum
+{
+    bench_in_u8,
+    bench_in_s16,
+    bench_in_s24,
+    bench_in_s32,
+    bench_in_f32,
+    bench_in_f64
+} bench_input_type;
+
+typedef struct
+{
+    const char* name;
+    bench_input_type input;
+    void (* onConvert)(void* pOut, const void* pIn, size_t sampleCount);
+} bench_converter;
+
+#define BENCH_CONVERTER(name, tOut, tIn) \
+    static void bench__##name(void* pOut, const void* pIn, size_t sampleCount) { drwav_##name((tOut*)pOut, (const tIn*)pIn, sampleCount); }
+
+BENCH_CONVERTER(u8_to_s16,    drwav_int16, drwav_uint8)
+BENCH_CONVERTER(s24_to_s16,   drwav_int16, drwav_uint8)
+BENCH_CONVERTER(s32_to_s16,   drwav_int16, drwav_int32)
+BENCH_CONVERTER(f32_to_s16,   drwav_int16, float)
+BENCH_CONVERTER(f64_to_s16,   drwav_int16, double)
+BENCH_CONVERTER(alaw_to_s16,  drwav_int16, drwav_uint8)
+BENCH_CONVERTER(mulaw_to_s16, drwav_int16, drwav_uint8)
+BENCH_CONVERTER(u8_to_f32,    float,       drwav_uint8)
+BENCH_CONVERTER(s16_to_f32,   float,       drwav_int16)
+BENCH_CONVERTER(s24_to_f32,   float,       drwav_uint8)
+BENCH_CONVERTER(s32_to_f32,   float,       drwav_int32)
+BENCH_CONVERTER(f64_to_f32,   float,       double)
+BENCH_CONVERTER(alaw_to_f32,  float,       drwav_uint8)
+BENCH_CONVERTER(mulaw_to_f32, float,       drwav_uint8)
+BENCH_CONVERTER(u8_to_s32,    drwav_int32, drwav_uint8)
+BENCH_CONVERTER(s16_to_s32,   drwav_int32, drwav_int16)
+BENCH_CONVERTER(s24_to_s32,   drwav_int32, drwav_uint8)
+BENCH_CONVERTER(f32_to_s32,   drwav_int32, float)
+BENCH_CONVERTER(f64_to_s32,   drwav_int32, double)
+BENCH_CONVERTER(alaw_to_s32,  drwav_int32, drwav_uint8)
+BENCH_CONVERTER(mulaw_to_s32, drwav_int32, drwav_uint8)
+
+static const bench_converter g_benchConverters[] = {
+    {"drwav_u8_to_s16",    bench_in_u8,  bench__u8_to_s16},
+    {"drwav_s24_to_s16",   bench_in_s24, bench__s24_to_s16},
+    {"drwav_s32_to_s16",   bench_in_s32, bench__s32_to_s16},
+    {"drwav_f32_to_s16",   bench_in_f32, bench__f32_to_s16},
+    {"drwav_f64_to_s16",   bench_in_f64, bench__f64_to_s16},
+    {"drwav_alaw_to_s16",  bench_in_u8,  bench__alaw_to_s16},
+    {"drwav_mulaw_to_s16", bench_in_u8,  bench__mulaw_to_s16},
+    {"drwav_u8_to_f32",    bench_in_u8,  bench__u8_to_f32},
+    {"drwav_s16_to_f32",   bench_in_s16, bench__s16_to_f32},
+    {"drwav_s24_to_f32",   bench_in_s24, bench__s24_to_f32},
+    {"drwav_s32_to_f32",   bench_in_s32, bench__s32_to_f32},
+    {"drwav_f64_to_f32",   bench_in_f64, bench__f64_to_f32},
+    {"drwav_alaw_to_f32",  bench_in_u8,  bench__alaw_to_f32},
+    {"drwav_mulaw_to_f32", bench_in_u8,  bench__mulaw_to_f32},
+    {"drwav_u8_to_s32",    bench_in_u8,  bench__u8_to_s32},
+    {"drwav_s16_to_s32",   bench_in_s16, bench__s16_to_s32},
+    {"drwav_s24_to_s32",   bench_in_s24, bench__s24_to_s32},
+    {"drwav_f32_to_s32",   bench_in_f32, bench__f32_to_s32},
+    {"drwav_f64_to_s32",   bench_in_f64, bench__f64_to_s32},
+    {"drwav_alaw_to_s32",  bench_in_u8,  bench__alaw_to_s32},
+    {"drwav_mulaw_to_s32", bench_in_u8,  bench__mulaw_to_s32}
+};
+
+static void bench_run_convert(int iterations, size_t sampleCount)
+{
+    // One input buffer per type, filled with data that's valid for it.
+    void* pInputs[6];
+    void* pOut = malloc(sampleCount * sizeof(drwav_int32));
+    size_t iConverter;
+    size_t i;
+
+    pInputs[bench_in_u8]  = malloc(sampleCount);
+    pInputs[bench_in_s16] = malloc(sampleCount * 2);
+    pInputs[bench_in_s24] = malloc(sampleCount * 3);
+    pInputs[bench_in_s32] = malloc(sampleCount * 4);
+    pInputs[bench_in_f32] = malloc(sampleCount * 4);
+    pInputs[bench_in_f64] = malloc(sampleCount * 8);
+
+    g_benchRandomState = 0x12345678;
+    bench_rand_bytes((drwav_uint8*)pInputs[bench_in_u8],  sampleCount);
+    bench_rand_bytes((drwav_uint8*)pInputs[bench_in_s16], sampleCount * 2);
+    bench_rand_bytes((drwav_uint8*)pInputs[bench_in_s24], sampleCount * 3);
+    bench_rand_bytes((drwav_uint8*)pInputs[bench_in_s32], sampleCount * 4);
+    for (i = 0; i < sampleCount; ++i) {
+        ((float*)pInputs[bench_in_f32])[i] = bench_rand_f32();
+        ((double*)pInputs[bench_in_f64])[i] = (double)bench_rand_f32();
+    }
+
+    printf("  \"convert\": [\n");
+    for (iConverter = 0; iConverter < sizeof(g_benchConverters) / sizeof(g_benchConverters[0]); ++iConverter) {
+        const bench_converter* pConverter = &g_benchConverters[iConverter];
+        double best = 1e30;
+        int iIteration;
+
+        for (iIteration = 0; iIteration < iterations; ++iIteration) {
+            double start = bench_now_ms();
+            double elapsed;
+            pConverter->onConvert(pOut, pInputs[pConverter->input], sampleCount);
+            elapsed = bench_now_ms() - start;
+            if (best > elapsed) {
+                best = elapsed;
+            }
+        }
+
+        printf("%s    {\"name\": \"%s\", \"samples\": %llu, \"ms\": %.3f, \"msamples_per_sec\": %.1f}",
+            (iConverter == 0) ? "" : ",\n", pConverter->name, (unsigned long long)sampleCount, best, (double)sampleCount / (best * 1000.0));
+        fflush(stdout);
+    }
+    printf("\n  ],\n");
+
+    for (i = 0; i < 6; ++i) {
+        free(pInputs[i]);
+    }
+    free(pOut);
+}
+
+
+//// Files ////
+
+static void bench_path(char* pPathOut, size_t pathOutSize, const char* pDirectory, const char* pName)
+{
+    snprintf(pPathOut, pathOutSize, "%s/bench_dr_wav_%s.wav", pDirectory, pName);
+}
+
+// Decodes a whole file from disk through stdio, and through a cursor. Returns the cursor time as a negative number if
+// drwav_source_init_file() isn't available on this platform.
+static void bench_cursor_decode(const char* path, int iterations, void* pBuffer, double* pStdioMS, double* pCursorMS)
+{
+    int iIteration;
+
+    *pStdioMS  = 1e30;
+    *pCursorMS = 1e30;
+    for (iIteration = 0; iIteration < iterations; ++iIteration) {
+        drwav_source source;
+        drwav_cursor cursor;
+        drwav* pWav;
+        double start;
+        double elapsed;
+
+        start = bench_now_ms();
+        pWav = drwav_open_file(path);
+        if (pWav == NULL) {
+            *pStdioMS = -1;
+            *pCursorMS = -1;
+            return;
+        }
+        bench_read_all(pWav, bench_read_s16, pBuffer);
+        drwav_close(pWav);
+        elapsed = bench_now_ms() - start;
+        if (*pStdioMS > elapsed) {
+            *pStdioMS = elapsed;
+        }
+
+        start = bench_now_ms();
+        if (!drwav_source_init_file(&source, path)) {
+            *pCursorMS = -1;
+            continue;
+        }
+        drwav_cursor_init(&cursor, &source);
+        bench_read_all(&cursor.wav, bench_read_s16, pBuffer);
+        drwav_cursor_uninit(&cursor);
+        drwav_source_uninit(&source);
+        elapsed = bench_now_ms() - start;
+        if (*pCursorMS > elapsed) {
+            *pCursorMS = elapsed;
+        }
+    }
+}
+
+static void bench_run_cursor(int iterations, drwav_uint64 frameCount, const char* pDirectory)
+{
+    static const size_t formats[] = {1, 8, 9};  // s16, msadpcm and ima.
+    bench_buffer file = {NULL, 0, 0};
+    void* pBuffer = malloc(BENCH_READ_CHUNK * BENCH_CHANNELS * sizeof(drwav_int16));
+    size_t i;
+
+    printf("  \"cursor\": [\n");
+    for (i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+        const bench_format* pFormat = &g_benchFormats[formats[i]];
+        char path[4096];
+        double stdioMS;
+        double cursorMS;
+
+        g_benchRandomState = 0x12345678;
+        bench_make_file(drwav_container_riff, pFormat, frameCount, &file);
+        bench_path(path, sizeof(path), pDirectory, pFormat->name);
+        if (!bench_save_file(path, &file)) {
+            fprintf(stderr, "Failed to write %s.\n", path);
+            continue;
+        }
+
+        bench_cursor_decode(path, iterations, pBuffer, &stdioMS, &cursorMS);
+        remove(path);
+
+        printf("%s    {\"format\": \"%s\", \"frames\": %llu, \"stdio_ms\": %.3f, \"cursor_ms\": %.3f}",
+            (i == 0) ? "" : ",\n", pFormat->name, (unsigned long long)frameCount, stdioMS, cursorMS);
+        fflush(stdout);
+    }
+    printf("\n  ],\n");
+
+    free(pBuffer);
+    free(file.pData);
+}
+
+static double bench_windows_read(drwav* pWav, drwav_read_window* pWindows, drwav_bool32 isBatch)
+{
+    double start = bench_now_ms();
+    if (isBatch) {
+        drwav_read_f32_at_batch(pWav, pWindows, BENCH_WINDOW_COUNT);
+    } else {
+        size_t i;
+        for (i = 0; i < BENCH_WINDOW_COUNT; ++i) {
+            pWindows[i].framesRead = drwav_read_f32_at(pWav, pWindows[i].frameIndex, pWindows[i].frameCount, pWindows[i].pFramesOut);
+        }
+    }
+
+    return bench_now_ms() - start;
+}
+
+static void bench_run_windows(int iterations, drwav_uint64 frameCount, const char* pDirectory)
+{
+    bench_buffer file = {NULL, 0, 0};
+    drwav_read_window* pWindows = (drwav_read_window*)malloc(BENCH_WINDOW_COUNT * sizeof(*pWindows));
+    float* pFrames = (float*)malloc((size_t)BENCH_WINDOW_COUNT * BENCH_WINDOW_FRAMES * BENCH_CHANNELS * sizeof(float));
+    double results[4] = {1e30, 1e30, 1e30, 1e30};   // stdio single, stdio batch, cursor single, cursor batch.
+    char path[4096];
+    int iIteration;
+    size_t i;
+
+    g_benchRandomState = 0x12345678;
+    bench_make_file(drwav_container_riff, &g_benchFormats[1], frameCount, &file);
+    bench_path(path, sizeof(path), pDirectory, "windows");
+    if (!bench_save_file(path, &file)) {
+        fprintf(stderr, "Failed to write %s.\n", path);
+        frameCount = 0;
+    }
+
+    g_benchRandomState = 0x9E3779B9;
+    for (i = 0; i < BENCH_WINDOW_COUNT; ++i) {
+        pWindows[i].frameIndex = ((drwav_uint64)bench_rand() * (frameCount - BENCH_WINDOW_FRAMES)) >> 32;
+        pWindows[i].frameCount = BENCH_WINDOW_FRAMES;
+        pWindows[i].pFramesOut = pFrames + i * BENCH_WINDOW_FRAMES * BENCH_CHANNELS;
+        pWindows[i].framesRead = 0;
+    }
+
+    for (iIteration = 0; iIteration < iterations && frameCount > 0; ++iIteration) {
+        int iMode;
+        for (iMode = 0; iMode < 4; ++iMode) {
+            drwav_bool32 isBatch = (iMode & 1) != 0;
+            double elapsed;
+
+            if (iMode < 2) {
+                drwav* pWav = drwav_open_file(path);
+                if (pWav == NULL) {
+                    results[iMode] = -1;
+                    continue;
+                }
+                elapsed = bench_windows_read(pWav, pWindows, isBatch);
+                drwav_close(pWav);
+            } else {
+                drwav_source source;
+                drwav_cursor cursor;
+                if (!drwav_source_init_file(&source, path)) {
+                    results[iMode] = -1;
+                    continue;
+                }
+                drwav_cursor_init(&cursor, &source);
+                elapsed = bench_windows_read(&cursor.wav, pWindows, isBatch);
+                drwav_cursor_uninit(&cursor);
+                drwav_source_uninit(&source);
+            }
+
+            if (results[iMode] > elapsed) {
+                results[iMode] = elapsed;
+            }
+        }
+    }
+    remove(path);
+
+    printf("  \"windows\": {\"windows\": %d, \"frames_per_window\": %d, \"stdio_single_ms\": %.3f, \"stdio_batch_ms\": %.3f, \"cursor_single_ms\": %.3f, \"cursor_batch_ms\": %.3f}\n",
+        BENCH_WINDOW_COUNT, BENCH_WINDOW_FRAMES, results[0], results[1], results[2], results[3]);
+
+    free(pFrames);
+    free(pWindows);
+    free(file.pData);
+}
+
+
+int main(int argc, char** argv)
+{
+    int iterations = 5;
+    drwav_uint64 frameCount = 1 << 21;
+    const char* pDirectory = ".";
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations < 1) {
+            iterations = 1;
+        }
+    }
+    if (argc > 2) {
+        frameCount = (drwav_uint64)strtoull(argv[2], NULL, 10);
+        if (frameCount < BENCH_WINDOW_FRAMES) {
+            frameCount = BENCH_WINDOW_FRAMES;
+        }
+    }
+    if (argc > 3) {
+        pDirectory = argv[3];
+    }
+
+    printf("{\n");
+#ifdef DR_WAV_NO_SIMD
+    printf("  \"config\": {\"iterations\": %d, \"frames\": %llu, \"channels\": %d, \"simd\": false},\n", iterations, (unsigned long long)frameCount, BENCH_CHANNELS);
+#else
+    printf("  \"config\": {\"iterations\": %d, \"frames\": %llu, \"channels\": %d, \"simd\": true},\n", iterations, (unsigned long long)frameCount, BENCH_CHANNELS);
+#endif
+    bench_run_decode(iterations, frameCount);
+    bench_run_convert(iterations, (size_t)(frameCount * BENCH_CHANNELS));
+    bench_run_cursor(iterations, frameCount, pDirectory);
+    bench_run_windows(iterations, frameCount, pDirectory);
+    printf("}\n");
+
+    return 0;
+}